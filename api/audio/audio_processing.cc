@@ -35,6 +35,17 @@ std::string NoiseSuppressionLevelToString(
   RTC_CHECK_NOTREACHED();
 }
 
+std::string NoiseSuppressionModeToString(
+    const AudioProcessing::Config::NoiseSuppression::Mode& mode) {
+  switch (mode) {
+    case AudioProcessing::Config::NoiseSuppression::Mode::kClassic:
+      return "Classic";
+    case AudioProcessing::Config::NoiseSuppression::Mode::kRnnoise:
+      return "Rnnoise";
+  }
+  RTC_CHECK_NOTREACHED();
+}
+
 std::string GainController1ModeToString(const Agc1Config::Mode& mode) {
   switch (mode) {
     case Agc1Config::Mode::kAdaptiveAnalog:
@@ -147,6 +158,7 @@ std::string AudioProcessing::Config::ToString() const {
           << " }, noise_suppression: { enabled: " << noise_suppression.enabled
           << ", level: "
           << NoiseSuppressionLevelToString(noise_suppression.level)
+          << ", mode: " << NoiseSuppressionModeToString(noise_suppression.mode)
           << " }, transient_suppression: { enabled: "
           << transient_suppression.enabled
           << " }, gain_controller1: { enabled: " << gain_controller1.enabled
@@ -219,6 +219,11 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
       enum Level { kLow, kModerate, kHigh, kVeryHigh };
       Level level = kModerate;
       bool analyze_linear_aec_output_when_available = false;
+      // kRnnoise suppresses the noise with the RNNoise neural network, which
+      // does not use `level` other than to limit the attenuation of the bands
+      // above 8 kHz.
+      enum Mode { kClassic, kRnnoise };
+      Mode mode = kClassic;
     } noise_suppression;
 
     // Enables transient suppression.
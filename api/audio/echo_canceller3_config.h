@@ -30,6 +30,15 @@ struct RTC_EXPORT EchoCanceller3Config {
   struct Buffering {
     size_t excess_render_detection_interval_blocks = 250;
     size_t max_allowed_excess_render_blocks = 8;
+    // Buffers the render signal and computes its spectra on a worker thread
+    // as render frames arrive, instead of on the capture thread. Every
+    // EchoCanceller3 instance then spawns a thread of its own, so this is
+    // meant for a few instances per process, typically the one of the
+    // AudioProcessing used by the audio device.
+    bool pipelined_render_processing = false;
+    // Runs the worker at realtime priority, like the audio device threads,
+    // rather than at high priority.
+    bool realtime_render_worker = false;
   } buffering;
 
   struct Delay {
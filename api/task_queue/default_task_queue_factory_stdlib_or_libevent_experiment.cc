@@ -24,6 +24,11 @@ std::unique_ptr<TaskQueueFactory> CreateDefaultTaskQueueFactory(
     const FieldTrialsView* field_trials_view) {
   AlwaysValidPointer<const FieldTrialsView, FieldTrialBasedConfig> field_trials(
       field_trials_view);
+  if (field_trials->IsEnabled("WebRTC-TaskQueue-LockFreeStdlib")) {
+    RTC_LOG(LS_INFO) << "WebRTC-TaskQueue-LockFreeStdlib: "
+                     << "using TaskQueueStdlibLockFreeFactory.";
+    return CreateTaskQueueStdlibLockFreeFactory();
+  }
   if (field_trials->IsEnabled("WebRTC-TaskQueue-ReplaceLibeventWithStdlib")) {
     RTC_LOG(LS_INFO) << "WebRTC-TaskQueue-ReplaceLibeventWithStdlib: "
                      << "using TaskQueueStdlibFactory.";
@@ -46,7 +46,10 @@ int AudioprocFloat(rtc::scoped_refptr<AudioProcessing> audio_processing,
 // To get a fully-working audioproc_f utility, all that is needed is to write a
 // main function, create an AudioProcessingBuilder, optionally set custom
 // processing components on it, and pass the builder together with the command
-// line arguments into this function.
+// line arguments into this function. If `ap_builder` is null, a default
+// builder is used. Since a builder creates a single AudioProcessing instance,
+// a builder cannot be passed when replaying a directory of aec dumps with
+// --dump_input_dir, as each aec dump is replayed with its own instance.
 // To see a list of all supported command line flags, run the executable with
 // the '--help' flag.
 int AudioprocFloat(std::unique_ptr<AudioProcessingBuilder> ap_builder,
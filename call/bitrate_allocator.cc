@@ -17,6 +17,7 @@
 #include <utility>
 
 #include "absl/algorithm/container.h"
+#include "api/task_queue/pending_task_safety_flag.h"
 #include "api/units/data_rate.h"
 #include "api/units/time_delta.h"
 #include "rtc_base/checks.h"
@@ -351,7 +352,8 @@ std::map<BitrateAllocatorObserver*, int> AllocateBitrates(
 
 }  // namespace
 
-BitrateAllocator::BitrateAllocator(LimitObserver* limit_observer)
+BitrateAllocator::BitrateAllocator(LimitObserver* limit_observer,
+                                   EgressBudget* egress_budget)
     : limit_observer_(limit_observer),
       last_target_bps_(0),
       last_stable_target_bps_(0),
@@ -360,7 +362,18 @@ BitrateAllocator::BitrateAllocator(LimitObserver* limit_observer)
       last_rtt_(0),
       last_bwe_period_ms_(1000),
       num_pause_events_(0),
-      last_bwe_log_time_(0) {
+      last_bwe_log_time_(0),
+      task_queue_(TaskQueueBase::Current()),
+      egress_subscription_(
+          egress_budget
+              ? egress_budget->Subscribe([this, flag = task_safety_.flag()] {
+                  task_queue_->PostTask(SafeTask(flag, [this] {
+                    RTC_DCHECK_RUN_ON(&sequenced_checker_);
+                    OnEgressShareChanged();
+                  }));
+                })
+              : nullptr) {
+  RTC_DCHECK(!egress_budget || task_queue_);
   sequenced_checker_.Detach();
 }
 
@@ -374,8 +387,52 @@ void BitrateAllocator::UpdateStartRate(uint32_t start_rate_bps) {
   last_non_zero_bitrate_bps_ = start_rate_bps;
 }
 
+void BitrateAllocator::SetEgressNetworkId(uint16_t network_id) {
+  RTC_DCHECK_RUN_ON(&sequenced_checker_);
+  if (egress_subscription_) {
+    egress_subscription_->SetNetworkId(network_id);
+  }
+}
+
+void BitrateAllocator::ApplyEgressBudget(TargetTransferRate& msg) {
+  if (!egress_subscription_) {
+    return;
+  }
+  // The call can't use more than its observers can send, so only that counts
+  // against the budget.
+  DataRate max_allocatable = DataRate::Zero();
+  double priority = 0.0;
+  for (const auto& config : allocatable_tracks_) {
+    max_allocatable += DataRate::BitsPerSec(config.config.max_bitrate_bps);
+    priority += config.config.bitrate_priority;
+  }
+  DataRate cap = egress_subscription_->Update(
+      std::min(msg.target_rate, max_allocatable), priority, msg.at_time);
+  msg.target_rate = std::min(msg.target_rate, cap);
+  msg.stable_target_rate = std::min(msg.stable_target_rate, cap);
+}
+
+void BitrateAllocator::OnEgressShareChanged() {
+  if (!last_estimate_) {
+    return;
+  }
+  TargetTransferRate msg = *last_estimate_;
+  DataRate cap = egress_subscription_->CurrentShare();
+  msg.target_rate = std::min(msg.target_rate, cap);
+  msg.stable_target_rate = std::min(msg.stable_target_rate, cap);
+  AllocateTargetRate(msg);
+}
+
 void BitrateAllocator::OnNetworkEstimateChanged(TargetTransferRate msg) {
   RTC_DCHECK_RUN_ON(&sequenced_checker_);
+  if (egress_subscription_) {
+    last_estimate_ = msg;
+    ApplyEgressBudget(msg);
+  }
+  AllocateTargetRate(msg);
+}
+
+void BitrateAllocator::AllocateTargetRate(const TargetTransferRate& msg) {
   last_target_bps_ = msg.target_rate.bps();
   last_stable_target_bps_ = msg.stable_target_rate.bps();
   last_non_zero_bitrate_bps_ =
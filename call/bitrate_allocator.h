@@ -19,9 +19,14 @@
 #include <utility>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/call/bitrate_allocation.h"
 #include "api/sequence_checker.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
 #include "api/transport/network_types.h"
+#include "api/units/timestamp.h"
+#include "call/egress_budget.h"
 #include "rtc_base/system/no_unique_address.h"
 
 namespace webrtc {
@@ -110,11 +115,19 @@ class BitrateAllocator : public BitrateAllocatorInterface {
     virtual ~LimitObserver() = default;
   };
 
-  explicit BitrateAllocator(LimitObserver* limit_observer);
+  // If `egress_budget` is set, the target rate is capped to the share of the
+  // budget available to this allocator. The allocator must then be created on
+  // the task queue it is used on, where changes of the share are posted.
+  explicit BitrateAllocator(LimitObserver* limit_observer,
+                            EgressBudget* egress_budget = nullptr);
   ~BitrateAllocator() override;
 
   void UpdateStartRate(uint32_t start_rate_bps);
 
+  // Sets the id of the network interface that the call sends over, selecting
+  // the capacity of the egress budget that applies. No-op without a budget.
+  void SetEgressNetworkId(uint16_t network_id);
+
   // Allocate target_bitrate across the registered BitrateAllocatorObservers.
   void OnNetworkEstimateChanged(TargetTransferRate msg);
 
@@ -143,6 +156,19 @@ class BitrateAllocator : public BitrateAllocatorInterface {
   // calls LimitObserver::OnAllocationLimitsChanged.
   void UpdateAllocationLimits() RTC_RUN_ON(&sequenced_checker_);
 
+  // Allocates the target rates of `msg` across the registered observers.
+  void AllocateTargetRate(const TargetTransferRate& msg)
+      RTC_RUN_ON(&sequenced_checker_);
+
+  // Reports the demand of the registered observers to the egress budget and
+  // caps the target rates of `msg` to the share it returns.
+  void ApplyEgressBudget(TargetTransferRate& msg)
+      RTC_RUN_ON(&sequenced_checker_);
+
+  // Reallocates the last estimate when an update of another call sharing the
+  // egress budget changed the share of this one.
+  void OnEgressShareChanged() RTC_RUN_ON(&sequenced_checker_);
+
   // Allow packets to be transmitted in up to 2 times max video bitrate if the
   // bandwidth estimate allows it.
   // TODO(bugs.webrtc.org/8541): May be worth to refactor to keep this logic in
@@ -164,6 +190,14 @@ class BitrateAllocator : public BitrateAllocatorInterface {
   int num_pause_events_ RTC_GUARDED_BY(&sequenced_checker_);
   int64_t last_bwe_log_time_ RTC_GUARDED_BY(&sequenced_checker_);
   BitrateAllocationLimits current_limits_ RTC_GUARDED_BY(&sequenced_checker_);
+  // The last estimate before the egress budget was applied.
+  absl::optional<TargetTransferRate> last_estimate_
+      RTC_GUARDED_BY(&sequenced_checker_);
+  TaskQueueBase* const task_queue_;
+  ScopedTaskSafety task_safety_;
+  // Destroyed first, so that the budget stops posting share changes before
+  // `task_safety_` goes away.
+  const std::unique_ptr<EgressBudget::Subscription> egress_subscription_;
 };
 
 }  // namespace webrtc
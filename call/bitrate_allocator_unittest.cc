@@ -15,6 +15,8 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "call/egress_budget.h"
+#include "rtc_base/thread.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -1034,4 +1036,53 @@ TEST_F(BitrateAllocatorTest, PriorityRateThreeObserversTwoAllocatedToMax) {
   allocator_->RemoveObserver(&observer_high);
 }
 
+TEST(BitrateAllocatorEgressBudgetTest, CapsTargetRateToShareOfBudget) {
+  rtc::AutoThread main_thread;
+  EgressBudget budget;
+  budget.SetCapacity(/*network_id=*/1, DataRate::KilobitsPerSec(1000));
+  NiceMock<MockLimitObserver> limit_observer;
+  BitrateAllocator allocator_a(&limit_observer, &budget);
+  BitrateAllocator allocator_b(&limit_observer, &budget);
+  allocator_a.SetEgressNetworkId(1);
+  allocator_b.SetEgressNetworkId(1);
+  TestBitrateObserver observer_a;
+  TestBitrateObserver observer_b;
+  const MediaStreamAllocationConfig config = {
+      .min_bitrate_bps = 30000,
+      .max_bitrate_bps = 2000000,
+      .pad_up_bitrate_bps = 0,
+      .priority_bitrate_bps = 0,
+      .enforce_min_bitrate = true,
+      .bitrate_priority = kDefaultBitratePriority};
+  allocator_a.AddObserver(&observer_a, config);
+  allocator_b.AddObserver(&observer_b, config);
+
+  allocator_a.OnNetworkEstimateChanged(
+      CreateTargetRateMessage(1500000, 0, 50, kDefaultProbingIntervalMs));
+  EXPECT_EQ(observer_a.last_bitrate_bps_, 1000000u);
+  allocator_b.OnNetworkEstimateChanged(
+      CreateTargetRateMessage(1500000, 0, 50, kDefaultProbingIntervalMs));
+  EXPECT_EQ(observer_b.last_bitrate_bps_, 500000u);
+
+  // A is told that its share shrank when B joined, without waiting for an
+  // estimate of its own.
+  rtc::Thread::Current()->ProcessMessages(0);
+  EXPECT_EQ(observer_a.last_bitrate_bps_, 500000u);
+  EXPECT_LE(observer_a.last_bitrate_bps_ + observer_b.last_bitrate_bps_,
+            1000000u);
+
+  // Estimates below the share are not capped, and the capacity A leaves
+  // unused goes to B.
+  allocator_a.OnNetworkEstimateChanged(
+      CreateTargetRateMessage(300000, 0, 50, kDefaultProbingIntervalMs));
+  EXPECT_EQ(observer_a.last_bitrate_bps_, 300000u);
+  rtc::Thread::Current()->ProcessMessages(0);
+  EXPECT_EQ(observer_b.last_bitrate_bps_, 700000u);
+  EXPECT_LE(observer_a.last_bitrate_bps_ + observer_b.last_bitrate_bps_,
+            1000000u);
+
+  allocator_a.RemoveObserver(&observer_a);
+  allocator_b.RemoveObserver(&observer_b);
+}
+
 }  // namespace webrtc
@@ -417,6 +417,11 @@ class Call final : public webrtc::Call,
   // atomic avoids a PostTask. The variables are used for stats gathering.
   std::atomic<uint32_t> last_bandwidth_bps_{0};
   std::atomic<uint32_t> configured_max_padding_bitrate_bps_{0};
+  // Id of the network interface of the last sent packet, or -1. Written on
+  // the network thread, read when the target rate changes.
+  std::atomic<int> egress_network_id_{-1};
+  int applied_egress_network_id_
+      RTC_GUARDED_BY(send_transport_sequence_checker_) = -1;
 
   ReceiveSideCongestionController receive_side_cc_;
   RepeatingTaskHandle receive_side_cc_periodic_task_;
@@ -659,7 +664,7 @@ Call::Call(const CallConfig& config,
               : nullptr),
       num_cpu_cores_(CpuInfo::DetectNumberOfCores()),
       call_stats_(new CallStats(&env_.clock(), worker_thread_)),
-      bitrate_allocator_(new BitrateAllocator(this)),
+      bitrate_allocator_(new BitrateAllocator(this, config.egress_budget)),
       config_(config),
       audio_network_state_(kNetworkDown),
       video_network_state_(kNetworkDown),
@@ -1228,6 +1233,10 @@ void Call::OnSentPacket(const rtc::SentPacket& sent_packet) {
     return;
   }
   last_sent_packet_ = sent_packet;
+  if (sent_packet.info.network_id.has_value()) {
+    egress_network_id_.store(*sent_packet.info.network_id,
+                             std::memory_order_relaxed);
+  }
 
   // In production and with most tests, this method will be called on the
   // network thread. However some test classes such as DirectTransport don't
@@ -1251,6 +1260,13 @@ void Call::OnTargetTransferRate(TargetTransferRate msg) {
   uint32_t target_bitrate_bps = msg.target_rate.bps();
   // For controlling the rate of feedback messages.
   receive_side_cc_.OnBitrateChanged(target_bitrate_bps);
+  const int egress_network_id =
+      egress_network_id_.load(std::memory_order_relaxed);
+  if (egress_network_id != applied_egress_network_id_) {
+    bitrate_allocator_->SetEgressNetworkId(
+        static_cast<uint16_t>(egress_network_id));
+    applied_egress_network_id_ = egress_network_id;
+  }
   bitrate_allocator_->OnNetworkEstimateChanged(msg);
 
   last_bandwidth_bps_.store(target_bitrate_bps, std::memory_order_relaxed);
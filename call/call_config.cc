@@ -29,6 +29,8 @@ RtpTransportConfig CallConfig::ExtractTransportConfig() const {
   transport_config.network_state_predictor_factory =
       network_state_predictor_factory;
   transport_config.pacer_burst_interval = pacer_burst_interval;
+  transport_config.pacer_scheduler = pacer_scheduler;
+  transport_config.fec_encoding_pool = fec_encoding_pool;
 
   return transport_config;
 }
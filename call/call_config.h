@@ -24,6 +24,9 @@
 namespace webrtc {
 
 class AudioProcessing;
+class EgressBudget;
+class FecEncodingPool;
+class SharedPacerScheduler;
 
 struct CallConfig {
   // If `network_task_queue` is set to nullptr, Call will assume that network
@@ -76,6 +79,20 @@ struct CallConfig {
 
   // Enables send packet batching from the egress RTP sender.
   bool enable_send_packet_batching = false;
+
+  // Optional budget shared with other calls sending over the same network
+  // interfaces, capping the target rate of this call. Must outlive the call.
+  // PeerConnectionFactory leaves it unset; to share a budget between its calls,
+  // inject a MediaFactory whose CreateCall() sets it.
+  EgressBudget* egress_budget = nullptr;
+
+  // Optional scheduler of the pacer wakeups, shared with other calls. Must
+  // outlive the call.
+  SharedPacerScheduler* pacer_scheduler = nullptr;
+
+  // Optional worker threads for FEC encoding of large video frames, shared
+  // with other calls. Must outlive the call.
+  FecEncodingPool* fec_encoding_pool = nullptr;
 };
 
 }  // namespace webrtc
@@ -0,0 +1,221 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/egress_budget.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "absl/algorithm/container.h"
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+constexpr double kUnlimited = std::numeric_limits<double>::infinity();
+
+}  // namespace
+
+EgressBudget::Subscription::~Subscription() {
+  budget_->Unsubscribe(this);
+}
+
+void EgressBudget::Subscription::SetNetworkId(uint16_t network_id) {
+  budget_->SetNetworkId(this, network_id);
+}
+
+DataRate EgressBudget::Subscription::Update(DataRate demand,
+                                            double priority,
+                                            Timestamp at_time) {
+  return budget_->Update(this, demand, priority, at_time);
+}
+
+DataRate EgressBudget::Subscription::CurrentShare() const {
+  return budget_->CurrentShare(this);
+}
+
+EgressBudget::EgressBudget() = default;
+
+EgressBudget::~EgressBudget() {
+  MutexLock lock(&mutex_);
+  RTC_DCHECK(subscribers_.empty());
+}
+
+std::unique_ptr<EgressBudget::Subscription> EgressBudget::Subscribe(
+    absl::AnyInvocable<void()> on_share_changed) {
+  // Can't use make_unique with the private constructor.
+  std::unique_ptr<Subscription> subscription(new Subscription(this));
+  MutexLock lock(&mutex_);
+  subscribers_[subscription.get()].on_share_changed =
+      std::move(on_share_changed);
+  Join(subscription.get(), kUnknownNetwork);
+  return subscription;
+}
+
+void EgressBudget::SetCapacity(uint16_t network_id, DataRate capacity) {
+  MutexLock lock(&mutex_);
+  capacities_.insert_or_assign(network_id, capacity);
+  auto it = pools_.find(network_id);
+  if (it != pools_.end()) {
+    Recompute(network_id, it->second, /*updated=*/nullptr);
+  }
+}
+
+void EgressBudget::SetDefaultCapacity(DataRate capacity) {
+  MutexLock lock(&mutex_);
+  default_capacity_ = capacity;
+  for (auto& [network, pool] : pools_) {
+    Recompute(network, pool, /*updated=*/nullptr);
+  }
+}
+
+void EgressBudget::SetNetworkId(const Subscription* subscription,
+                                uint16_t network_id) {
+  MutexLock lock(&mutex_);
+  if (subscribers_.at(subscription).network == network_id) {
+    return;
+  }
+  Leave(subscription);
+  Join(subscription, network_id);
+}
+
+DataRate EgressBudget::Update(const Subscription* subscription,
+                              DataRate demand,
+                              double priority,
+                              Timestamp at_time) {
+  RTC_DCHECK(demand.IsFinite());
+  RTC_DCHECK_GE(priority, 0.0);
+  MutexLock lock(&mutex_);
+  Subscriber& subscriber = subscribers_.at(subscription);
+  Pool& pool = pools_.at(subscriber.network);
+  pool.total_demand_bps +=
+      demand.bps<double>() - subscriber.demand.bps<double>();
+  subscriber.demand = demand;
+  subscriber.priority = std::max(priority, kMinPriority);
+
+  // Recompute early on large changes in demand, so that new or growing
+  // subscribers can't overload the interface until the next recompute.
+  const bool demand_changed =
+      std::abs(pool.total_demand_bps - pool.total_demand_bps_at_recompute) >
+      kDemandChangeForRecompute * pool.total_demand_bps_at_recompute;
+  if (demand_changed || at_time < pool.last_recompute ||
+      at_time >= pool.last_recompute + kRecomputeInterval) {
+    Recompute(subscriber.network, pool, &subscriber);
+    pool.last_recompute = at_time;
+  }
+  return ShareOf(pool, subscriber.priority);
+}
+
+DataRate EgressBudget::CurrentShare(const Subscription* subscription) {
+  MutexLock lock(&mutex_);
+  const Subscriber& subscriber = subscribers_.at(subscription);
+  return ShareOf(pools_.at(subscriber.network), subscriber.priority);
+}
+
+void EgressBudget::Unsubscribe(const Subscription* subscription) {
+  MutexLock lock(&mutex_);
+  Leave(subscription);
+  subscribers_.erase(subscription);
+}
+
+void EgressBudget::Join(const Subscription* subscription, int network) {
+  Subscriber& subscriber = subscribers_.at(subscription);
+  subscriber.network = network;
+  Pool& pool = pools_[network];
+  pool.members.push_back(&subscriber);
+  pool.total_demand_bps += subscriber.demand.bps<double>();
+  // A subscriber moving in may shrink the shares of all members, itself
+  // included.
+  Recompute(network, pool, /*updated=*/nullptr);
+}
+
+void EgressBudget::Leave(const Subscription* subscription) {
+  const Subscriber& subscriber = subscribers_.at(subscription);
+  auto it = pools_.find(subscriber.network);
+  RTC_DCHECK(it != pools_.end());
+  Pool& pool = it->second;
+  auto member = absl::c_find(pool.members, &subscriber);
+  RTC_DCHECK(member != pool.members.end());
+  *member = pool.members.back();
+  pool.members.pop_back();
+  if (pool.members.empty()) {
+    pools_.erase(it);
+    return;
+  }
+  pool.total_demand_bps -= subscriber.demand.bps<double>();
+  Recompute(subscriber.network, pool, /*updated=*/nullptr);
+}
+
+DataRate EgressBudget::CapacityOf(int network) const {
+  auto it = capacities_.find(network);
+  return it != capacities_.end() ? it->second : default_capacity_;
+}
+
+void EgressBudget::Recompute(int network,
+                             Pool& pool,
+                             const Subscriber* updated) {
+  pool.total_demand_bps_at_recompute = pool.total_demand_bps;
+  const double previous_level_bps = pool.level_bps;
+  pool.level_bps = ComputeLevel(CapacityOf(network), pool);
+  if (pool.level_bps == previous_level_bps) {
+    return;
+  }
+  for (Subscriber* member : pool.members) {
+    if (member != updated && member->on_share_changed) {
+      member->on_share_changed();
+    }
+  }
+}
+
+double EgressBudget::ComputeLevel(DataRate capacity, const Pool& pool) {
+  if (capacity.IsPlusInfinity() ||
+      pool.total_demand_bps <= capacity.bps<double>()) {
+    return kUnlimited;
+  }
+
+  // Water filling: members whose demand is below the fair share of what is
+  // left get their demand, the others share the rest by priority.
+  sorted_.clear();
+  double remaining_priority = 0.0;
+  for (const Subscriber* member : pool.members) {
+    sorted_.emplace_back(member->demand.bps<double>() / member->priority,
+                         member->priority);
+    remaining_priority += member->priority;
+  }
+  std::sort(sorted_.begin(), sorted_.end());
+
+  double remaining_capacity_bps = capacity.bps<double>();
+  size_t satisfied = 0;
+  for (; satisfied < sorted_.size(); ++satisfied) {
+    const auto& [demand_per_priority, priority] = sorted_[satisfied];
+    if (demand_per_priority * remaining_priority > remaining_capacity_bps) {
+      break;
+    }
+    remaining_capacity_bps -= demand_per_priority * priority;
+    remaining_priority -= priority;
+  }
+  return satisfied == sorted_.size()
+             ? kUnlimited
+             : std::max(remaining_capacity_bps, 0.0) / remaining_priority;
+}
+
+DataRate EgressBudget::ShareOf(const Pool& pool, double priority) {
+  if (std::isinf(pool.level_bps)) {
+    return DataRate::PlusInfinity();
+  }
+  return DataRate::BitsPerSec(pool.level_bps * priority);
+}
+
+}  // namespace webrtc
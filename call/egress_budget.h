@@ -0,0 +1,170 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef CALL_EGRESS_BUDGET_H_
+#define CALL_EGRESS_BUDGET_H_
+
+#include <stdint.h>
+
+#include <limits>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Shares the send capacity of network interfaces among the calls of a
+// process. Every call runs its own congestion controller, so many calls
+// sending over the same interface each estimate what the path allows on its
+// own and together overload the interface.
+//
+// Calls subscribe to the budget and report the rate they want to send at,
+// and their priority. The budget returns a cap for each call, so that the
+// calls on one interface together stay within its capacity. Capacity that a
+// call does not need is shared among the other calls on the interface in
+// proportion to their priorities (weighted max-min fairness).
+//
+// The shares of an interface are recomputed every kRecomputeInterval, and
+// immediately when calls subscribe, leave or change interface, when the
+// capacity changes, or when the total demand on the interface changes by more
+// than kDemandChangeForRecompute. In between, an update only looks up the
+// share of its subscriber. When a recompute changes the shares, the other
+// subscribers of the interface are notified, so that they don't keep sending
+// at a share that is no longer theirs until their own next update.
+//
+// Priorities below kMinPriority, including 0, count as kMinPriority, so that
+// no call is starved on a contended interface.
+//
+// Thread safe. Must outlive all subscriptions.
+class EgressBudget {
+ public:
+  static constexpr TimeDelta kRecomputeInterval = TimeDelta::Millis(100);
+  static constexpr double kDemandChangeForRecompute = 0.1;
+  static constexpr double kMinPriority = 0.01;
+
+  // The share of one call. Destroying it releases the share.
+  class Subscription {
+   public:
+    ~Subscription();
+
+    Subscription(const Subscription&) = delete;
+    Subscription& operator=(const Subscription&) = delete;
+
+    // Moves the subscriber to the interface `network_id`, the id of the
+    // rtc::Network it sends over. Until this is called the capacity of
+    // unknown interfaces applies.
+    void SetNetworkId(uint16_t network_id);
+
+    // Reports that the subscriber wants to send at `demand` with `priority`,
+    // and returns the rate it may send at, which is PlusInfinity() if the
+    // interface is not fully used.
+    DataRate Update(DataRate demand, double priority, Timestamp at_time);
+
+    // Returns the rate the subscriber may send at, as of the last recompute,
+    // without reporting a new demand.
+    DataRate CurrentShare() const;
+
+   private:
+    friend class EgressBudget;
+    explicit Subscription(EgressBudget* budget) : budget_(budget) {}
+
+    EgressBudget* const budget_;
+  };
+
+  EgressBudget();
+  ~EgressBudget();
+
+  EgressBudget(const EgressBudget&) = delete;
+  EgressBudget& operator=(const EgressBudget&) = delete;
+
+  // `on_share_changed` is called whenever the shares of the subscriber's
+  // interface are recomputed to a new level, except by the subscriber's own
+  // Update(), which returns the new share instead. That happens on updates of
+  // other subscribers, on SetCapacity() and SetDefaultCapacity(), and when a
+  // subscriber joins or leaves the interface, including this one's own
+  // Subscribe() and SetNetworkId(). It is called with the lock of the budget
+  // held, on the thread of the call that caused it, so it must not call back
+  // into the budget and should only post a task.
+  std::unique_ptr<Subscription> Subscribe(
+      absl::AnyInvocable<void()> on_share_changed = nullptr);
+
+  // Sets the capacity of the interface `network_id`.
+  void SetCapacity(uint16_t network_id, DataRate capacity);
+  // Sets the capacity of interfaces without a capacity of their own, and of
+  // calls whose interface is not yet known. Unlimited by default.
+  void SetDefaultCapacity(DataRate capacity);
+
+ private:
+  static constexpr int kUnknownNetwork = -1;
+
+  struct Subscriber {
+    int network = kUnknownNetwork;
+    DataRate demand = DataRate::Zero();
+    double priority = kMinPriority;
+    absl::AnyInvocable<void()> on_share_changed;
+  };
+
+  // The subscribers of one interface.
+  struct Pool {
+    // Points into `subscribers_`, whose nodes are stable.
+    std::vector<Subscriber*> members;
+    double total_demand_bps = 0.0;
+    double total_demand_bps_at_recompute = 0.0;
+    // The rate per unit of priority that each member may send at. Infinite
+    // while the total demand fits in the capacity.
+    double level_bps = std::numeric_limits<double>::infinity();
+    Timestamp last_recompute = Timestamp::MinusInfinity();
+  };
+
+  void SetNetworkId(const Subscription* subscription, uint16_t network_id);
+  DataRate Update(const Subscription* subscription,
+                  DataRate demand,
+                  double priority,
+                  Timestamp at_time);
+  DataRate CurrentShare(const Subscription* subscription);
+  void Unsubscribe(const Subscription* subscription);
+
+  void Join(const Subscription* subscription, int network)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void Leave(const Subscription* subscription)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  DataRate CapacityOf(int network) const RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Recomputes the shares of `pool` and, if they changed, notifies all its
+  // members except `updated`, which may be null.
+  void Recompute(int network, Pool& pool, const Subscriber* updated)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Returns the rate per unit of priority that the members of `pool` may send
+  // at.
+  double ComputeLevel(DataRate capacity, const Pool& pool)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  static DataRate ShareOf(const Pool& pool, double priority);
+
+  Mutex mutex_;
+  DataRate default_capacity_ RTC_GUARDED_BY(mutex_) = DataRate::PlusInfinity();
+  std::map<int, DataRate> capacities_ RTC_GUARDED_BY(mutex_);
+  std::map<const Subscription*, Subscriber> subscribers_
+      RTC_GUARDED_BY(mutex_);
+  std::map<int, Pool> pools_ RTC_GUARDED_BY(mutex_);
+  // Scratch space for ComputeLevel(), holding the demand per unit of priority
+  // and the priority of each member.
+  std::vector<std::pair<double, double>> sorted_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // CALL_EGRESS_BUDGET_H_
@@ -0,0 +1,238 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/egress_budget.h"
+
+#include <memory>
+
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint16_t kNetworkId = 1;
+constexpr uint16_t kOtherNetworkId = 2;
+constexpr Timestamp kStartTime = Timestamp::Seconds(1000);
+
+TEST(EgressBudgetTest, DoesNotCapWhileDemandFitsInCapacity) {
+  EgressBudget budget;
+  budget.SetCapacity(kNetworkId, DataRate::KilobitsPerSec(1000));
+  std::unique_ptr<EgressBudget::Subscription> a = budget.Subscribe();
+  std::unique_ptr<EgressBudget::Subscription> b = budget.Subscribe();
+  a->SetNetworkId(kNetworkId);
+  b->SetNetworkId(kNetworkId);
+
+  EXPECT_TRUE(a->Update(DataRate::KilobitsPerSec(400), 1.0, kStartTime)
+                  .IsPlusInfinity());
+  EXPECT_TRUE(b->Update(DataRate::KilobitsPerSec(600), 1.0, kStartTime)
+                  .IsPlusInfinity());
+}
+
+TEST(EgressBudgetTest, RedistributesUnusedShareByPriority) {
+  EgressBudget budget;
+  budget.SetCapacity(kNetworkId, DataRate::KilobitsPerSec(1000));
+  std::unique_ptr<EgressBudget::Subscription> low = budget.Subscribe();
+  std::unique_ptr<EgressBudget::Subscription> high = budget.Subscribe();
+  std::unique_ptr<EgressBudget::Subscription> small = budget.Subscribe();
+  low->SetNetworkId(kNetworkId);
+  high->SetNetworkId(kNetworkId);
+  small->SetNetworkId(kNetworkId);
+
+  small->Update(DataRate::KilobitsPerSec(100), 1.0, kStartTime);
+  low->Update(DataRate::KilobitsPerSec(2000), 1.0, kStartTime);
+  high->Update(DataRate::KilobitsPerSec(2000), 2.0, kStartTime);
+
+  // `small` gets all it asks for, the remaining 900 kbps are split 1:2 once
+  // the shares are recomputed.
+  const Timestamp recompute_time =
+      kStartTime + EgressBudget::kRecomputeInterval;
+  EXPECT_EQ(low->Update(DataRate::KilobitsPerSec(2000), 1.0, recompute_time),
+            DataRate::KilobitsPerSec(300));
+  EXPECT_EQ(high->Update(DataRate::KilobitsPerSec(2000), 2.0, recompute_time),
+            DataRate::KilobitsPerSec(600));
+  EXPECT_GE(small->Update(DataRate::KilobitsPerSec(100), 1.0, recompute_time),
+            DataRate::KilobitsPerSec(100));
+}
+
+TEST(EgressBudgetTest, RedistributesShareFreedByLowerDemand) {
+  EgressBudget budget;
+  budget.SetCapacity(kNetworkId, DataRate::KilobitsPerSec(1000));
+  std::unique_ptr<EgressBudget::Subscription> a = budget.Subscribe();
+  std::unique_ptr<EgressBudget::Subscription> b = budget.Subscribe();
+  a->SetNetworkId(kNetworkId);
+  b->SetNetworkId(kNetworkId);
+  a->Update(DataRate::KilobitsPerSec(1000), 1.0, kStartTime);
+  EXPECT_EQ(b->Update(DataRate::KilobitsPerSec(1000), 1.0, kStartTime),
+            DataRate::KilobitsPerSec(500));
+
+  // `a` needs less, which frees capacity for `b` once the shares are
+  // recomputed.
+  a->Update(DataRate::KilobitsPerSec(200), 1.0, kStartTime);
+  EXPECT_EQ(b->Update(DataRate::KilobitsPerSec(1000), 1.0,
+                      kStartTime + EgressBudget::kRecomputeInterval),
+            DataRate::KilobitsPerSec(800));
+}
+
+TEST(EgressBudgetTest, NotifiesOtherSubscribersWhenSharesChange) {
+  EgressBudget budget;
+  budget.SetCapacity(kNetworkId, DataRate::KilobitsPerSec(1000));
+  budget.SetCapacity(kOtherNetworkId, DataRate::KilobitsPerSec(1000));
+  int a_notifications = 0;
+  int b_notifications = 0;
+  int other_notifications = 0;
+  std::unique_ptr<EgressBudget::Subscription> a =
+      budget.Subscribe([&] { ++a_notifications; });
+  std::unique_ptr<EgressBudget::Subscription> b =
+      budget.Subscribe([&] { ++b_notifications; });
+  std::unique_ptr<EgressBudget::Subscription> other =
+      budget.Subscribe([&] { ++other_notifications; });
+  a->SetNetworkId(kNetworkId);
+  b->SetNetworkId(kNetworkId);
+  other->SetNetworkId(kOtherNetworkId);
+  EXPECT_EQ(a->Update(DataRate::KilobitsPerSec(1500), 1.0, kStartTime),
+            DataRate::KilobitsPerSec(1000));
+  other->Update(DataRate::KilobitsPerSec(1500), 1.0, kStartTime);
+  a_notifications = 0;
+  b_notifications = 0;
+
+  // `b` joining shrinks the share of `a`, which learns it without an update
+  // of its own.
+  EXPECT_EQ(b->Update(DataRate::KilobitsPerSec(1500), 1.0, kStartTime),
+            DataRate::KilobitsPerSec(500));
+  EXPECT_EQ(a_notifications, 1);
+  EXPECT_EQ(b_notifications, 0);
+  EXPECT_EQ(other_notifications, 0);
+  EXPECT_EQ(a->CurrentShare(), DataRate::KilobitsPerSec(500));
+
+  // Updates that don't change the shares don't notify.
+  b->Update(DataRate::KilobitsPerSec(1500), 1.0, kStartTime);
+  EXPECT_EQ(a_notifications, 1);
+}
+
+TEST(EgressBudgetTest, NotifiesSubscribersWhenCapacityChanges) {
+  EgressBudget budget;
+  budget.SetCapacity(kNetworkId, DataRate::KilobitsPerSec(1000));
+  int notifications = 0;
+  int unknown_network_notifications = 0;
+  std::unique_ptr<EgressBudget::Subscription> a =
+      budget.Subscribe([&] { ++notifications; });
+  std::unique_ptr<EgressBudget::Subscription> unknown_network =
+      budget.Subscribe([&] { ++unknown_network_notifications; });
+  a->SetNetworkId(kNetworkId);
+  EXPECT_EQ(a->Update(DataRate::KilobitsPerSec(1500), 1.0, kStartTime),
+            DataRate::KilobitsPerSec(1000));
+  EXPECT_TRUE(
+      unknown_network->Update(DataRate::KilobitsPerSec(1500), 1.0, kStartTime)
+          .IsPlusInfinity());
+
+  budget.SetCapacity(kNetworkId, DataRate::KilobitsPerSec(600));
+  EXPECT_EQ(notifications, 1);
+  EXPECT_EQ(unknown_network_notifications, 0);
+  EXPECT_EQ(a->CurrentShare(), DataRate::KilobitsPerSec(600));
+
+  budget.SetDefaultCapacity(DataRate::KilobitsPerSec(500));
+  EXPECT_EQ(notifications, 1);
+  EXPECT_EQ(unknown_network_notifications, 1);
+  EXPECT_EQ(unknown_network->CurrentShare(), DataRate::KilobitsPerSec(500));
+}
+
+TEST(EgressBudgetTest, NotifiesRemainingSubscribersWhenOneLeaves) {
+  EgressBudget budget;
+  budget.SetCapacity(kNetworkId, DataRate::KilobitsPerSec(1000));
+  int b_notifications = 0;
+  std::unique_ptr<EgressBudget::Subscription> a = budget.Subscribe();
+  std::unique_ptr<EgressBudget::Subscription> b =
+      budget.Subscribe([&] { ++b_notifications; });
+  a->SetNetworkId(kNetworkId);
+  b->SetNetworkId(kNetworkId);
+  a->Update(DataRate::KilobitsPerSec(1000), 1.0, kStartTime);
+  b->Update(DataRate::KilobitsPerSec(1000), 1.0, kStartTime);
+  EXPECT_EQ(b->CurrentShare(), DataRate::KilobitsPerSec(500));
+  b_notifications = 0;
+
+  a->SetNetworkId(kOtherNetworkId);
+  EXPECT_EQ(b_notifications, 1);
+  EXPECT_TRUE(b->CurrentShare().IsPlusInfinity());
+
+  a->SetNetworkId(kNetworkId);
+  EXPECT_EQ(b_notifications, 2);
+  EXPECT_EQ(b->CurrentShare(), DataRate::KilobitsPerSec(500));
+
+  a = nullptr;
+  EXPECT_EQ(b_notifications, 3);
+  EXPECT_TRUE(b->CurrentShare().IsPlusInfinity());
+}
+
+TEST(EgressBudgetTest, ZeroPriorityGetsMinimumShare) {
+  EgressBudget budget;
+  budget.SetCapacity(kNetworkId, DataRate::KilobitsPerSec(1010));
+  std::unique_ptr<EgressBudget::Subscription> zero = budget.Subscribe();
+  std::unique_ptr<EgressBudget::Subscription> other = budget.Subscribe();
+  zero->SetNetworkId(kNetworkId);
+  other->SetNetworkId(kNetworkId);
+  zero->Update(DataRate::KilobitsPerSec(2000), 0.0, kStartTime);
+  other->Update(DataRate::KilobitsPerSec(2000), 1.0, kStartTime);
+
+  // The priority of `zero` counts as kMinPriority.
+  EXPECT_EQ(zero->CurrentShare(), DataRate::KilobitsPerSec(10));
+  EXPECT_EQ(other->CurrentShare(), DataRate::KilobitsPerSec(1000));
+}
+
+TEST(EgressBudgetTest, SharesCapacityOnlyWithinInterface) {
+  EgressBudget budget;
+  budget.SetCapacity(kNetworkId, DataRate::KilobitsPerSec(1000));
+  budget.SetCapacity(kOtherNetworkId, DataRate::KilobitsPerSec(300));
+  std::unique_ptr<EgressBudget::Subscription> a = budget.Subscribe();
+  std::unique_ptr<EgressBudget::Subscription> b = budget.Subscribe();
+  a->SetNetworkId(kNetworkId);
+  b->SetNetworkId(kOtherNetworkId);
+
+  EXPECT_EQ(a->Update(DataRate::KilobitsPerSec(2000), 1.0, kStartTime),
+            DataRate::KilobitsPerSec(1000));
+  EXPECT_EQ(b->Update(DataRate::KilobitsPerSec(2000), 1.0, kStartTime),
+            DataRate::KilobitsPerSec(300));
+
+  b->SetNetworkId(kNetworkId);
+  EXPECT_EQ(b->Update(DataRate::KilobitsPerSec(2000), 1.0, kStartTime),
+            DataRate::KilobitsPerSec(500));
+}
+
+TEST(EgressBudgetTest, ReleasesShareOnUnsubscribe) {
+  EgressBudget budget;
+  budget.SetCapacity(kNetworkId, DataRate::KilobitsPerSec(1000));
+  std::unique_ptr<EgressBudget::Subscription> a = budget.Subscribe();
+  std::unique_ptr<EgressBudget::Subscription> b = budget.Subscribe();
+  a->SetNetworkId(kNetworkId);
+  b->SetNetworkId(kNetworkId);
+  a->Update(DataRate::KilobitsPerSec(1000), 1.0, kStartTime);
+  EXPECT_EQ(b->Update(DataRate::KilobitsPerSec(1000), 1.0, kStartTime),
+            DataRate::KilobitsPerSec(500));
+
+  a = nullptr;
+  EXPECT_TRUE(b->Update(DataRate::KilobitsPerSec(1000), 1.0, kStartTime)
+                  .IsPlusInfinity());
+}
+
+TEST(EgressBudgetTest, DefaultCapacityAppliesToUnknownInterface) {
+  EgressBudget budget;
+  budget.SetDefaultCapacity(DataRate::KilobitsPerSec(400));
+  std::unique_ptr<EgressBudget::Subscription> a = budget.Subscribe();
+  std::unique_ptr<EgressBudget::Subscription> b = budget.Subscribe();
+
+  a->Update(DataRate::KilobitsPerSec(1000), 1.0, kStartTime);
+  EXPECT_EQ(b->Update(DataRate::KilobitsPerSec(1000), 1.0, kStartTime),
+            DataRate::KilobitsPerSec(200));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -10,6 +10,8 @@
 
 #include "call/rtp_demuxer.h"
 
+#include <algorithm>
+
 #include "absl/strings/string_view.h"
 #include "call/rtp_packet_sink_interface.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
@@ -21,6 +23,9 @@
 namespace webrtc {
 namespace {
 
+// Initial number of entries of the resolved sink table. Power of two.
+constexpr size_t kInitialResolvedSinkTableSize = 16;
+
 template <typename Container, typename Value>
 size_t RemoveFromMultimapByValue(Container* multimap, const Value& value) {
   size_t count = 0;
@@ -160,6 +165,17 @@ bool RtpDemuxer::AddSink(const RtpDemuxerCriteria& criteria,
 
   RefreshKnownMids();
 
+  // A MID or RSID sink may take over SSRCs latched to that MID or RSID, while
+  // SSRC sinks only affect their own SSRCs. Payload type sinks do not affect
+  // the cached results, which never depend on the payload type.
+  if (!criteria.mid().empty() || !criteria.rsid().empty()) {
+    resolved_sinks_.Clear();
+  } else {
+    for (uint32_t ssrc : criteria.ssrcs()) {
+      resolved_sinks_.Erase(ssrc);
+    }
+  }
+
   RTC_DLOG(LS_INFO) << "Added sink = " << sink << " for criteria "
                     << criteria.ToString();
 
@@ -252,6 +268,9 @@ bool RtpDemuxer::RemoveSink(const RtpPacketSinkInterface* sink) {
                        RemoveFromMapByValue(&sink_by_mid_and_rsid_, sink) +
                        RemoveFromMapByValue(&sink_by_rsid_, sink);
   RefreshKnownMids();
+  // Removing a sink can only change the result for SSRCs resolving to it, as
+  // all rules with higher priority than its rule failed for the others.
+  resolved_sinks_.EraseSink(sink);
   return num_removed > 0;
 }
 
@@ -279,6 +298,36 @@ bool RtpDemuxer::OnRtpPacket(const RtpPacketReceived& packet) {
 
 RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
     const RtpPacketReceived& packet) {
+  const uint32_t ssrc = packet.Ssrc();
+  const bool has_ids = (use_mid_ && packet.HasExtension<RtpMid>()) ||
+                       packet.HasExtension<RepairedRtpStreamId>() ||
+                       packet.HasExtension<RtpStreamId>();
+  if (!has_ids) {
+    const ResolvedSinkTable::Entry* entry = resolved_sinks_.Find(ssrc);
+    if (entry != nullptr) {
+      return entry->sink;
+    }
+  }
+
+  bool used_payload_type = false;
+  RtpPacketSinkInterface* sink = RunDemuxAlgorithm(packet, used_payload_type);
+  if (has_ids) {
+    // The packet may have changed the IDs latched to its SSRC.
+    resolved_sinks_.Erase(ssrc);
+  } else if (!used_payload_type &&
+             resolved_sinks_.size() < sink_by_ssrc_.size() + kMaxSsrcBindings) {
+    // Running the algorithm again for the SSRC would give the same result and
+    // have no further side effects until the demuxer state changes. The
+    // table is bounded like the SSRC bindings, as SSRCs are chosen by the
+    // remote peer.
+    resolved_sinks_.Insert(ssrc, sink);
+  }
+  return sink;
+}
+
+RtpPacketSinkInterface* RtpDemuxer::RunDemuxAlgorithm(
+    const RtpPacketReceived& packet,
+    bool& used_payload_type) {
   // See the BUNDLE spec for high level reference to this algorithm:
   // https://tools.ietf.org/html/draft-ietf-mmusic-sdp-bundle-negotiation-38#section-10.2
 
@@ -373,6 +422,7 @@ RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
   }
 
   // Legacy senders will only signal payload type, support that as last resort.
+  used_payload_type = true;
   return ResolveSinkByPayloadType(packet.PayloadType(), ssrc);
 }
 
@@ -449,4 +499,92 @@ void RtpDemuxer::AddSsrcSinkBinding(uint32_t ssrc,
   }
 }
 
+const RtpDemuxer::ResolvedSinkTable::Entry* RtpDemuxer::ResolvedSinkTable::Find(
+    uint32_t ssrc) const {
+  if (entries_.empty()) {
+    return nullptr;
+  }
+  const size_t mask = entries_.size() - 1;
+  for (size_t i = SlotIndex(ssrc);; i = (i + 1) & mask) {
+    const Entry& entry = entries_[i];
+    if (!entry.occupied) {
+      return nullptr;
+    }
+    if (entry.ssrc == ssrc) {
+      return &entry;
+    }
+  }
+}
+
+void RtpDemuxer::ResolvedSinkTable::Insert(uint32_t ssrc,
+                                           RtpPacketSinkInterface* sink) {
+  if (2 * (size_ + 1) > entries_.size()) {
+    Rehash(std::max(2 * entries_.size(), kInitialResolvedSinkTableSize));
+  }
+  const size_t mask = entries_.size() - 1;
+  size_t i = SlotIndex(ssrc);
+  while (entries_[i].occupied && entries_[i].ssrc != ssrc) {
+    i = (i + 1) & mask;
+  }
+  if (!entries_[i].occupied) {
+    ++size_;
+  }
+  entries_[i] = {.ssrc = ssrc, .occupied = true, .sink = sink};
+}
+
+void RtpDemuxer::ResolvedSinkTable::Erase(uint32_t ssrc) {
+  const Entry* entry = Find(ssrc);
+  if (entry == nullptr) {
+    return;
+  }
+  // Backward shift deletion: move later entries of the probe sequence into
+  // the hole, unless that would put them before their home slot.
+  const size_t mask = entries_.size() - 1;
+  size_t hole = entry - entries_.data();
+  for (size_t i = (hole + 1) & mask; entries_[i].occupied; i = (i + 1) & mask) {
+    const size_t home = SlotIndex(entries_[i].ssrc);
+    if (((i - home) & mask) >= ((i - hole) & mask)) {
+      entries_[hole] = entries_[i];
+      hole = i;
+    }
+  }
+  entries_[hole] = Entry();
+  --size_;
+}
+
+void RtpDemuxer::ResolvedSinkTable::EraseSink(
+    const RtpPacketSinkInterface* sink) {
+  std::vector<Entry> entries = std::move(entries_);
+  entries_.assign(entries.size(), Entry());
+  size_ = 0;
+  for (const Entry& entry : entries) {
+    if (entry.occupied && entry.sink != sink) {
+      Insert(entry.ssrc, entry.sink);
+    }
+  }
+}
+
+void RtpDemuxer::ResolvedSinkTable::Clear() {
+  entries_.clear();
+  size_ = 0;
+}
+
+size_t RtpDemuxer::ResolvedSinkTable::SlotIndex(uint32_t ssrc) const {
+  // Mix the bits, so that consecutive SSRCs do not form long probe sequences.
+  const uint32_t hash = ssrc * 0x9E3779B1u;
+  return (hash ^ (hash >> 16)) & (entries_.size() - 1);
+}
+
+void RtpDemuxer::ResolvedSinkTable::Rehash(size_t capacity) {
+  RTC_DCHECK_EQ(capacity & (capacity - 1), 0);
+  std::vector<Entry> entries = std::move(entries_);
+  entries_.assign(capacity, Entry());
+  size_ = 0;
+  for (const Entry& entry : entries) {
+    if (entry.occupied) {
+      Insert(entry.ssrc, entry.sink);
+    }
+  }
+}
+
 }  // namespace webrtc
@@ -11,6 +11,9 @@
 #ifndef CALL_RTP_DEMUXER_H_
 #define CALL_RTP_DEMUXER_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <map>
 #include <string>
 #include <utility>
@@ -106,6 +109,12 @@ class RtpDemuxerCriteria {
 // In summary, the routing algorithm will always try to first match MID and RSID
 // (including through SSRC binding), match SSRC directly as needed, and use
 // payload types only if all else fails.
+//
+// Packets without MID, RSID and RRID header extensions, which is what most
+// senders send once the receiver has learned their SSRCs, are routed by their
+// SSRC alone. The result of the algorithm for such packets is therefore
+// cached per SSRC in a hash table, so that they are usually demuxed with a
+// single probe of it.
 class RtpDemuxer {
  public:
   // Maximum number of unique SSRC bindings allowed. This limit is to prevent
@@ -163,11 +172,49 @@ class RtpDemuxer {
   // with the existing criteria and should be rejected.
   bool CriteriaWouldConflict(const RtpDemuxerCriteria& criteria) const;
 
+  // Open addressing hash table from SSRC to the sink that packets without
+  // MID, RSID and RRID header extensions resolve to, possibly null. Linear
+  // probing, kept at most half full.
+  class ResolvedSinkTable {
+   public:
+    struct Entry {
+      uint32_t ssrc = 0;
+      bool occupied = false;
+      RtpPacketSinkInterface* sink = nullptr;
+    };
+
+    // Returns the entry for `ssrc`, or null if there is none.
+    const Entry* Find(uint32_t ssrc) const;
+    // Inserts `ssrc`, or updates its sink if it is already present.
+    void Insert(uint32_t ssrc, RtpPacketSinkInterface* sink);
+    void Erase(uint32_t ssrc);
+    // Erases all entries resolving to `sink`.
+    void EraseSink(const RtpPacketSinkInterface* sink);
+    void Clear();
+    size_t size() const { return size_; }
+
+   private:
+    size_t SlotIndex(uint32_t ssrc) const;
+    void Rehash(size_t capacity);
+
+    // Empty, or a power of two number of entries.
+    std::vector<Entry> entries_;
+    size_t size_ = 0;
+  };
+
+  // Returns the sink that should receive the packet, looking it up in
+  // `resolved_sinks_` if possible and running the demux algorithm otherwise.
+  // If the packet should be dropped, this method returns null.
+  RtpPacketSinkInterface* ResolveSink(const RtpPacketReceived& packet);
+
   // Runs the demux algorithm on the given packet and returns the sink that
   // should receive the packet.
   // Will record any SSRC<->ID associations along the way.
   // If the packet should be dropped, this method returns null.
-  RtpPacketSinkInterface* ResolveSink(const RtpPacketReceived& packet);
+  // `used_payload_type` is set if the result depends on the payload type of
+  // the packet rather than only on its SSRC and header extensions.
+  RtpPacketSinkInterface* RunDemuxAlgorithm(const RtpPacketReceived& packet,
+                                            bool& used_payload_type);
 
   // Used by the ResolveSink algorithm.
   RtpPacketSinkInterface* ResolveSinkByMid(absl::string_view mid,
@@ -210,6 +257,12 @@ class RtpDemuxer {
   flat_map<uint32_t, std::string> mid_by_ssrc_;
   flat_map<uint32_t, std::string> rsid_by_ssrc_;
 
+  // Result of the demux algorithm for packets without MID, RSID and RRID
+  // header extensions by SSRC. Entries are erased when packets with those
+  // extensions arrive on their SSRC, since that may change the latched IDs,
+  // and when sinks are added or removed.
+  ResolvedSinkTable resolved_sinks_;
+
   // Adds a binding from the SSRC to the given sink.
   void AddSsrcSinkBinding(uint32_t ssrc, RtpPacketSinkInterface* sink);
 
@@ -0,0 +1,159 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "call/rtp_demuxer.h"
+#include "call/rtp_packet_sink_interface.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/random.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kMidExtensionId = 1;
+constexpr int kRsidExtensionId = 2;
+// Number of packets cycled through, in random order of their streams.
+constexpr int kNumPackets = 1 << 14;
+
+class CountingSink : public RtpPacketSinkInterface {
+ public:
+  void OnRtpPacket(const RtpPacketReceived& /*packet*/) override {
+    ++count_;
+  }
+
+ private:
+  int count_ = 0;
+};
+
+std::string Mid(int stream) {
+  return "m" + std::to_string(stream);
+}
+
+// Streams of an SFU with `num_streams` sinks in one BUNDLE group, each with a
+// random SSRC, a MID and an RSID.
+class DemuxFixture {
+ public:
+  explicit DemuxFixture(int num_streams)
+      : random_(0x5eed), sinks_(num_streams) {
+    extensions_.Register<RtpMid>(kMidExtensionId);
+    extensions_.Register<RtpStreamId>(kRsidExtensionId);
+    for (int i = 0; i < num_streams; ++i) {
+      ssrcs_.push_back(random_.Rand<uint32_t>());
+    }
+  }
+
+  ~DemuxFixture() {
+    for (CountingSink& sink : sinks_) {
+      demuxer_.RemoveSink(&sink);
+    }
+  }
+
+  void AddSsrcSinks() {
+    for (size_t i = 0; i < sinks_.size(); ++i) {
+      RTC_CHECK(demuxer_.AddSink(ssrcs_[i], &sinks_[i]));
+    }
+  }
+
+  void AddMidRsidSinks() {
+    for (size_t i = 0; i < sinks_.size(); ++i) {
+      RtpDemuxerCriteria criteria(Mid(i), "r");
+      RTC_CHECK(demuxer_.AddSink(criteria, &sinks_[i]));
+    }
+  }
+
+  // Packets on random streams, with MID and RSID if `with_ids` is set.
+  std::vector<RtpPacketReceived> CreatePackets(bool with_ids) {
+    std::vector<RtpPacketReceived> packets;
+    for (int i = 0; i < kNumPackets; ++i) {
+      const int stream = random_.Rand(0, static_cast<int>(ssrcs_.size()) - 1);
+      packets.emplace_back(&extensions_);
+      packets.back().SetSsrc(ssrcs_[stream]);
+      packets.back().SetSequenceNumber(i);
+      if (with_ids) {
+        packets.back().SetExtension<RtpMid>(Mid(stream));
+        packets.back().SetExtension<RtpStreamId>("r");
+      }
+    }
+    return packets;
+  }
+
+  // Sends one packet with MID and RSID on each stream, binding its SSRC.
+  void LatchIds() {
+    for (size_t i = 0; i < ssrcs_.size(); ++i) {
+      RtpPacketReceived packet(&extensions_);
+      packet.SetSsrc(ssrcs_[i]);
+      packet.SetExtension<RtpMid>(Mid(i));
+      packet.SetExtension<RtpStreamId>("r");
+      demuxer_.OnRtpPacket(packet);
+    }
+  }
+
+  RtpDemuxer& demuxer() { return demuxer_; }
+
+ private:
+  Random random_;
+  RtpHeaderExtensionMap extensions_;
+  std::vector<uint32_t> ssrcs_;
+  std::vector<CountingSink> sinks_;
+  RtpDemuxer demuxer_;
+};
+
+void RunDemuxer(benchmark::State& state,
+                RtpDemuxer& demuxer,
+                const std::vector<RtpPacketReceived>& packets) {
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(demuxer.OnRtpPacket(packets[i]));
+    i = (i + 1) % packets.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Packets with only an SSRC, each signaled in the criteria of its sink.
+void BM_RtpDemuxerBySsrc(benchmark::State& state) {
+  DemuxFixture fixture(state.range(0));
+  fixture.AddSsrcSinks();
+  RunDemuxer(state, fixture.demuxer(), fixture.CreatePackets(false));
+}
+
+// Packets with only an SSRC, after their MID and RSID have been latched by
+// earlier packets. The number of sinks is capped by the number of SSRC
+// bindings the demuxer learns.
+void BM_RtpDemuxerByLatchedMidRsid(benchmark::State& state) {
+  DemuxFixture fixture(state.range(0));
+  fixture.AddMidRsidSinks();
+  fixture.LatchIds();
+  RunDemuxer(state, fixture.demuxer(), fixture.CreatePackets(false));
+}
+
+// Packets that all carry MID and RSID header extensions.
+void BM_RtpDemuxerByMidRsid(benchmark::State& state) {
+  DemuxFixture fixture(state.range(0));
+  fixture.AddMidRsidSinks();
+  RunDemuxer(state, fixture.demuxer(), fixture.CreatePackets(true));
+}
+
+BENCHMARK(BM_RtpDemuxerBySsrc)->Arg(10)->Arg(1000)->Arg(10000);
+BENCHMARK(BM_RtpDemuxerByLatchedMidRsid)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(RtpDemuxer::kMaxSsrcBindings);
+BENCHMARK(BM_RtpDemuxerByMidRsid)->Arg(10)->Arg(100)->Arg(1000);
+
+}  // namespace
+}  // namespace webrtc
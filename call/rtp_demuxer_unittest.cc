@@ -13,6 +13,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "call/test/mock_rtp_packet_sink_interface.h"
@@ -1238,6 +1239,65 @@ TEST_F(RtpDemuxerTest, PacketWithMidAndUnknownRsidIsNotRoutedByPayloadType) {
   EXPECT_FALSE(demuxer_.OnRtpPacket(*packet));
 }
 
+TEST_F(RtpDemuxerTest, RoutesPacketsWithOnlySsrcToNewlyLatchedMid) {
+  constexpr uint32_t ssrc = 10;
+  const std::string mid1 = "v";
+  const std::string mid2 = "a";
+  MockRtpPacketSink sink1;
+  AddSinkOnlyMid(mid1, &sink1);
+  MockRtpPacketSink sink2;
+  AddSinkOnlyMid(mid2, &sink2);
+
+  EXPECT_CALL(sink1, OnRtpPacket(_)).Times(3);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*CreatePacketWithSsrcMid(ssrc, mid1)));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*CreatePacketWithSsrc(ssrc)));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*CreatePacketWithSsrc(ssrc)));
+
+  EXPECT_CALL(sink2, OnRtpPacket(_)).Times(2);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*CreatePacketWithSsrcMid(ssrc, mid2)));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*CreatePacketWithSsrc(ssrc)));
+}
+
+TEST_F(RtpDemuxerTest, RsidSinkTakesOverSsrcOfPacketsWithOnlySsrc) {
+  constexpr uint32_t ssrc = 10;
+  const std::string rsid = "1";
+  MockRtpPacketSink ssrc_sink;
+  AddSinkOnlySsrc(ssrc, &ssrc_sink);
+
+  // Latches the RSID, which no sink is added for yet.
+  EXPECT_CALL(ssrc_sink, OnRtpPacket(_)).Times(2);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*CreatePacketWithSsrcRsid(ssrc, rsid)));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*CreatePacketWithSsrc(ssrc)));
+
+  MockRtpPacketSink rsid_sink;
+  AddSinkOnlyRsid(rsid, &rsid_sink);
+  EXPECT_CALL(rsid_sink, OnRtpPacket(_)).Times(1);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*CreatePacketWithSsrc(ssrc)));
+}
+
+TEST_F(RtpDemuxerTest, RoutesPacketsOfManySsrcSinksAfterSomeAreRemoved) {
+  constexpr int kNumSinks = 2000;
+  std::vector<std::unique_ptr<NiceMock<MockRtpPacketSink>>> sinks;
+  for (int i = 0; i < kNumSinks; ++i) {
+    sinks.push_back(std::make_unique<NiceMock<MockRtpPacketSink>>());
+    ASSERT_TRUE(AddSinkOnlySsrc(1000 + i, sinks.back().get()));
+  }
+  for (int i = 0; i < kNumSinks; ++i) {
+    EXPECT_CALL(*sinks[i], OnRtpPacket(_)).Times(1);
+    EXPECT_TRUE(demuxer_.OnRtpPacket(*CreatePacketWithSsrc(1000 + i)));
+  }
+
+  for (int i = 0; i < kNumSinks; i += 3) {
+    EXPECT_TRUE(RemoveSink(sinks[i].get()));
+  }
+  for (int i = 0; i < kNumSinks; ++i) {
+    ::testing::Mock::VerifyAndClearExpectations(sinks[i].get());
+    EXPECT_CALL(*sinks[i], OnRtpPacket(_)).Times(i % 3 == 0 ? 0 : 1);
+    EXPECT_EQ(demuxer_.OnRtpPacket(*CreatePacketWithSsrc(1000 + i)),
+              i % 3 != 0);
+  }
+}
+
 TEST_F(RtpDemuxerTest, MidMustNotExceedMaximumLength) {
   MockRtpPacketSink sink1;
   std::string mid1(BaseRtpStringExtension::kMaxValueSizeBytes + 1, 'a');
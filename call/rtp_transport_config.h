@@ -22,6 +22,9 @@
 
 namespace webrtc {
 
+class FecEncodingPool;
+class SharedPacerScheduler;
+
 struct RtpTransportConfig {
   Environment env;
 
@@ -38,6 +41,17 @@ struct RtpTransportConfig {
 
   // The burst interval of the pacer, see TaskQueuePacedSender constructor.
   absl::optional<TimeDelta> pacer_burst_interval;
+
+  // Optional scheduler of the pacer wakeups, shared with other calls. Must
+  // outlive the transport. PeerConnectionFactory leaves it unset; to share a
+  // scheduler between its calls, inject a
+  // RtpTransportControllerSendFactoryInterface that sets it.
+  SharedPacerScheduler* pacer_scheduler = nullptr;
+
+  // Optional worker threads for the FEC encoding of the video senders of
+  // this transport, shared with other calls. Must outlive the transport.
+  // Injected the same way as `pacer_scheduler`.
+  FecEncodingPool* fec_encoding_pool = nullptr;
 };
 }  // namespace webrtc
 
@@ -74,13 +74,15 @@ RtpTransportControllerSend::RtpTransportControllerSend(
     const RtpTransportConfig& config)
     : env_(config.env),
       task_queue_(TaskQueueBase::Current()),
+      fec_encoding_pool_(config.fec_encoding_pool),
       bitrate_configurator_(config.bitrate_config),
       pacer_started_(false),
       pacer_(&env_.clock(),
              &packet_router_,
              env_.field_trials(),
              TimeDelta::Millis(5),
-             3),
+             3,
+             config.pacer_scheduler),
       observer_(nullptr),
       controller_factory_override_(config.network_controller_factory),
       controller_factory_fallback_(
@@ -150,7 +152,7 @@ RtpVideoSenderInterface* RtpTransportControllerSend::CreateRtpVideoSender(
       this, &env_.event_log(), &retransmission_rate_limiter_,
       std::move(fec_controller), frame_encryption_config.frame_encryptor,
       frame_encryption_config.crypto_options, std::move(frame_transformer),
-      env_.field_trials(), &env_.task_queue_factory()));
+      fec_encoding_pool_, env_.field_trials(), &env_.task_queue_factory()));
   return video_rtp_senders_.back().get();
 }
 
@@ -42,6 +42,7 @@
 #include "rtc_base/task_utils/repeating_task.h"
 
 namespace webrtc {
+class FecEncodingPool;
 class FrameEncryptorInterface;
 
 class RtpTransportControllerSend final
@@ -156,6 +157,8 @@ class RtpTransportControllerSend final
   const Environment env_;
   SequenceChecker sequence_checker_;
   TaskQueueBase* task_queue_;
+  // Shared by the FEC generators of `video_rtp_senders_`, may be null.
+  FecEncodingPool* const fec_encoding_pool_;
   PacketRouter packet_router_;
 
   std::vector<std::unique_ptr<RtpVideoSenderInterface>> video_rtp_senders_
@@ -128,6 +128,7 @@ std::unique_ptr<VideoFecGenerator> MaybeCreateFecGenerator(
     const RtpConfig& rtp,
     const std::map<uint32_t, RtpState>& suspended_ssrcs,
     int simulcast_index,
+    FecEncodingPool* fec_encoding_pool,
     const FieldTrialsView& trials) {
   // If flexfec is configured that takes priority.
   if (rtp.flexfec.payload_type >= 0) {
@@ -168,17 +169,21 @@ std::unique_ptr<VideoFecGenerator> MaybeCreateFecGenerator(
     }
 
     RTC_DCHECK_EQ(1U, rtp.flexfec.protected_media_ssrcs.size());
-    return std::make_unique<FlexfecSender>(
+    auto flexfec_sender = std::make_unique<FlexfecSender>(
         rtp.flexfec.payload_type, rtp.flexfec.ssrc,
         rtp.flexfec.protected_media_ssrcs[0], rtp.mid, rtp.extensions,
         RTPSender::FecExtensionSizes(), rtp_state, clock);
+    flexfec_sender->SetEncodingPool(fec_encoding_pool);
+    return flexfec_sender;
   } else if (rtp.ulpfec.red_payload_type >= 0 &&
              rtp.ulpfec.ulpfec_payload_type >= 0 &&
              !ShouldDisableRedAndUlpfec(/*flexfec_enabled=*/false, rtp,
                                         trials)) {
     // Flexfec not configured, but ulpfec is and is not disabled.
-    return std::make_unique<UlpfecGenerator>(
+    auto ulpfec_generator = std::make_unique<UlpfecGenerator>(
         rtp.ulpfec.red_payload_type, rtp.ulpfec.ulpfec_payload_type, clock);
+    ulpfec_generator->SetEncodingPool(fec_encoding_pool);
+    return ulpfec_generator;
   }
 
   // Not a single FEC is given.
@@ -198,6 +203,7 @@ std::vector<RtpStreamSender> CreateRtpStreamSenders(
     FrameEncryptorInterface* frame_encryptor,
     const CryptoOptions& crypto_options,
     rtc::scoped_refptr<FrameTransformerInterface> frame_transformer,
+    FecEncodingPool* fec_encoding_pool,
     const FieldTrialsView& trials,
     TaskQueueFactory* task_queue_factory) {
   RTC_DCHECK_GT(rtp_config.ssrcs.size(), 0);
@@ -250,8 +256,8 @@ std::vector<RtpStreamSender> CreateRtpStreamSenders(
     RTPSenderVideo::Config video_config;
     configuration.local_media_ssrc = rtp_config.ssrcs[i];
 
-    std::unique_ptr<VideoFecGenerator> fec_generator =
-        MaybeCreateFecGenerator(clock, rtp_config, suspended_ssrcs, i, trials);
+    std::unique_ptr<VideoFecGenerator> fec_generator = MaybeCreateFecGenerator(
+        clock, rtp_config, suspended_ssrcs, i, fec_encoding_pool, trials);
     configuration.fec_generator = fec_generator.get();
 
     configuration.rtx_send_ssrc =
@@ -373,6 +379,7 @@ RtpVideoSender::RtpVideoSender(
     FrameEncryptorInterface* frame_encryptor,
     const CryptoOptions& crypto_options,
     rtc::scoped_refptr<FrameTransformerInterface> frame_transformer,
+    FecEncodingPool* fec_encoding_pool,
     const FieldTrialsView& field_trials,
     TaskQueueFactory* task_queue_factory)
     : field_trials_(field_trials),
@@ -395,6 +402,7 @@ RtpVideoSender::RtpVideoSender(
                                           frame_encryptor,
                                           crypto_options,
                                           std::move(frame_transformer),
+                                          fec_encoding_pool,
                                           field_trials_,
                                           task_queue_factory)),
       rtp_config_(rtp_config),
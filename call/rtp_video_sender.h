@@ -43,6 +43,7 @@
 
 namespace webrtc {
 
+class FecEncodingPool;
 class FrameEncryptorInterface;
 class RtpTransportControllerSendInterface;
 
@@ -73,6 +74,8 @@ class RtpVideoSender : public RtpVideoSenderInterface,
                        public StreamFeedbackObserver {
  public:
   // Rtp modules are assumed to be sorted in simulcast index order.
+  // `fec_encoding_pool` is optional and may be shared with other senders; it
+  // must outlive this sender.
   RtpVideoSender(
       Clock* clock,
       const std::map<uint32_t, RtpState>& suspended_ssrcs,
@@ -88,6 +91,7 @@ class RtpVideoSender : public RtpVideoSenderInterface,
       FrameEncryptorInterface* frame_encryptor,
       const CryptoOptions& crypto_options,  // move inside RtpTransport
       rtc::scoped_refptr<FrameTransformerInterface> frame_transformer,
+      FecEncodingPool* fec_encoding_pool,
       const FieldTrialsView& field_trials,
       TaskQueueFactory* task_queue_factory);
   ~RtpVideoSender() override;
@@ -16,12 +16,14 @@
 #include <utility>
 
 #include "absl/functional/any_invocable.h"
+#include "absl/types/optional.h"
 #include "api/environment/environment.h"
 #include "api/environment/environment_factory.h"
 #include "api/test/mock_frame_transformer.h"
 #include "call/rtp_transport_controller_send.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/fec_encoding_pool.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
 #include "modules/rtp_rtcp/source/rtp_dependency_descriptor_extension.h"
 #include "modules/rtp_rtcp/source/rtp_packet.h"
@@ -57,6 +59,8 @@ const int16_t kInitialTl0PicIdx2 = 199;
 const int64_t kRetransmitWindowSizeMs = 500;
 const int kTransportsSequenceExtensionId = 7;
 const int kDependencyDescriptorExtensionId = 8;
+const int kFlexfecPayloadType = 118;
+const uint32_t kFlexfecSsrc = 56789;
 
 class MockRtcpIntraFrameObserver : public RtcpIntraFrameObserver {
  public:
@@ -95,7 +99,8 @@ VideoSendStream::Config CreateVideoSendStreamConfig(
     Transport* transport,
     const std::vector<uint32_t>& ssrcs,
     const std::vector<uint32_t>& rtx_ssrcs,
-    int payload_type) {
+    int payload_type,
+    absl::optional<uint32_t> flexfec_ssrc) {
   VideoSendStream::Config config(transport);
   config.rtp.ssrcs = ssrcs;
   config.rtp.rtx.ssrcs = rtx_ssrcs;
@@ -107,6 +112,11 @@ VideoSendStream::Config CreateVideoSendStreamConfig(
   config.rtp.extensions.emplace_back(RtpDependencyDescriptorExtension::Uri(),
                                      kDependencyDescriptorExtensionId);
   config.rtp.extmap_allow_mixed = true;
+  if (flexfec_ssrc.has_value()) {
+    config.rtp.flexfec.payload_type = kFlexfecPayloadType;
+    config.rtp.flexfec.ssrc = *flexfec_ssrc;
+    config.rtp.flexfec.protected_media_ssrcs = {ssrcs[0]};
+  }
   return config;
 }
 
@@ -119,7 +129,9 @@ class RtpVideoSenderTestFixture {
       const std::map<uint32_t, RtpPayloadState>& suspended_payload_states,
       FrameCountObserver* frame_count_observer,
       rtc::scoped_refptr<FrameTransformerInterface> frame_transformer,
-      const FieldTrialsView* field_trials = nullptr)
+      const FieldTrialsView* field_trials = nullptr,
+      absl::optional<uint32_t> flexfec_ssrc = absl::nullopt,
+      FecEncodingPool* fec_encoding_pool = nullptr)
       : time_controller_(Timestamp::Millis(1000000)),
         env_(CreateEnvironment(&field_trials_,
                                field_trials,
@@ -128,7 +140,8 @@ class RtpVideoSenderTestFixture {
         config_(CreateVideoSendStreamConfig(&transport_,
                                             ssrcs,
                                             rtx_ssrcs,
-                                            payload_type)),
+                                            payload_type,
+                                            flexfec_ssrc)),
         bitrate_config_(GetBitrateConfig()),
         transport_controller_(
             RtpTransportConfig{.env = env_, .bitrate_config = bitrate_config_}),
@@ -148,7 +161,7 @@ class RtpVideoSenderTestFixture {
         &transport_controller_, &env_.event_log(),
         &retransmission_rate_limiter_,
         std::make_unique<FecControllerDefault>(env_), nullptr, CryptoOptions{},
-        frame_transformer, env_.field_trials(),
+        frame_transformer, fec_encoding_pool, env_.field_trials(),
         time_controller_.GetTaskQueueFactory());
   }
 
@@ -1385,4 +1398,55 @@ TEST(RtpVideoSenderTest, RetransmitsBaseLayerOnly) {
   EXPECT_EQ(retransmitted_rtp_sequence_numbers, base_rtp_sequence_numbers);
 }
 
+TEST(RtpVideoSenderTest, ProtectsLargeKeyFramesUsingFecEncodingPool) {
+  FecEncodingPool fec_encoding_pool(/*num_threads=*/2);
+  RtpVideoSenderTestFixture test({kSsrc1}, {kRtxSsrc1}, kPayloadType, {},
+                                 /*frame_count_observer=*/nullptr,
+                                 /*frame_transformer=*/nullptr,
+                                 /*field_trials=*/nullptr, kFlexfecSsrc,
+                                 &fec_encoding_pool);
+  test.SetSending(true);
+
+  // Protect key frames with as many FEC packets as media packets, which is
+  // enough for the FEC packets to be generated on the pool.
+  FecProtectionParams params;
+  params.fec_rate = 255;
+  params.max_fec_frames = 1;
+  params.fec_mask_type = kFecMaskRandom;
+  uint32_t sent_video_rate_bps;
+  uint32_t sent_nack_rate_bps;
+  uint32_t sent_fec_rate_bps;
+  test.router()->ProtectionRequest(&params, &params, &sent_video_rate_bps,
+                                   &sent_nack_rate_bps, &sent_fec_rate_bps);
+
+  int num_media_packets = 0;
+  int num_fec_packets = 0;
+  EXPECT_CALL(test.transport(), SendRtp)
+      .WillRepeatedly([&](rtc::ArrayView<const uint8_t> packet,
+                          const PacketOptions& options) {
+        RtpPacket rtp_packet;
+        EXPECT_TRUE(rtp_packet.Parse(packet));
+        if (rtp_packet.Ssrc() == kFlexfecSsrc) {
+          ++num_fec_packets;
+        } else if (rtp_packet.Ssrc() == kSsrc1) {
+          ++num_media_packets;
+        }
+        return true;
+      });
+
+  const std::vector<uint8_t> payload(20 * 1000, 'a');
+  EncodedImage encoded_image;
+  encoded_image.SetRtpTimestamp(1);
+  encoded_image.capture_time_ms_ = 2;
+  encoded_image._frameType = VideoFrameType::kVideoFrameKey;
+  encoded_image.SetEncodedData(
+      EncodedImageBuffer::Create(payload.data(), payload.size()));
+  EXPECT_EQ(EncodedImageCallback::Result::OK,
+            test.router()->OnEncodedImage(encoded_image, nullptr).error);
+  test.AdvanceTime(TimeDelta::Seconds(1));
+
+  EXPECT_GE(num_media_packets, 8);
+  EXPECT_GE(num_fec_packets, 8);
+}
+
 }  // namespace webrtc
@@ -21,6 +21,7 @@
 #include "api/array_view.h"
 #include "api/data_channel_interface.h"
 #include "api/environment/environment.h"
+#include "api/units/time_delta.h"
 #include "media/base/media_channel.h"
 #include "net/dcsctp/public/dcsctp_socket_factory.h"
 #include "net/dcsctp/public/packet_observer.h"
@@ -32,6 +33,7 @@
 #include "rtc_base/network/received_packet.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/task_utils/timer_wheel.h"
 #include "rtc_base/thread.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/clock.h"
@@ -138,7 +140,11 @@ DcSctpTransport::DcSctpTransport(
           [this]() { return TimeMillis(); },
           [this](dcsctp::TimeoutID timeout_id) {
             socket_->HandleTimeout(timeout_id);
-          }) {
+          },
+          env_.field_trials().IsEnabled(
+              "WebRTC-TaskQueue-CoarseLowPrecisionTimers")
+              ? kLowPrecisionTimerSlack
+              : TimeDelta::Zero()) {
   RTC_DCHECK_RUN_ON(network_thread_);
   static std::atomic<int> instance_count = 0;
   rtc::StringBuilder sb;
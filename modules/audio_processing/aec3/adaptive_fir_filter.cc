@@ -563,6 +563,9 @@ void AdaptiveFirFilter::Filter(const RenderBuffer& render_buffer,
     case Aec3Optimization::kAvx2:
       aec3::ApplyFilter_Avx2(render_buffer, current_size_partitions_, H_, S);
       break;
+    case Aec3Optimization::kAvx512:
+      aec3::ApplyFilter_Avx512(render_buffer, current_size_partitions_, H_, S);
+      break;
 #endif
 #if defined(WEBRTC_HAS_NEON)
     case Aec3Optimization::kNeon:
@@ -607,6 +610,9 @@ void AdaptiveFirFilter::ComputeFrequencyResponse(
     case Aec3Optimization::kAvx2:
       aec3::ComputeFrequencyResponse_Avx2(current_size_partitions_, H_, H2);
       break;
+    case Aec3Optimization::kAvx512:
+      aec3::ComputeFrequencyResponse_Avx512(current_size_partitions_, H_, H2);
+      break;
 #endif
 #if defined(WEBRTC_HAS_NEON)
     case Aec3Optimization::kNeon:
@@ -634,6 +640,10 @@ void AdaptiveFirFilter::AdaptAndUpdateSize(const RenderBuffer& render_buffer,
       aec3::AdaptPartitions_Avx2(render_buffer, G, current_size_partitions_,
                                  &H_);
       break;
+    case Aec3Optimization::kAvx512:
+      aec3::AdaptPartitions_Avx512(render_buffer, G, current_size_partitions_,
+                                   &H_);
+      break;
 #endif
 #if defined(WEBRTC_HAS_NEON)
     case Aec3Optimization::kNeon:
@@ -48,6 +48,11 @@ void ComputeFrequencyResponse_Avx2(
     size_t num_partitions,
     const std::vector<std::vector<FftData>>& H,
     std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
+
+void ComputeFrequencyResponse_Avx512(
+    size_t num_partitions,
+    const std::vector<std::vector<FftData>>& H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
 #endif
 
 // Adapts the filter partitions.
@@ -71,6 +76,11 @@ void AdaptPartitions_Avx2(const RenderBuffer& render_buffer,
                           const FftData& G,
                           size_t num_partitions,
                           std::vector<std::vector<FftData>>* H);
+
+void AdaptPartitions_Avx512(const RenderBuffer& render_buffer,
+                            const FftData& G,
+                            size_t num_partitions,
+                            std::vector<std::vector<FftData>>* H);
 #endif
 
 // Produces the filter output.
@@ -94,6 +104,11 @@ void ApplyFilter_Avx2(const RenderBuffer& render_buffer,
                       size_t num_partitions,
                       const std::vector<std::vector<FftData>>& H,
                       FftData* S);
+
+void ApplyFilter_Avx512(const RenderBuffer& render_buffer,
+                        size_t num_partitions,
+                        const std::vector<std::vector<FftData>>& H,
+                        FftData* S);
 #endif
 
 }  // namespace aec3
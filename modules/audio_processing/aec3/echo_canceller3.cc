@@ -18,6 +18,7 @@
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
+#include "system_wrappers/include/denormal_disabler.h"
 #include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
@@ -789,16 +790,32 @@ EchoCanceller3::EchoCanceller3(
 
   Initialize();
 
+  // Started last, as the worker uses the state initialized above.
+  if (config_.buffering.pipelined_render_processing) {
+    render_worker_ = rtc::PlatformThread::SpawnJoinable(
+        [this] { RunRenderWorker(); }, "Aec3RenderWorker",
+        rtc::ThreadAttributes().SetPriority(
+            config_.buffering.realtime_render_worker
+                ? rtc::ThreadPriority::kRealtime
+                : rtc::ThreadPriority::kHigh));
+  }
+
   RTC_LOG(LS_INFO) << "AEC3 created with sample rate: " << sample_rate_hz_
                    << " Hz, num render channels: " << num_render_input_channels_
-                   << ", num capture channels: " << num_capture_channels_;
+                   << ", num capture channels: " << num_capture_channels_
+                   << ", pipelined render processing: "
+                   << (render_worker_.empty() ? "off" : "on");
 }
 
-EchoCanceller3::~EchoCanceller3() = default;
+EchoCanceller3::~EchoCanceller3() {
+  if (!render_worker_.empty()) {
+    stop_render_worker_.store(true, std::memory_order_release);
+    render_frame_queued_.Set();
+    render_worker_.Finalize();
+  }
+}
 
 void EchoCanceller3::Initialize() {
-  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
-
   num_render_channels_to_aec_ =
       multichannel_content_detector_.IsProperMultiChannelContentDetected()
           ? num_render_input_channels_
@@ -828,11 +845,15 @@ void EchoCanceller3::AnalyzeRender(const AudioBuffer& render) {
   data_dumper_->DumpRaw("aec3_call_order",
                         static_cast<int>(EchoCanceller3ApiCall::kRender));
 
-  return render_writer_->Insert(render);
+  render_writer_->Insert(render);
+  if (!render_worker_.empty()) {
+    render_frame_queued_.Set();
+  }
 }
 
 void EchoCanceller3::AnalyzeCapture(const AudioBuffer& capture) {
   RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  MutexLock lock(&mutex_);
   data_dumper_->DumpWav("aec3_capture_analyze_input", capture.num_frames(),
                         capture.channels_const()[0], sample_rate_hz_, 1);
   saturated_microphone_signal_ = false;
@@ -858,6 +879,7 @@ void EchoCanceller3::ProcessCapture(AudioBuffer* capture,
   RTC_DCHECK_EQ(num_bands_, capture->num_bands());
   RTC_DCHECK_EQ(AudioBuffer::kSplitBandSize, capture->num_frames_per_band());
   RTC_DCHECK_EQ(capture->num_channels(), num_capture_channels_);
+  MutexLock lock(&mutex_);
   data_dumper_->DumpRaw("aec3_call_order",
                         static_cast<int>(EchoCanceller3ApiCall::kCapture));
 
@@ -882,6 +904,7 @@ void EchoCanceller3::ProcessCapture(AudioBuffer* capture,
 
   data_dumper_->DumpWav("aec3_capture_input", capture_lower_band, 16000, 1);
 
+  // Buffer any render frames that the render worker has not reached.
   EmptyRenderQueue();
 
   ProcessCaptureFrameContent(
@@ -914,17 +937,20 @@ void EchoCanceller3::ProcessCapture(AudioBuffer* capture,
 EchoControl::Metrics EchoCanceller3::GetMetrics() const {
   RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
   Metrics metrics;
+  MutexLock lock(&mutex_);
   block_processor_->GetMetrics(&metrics);
   return metrics;
 }
 
 void EchoCanceller3::SetAudioBufferDelay(int delay_ms) {
   RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  MutexLock lock(&mutex_);
   block_processor_->SetAudioBufferDelay(delay_ms);
 }
 
 void EchoCanceller3::SetCaptureOutputUsage(bool capture_output_used) {
   RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  MutexLock lock(&mutex_);
   block_processor_->SetCaptureOutputUsage(capture_output_used);
 }
 
@@ -951,41 +977,62 @@ void EchoCanceller3::SetBlockProcessorForTesting(
     std::unique_ptr<BlockProcessor> block_processor) {
   RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
   RTC_DCHECK(block_processor);
+  MutexLock lock(&mutex_);
   block_processor_ = std::move(block_processor);
 }
 
-void EchoCanceller3::EmptyRenderQueue() {
-  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
-  bool frame_to_buffer =
-      render_transfer_queue_.Remove(&render_queue_output_frame_);
-  while (frame_to_buffer) {
-    // Report render call in the metrics.
-    api_call_metrics_.ReportRenderCall();
-
-    if (multichannel_content_detector_.UpdateDetection(
-            render_queue_output_frame_)) {
-      // Reinitialize the AEC when proper stereo is detected.
-      Initialize();
+void EchoCanceller3::RunRenderWorker() {
+  // As APM does on the threads calling it.
+  DenormalDisabler denormal_disabler;
+  while (true) {
+    render_frame_queued_.Wait(rtc::Event::kForever);
+    if (stop_render_worker_.load(std::memory_order_acquire)) {
+      return;
     }
+    // Lock per frame, so that the capture processing waits for at most one
+    // frame to be buffered.
+    bool frame_buffered = true;
+    while (frame_buffered) {
+      MutexLock lock(&mutex_);
+      frame_buffered = BufferNextRenderFrame();
+    }
+  }
+}
 
-    // Buffer frame content.
-    BufferRenderFrameContent(
-        /*proper_downmix_needed=*/multichannel_content_detector_
-            .IsTemporaryMultiChannelContentDetected(),
-        &render_queue_output_frame_, 0, render_blocker_.get(),
-        block_processor_.get(), &render_block_, &render_sub_frame_view_);
+void EchoCanceller3::EmptyRenderQueue() {
+  while (BufferNextRenderFrame()) {
+  }
+}
 
-    BufferRenderFrameContent(
-        /*proper_downmix_needed=*/multichannel_content_detector_
-            .IsTemporaryMultiChannelContentDetected(),
-        &render_queue_output_frame_, 1, render_blocker_.get(),
-        block_processor_.get(), &render_block_, &render_sub_frame_view_);
+bool EchoCanceller3::BufferNextRenderFrame() {
+  if (!render_transfer_queue_.Remove(&render_queue_output_frame_)) {
+    return false;
+  }
 
-    BufferRemainingRenderFrameContent(render_blocker_.get(),
-                                      block_processor_.get(), &render_block_);
+  // Report render call in the metrics.
+  api_call_metrics_.ReportRenderCall();
 
-    frame_to_buffer =
-        render_transfer_queue_.Remove(&render_queue_output_frame_);
+  if (multichannel_content_detector_.UpdateDetection(
+          render_queue_output_frame_)) {
+    // Reinitialize the AEC when proper stereo is detected.
+    Initialize();
   }
+
+  // Buffer frame content.
+  BufferRenderFrameContent(
+      /*proper_downmix_needed=*/multichannel_content_detector_
+          .IsTemporaryMultiChannelContentDetected(),
+      &render_queue_output_frame_, 0, render_blocker_.get(),
+      block_processor_.get(), &render_block_, &render_sub_frame_view_);
+
+  BufferRenderFrameContent(
+      /*proper_downmix_needed=*/multichannel_content_detector_
+          .IsTemporaryMultiChannelContentDetected(),
+      &render_queue_output_frame_, 1, render_blocker_.get(),
+      block_processor_.get(), &render_block_, &render_sub_frame_view_);
+
+  BufferRemainingRenderFrameContent(render_blocker_.get(),
+                                    block_processor_.get(), &render_block_);
+  return true;
 }
 }  // namespace webrtc
@@ -31,8 +31,11 @@
 #include "modules/audio_processing/audio_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/race_checker.h"
 #include "rtc_base/swap_queue.h"
+#include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
@@ -86,6 +89,16 @@ class Aec3RenderQueueItemVerifier {
 //
 // The class is supposed to be used in a non-concurrent manner apart from the
 // AnalyzeRender call which can be called concurrently with the other methods.
+//
+// With config.buffering.pipelined_render_processing, the render frames are
+// buffered into the block processor, which computes their spectra and their
+// downsampled signal for the delay estimator, on a worker thread as they
+// arrive rather than by the next ProcessCapture call. The capture thread then
+// only buffers the render frames that the worker has not yet reached. The
+// order in which the render and capture blocks are processed, and hence the
+// output, is the same in both modes. The worker is a thread of its own per
+// instance, at high priority unless config.buffering.realtime_render_worker is
+// set.
 class EchoCanceller3 : public EchoControl {
  public:
   EchoCanceller3(
@@ -133,6 +146,7 @@ class EchoCanceller3 : public EchoControl {
   // once it is no longer occurring.
   void UpdateEchoLeakageStatus(bool leakage_detected) {
     RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+    MutexLock lock(&mutex_);
     block_processor_->UpdateEchoLeakageStatus(leakage_detected);
   }
 
@@ -153,7 +167,7 @@ class EchoCanceller3 : public EchoControl {
 
   // (Re-)Initializes the selected subset of the EchoCanceller3 fields, at
   // creation as well as during reconfiguration.
-  void Initialize();
+  void Initialize() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
   // Only for testing. Replaces the internal block processor.
   void SetBlockProcessorForTesting(
@@ -161,16 +175,28 @@ class EchoCanceller3 : public EchoControl {
 
   // Only for testing. Returns whether stereo processing is active.
   bool StereoRenderProcessingActiveForTesting() const {
+    MutexLock lock(&mutex_);
     return multichannel_content_detector_.IsProperMultiChannelContentDetected();
   }
 
   // Only for testing.
   const EchoCanceller3Config& GetActiveConfigForTesting() const {
+    MutexLock lock(&mutex_);
     return config_selector_.active_config();
   }
 
-  // Empties the render SwapQueue.
-  void EmptyRenderQueue();
+  // Empties the render SwapQueue. Runs on the capture thread, and on
+  // `render_worker_` with pipelined render processing, so it only touches the
+  // state guarded by `mutex_`.
+  void EmptyRenderQueue() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Buffers the next frame of the render SwapQueue. Returns false if the
+  // queue is empty.
+  bool BufferNextRenderFrame() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Buffers the render frames as they are queued, until the destructor runs.
+  // Holds `mutex_` for one frame at a time.
+  void RunRenderWorker() RTC_LOCKS_EXCLUDED(mutex_);
 
   // Analyzes and stores an internal copy of the split-band domain render
   // signal.
@@ -185,6 +211,16 @@ class EchoCanceller3 : public EchoControl {
   std::unique_ptr<RenderWriter> render_writer_
       RTC_GUARDED_BY(render_race_checker_);
 
+  // Serializes the render buffering of `render_worker_` with the capture
+  // processing. Held by the capture thread for all of AnalyzeCapture and
+  // ProcessCapture, and whenever it uses the block processor.
+  mutable Mutex mutex_;
+  // Set by AnalyzeRender when a frame has been queued for `render_worker_`.
+  rtc::Event render_frame_queued_;
+  std::atomic<bool> stop_render_worker_{false};
+  // Only running with pipelined render processing.
+  rtc::PlatformThread render_worker_;
+
   // State that may be accessed by the capture thread.
   static std::atomic<int> instance_count_;
   std::unique_ptr<ApmDataDumper> data_dumper_;
@@ -192,38 +228,37 @@ class EchoCanceller3 : public EchoControl {
   const int sample_rate_hz_;
   const int num_bands_;
   const size_t num_render_input_channels_;
-  size_t num_render_channels_to_aec_;
+  size_t num_render_channels_to_aec_ RTC_GUARDED_BY(mutex_);
   const size_t num_capture_channels_;
-  ConfigSelector config_selector_;
-  MultiChannelContentDetector multichannel_content_detector_;
+  ConfigSelector config_selector_ RTC_GUARDED_BY(mutex_);
+  MultiChannelContentDetector multichannel_content_detector_
+      RTC_GUARDED_BY(mutex_);
   std::unique_ptr<BlockFramer> linear_output_framer_
       RTC_GUARDED_BY(capture_race_checker_);
   BlockFramer output_framer_ RTC_GUARDED_BY(capture_race_checker_);
   FrameBlocker capture_blocker_ RTC_GUARDED_BY(capture_race_checker_);
-  std::unique_ptr<FrameBlocker> render_blocker_
-      RTC_GUARDED_BY(capture_race_checker_);
+  std::unique_ptr<FrameBlocker> render_blocker_ RTC_GUARDED_BY(mutex_);
   SwapQueue<std::vector<std::vector<std::vector<float>>>,
             Aec3RenderQueueItemVerifier>
       render_transfer_queue_;
-  std::unique_ptr<BlockProcessor> block_processor_
-      RTC_GUARDED_BY(capture_race_checker_);
+  std::unique_ptr<BlockProcessor> block_processor_ RTC_GUARDED_BY(mutex_);
   std::vector<std::vector<std::vector<float>>> render_queue_output_frame_
-      RTC_GUARDED_BY(capture_race_checker_);
+      RTC_GUARDED_BY(mutex_);
   bool saturated_microphone_signal_ RTC_GUARDED_BY(capture_race_checker_) =
       false;
-  Block render_block_ RTC_GUARDED_BY(capture_race_checker_);
+  Block render_block_ RTC_GUARDED_BY(mutex_);
   std::unique_ptr<Block> linear_output_block_
       RTC_GUARDED_BY(capture_race_checker_);
   Block capture_block_ RTC_GUARDED_BY(capture_race_checker_);
   std::vector<std::vector<rtc::ArrayView<float>>> render_sub_frame_view_
-      RTC_GUARDED_BY(capture_race_checker_);
+      RTC_GUARDED_BY(mutex_);
   std::vector<std::vector<rtc::ArrayView<float>>> linear_output_sub_frame_view_
       RTC_GUARDED_BY(capture_race_checker_);
   std::vector<std::vector<rtc::ArrayView<float>>> capture_sub_frame_view_
       RTC_GUARDED_BY(capture_race_checker_);
   std::unique_ptr<BlockDelayBuffer> block_delay_buffer_
       RTC_GUARDED_BY(capture_race_checker_);
-  ApiCallJitterMetrics api_call_metrics_ RTC_GUARDED_BY(capture_race_checker_);
+  ApiCallJitterMetrics api_call_metrics_ RTC_GUARDED_BY(mutex_);
 };
 }  // namespace webrtc
 
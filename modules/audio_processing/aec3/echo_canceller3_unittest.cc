@@ -23,6 +23,7 @@
 #include "modules/audio_processing/audio_buffer.h"
 #include "modules/audio_processing/high_pass_filter.h"
 #include "modules/audio_processing/utility/cascaded_biquad_filter.h"
+#include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
 #include "test/field_trial.h"
 #include "test/gmock.h"
@@ -1135,6 +1136,82 @@ TEST(EchoCanceller3, StereoContentDetectionForMonoSignals) {
   }
 }
 
+// Verifies that buffering the render signal on the render worker gives the
+// same output as buffering it on the capture thread, also when the render
+// frames arrive in bursts.
+TEST(EchoCanceller3, PipelinedRenderProcessingIsBitExact) {
+  constexpr int kSampleRateHz = 16000;
+  constexpr size_t kNumChannels = 2;
+  constexpr size_t kEchoDelayFrames = 3;
+  constexpr int kNumTicks = 300;
+  EchoCanceller3Config config;
+  EchoCanceller3Config pipelined_config;
+  pipelined_config.buffering.pipelined_render_processing = true;
+  EchoCanceller3 aec3(config, /*multichannel_config=*/absl::nullopt,
+                      kSampleRateHz, kNumChannels, kNumChannels);
+  EchoCanceller3 pipelined_aec3(pipelined_config,
+                                /*multichannel_config=*/absl::nullopt,
+                                kSampleRateHz, kNumChannels, kNumChannels);
+
+  auto create_buffer = [&] {
+    return std::make_unique<AudioBuffer>(kSampleRateHz, kNumChannels,
+                                         kSampleRateHz, kNumChannels,
+                                         kSampleRateHz, kNumChannels);
+  };
+  std::unique_ptr<AudioBuffer> render_buffer = create_buffer();
+  std::unique_ptr<AudioBuffer> capture_buffer = create_buffer();
+  std::unique_ptr<AudioBuffer> pipelined_capture_buffer = create_buffer();
+
+  Random random(42);
+  std::deque<std::vector<std::vector<float>>> render_history;
+  for (int tick = 0; tick < kNumTicks; ++tick) {
+    // Two render frames every fourth tick and none two ticks later.
+    const int num_render_frames = tick % 4 == 1 ? 2 : tick % 4 == 3 ? 0 : 1;
+    for (int i = 0; i < num_render_frames; ++i) {
+      std::vector<std::vector<float>> frame(kNumChannels,
+                                            std::vector<float>(160));
+      for (size_t ch = 0; ch < kNumChannels; ++ch) {
+        for (float& sample : frame[ch]) {
+          sample = random.Gaussian(0.f, 1000.f);
+        }
+        std::copy(frame[ch].begin(), frame[ch].end(),
+                  render_buffer->channels()[ch]);
+      }
+      render_history.push_front(frame);
+      render_history.resize(kEchoDelayFrames + 1);
+      aec3.AnalyzeRender(render_buffer.get());
+      pipelined_aec3.AnalyzeRender(render_buffer.get());
+    }
+
+    // Near-end noise plus the echo of the render signal.
+    for (size_t ch = 0; ch < kNumChannels; ++ch) {
+      float* capture = capture_buffer->channels()[ch];
+      for (size_t k = 0; k < 160; ++k) {
+        capture[k] = random.Gaussian(0.f, 10.f);
+        if (!render_history.back().empty()) {
+          capture[k] += 0.5f * render_history.back()[ch][k];
+        }
+      }
+      std::copy(capture, capture + 160,
+                pipelined_capture_buffer->channels()[ch]);
+    }
+
+    aec3.AnalyzeCapture(capture_buffer.get());
+    aec3.ProcessCapture(capture_buffer.get(), /*level_change=*/false);
+    pipelined_aec3.AnalyzeCapture(pipelined_capture_buffer.get());
+    pipelined_aec3.ProcessCapture(pipelined_capture_buffer.get(),
+                                  /*level_change=*/false);
+    for (size_t ch = 0; ch < kNumChannels; ++ch) {
+      for (size_t k = 0; k < 160; ++k) {
+        ASSERT_EQ(capture_buffer->channels()[ch][k],
+                  pipelined_capture_buffer->channels()[ch][k])
+            << "tick " << tick << ", channel " << ch << ", sample " << k;
+      }
+    }
+  }
+  EXPECT_EQ(aec3.GetMetrics().delay_ms, pipelined_aec3.GetMetrics().delay_ms);
+}
+
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 
 TEST(EchoCanceller3InputCheckDeathTest, WrongCaptureNumBandsCheckVerification) {
@@ -219,6 +219,52 @@ TEST_P(MatchedFilterTest, TestAvx2Optimizations) {
   }
 }
 
+// Verifies that the AVX-512 filter core produces the same output as the AVX2
+// one, which in turn is verified against the reference implementation above.
+TEST_P(MatchedFilterTest, TestAvx512Optimizations) {
+  bool use_avx512 = (GetCPUInfo(kAVX512) != 0);
+  const bool kComputeAccumulatederror = GetParam();
+  if (use_avx512) {
+    Random random_generator(42U);
+    constexpr float kSmoothing = 0.7f;
+    for (auto down_sampling_factor : kDownSamplingFactors) {
+      const size_t sub_block_size = kBlockSize / down_sampling_factor;
+      std::vector<float> x(2000);
+      RandomizeSampleVector(&random_generator, x);
+      std::vector<float> y(sub_block_size);
+      std::vector<float> h_AVX512(512);
+      std::vector<float> h_AVX2(512);
+      std::vector<float> accumulated_error_AVX512(512 / 4);
+      std::vector<float> accumulated_error_AVX2(512 / 4);
+      std::vector<float> scratch_memory(512);
+      int x_index = 0;
+      for (int k = 0; k < 1000; ++k) {
+        RandomizeSampleVector(&random_generator, y);
+        bool filters_updated_AVX2 = false;
+        float error_sum_AVX2 = 0.f;
+        bool filters_updated_AVX512 = false;
+        float error_sum_AVX512 = 0.f;
+        MatchedFilterCore_AVX512(x_index, h_AVX512.size() * 150.f * 150.f,
+                                 kSmoothing, x, y, h_AVX512,
+                                 &filters_updated_AVX512, &error_sum_AVX512,
+                                 kComputeAccumulatederror,
+                                 accumulated_error_AVX512, scratch_memory);
+        MatchedFilterCore_AVX2(x_index, h_AVX2.size() * 150.f * 150.f,
+                               kSmoothing, x, y, h_AVX2, &filters_updated_AVX2,
+                               &error_sum_AVX2, kComputeAccumulatederror,
+                               accumulated_error_AVX2, scratch_memory);
+        EXPECT_EQ(filters_updated_AVX2, filters_updated_AVX512);
+        EXPECT_EQ(error_sum_AVX2, error_sum_AVX512);
+        EXPECT_EQ(h_AVX2, h_AVX512);
+        if (kComputeAccumulatederror) {
+          EXPECT_EQ(accumulated_error_AVX2, accumulated_error_AVX512);
+        }
+        x_index = (x_index + sub_block_size) % x.size();
+      }
+    }
+  }
+}
+
 #endif
 
 // Verifies that the (optimized) function MaxSquarePeakIndex() produces output
@@ -31,6 +31,7 @@
 #include "modules/audio_processing/audio_buffer.h"
 #include "modules/audio_processing/include/audio_frame_view.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "modules/audio_processing/ns/ns_config_conversion.h"
 #include "modules/audio_processing/optionally_built_submodule_creators.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/experiments/field_trial_parser.h"
@@ -712,7 +713,8 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
 
   const bool ns_config_changed =
       config_.noise_suppression.enabled != config.noise_suppression.enabled ||
-      config_.noise_suppression.level != config.noise_suppression.level;
+      config_.noise_suppression.level != config.noise_suppression.level ||
+      config_.noise_suppression.mode != config.noise_suppression.mode;
 
   const bool ts_config_changed = config_.transient_suppression.enabled !=
                                  config.transient_suppression.enabled;
@@ -2166,27 +2168,9 @@ void AudioProcessingImpl::InitializeNoiseSuppressor() {
   submodules_.noise_suppressor.reset();
 
   if (config_.noise_suppression.enabled) {
-    auto map_level =
-        [](AudioProcessing::Config::NoiseSuppression::Level level) {
-          using NoiseSuppresionConfig =
-              AudioProcessing::Config::NoiseSuppression;
-          switch (level) {
-            case NoiseSuppresionConfig::kLow:
-              return NsConfig::SuppressionLevel::k6dB;
-            case NoiseSuppresionConfig::kModerate:
-              return NsConfig::SuppressionLevel::k12dB;
-            case NoiseSuppresionConfig::kHigh:
-              return NsConfig::SuppressionLevel::k18dB;
-            case NoiseSuppresionConfig::kVeryHigh:
-              return NsConfig::SuppressionLevel::k21dB;
-          }
-          RTC_CHECK_NOTREACHED();
-        };
-
-    NsConfig cfg;
-    cfg.target_level = map_level(config_.noise_suppression.level);
     submodules_.noise_suppressor = std::make_unique<NoiseSuppressor>(
-        cfg, proc_sample_rate_hz(), num_proc_channels());
+        ToNsConfig(config_.noise_suppression), proc_sample_rate_hz(),
+        num_proc_channels());
   }
 }
 
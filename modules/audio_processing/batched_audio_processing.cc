@@ -0,0 +1,185 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/batched_audio_processing.h"
+
+#include <algorithm>
+#include <array>
+
+#include "absl/types/optional.h"
+#include "modules/audio_processing/agc2/input_volume_controller.h"
+#include "modules/audio_processing/ns/ns_config_conversion.h"
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/denormal_disabler.h"
+
+namespace webrtc {
+
+BatchedAudioProcessing::Stream::Stream(const Config& config,
+                                       int sample_rate_hz)
+    : audio(sample_rate_hz,
+            /*input_num_channels=*/1,
+            sample_rate_hz,
+            /*buffer_num_channels=*/1,
+            sample_rate_hz,
+            /*output_num_channels=*/1) {
+  if (config.noise_suppression.enabled) {
+    noise_suppressor = std::make_unique<NoiseSuppressor>(
+        ToNsConfig(config.noise_suppression), sample_rate_hz,
+        /*num_channels=*/1);
+  }
+  if (config.gain_controller2.enabled) {
+    gain_controller2 = std::make_unique<GainController2>(
+        config.gain_controller2, InputVolumeController::Config{},
+        sample_rate_hz, /*num_channels=*/1, /*use_internal_vad=*/true);
+  }
+}
+
+BatchedAudioProcessing::Stream::~Stream() = default;
+
+BatchedAudioProcessing::BatchedAudioProcessing(const Config& config,
+                                               int sample_rate_hz,
+                                               size_t num_streams)
+    : config_(config),
+      stream_config_(sample_rate_hz, /*num_channels=*/1),
+      use_high_pass_filter_(config.high_pass_filter.enabled ||
+                            config.noise_suppression.enabled),
+      use_full_band_high_pass_filter_(
+          config.high_pass_filter.apply_in_full_band),
+      split_bands_(sample_rate_hz > 16000 &&
+                   (config.noise_suppression.enabled ||
+                    (use_high_pass_filter_ &&
+                     !use_full_band_high_pass_filter_))) {
+  RTC_DCHECK(sample_rate_hz == 16000 || sample_rate_hz == 32000 ||
+             sample_rate_hz == 48000);
+  RTC_DCHECK(!config.gain_controller2.enabled ||
+             GainController2::Validate(config.gain_controller2));
+  for (size_t s = 0; s < num_streams; ++s) {
+    streams_.push_back(std::make_unique<Stream>(config_, sample_rate_hz));
+  }
+
+  if (use_high_pass_filter_) {
+    const int high_pass_filter_rate_hz =
+        use_full_band_high_pass_filter_ ? sample_rate_hz : 16000;
+    for (size_t first = 0; first < num_streams; first += kStreamsPerBlock) {
+      high_pass_filters_.push_back(std::make_unique<BatchedHighPassFilter>(
+          high_pass_filter_rate_hz,
+          std::min(kStreamsPerBlock, num_streams - first)));
+    }
+    interleaved_block_.resize(kStreamsPerBlock * stream_config_.num_frames());
+  }
+}
+
+BatchedAudioProcessing::~BatchedAudioProcessing() = default;
+
+void BatchedAudioProcessing::ProcessStreams(DeinterleavedView<float> streams) {
+  RTC_DCHECK_EQ(streams.num_channels(), streams_.size());
+  RTC_DCHECK_EQ(streams.samples_per_channel(), stream_config_.num_frames());
+  DenormalDisabler denormal_disabler;
+  for (size_t first = 0; first < streams_.size(); first += kStreamsPerBlock) {
+    ProcessBlock(first, streams);
+  }
+}
+
+void BatchedAudioProcessing::ProcessBlock(size_t first_stream,
+                                          DeinterleavedView<float> streams) {
+  const size_t end_stream =
+      std::min(first_stream + kStreamsPerBlock, streams_.size());
+  const size_t block = first_stream / kStreamsPerBlock;
+
+  for (size_t s = first_stream; s < end_stream; ++s) {
+    const float* data = streams[s].data();
+    streams_[s]->audio.CopyFrom(&data, stream_config_);
+  }
+
+  if (use_high_pass_filter_ && use_full_band_high_pass_filter_) {
+    ApplyHighPassFilter(block, first_stream);
+  }
+
+  if (split_bands_) {
+    for (size_t s = first_stream; s < end_stream; ++s) {
+      streams_[s]->audio.SplitIntoFrequencyBands();
+    }
+  }
+
+  if (use_high_pass_filter_ && !use_full_band_high_pass_filter_) {
+    ApplyHighPassFilter(block, first_stream);
+  }
+
+  if (config_.noise_suppression.enabled) {
+    std::array<NoiseSuppressor*, kStreamsPerBlock> suppressors;
+    std::array<AudioBuffer*, kStreamsPerBlock> audio;
+    const size_t num_streams = end_stream - first_stream;
+    for (size_t s = 0; s < num_streams; ++s) {
+      suppressors[s] = streams_[first_stream + s]->noise_suppressor.get();
+      audio[s] = &streams_[first_stream + s]->audio;
+    }
+    NoiseSuppressor::AnalyzeBatch(
+        rtc::ArrayView<NoiseSuppressor* const>(suppressors.data(),
+                                               num_streams),
+        rtc::ArrayView<const AudioBuffer* const>(audio.data(), num_streams),
+        ns_fft_);
+    NoiseSuppressor::ProcessBatch(
+        rtc::ArrayView<NoiseSuppressor* const>(suppressors.data(),
+                                               num_streams),
+        rtc::ArrayView<AudioBuffer* const>(audio.data(), num_streams),
+        ns_fft_);
+  }
+
+  if (split_bands_) {
+    for (size_t s = first_stream; s < end_stream; ++s) {
+      streams_[s]->audio.MergeFrequencyBands();
+    }
+  }
+
+  if (config_.gain_controller2.enabled) {
+    for (size_t s = first_stream; s < end_stream; ++s) {
+      streams_[s]->gain_controller2->Process(
+          /*speech_probability=*/absl::nullopt,
+          /*input_volume_changed=*/false, &streams_[s]->audio);
+    }
+  }
+
+  for (size_t s = first_stream; s < end_stream; ++s) {
+    float* data = streams[s].data();
+    streams_[s]->audio.CopyTo(stream_config_, &data);
+  }
+}
+
+void BatchedAudioProcessing::ApplyHighPassFilter(size_t block,
+                                                 size_t first_stream) {
+  BatchedHighPassFilter& filter = *high_pass_filters_[block];
+  const size_t num_streams = filter.num_streams();
+  const size_t num_frames =
+      use_full_band_high_pass_filter_
+          ? stream_config_.num_frames()
+          : streams_[first_stream]->audio.num_frames_per_band();
+  auto samples = [&](size_t s) {
+    AudioBuffer& audio = streams_[first_stream + s]->audio;
+    return use_full_band_high_pass_filter_ ? audio.channels()[0]
+                                           : audio.split_bands(0)[0];
+  };
+
+  for (size_t s = 0; s < num_streams; ++s) {
+    const float* x = samples(s);
+    for (size_t k = 0; k < num_frames; ++k) {
+      interleaved_block_[k * num_streams + s] = x[k];
+    }
+  }
+  filter.Process(rtc::ArrayView<float>(interleaved_block_.data(),
+                                       num_frames * num_streams));
+  for (size_t s = 0; s < num_streams; ++s) {
+    float* y = samples(s);
+    for (size_t k = 0; k < num_frames; ++k) {
+      y[k] = interleaved_block_[k * num_streams + s];
+    }
+  }
+}
+
+}  // namespace webrtc
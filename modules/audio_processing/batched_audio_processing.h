@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_BATCHED_AUDIO_PROCESSING_H_
+#define MODULES_AUDIO_PROCESSING_BATCHED_AUDIO_PROCESSING_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/audio/audio_processing.h"
+#include "api/audio/audio_view.h"
+#include "modules/audio_processing/audio_buffer.h"
+#include "modules/audio_processing/gain_controller2.h"
+#include "modules/audio_processing/high_pass_filter.h"
+#include "modules/audio_processing/ns/batched_ns_fft.h"
+#include "modules/audio_processing/ns/noise_suppressor.h"
+
+namespace webrtc {
+
+// Applies the capture processing of AudioProcessing to many independent mono
+// streams that are processed at the same 10 ms tick, such as the incoming
+// streams of the participants of a conference mixed on a server. Supports the
+// high-pass filter, the noise suppressor and AGC2, configured as in
+// AudioProcessing::Config, which run on each stream as in AudioProcessing.
+//
+// The streams are processed in blocks, one submodule at a time for all the
+// streams of a block, so that the code and tables of each submodule stay in
+// the caches while the audio of the block does too. The high-pass filter runs
+// on the streams of a block at once, in SIMD lanes, and so do the FFTs of the
+// noise suppressor.
+//
+// Not thread-safe.
+class BatchedAudioProcessing {
+ public:
+  struct Config {
+    AudioProcessing::Config::HighPassFilter high_pass_filter;
+    AudioProcessing::Config::NoiseSuppression noise_suppression;
+    AudioProcessing::Config::GainController2 gain_controller2;
+  };
+
+  // Number of streams processed a submodule at a time.
+  static constexpr size_t kStreamsPerBlock = 16;
+  static_assert(kStreamsPerBlock <= BatchedNrFft::kNumLanes);
+
+  // `sample_rate_hz` must be 16000, 32000 or 48000.
+  BatchedAudioProcessing(const Config& config,
+                         int sample_rate_hz,
+                         size_t num_streams);
+  BatchedAudioProcessing(const BatchedAudioProcessing&) = delete;
+  BatchedAudioProcessing& operator=(const BatchedAudioProcessing&) = delete;
+  ~BatchedAudioProcessing();
+
+  // Processes one 10 ms frame of every stream in place. Channel s of `streams`
+  // holds the frame of stream s, with samples in [-1, 1].
+  void ProcessStreams(DeinterleavedView<float> streams);
+
+  size_t num_streams() const { return streams_.size(); }
+
+ private:
+  struct Stream {
+    Stream(const Config& config, int sample_rate_hz);
+    ~Stream();
+
+    AudioBuffer audio;
+    std::unique_ptr<NoiseSuppressor> noise_suppressor;
+    std::unique_ptr<GainController2> gain_controller2;
+  };
+
+  void ProcessBlock(size_t first_stream, DeinterleavedView<float> streams);
+  // Applies the high-pass filter of `block` to the lowest band, or to the full
+  // band, of the streams starting at `first_stream`.
+  void ApplyHighPassFilter(size_t block, size_t first_stream);
+
+  const Config config_;
+  const StreamConfig stream_config_;
+  // As in AudioProcessing, the noise suppressor requires the high-pass
+  // filter.
+  const bool use_high_pass_filter_;
+  const bool use_full_band_high_pass_filter_;
+  // Whether the streams are split into bands, which requires a rate above
+  // 16 kHz.
+  const bool split_bands_;
+  std::vector<std::unique_ptr<Stream>> streams_;
+  std::vector<std::unique_ptr<BatchedHighPassFilter>> high_pass_filters_;
+  // The samples filtered by the high-pass filter of a block, interleaved.
+  std::vector<float> interleaved_block_;
+  // Computes the FFTs of the noise suppressors of a block.
+  BatchedNrFft ns_fft_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_BATCHED_AUDIO_PROCESSING_H_
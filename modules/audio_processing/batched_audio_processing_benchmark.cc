@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "api/audio/audio_processing.h"
+#include "api/audio/audio_view.h"
+#include "api/scoped_refptr.h"
+#include "benchmark/benchmark.h"
+#include "modules/audio_processing/batched_audio_processing.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/random.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kNumFrames = kSampleRateHz / 100;
+
+BatchedAudioProcessing::Config CreateConfig() {
+  BatchedAudioProcessing::Config config;
+  config.high_pass_filter.enabled = true;
+  config.noise_suppression.enabled = true;
+  config.noise_suppression.level =
+      AudioProcessing::Config::NoiseSuppression::kHigh;
+  config.gain_controller2.enabled = true;
+  config.gain_controller2.adaptive_digital.enabled = true;
+  return config;
+}
+
+// One 10 ms frame of noise per stream, in the layout of `ProcessStreams()`.
+std::vector<float> CreateFrames(size_t num_streams) {
+  Random random(0x5eed);
+  std::vector<float> frames(num_streams * kNumFrames);
+  for (float& sample : frames) {
+    sample = random.Gaussian(/*mean=*/0.0, /*standard_deviation=*/0.1);
+  }
+  return frames;
+}
+
+// Each stream processed by an AudioProcessing of its own.
+void BM_SeparateAudioProcessing(benchmark::State& state) {
+  const size_t num_streams = state.range(0);
+  const BatchedAudioProcessing::Config batched_config = CreateConfig();
+  AudioProcessing::Config config;
+  config.high_pass_filter = batched_config.high_pass_filter;
+  config.noise_suppression = batched_config.noise_suppression;
+  config.gain_controller2 = batched_config.gain_controller2;
+  std::vector<rtc::scoped_refptr<AudioProcessing>> apms;
+  for (size_t s = 0; s < num_streams; ++s) {
+    apms.push_back(AudioProcessingBuilder().SetConfig(config).Create());
+  }
+  const StreamConfig stream_config(kSampleRateHz, /*num_channels=*/1);
+  std::vector<float> frames = CreateFrames(num_streams);
+
+  for (auto _ : state) {
+    for (size_t s = 0; s < num_streams; ++s) {
+      float* frame = &frames[s * kNumFrames];
+      RTC_CHECK_EQ(apms[s]->ProcessStream(&frame, stream_config,
+                                          stream_config, &frame),
+                   AudioProcessing::kNoError);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * num_streams);
+}
+
+void BM_BatchedAudioProcessing(benchmark::State& state) {
+  const size_t num_streams = state.range(0);
+  BatchedAudioProcessing apm(CreateConfig(), kSampleRateHz, num_streams);
+  std::vector<float> frames = CreateFrames(num_streams);
+  DeinterleavedView<float> streams(frames.data(), kNumFrames, num_streams);
+
+  for (auto _ : state) {
+    apm.ProcessStreams(streams);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * num_streams);
+}
+
+BENCHMARK(BM_SeparateAudioProcessing)->Arg(1)->Arg(16)->Arg(64)->Arg(256);
+BENCHMARK(BM_BatchedAudioProcessing)->Arg(1)->Arg(16)->Arg(64)->Arg(256);
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,204 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/batched_audio_processing.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/audio/audio_processing.h"
+#include "api/audio/audio_view.h"
+#include "modules/audio_processing/agc2/input_volume_controller.h"
+#include "modules/audio_processing/audio_buffer.h"
+#include "modules/audio_processing/gain_controller2.h"
+#include "modules/audio_processing/high_pass_filter.h"
+#include "modules/audio_processing/ns/noise_suppressor.h"
+#include "modules/audio_processing/ns/ns_config_conversion.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumFramesToProcess = 100;
+constexpr float kTolerance = 1e-5f;
+
+// Processes one stream with its own submodules, in the order of
+// AudioProcessing.
+class ReferenceProcessing {
+ public:
+  ReferenceProcessing(const BatchedAudioProcessing::Config& config,
+                      int sample_rate_hz)
+      : config_(config),
+        stream_config_(sample_rate_hz, 1),
+        audio_(sample_rate_hz, 1, sample_rate_hz, 1, sample_rate_hz, 1) {
+    if (config.high_pass_filter.enabled || config.noise_suppression.enabled) {
+      high_pass_filter_ = std::make_unique<HighPassFilter>(
+          config.high_pass_filter.apply_in_full_band ? sample_rate_hz : 16000,
+          1);
+    }
+    if (config.noise_suppression.enabled) {
+      noise_suppressor_ = std::make_unique<NoiseSuppressor>(
+          ToNsConfig(config.noise_suppression), sample_rate_hz, 1);
+    }
+    if (config.gain_controller2.enabled) {
+      gain_controller2_ = std::make_unique<GainController2>(
+          config.gain_controller2, InputVolumeController::Config{},
+          sample_rate_hz, 1, /*use_internal_vad=*/true);
+    }
+  }
+
+  void Process(float* data) {
+    audio_.CopyFrom(&data, stream_config_);
+    const bool full_band = config_.high_pass_filter.apply_in_full_band;
+    const bool split_bands =
+        stream_config_.sample_rate_hz() > 16000 &&
+        (noise_suppressor_ || (high_pass_filter_ && !full_band));
+    if (high_pass_filter_ && full_band) {
+      high_pass_filter_->Process(&audio_, /*use_split_band_data=*/false);
+    }
+    if (split_bands) {
+      audio_.SplitIntoFrequencyBands();
+    }
+    if (high_pass_filter_ && !full_band) {
+      high_pass_filter_->Process(&audio_, /*use_split_band_data=*/true);
+    }
+    if (noise_suppressor_) {
+      noise_suppressor_->Analyze(audio_);
+      noise_suppressor_->Process(&audio_);
+    }
+    if (split_bands) {
+      audio_.MergeFrequencyBands();
+    }
+    if (gain_controller2_) {
+      gain_controller2_->Process(absl::nullopt, false, &audio_);
+    }
+    audio_.CopyTo(stream_config_, &data);
+  }
+
+ private:
+  const BatchedAudioProcessing::Config config_;
+  const StreamConfig stream_config_;
+  AudioBuffer audio_;
+  std::unique_ptr<HighPassFilter> high_pass_filter_;
+  std::unique_ptr<NoiseSuppressor> noise_suppressor_;
+  std::unique_ptr<GainController2> gain_controller2_;
+};
+
+// Fills `streams` with a tone of a different frequency per stream in noise.
+void GenerateFrames(int frame_index,
+                    int sample_rate_hz,
+                    Random& random,
+                    DeinterleavedView<float> streams) {
+  for (size_t s = 0; s < streams.num_channels(); ++s) {
+    const float frequency_hz = 200.f + 50.f * s;
+    MonoView<float> stream = streams[s];
+    for (size_t k = 0; k < stream.size(); ++k) {
+      const size_t t = frame_index * stream.size() + k;
+      stream[k] = 0.2f * std::sin(6.2831853f * frequency_hz * t /
+                                  sample_rate_hz) +
+                  static_cast<float>(random.Gaussian(0.0, 0.05));
+    }
+  }
+}
+
+void ExpectSameOutputAsReference(const BatchedAudioProcessing::Config& config,
+                                 int sample_rate_hz,
+                                 size_t num_streams) {
+  BatchedAudioProcessing batched(config, sample_rate_hz, num_streams);
+  std::vector<std::unique_ptr<ReferenceProcessing>> references;
+  for (size_t s = 0; s < num_streams; ++s) {
+    references.push_back(
+        std::make_unique<ReferenceProcessing>(config, sample_rate_hz));
+  }
+
+  const size_t samples_per_channel = sample_rate_hz / 100;
+  std::vector<float> batched_data(num_streams * samples_per_channel);
+  std::vector<float> reference_data(batched_data.size());
+  DeinterleavedView<float> batched_streams(batched_data.data(),
+                                           samples_per_channel, num_streams);
+  DeinterleavedView<float> reference_streams(
+      reference_data.data(), samples_per_channel, num_streams);
+  Random random(/*seed=*/1234);
+  for (int frame = 0; frame < kNumFramesToProcess; ++frame) {
+    GenerateFrames(frame, sample_rate_hz, random, batched_streams);
+    reference_data = batched_data;
+
+    batched.ProcessStreams(batched_streams);
+    for (size_t s = 0; s < num_streams; ++s) {
+      references[s]->Process(reference_streams[s].data());
+    }
+
+    for (size_t i = 0; i < batched_data.size(); ++i) {
+      ASSERT_NEAR(batched_data[i], reference_data[i], kTolerance)
+          << "frame " << frame << ", stream " << i / samples_per_channel;
+    }
+  }
+}
+
+BatchedAudioProcessing::Config AllSubmodulesConfig() {
+  BatchedAudioProcessing::Config config;
+  config.high_pass_filter.enabled = true;
+  config.noise_suppression.enabled = true;
+  config.noise_suppression.level =
+      AudioProcessing::Config::NoiseSuppression::kHigh;
+  config.gain_controller2.enabled = true;
+  config.gain_controller2.adaptive_digital.enabled = true;
+  return config;
+}
+
+TEST(BatchedAudioProcessingTest, MatchesSubmodulesPerStream) {
+  for (int sample_rate_hz : {16000, 32000, 48000}) {
+    SCOPED_TRACE(sample_rate_hz);
+    // More streams than a block, and a partial last block.
+    ExpectSameOutputAsReference(AllSubmodulesConfig(), sample_rate_hz,
+                                BatchedAudioProcessing::kStreamsPerBlock + 3);
+  }
+}
+
+TEST(BatchedAudioProcessingTest, MatchesSubmodulesPerStreamWithSplitBandHpf) {
+  BatchedAudioProcessing::Config config = AllSubmodulesConfig();
+  config.high_pass_filter.apply_in_full_band = false;
+  ExpectSameOutputAsReference(config, /*sample_rate_hz=*/48000,
+                              /*num_streams=*/5);
+}
+
+TEST(BatchedAudioProcessingTest, MatchesSubmodulesPerStreamAtEachNsLevel) {
+  using NoiseSuppression = AudioProcessing::Config::NoiseSuppression;
+  for (NoiseSuppression::Level level :
+       {NoiseSuppression::kLow, NoiseSuppression::kModerate,
+        NoiseSuppression::kVeryHigh}) {
+    SCOPED_TRACE(level);
+    BatchedAudioProcessing::Config config = AllSubmodulesConfig();
+    config.noise_suppression.level = level;
+    ExpectSameOutputAsReference(config, /*sample_rate_hz=*/32000,
+                                /*num_streams=*/3);
+  }
+}
+
+TEST(BatchedAudioProcessingTest, MatchesSubmodulesPerStreamWithRnnoise) {
+  BatchedAudioProcessing::Config config = AllSubmodulesConfig();
+  config.noise_suppression.mode =
+      AudioProcessing::Config::NoiseSuppression::kRnnoise;
+  ExpectSameOutputAsReference(config, /*sample_rate_hz=*/48000,
+                              /*num_streams=*/3);
+}
+
+TEST(BatchedAudioProcessingTest, MatchesHighPassFilterPerStream) {
+  BatchedAudioProcessing::Config config;
+  config.high_pass_filter.enabled = true;
+  ExpectSameOutputAsReference(config, /*sample_rate_hz=*/48000,
+                              /*num_streams=*/3);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -10,6 +10,8 @@
 
 #include "modules/audio_processing/high_pass_filter.h"
 
+#include <algorithm>
+
 #include "api/array_view.h"
 #include "modules/audio_processing/audio_buffer.h"
 #include "rtc_base/checks.h"
@@ -112,4 +114,51 @@ void HighPassFilter::Reset(size_t num_channels) {
   }
 }
 
+BatchedHighPassFilter::BatchedHighPassFilter(int sample_rate_hz,
+                                             size_t num_streams)
+    : coefficients_(ChooseCoefficients(sample_rate_hz)),
+      x0_(num_streams, 0.f),
+      x1_(num_streams, 0.f),
+      y0_(num_streams, 0.f),
+      y1_(num_streams, 0.f) {
+  static_assert(kNumberOfHighPassBiQuads == 1);
+}
+
+BatchedHighPassFilter::~BatchedHighPassFilter() = default;
+
+void BatchedHighPassFilter::Process(rtc::ArrayView<float> audio) {
+  const size_t num_streams = x0_.size();
+  RTC_DCHECK_EQ(audio.size() % num_streams, 0);
+  const float c_a_0 = coefficients_.a[0];
+  const float c_a_1 = coefficients_.a[1];
+  const float c_b_0 = coefficients_.b[0];
+  const float c_b_1 = coefficients_.b[1];
+  const float c_b_2 = coefficients_.b[2];
+  float* m_x_0 = x0_.data();
+  float* m_x_1 = x1_.data();
+  float* m_y_0 = y0_.data();
+  float* m_y_1 = y1_.data();
+  // Same direct form 1 biquad as CascadedBiQuadFilter, with the loop over the
+  // independent streams innermost.
+  for (size_t k = 0; k < audio.size(); k += num_streams) {
+    float* y = &audio[k];
+    for (size_t s = 0; s < num_streams; ++s) {
+      const float tmp = y[s];
+      y[s] = c_b_0 * tmp + c_b_1 * m_x_0[s] + c_b_2 * m_x_1[s] -
+             c_a_0 * m_y_0[s] - c_a_1 * m_y_1[s];
+      m_x_1[s] = m_x_0[s];
+      m_x_0[s] = tmp;
+      m_y_1[s] = m_y_0[s];
+      m_y_0[s] = y[s];
+    }
+  }
+}
+
+void BatchedHighPassFilter::Reset() {
+  std::fill(x0_.begin(), x0_.end(), 0.f);
+  std::fill(x1_.begin(), x1_.end(), 0.f);
+  std::fill(y0_.begin(), y0_.end(), 0.f);
+  std::fill(y1_.begin(), y1_.end(), 0.f);
+}
+
 }  // namespace webrtc
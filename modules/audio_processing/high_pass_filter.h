@@ -40,6 +40,32 @@ class HighPassFilter {
   const int sample_rate_hz_;
   std::vector<std::unique_ptr<CascadedBiQuadFilter>> filters_;
 };
+
+// Applies the high-pass filter of HighPassFilter to a number of independent
+// streams at once. The samples of the streams are interleaved and the filter
+// states are stored stream by stream, so that the streams are filtered in
+// SIMD lanes.
+class BatchedHighPassFilter {
+ public:
+  BatchedHighPassFilter(int sample_rate_hz, size_t num_streams);
+  ~BatchedHighPassFilter();
+  BatchedHighPassFilter(const BatchedHighPassFilter&) = delete;
+  BatchedHighPassFilter& operator=(const BatchedHighPassFilter&) = delete;
+
+  // Filters `audio` in place, where sample k of stream s is at
+  // `audio[k * num_streams() + s]`.
+  void Process(rtc::ArrayView<float> audio);
+  void Reset();
+
+  size_t num_streams() const { return x0_.size(); }
+
+ private:
+  const CascadedBiQuadFilter::BiQuadCoefficients& coefficients_;
+  std::vector<float> x0_;
+  std::vector<float> x1_;
+  std::vector<float> y0_;
+  std::vector<float> y1_;
+};
 }  // namespace webrtc
 
 #endif  // MODULES_AUDIO_PROCESSING_HIGH_PASS_FILTER_H_
@@ -0,0 +1,530 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/ns/batched_ns_fft.h"
+
+#include <algorithm>
+#include <array>
+
+#include "common_audio/third_party/ooura/fft_size_256/fft4g.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr size_t kNumLanes = BatchedNrFft::kNumLanes;
+
+// Element k of all the lanes.
+using Lanes = float[kNumLanes];
+
+// The routines below are those of WebRtc_rdft in fft4g.cc, with each
+// operation on an element applied to the element of all the lanes. The
+// tables are computed by WebRtc_rdft.
+
+// Swaps the complex elements at `j1` and `k1` of all the lanes.
+void SwapComplex(Lanes* a, size_t j1, size_t k1) {
+  std::swap_ranges(&a[j1][0], &a[j1 + 2][0], &a[k1][0]);
+}
+
+void bitrv2(size_t n, size_t* ip, Lanes* a) {
+  size_t j, j1, k, k1, l, m, m2;
+
+  ip[0] = 0;
+  l = n;
+  m = 1;
+  while ((m << 3) < l) {
+    l >>= 1;
+    for (j = 0; j < m; j++) {
+      ip[m + j] = ip[j] + l;
+    }
+    m <<= 1;
+  }
+  m2 = 2 * m;
+  if ((m << 3) == l) {
+    for (k = 0; k < m; k++) {
+      for (j = 0; j < k; j++) {
+        j1 = 2 * j + ip[k];
+        k1 = 2 * k + ip[j];
+        SwapComplex(a, j1, k1);
+        j1 += m2;
+        k1 += 2 * m2;
+        SwapComplex(a, j1, k1);
+        j1 += m2;
+        k1 -= m2;
+        SwapComplex(a, j1, k1);
+        j1 += m2;
+        k1 += 2 * m2;
+        SwapComplex(a, j1, k1);
+      }
+      j1 = 2 * k + m2 + ip[k];
+      k1 = j1 + m2;
+      SwapComplex(a, j1, k1);
+    }
+  } else {
+    for (k = 1; k < m; k++) {
+      for (j = 0; j < k; j++) {
+        j1 = 2 * j + ip[k];
+        k1 = 2 * k + ip[j];
+        SwapComplex(a, j1, k1);
+        j1 += m2;
+        k1 += m2;
+        SwapComplex(a, j1, k1);
+      }
+    }
+  }
+}
+
+void cft1st(size_t n, Lanes* a, const float* w) {
+  const float wk1r = w[2];
+  for (size_t i = 0; i < kNumLanes; ++i) {
+    float x0r = a[0][i] + a[2][i];
+    float x0i = a[1][i] + a[3][i];
+    float x1r = a[0][i] - a[2][i];
+    float x1i = a[1][i] - a[3][i];
+    float x2r = a[4][i] + a[6][i];
+    float x2i = a[5][i] + a[7][i];
+    float x3r = a[4][i] - a[6][i];
+    float x3i = a[5][i] - a[7][i];
+    a[0][i] = x0r + x2r;
+    a[1][i] = x0i + x2i;
+    a[4][i] = x0r - x2r;
+    a[5][i] = x0i - x2i;
+    a[2][i] = x1r - x3i;
+    a[3][i] = x1i + x3r;
+    a[6][i] = x1r + x3i;
+    a[7][i] = x1i - x3r;
+    x0r = a[8][i] + a[10][i];
+    x0i = a[9][i] + a[11][i];
+    x1r = a[8][i] - a[10][i];
+    x1i = a[9][i] - a[11][i];
+    x2r = a[12][i] + a[14][i];
+    x2i = a[13][i] + a[15][i];
+    x3r = a[12][i] - a[14][i];
+    x3i = a[13][i] - a[15][i];
+    a[8][i] = x0r + x2r;
+    a[9][i] = x0i + x2i;
+    a[12][i] = x2i - x0i;
+    a[13][i] = x0r - x2r;
+    x0r = x1r - x3i;
+    x0i = x1i + x3r;
+    a[10][i] = wk1r * (x0r - x0i);
+    a[11][i] = wk1r * (x0r + x0i);
+    x0r = x3i + x1r;
+    x0i = x3r - x1i;
+    a[14][i] = wk1r * (x0i - x0r);
+    a[15][i] = wk1r * (x0i + x0r);
+  }
+  size_t k1 = 0;
+  for (size_t j = 16; j < n; j += 16) {
+    k1 += 2;
+    const size_t k2 = 2 * k1;
+    const float wk2r = w[k1];
+    const float wk2i = w[k1 + 1];
+    float wk1r = w[k2];
+    float wk1i = w[k2 + 1];
+    float wk3r = wk1r - 2 * wk2i * wk1i;
+    float wk3i = 2 * wk2i * wk1r - wk1i;
+    for (size_t i = 0; i < kNumLanes; ++i) {
+      float x0r = a[j][i] + a[j + 2][i];
+      float x0i = a[j + 1][i] + a[j + 3][i];
+      const float x1r = a[j][i] - a[j + 2][i];
+      const float x1i = a[j + 1][i] - a[j + 3][i];
+      const float x2r = a[j + 4][i] + a[j + 6][i];
+      const float x2i = a[j + 5][i] + a[j + 7][i];
+      const float x3r = a[j + 4][i] - a[j + 6][i];
+      const float x3i = a[j + 5][i] - a[j + 7][i];
+      a[j][i] = x0r + x2r;
+      a[j + 1][i] = x0i + x2i;
+      x0r -= x2r;
+      x0i -= x2i;
+      a[j + 4][i] = wk2r * x0r - wk2i * x0i;
+      a[j + 5][i] = wk2r * x0i + wk2i * x0r;
+      x0r = x1r - x3i;
+      x0i = x1i + x3r;
+      a[j + 2][i] = wk1r * x0r - wk1i * x0i;
+      a[j + 3][i] = wk1r * x0i + wk1i * x0r;
+      x0r = x1r + x3i;
+      x0i = x1i - x3r;
+      a[j + 6][i] = wk3r * x0r - wk3i * x0i;
+      a[j + 7][i] = wk3r * x0i + wk3i * x0r;
+    }
+    wk1r = w[k2 + 2];
+    wk1i = w[k2 + 3];
+    wk3r = wk1r - 2 * wk2r * wk1i;
+    wk3i = 2 * wk2r * wk1r - wk1i;
+    for (size_t i = 0; i < kNumLanes; ++i) {
+      float x0r = a[j + 8][i] + a[j + 10][i];
+      float x0i = a[j + 9][i] + a[j + 11][i];
+      const float x1r = a[j + 8][i] - a[j + 10][i];
+      const float x1i = a[j + 9][i] - a[j + 11][i];
+      const float x2r = a[j + 12][i] + a[j + 14][i];
+      const float x2i = a[j + 13][i] + a[j + 15][i];
+      const float x3r = a[j + 12][i] - a[j + 14][i];
+      const float x3i = a[j + 13][i] - a[j + 15][i];
+      a[j + 8][i] = x0r + x2r;
+      a[j + 9][i] = x0i + x2i;
+      x0r -= x2r;
+      x0i -= x2i;
+      a[j + 12][i] = -wk2i * x0r - wk2r * x0i;
+      a[j + 13][i] = -wk2i * x0i + wk2r * x0r;
+      x0r = x1r - x3i;
+      x0i = x1i + x3r;
+      a[j + 10][i] = wk1r * x0r - wk1i * x0i;
+      a[j + 11][i] = wk1r * x0i + wk1i * x0r;
+      x0r = x1r + x3i;
+      x0i = x1i - x3r;
+      a[j + 14][i] = wk3r * x0r - wk3i * x0i;
+      a[j + 15][i] = wk3r * x0i + wk3i * x0r;
+    }
+  }
+}
+
+void cftmdl(size_t n, size_t l, Lanes* a, const float* w) {
+  const size_t m = l << 2;
+  for (size_t j = 0; j < l; j += 2) {
+    const size_t j1 = j + l;
+    const size_t j2 = j1 + l;
+    const size_t j3 = j2 + l;
+    for (size_t i = 0; i < kNumLanes; ++i) {
+      const float x0r = a[j][i] + a[j1][i];
+      const float x0i = a[j + 1][i] + a[j1 + 1][i];
+      const float x1r = a[j][i] - a[j1][i];
+      const float x1i = a[j + 1][i] - a[j1 + 1][i];
+      const float x2r = a[j2][i] + a[j3][i];
+      const float x2i = a[j2 + 1][i] + a[j3 + 1][i];
+      const float x3r = a[j2][i] - a[j3][i];
+      const float x3i = a[j2 + 1][i] - a[j3 + 1][i];
+      a[j][i] = x0r + x2r;
+      a[j + 1][i] = x0i + x2i;
+      a[j2][i] = x0r - x2r;
+      a[j2 + 1][i] = x0i - x2i;
+      a[j1][i] = x1r - x3i;
+      a[j1 + 1][i] = x1i + x3r;
+      a[j3][i] = x1r + x3i;
+      a[j3 + 1][i] = x1i - x3r;
+    }
+  }
+  const float wk1r = w[2];
+  for (size_t j = m; j < l + m; j += 2) {
+    const size_t j1 = j + l;
+    const size_t j2 = j1 + l;
+    const size_t j3 = j2 + l;
+    for (size_t i = 0; i < kNumLanes; ++i) {
+      float x0r = a[j][i] + a[j1][i];
+      float x0i = a[j + 1][i] + a[j1 + 1][i];
+      const float x1r = a[j][i] - a[j1][i];
+      const float x1i = a[j + 1][i] - a[j1 + 1][i];
+      const float x2r = a[j2][i] + a[j3][i];
+      const float x2i = a[j2 + 1][i] + a[j3 + 1][i];
+      const float x3r = a[j2][i] - a[j3][i];
+      const float x3i = a[j2 + 1][i] - a[j3 + 1][i];
+      a[j][i] = x0r + x2r;
+      a[j + 1][i] = x0i + x2i;
+      a[j2][i] = x2i - x0i;
+      a[j2 + 1][i] = x0r - x2r;
+      x0r = x1r - x3i;
+      x0i = x1i + x3r;
+      a[j1][i] = wk1r * (x0r - x0i);
+      a[j1 + 1][i] = wk1r * (x0r + x0i);
+      x0r = x3i + x1r;
+      x0i = x3r - x1i;
+      a[j3][i] = wk1r * (x0i - x0r);
+      a[j3 + 1][i] = wk1r * (x0i + x0r);
+    }
+  }
+  size_t k1 = 0;
+  const size_t m2 = 2 * m;
+  for (size_t k = m2; k < n; k += m2) {
+    k1 += 2;
+    const size_t k2 = 2 * k1;
+    const float wk2r = w[k1];
+    const float wk2i = w[k1 + 1];
+    float wk1r = w[k2];
+    float wk1i = w[k2 + 1];
+    float wk3r = wk1r - 2 * wk2i * wk1i;
+    float wk3i = 2 * wk2i * wk1r - wk1i;
+    for (size_t j = k; j < l + k; j += 2) {
+      const size_t j1 = j + l;
+      const size_t j2 = j1 + l;
+      const size_t j3 = j2 + l;
+      for (size_t i = 0; i < kNumLanes; ++i) {
+        float x0r = a[j][i] + a[j1][i];
+        float x0i = a[j + 1][i] + a[j1 + 1][i];
+        const float x1r = a[j][i] - a[j1][i];
+        const float x1i = a[j + 1][i] - a[j1 + 1][i];
+        const float x2r = a[j2][i] + a[j3][i];
+        const float x2i = a[j2 + 1][i] + a[j3 + 1][i];
+        const float x3r = a[j2][i] - a[j3][i];
+        const float x3i = a[j2 + 1][i] - a[j3 + 1][i];
+        a[j][i] = x0r + x2r;
+        a[j + 1][i] = x0i + x2i;
+        x0r -= x2r;
+        x0i -= x2i;
+        a[j2][i] = wk2r * x0r - wk2i * x0i;
+        a[j2 + 1][i] = wk2r * x0i + wk2i * x0r;
+        x0r = x1r - x3i;
+        x0i = x1i + x3r;
+        a[j1][i] = wk1r * x0r - wk1i * x0i;
+        a[j1 + 1][i] = wk1r * x0i + wk1i * x0r;
+        x0r = x1r + x3i;
+        x0i = x1i - x3r;
+        a[j3][i] = wk3r * x0r - wk3i * x0i;
+        a[j3 + 1][i] = wk3r * x0i + wk3i * x0r;
+      }
+    }
+    wk1r = w[k2 + 2];
+    wk1i = w[k2 + 3];
+    wk3r = wk1r - 2 * wk2r * wk1i;
+    wk3i = 2 * wk2r * wk1r - wk1i;
+    for (size_t j = k + m; j < l + (k + m); j += 2) {
+      const size_t j1 = j + l;
+      const size_t j2 = j1 + l;
+      const size_t j3 = j2 + l;
+      for (size_t i = 0; i < kNumLanes; ++i) {
+        float x0r = a[j][i] + a[j1][i];
+        float x0i = a[j + 1][i] + a[j1 + 1][i];
+        const float x1r = a[j][i] - a[j1][i];
+        const float x1i = a[j + 1][i] - a[j1 + 1][i];
+        const float x2r = a[j2][i] + a[j3][i];
+        const float x2i = a[j2 + 1][i] + a[j3 + 1][i];
+        const float x3r = a[j2][i] - a[j3][i];
+        const float x3i = a[j2 + 1][i] - a[j3 + 1][i];
+        a[j][i] = x0r + x2r;
+        a[j + 1][i] = x0i + x2i;
+        x0r -= x2r;
+        x0i -= x2i;
+        a[j2][i] = -wk2i * x0r - wk2r * x0i;
+        a[j2 + 1][i] = -wk2i * x0i + wk2r * x0r;
+        x0r = x1r - x3i;
+        x0i = x1i + x3r;
+        a[j1][i] = wk1r * x0r - wk1i * x0i;
+        a[j1 + 1][i] = wk1r * x0i + wk1i * x0r;
+        x0r = x1r + x3i;
+        x0i = x1i - x3r;
+        a[j3][i] = wk3r * x0r - wk3i * x0i;
+        a[j3 + 1][i] = wk3r * x0i + wk3i * x0r;
+      }
+    }
+  }
+}
+
+// Runs the stages that cftfsub and cftbsub share, and returns the span of the
+// last stage, which they run each in their own way.
+size_t RunFirstStages(size_t n, Lanes* a, const float* w) {
+  size_t l = 2;
+  if (n > 8) {
+    cft1st(n, a, w);
+    l = 8;
+    while ((l << 2) < n) {
+      cftmdl(n, l, a, w);
+      l <<= 2;
+    }
+  }
+  return l;
+}
+
+void cftfsub(size_t n, Lanes* a, const float* w) {
+  const size_t l = RunFirstStages(n, a, w);
+  if ((l << 2) == n) {
+    for (size_t j = 0; j < l; j += 2) {
+      const size_t j1 = j + l;
+      const size_t j2 = j1 + l;
+      const size_t j3 = j2 + l;
+      for (size_t i = 0; i < kNumLanes; ++i) {
+        const float x0r = a[j][i] + a[j1][i];
+        const float x0i = a[j + 1][i] + a[j1 + 1][i];
+        const float x1r = a[j][i] - a[j1][i];
+        const float x1i = a[j + 1][i] - a[j1 + 1][i];
+        const float x2r = a[j2][i] + a[j3][i];
+        const float x2i = a[j2 + 1][i] + a[j3 + 1][i];
+        const float x3r = a[j2][i] - a[j3][i];
+        const float x3i = a[j2 + 1][i] - a[j3 + 1][i];
+        a[j][i] = x0r + x2r;
+        a[j + 1][i] = x0i + x2i;
+        a[j2][i] = x0r - x2r;
+        a[j2 + 1][i] = x0i - x2i;
+        a[j1][i] = x1r - x3i;
+        a[j1 + 1][i] = x1i + x3r;
+        a[j3][i] = x1r + x3i;
+        a[j3 + 1][i] = x1i - x3r;
+      }
+    }
+  } else {
+    for (size_t j = 0; j < l; j += 2) {
+      const size_t j1 = j + l;
+      for (size_t i = 0; i < kNumLanes; ++i) {
+        const float x0r = a[j][i] - a[j1][i];
+        const float x0i = a[j + 1][i] - a[j1 + 1][i];
+        a[j][i] += a[j1][i];
+        a[j + 1][i] += a[j1 + 1][i];
+        a[j1][i] = x0r;
+        a[j1 + 1][i] = x0i;
+      }
+    }
+  }
+}
+
+void cftbsub(size_t n, Lanes* a, const float* w) {
+  const size_t l = RunFirstStages(n, a, w);
+  if ((l << 2) == n) {
+    for (size_t j = 0; j < l; j += 2) {
+      const size_t j1 = j + l;
+      const size_t j2 = j1 + l;
+      const size_t j3 = j2 + l;
+      for (size_t i = 0; i < kNumLanes; ++i) {
+        const float x0r = a[j][i] + a[j1][i];
+        const float x0i = -a[j + 1][i] - a[j1 + 1][i];
+        const float x1r = a[j][i] - a[j1][i];
+        const float x1i = -a[j + 1][i] + a[j1 + 1][i];
+        const float x2r = a[j2][i] + a[j3][i];
+        const float x2i = a[j2 + 1][i] + a[j3 + 1][i];
+        const float x3r = a[j2][i] - a[j3][i];
+        const float x3i = a[j2 + 1][i] - a[j3 + 1][i];
+        a[j][i] = x0r + x2r;
+        a[j + 1][i] = x0i - x2i;
+        a[j2][i] = x0r - x2r;
+        a[j2 + 1][i] = x0i + x2i;
+        a[j1][i] = x1r - x3i;
+        a[j1 + 1][i] = x1i - x3r;
+        a[j3][i] = x1r + x3i;
+        a[j3 + 1][i] = x1i + x3r;
+      }
+    }
+  } else {
+    for (size_t j = 0; j < l; j += 2) {
+      const size_t j1 = j + l;
+      for (size_t i = 0; i < kNumLanes; ++i) {
+        const float x0r = a[j][i] - a[j1][i];
+        const float x0i = -a[j + 1][i] + a[j1 + 1][i];
+        a[j][i] += a[j1][i];
+        a[j + 1][i] = -a[j + 1][i] - a[j1 + 1][i];
+        a[j1][i] = x0r;
+        a[j1 + 1][i] = x0i;
+      }
+    }
+  }
+}
+
+void rftfsub(size_t n, Lanes* a, size_t nc, const float* c) {
+  const size_t m = n >> 1;
+  const size_t ks = 2 * nc / m;
+  size_t kk = 0;
+  for (size_t j = 2; j < m; j += 2) {
+    const size_t k = n - j;
+    kk += ks;
+    const float wkr = 0.5f - c[nc - kk];
+    const float wki = c[kk];
+    for (size_t i = 0; i < kNumLanes; ++i) {
+      const float xr = a[j][i] - a[k][i];
+      const float xi = a[j + 1][i] + a[k + 1][i];
+      const float yr = wkr * xr - wki * xi;
+      const float yi = wkr * xi + wki * xr;
+      a[j][i] -= yr;
+      a[j + 1][i] -= yi;
+      a[k][i] += yr;
+      a[k + 1][i] -= yi;
+    }
+  }
+}
+
+void rftbsub(size_t n, Lanes* a, size_t nc, const float* c) {
+  for (size_t i = 0; i < kNumLanes; ++i) {
+    a[1][i] = -a[1][i];
+  }
+  const size_t m = n >> 1;
+  const size_t ks = 2 * nc / m;
+  size_t kk = 0;
+  for (size_t j = 2; j < m; j += 2) {
+    const size_t k = n - j;
+    kk += ks;
+    const float wkr = 0.5f - c[nc - kk];
+    const float wki = c[kk];
+    for (size_t i = 0; i < kNumLanes; ++i) {
+      const float xr = a[j][i] - a[k][i];
+      const float xi = a[j + 1][i] + a[k + 1][i];
+      const float yr = wkr * xr + wki * xi;
+      const float yi = wkr * xi - wki * xr;
+      a[j][i] -= yr;
+      a[j + 1][i] = yi - a[j + 1][i];
+      a[k][i] += yr;
+      a[k + 1][i] = yi - a[k + 1][i];
+    }
+  }
+  for (size_t i = 0; i < kNumLanes; ++i) {
+    a[m + 1][i] = -a[m + 1][i];
+  }
+}
+
+}  // namespace
+
+BatchedNrFft::BatchedNrFft()
+    : bit_reversal_state_(kFftSize / 2),
+      tables_(kFftSize / 2),
+      time_data_(kFftSize * kNumLanes, 0.f),
+      real_(kFftSizeBy2Plus1 * kNumLanes, 0.f),
+      imag_(kFftSizeBy2Plus1 * kNumLanes, 0.f) {
+  // Computes the tables as NrFft does.
+  bit_reversal_state_[0] = 0;
+  std::array<float, kFftSize> tmp_buffer;
+  tmp_buffer.fill(0.f);
+  WebRtc_rdft(kFftSize, 1, tmp_buffer.data(), bit_reversal_state_.data(),
+              tables_.data());
+}
+
+void BatchedNrFft::Fft() {
+  Lanes* a = reinterpret_cast<Lanes*>(time_data_.data());
+  const size_t nw = bit_reversal_state_[0];
+  const size_t nc = bit_reversal_state_[1];
+  bitrv2(kFftSize, bit_reversal_state_.data() + 2, a);
+  cftfsub(kFftSize, a, tables_.data());
+  rftfsub(kFftSize, a, nc, tables_.data() + nw);
+
+  Lanes* real = reinterpret_cast<Lanes*>(real_.data());
+  Lanes* imag = reinterpret_cast<Lanes*>(imag_.data());
+  for (size_t i = 0; i < kNumLanes; ++i) {
+    const float xi = a[0][i] - a[1][i];
+    real[0][i] = a[0][i] + a[1][i];
+    imag[0][i] = 0.f;
+    real[kFftSizeBy2Plus1 - 1][i] = xi;
+    imag[kFftSizeBy2Plus1 - 1][i] = 0.f;
+  }
+  for (size_t k = 1; k < kFftSizeBy2Plus1 - 1; ++k) {
+    std::copy(a[2 * k], a[2 * k] + kNumLanes, real[k]);
+    std::copy(a[2 * k + 1], a[2 * k + 1] + kNumLanes, imag[k]);
+  }
+}
+
+void BatchedNrFft::Ifft() {
+  Lanes* a = reinterpret_cast<Lanes*>(time_data_.data());
+  const Lanes* real = reinterpret_cast<const Lanes*>(real_.data());
+  const Lanes* imag = reinterpret_cast<const Lanes*>(imag_.data());
+  for (size_t i = 0; i < kNumLanes; ++i) {
+    a[1][i] = 0.5f * (real[0][i] - real[kFftSizeBy2Plus1 - 1][i]);
+    a[0][i] = real[0][i] - a[1][i];
+  }
+  for (size_t k = 1; k < kFftSizeBy2Plus1 - 1; ++k) {
+    std::copy(real[k], real[k] + kNumLanes, a[2 * k]);
+    std::copy(imag[k], imag[k] + kNumLanes, a[2 * k + 1]);
+  }
+
+  const size_t nw = bit_reversal_state_[0];
+  const size_t nc = bit_reversal_state_[1];
+  rftbsub(kFftSize, a, nc, tables_.data() + nw);
+  bitrv2(kFftSize, bit_reversal_state_.data() + 2, a);
+  cftbsub(kFftSize, a, tables_.data());
+
+  // Scale the output as NrFft does.
+  constexpr float kScaling = 2.f / kFftSize;
+  for (float& d : time_data_) {
+    d *= kScaling;
+  }
+}
+
+}  // namespace webrtc
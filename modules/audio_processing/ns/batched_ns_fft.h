@@ -0,0 +1,68 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_BATCHED_NS_FFT_H_
+#define MODULES_AUDIO_PROCESSING_NS_BATCHED_NS_FFT_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/ns/ns_common.h"
+
+namespace webrtc {
+
+// Computes the transforms of NrFft for kNumLanes signals at once, with the
+// signals in the SIMD lanes. Runs the same operations as NrFft on each signal,
+// so the results are those of NrFft.
+//
+// The buffers hold element k of the signal, or spectrum, of lane l at index
+// k * kNumLanes + l.
+class BatchedNrFft {
+ public:
+  static constexpr size_t kNumLanes = 16;
+
+  BatchedNrFft();
+  BatchedNrFft(const BatchedNrFft&) = delete;
+  BatchedNrFft& operator=(const BatchedNrFft&) = delete;
+
+  // Transforms the signals in `time_data()` to the spectra in `real()` and
+  // `imag()`. Overwrites `time_data()`.
+  void Fft();
+
+  // Transforms the spectra in `real()` and `imag()` to the signals in
+  // `time_data()`.
+  void Ifft();
+
+  rtc::ArrayView<float, kFftSize * kNumLanes> time_data() {
+    return rtc::ArrayView<float, kFftSize * kNumLanes>(time_data_.data(),
+                                                       time_data_.size());
+  }
+  rtc::ArrayView<float, kFftSizeBy2Plus1 * kNumLanes> real() {
+    return rtc::ArrayView<float, kFftSizeBy2Plus1 * kNumLanes>(real_.data(),
+                                                               real_.size());
+  }
+  rtc::ArrayView<float, kFftSizeBy2Plus1 * kNumLanes> imag() {
+    return rtc::ArrayView<float, kFftSizeBy2Plus1 * kNumLanes>(imag_.data(),
+                                                               imag_.size());
+  }
+
+ private:
+  std::vector<size_t> bit_reversal_state_;
+  std::vector<float> tables_;
+  std::vector<float> time_data_;
+  std::vector<float> real_;
+  std::vector<float> imag_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_BATCHED_NS_FFT_H_
@@ -18,10 +18,6 @@
 
 #include "modules/audio_processing/ns/fast_math.h"
 #include "rtc_base/checks.h"
-#include "rnnoise/include/rnnoise.h"
-
-#define FRAME_SIZE 480
-#define SLIDING_WINDOW_SIZE 120
 
 namespace webrtc {
 
@@ -123,6 +119,39 @@ void DelaySignal(rtc::ArrayView<const float, kNsFrameSize> frame,
             delay_buffer.begin());
 }
 
+// Delays `frame` in place by `kRnnoiseDelay` samples.
+void DelayByRnnoiseDelay(rtc::ArrayView<float, kNsFrameSize> frame,
+                         rtc::ArrayView<float, kRnnoiseDelay> delay_buffer) {
+  std::array<float, kRnnoiseDelay + kNsFrameSize> signal;
+  std::copy(delay_buffer.begin(), delay_buffer.end(), signal.begin());
+  std::copy(frame.begin(), frame.end(), signal.begin() + kRnnoiseDelay);
+  std::copy(signal.begin(), signal.begin() + kNsFrameSize, frame.begin());
+  std::copy(signal.begin() + kNsFrameSize, signal.end(), delay_buffer.begin());
+}
+
+// RNNoise lazily initializes the tables shared by all its states when the
+// first frame is processed. Processes a frame before any suppressor does so
+// that suppressors on different threads do not race on the initialization.
+void InitializeRnnoiseTables() {
+  [[maybe_unused]] static const bool initialized = [] {
+    DenoiseState* state = rnnoise_create(nullptr);
+    std::array<float, kRnnoiseFrameSize> frame;
+    frame.fill(0.f);
+    rnnoise_process_frame(state, frame.data(), frame.data());
+    rnnoise_destroy(state);
+    return true;
+  }();
+}
+
+// Computes the energy of a frame.
+float ComputeEnergy(rtc::ArrayView<const float> x) {
+  float energy = 0.f;
+  for (float x_k : x) {
+    energy += x_k * x_k;
+  }
+  return energy;
+}
+
 // Computes the energy of an extended frame.
 float ComputeEnergyOfExtendedFrame(rtc::ArrayView<const float, kFftSize> x) {
   float energy = 0.f;
@@ -257,20 +286,40 @@ NoiseSuppressor::ChannelState::ChannelState(
   }
 }
 
+NoiseSuppressor::RnnoiseChannelState::RnnoiseChannelState(size_t num_bands)
+    : denoise_state(rnnoise_create(nullptr)),
+      upsampler(kNsFrameSize, kRnnoiseFrameSize),
+      downsampler(kRnnoiseFrameSize, kNsFrameSize),
+      upper_band_delay_memory(num_bands > 1 ? num_bands - 1 : 0) {
+  input_delay_memory.fill(0.f);
+  for (auto& d : upper_band_delay_memory) {
+    d.fill(0.f);
+  }
+}
+
 NoiseSuppressor::NoiseSuppressor(const NsConfig& config,
                                  size_t sample_rate_hz,
                                  size_t num_channels)
-    : num_bands_(NumBandsForRate(sample_rate_hz)),
+    : mode_(config.mode),
+      num_bands_(NumBandsForRate(sample_rate_hz)),
       num_channels_(num_channels),
       suppression_params_(config.target_level),
       filter_bank_states_heap_(NumChannelsOnHeap(num_channels_)),
       upper_band_gains_heap_(NumChannelsOnHeap(num_channels_)),
       energies_before_filtering_heap_(NumChannelsOnHeap(num_channels_)),
-      gain_adjustments_heap_(NumChannelsOnHeap(num_channels_)),
-      channels_(num_channels_) {
+      gain_adjustments_heap_(NumChannelsOnHeap(num_channels_)) {
+  if (mode_ == NsConfig::Mode::kRnnoise) {
+    InitializeRnnoiseTables();
+    for (size_t ch = 0; ch < num_channels_; ++ch) {
+      rnnoise_channels_.push_back(
+          std::make_unique<RnnoiseChannelState>(num_bands_));
+    }
+    return;
+  }
+
   for (size_t ch = 0; ch < num_channels_; ++ch) {
-    channels_[ch] =
-        std::make_unique<ChannelState>(suppression_params_, num_bands_);
+    channels_.push_back(
+        std::make_unique<ChannelState>(suppression_params_, num_bands_));
   }
 }
 
@@ -291,6 +340,71 @@ void NoiseSuppressor::AggregateWienerFilters(
 }
 
 void NoiseSuppressor::Analyze(const AudioBuffer& audio) {
+  if (mode_ == NsConfig::Mode::kRnnoise || !PrepareAnalysis(audio)) {
+    return;
+  }
+
+  // Analyze all channels.
+  for (size_t ch = 0; ch < num_channels_; ++ch) {
+    // Form an extended frame and apply analysis filter bank windowing.
+    std::array<float, kFftSize> extended_frame;
+    FormAnalysisFrame(ch, audio, extended_frame);
+
+    // Compute the spectrum and analyze it.
+    std::array<float, kFftSize> real;
+    std::array<float, kFftSize> imag;
+    fft_.Fft(extended_frame, real, imag);
+    AnalyzeSpectrum(ch, real, imag);
+  }
+}
+
+void NoiseSuppressor::AnalyzeBatch(
+    rtc::ArrayView<NoiseSuppressor* const> suppressors,
+    rtc::ArrayView<const AudioBuffer* const> audio,
+    BatchedNrFft& fft) {
+  constexpr size_t kNumLanes = BatchedNrFft::kNumLanes;
+  RTC_DCHECK_LE(suppressors.size(), kNumLanes);
+  RTC_DCHECK_EQ(suppressors.size(), audio.size());
+
+  // Form the extended frames of the suppressors to analyze in the lanes of
+  // `fft`.
+  std::array<bool, kNumLanes> analyze;
+  analyze.fill(false);
+  rtc::ArrayView<float, kFftSize * kNumLanes> time_data = fft.time_data();
+  for (size_t l = 0; l < kNumLanes; ++l) {
+    std::array<float, kFftSize> extended_frame;
+    extended_frame.fill(0.f);
+    if (l < suppressors.size()) {
+      NoiseSuppressor& suppressor = *suppressors[l];
+      RTC_DCHECK_EQ(suppressor.num_channels_, 1);
+      analyze[l] = suppressor.mode_ == NsConfig::Mode::kClassic &&
+                   suppressor.PrepareAnalysis(*audio[l]);
+      if (analyze[l]) {
+        suppressor.FormAnalysisFrame(/*ch=*/0, *audio[l], extended_frame);
+      }
+    }
+    for (size_t k = 0; k < kFftSize; ++k) {
+      time_data[k * kNumLanes + l] = extended_frame[k];
+    }
+  }
+
+  fft.Fft();
+
+  for (size_t l = 0; l < suppressors.size(); ++l) {
+    if (!analyze[l]) {
+      continue;
+    }
+    std::array<float, kFftSize> real;
+    std::array<float, kFftSize> imag;
+    for (size_t k = 0; k < kFftSizeBy2Plus1; ++k) {
+      real[k] = fft.real()[k * kNumLanes + l];
+      imag[k] = fft.imag()[k * kNumLanes + l];
+    }
+    suppressors[l]->AnalyzeSpectrum(/*ch=*/0, real, imag);
+  }
+}
+
+bool NoiseSuppressor::PrepareAnalysis(const AudioBuffer& audio) {
   // Prepare the noise estimator for the analysis stage.
   for (size_t ch = 0; ch < num_channels_; ++ch) {
     channels_[ch]->noise_estimator.PrepareAnalysis();
@@ -318,121 +432,80 @@ void NoiseSuppressor::Analyze(const AudioBuffer& audio) {
     // Depending on the duration of the inactive signal it takes a
     // considerable amount of time for the system to learn what is noise and
     // what is speech.
-    return;
+    return false;
   }
 
   // Only update analysis counter for frames that are properly analyzed.
   if (++num_analyzed_frames_ < 0) {
     num_analyzed_frames_ = 0;
   }
+  return true;
+}
 
-  // Analyze all channels.
-  for (size_t ch = 0; ch < num_channels_; ++ch) {
-    std::unique_ptr<ChannelState>& ch_p = channels_[ch];
-    rtc::ArrayView<const float, kNsFrameSize> y_band0(
-        &audio.split_bands_const(ch)[0][0], kNsFrameSize);
-
-    // Form an extended frame and apply analysis filter bank windowing.
-    std::array<float, kFftSize> extended_frame;
-    FormExtendedFrame(y_band0, ch_p->analyze_analysis_memory, extended_frame);
-    ApplyFilterBankWindow(extended_frame);
-
-    // Compute the magnitude spectrum.
-    std::array<float, kFftSize> real;
-    std::array<float, kFftSize> imag;
-    fft_.Fft(extended_frame, real, imag);
-
-    std::array<float, kFftSizeBy2Plus1> signal_spectrum;
-    ComputeMagnitudeSpectrum(real, imag, signal_spectrum);
-
-    // Compute energies.
-    float signal_energy = 0.f;
-    for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
-      signal_energy += real[i] * real[i] + imag[i] * imag[i];
-    }
-    signal_energy /= kFftSizeBy2Plus1;
-
-    float signal_spectral_sum = 0.f;
-    for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
-      signal_spectral_sum += signal_spectrum[i];
-    }
-
-    // Estimate the noise spectra and the probability estimates of speech
-    // presence.
-    ch_p->noise_estimator.PreUpdate(num_analyzed_frames_, signal_spectrum,
-                                    signal_spectral_sum);
+void NoiseSuppressor::FormAnalysisFrame(
+    size_t ch,
+    const AudioBuffer& audio,
+    rtc::ArrayView<float, kFftSize> extended_frame) {
+  rtc::ArrayView<const float, kNsFrameSize> y_band0(
+      &audio.split_bands_const(ch)[0][0], kNsFrameSize);
+  FormExtendedFrame(y_band0, channels_[ch]->analyze_analysis_memory,
+                    extended_frame);
+  ApplyFilterBankWindow(extended_frame);
+}
 
-    std::array<float, kFftSizeBy2Plus1> post_snr;
-    std::array<float, kFftSizeBy2Plus1> prior_snr;
-    ComputeSnr(ch_p->wiener_filter.get_filter(),
-               ch_p->prev_analysis_signal_spectrum, signal_spectrum,
-               ch_p->noise_estimator.get_prev_noise_spectrum(),
-               ch_p->noise_estimator.get_noise_spectrum(), prior_snr, post_snr);
+void NoiseSuppressor::AnalyzeSpectrum(
+    size_t ch,
+    rtc::ArrayView<const float, kFftSize> real,
+    rtc::ArrayView<const float, kFftSize> imag) {
+  std::unique_ptr<ChannelState>& ch_p = channels_[ch];
 
-    ch_p->speech_probability_estimator.Update(
-        num_analyzed_frames_, prior_snr, post_snr,
-        ch_p->noise_estimator.get_conservative_noise_spectrum(),
-        signal_spectrum, signal_spectral_sum, signal_energy);
+  // Compute the magnitude spectrum.
+  std::array<float, kFftSizeBy2Plus1> signal_spectrum;
+  ComputeMagnitudeSpectrum(real, imag, signal_spectrum);
 
-    ch_p->noise_estimator.PostUpdate(
-        ch_p->speech_probability_estimator.get_probability(), signal_spectrum);
+  // Compute energies.
+  float signal_energy = 0.f;
+  for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+    signal_energy += real[i] * real[i] + imag[i] * imag[i];
+  }
+  signal_energy /= kFftSizeBy2Plus1;
 
-    // Store the magnitude spectrum to make it avalilable for the process
-    // method.
-    std::copy(signal_spectrum.begin(), signal_spectrum.end(),
-              ch_p->prev_analysis_signal_spectrum.begin());
+  float signal_spectral_sum = 0.f;
+  for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+    signal_spectral_sum += signal_spectrum[i];
   }
+
+  // Estimate the noise spectra and the probability estimates of speech
+  // presence.
+  ch_p->noise_estimator.PreUpdate(num_analyzed_frames_, signal_spectrum,
+                                  signal_spectral_sum);
+
+  std::array<float, kFftSizeBy2Plus1> post_snr;
+  std::array<float, kFftSizeBy2Plus1> prior_snr;
+  ComputeSnr(ch_p->wiener_filter.get_filter(),
+             ch_p->prev_analysis_signal_spectrum, signal_spectrum,
+             ch_p->noise_estimator.get_prev_noise_spectrum(),
+             ch_p->noise_estimator.get_noise_spectrum(), prior_snr, post_snr);
+
+  ch_p->speech_probability_estimator.Update(
+      num_analyzed_frames_, prior_snr, post_snr,
+      ch_p->noise_estimator.get_conservative_noise_spectrum(), signal_spectrum,
+      signal_spectral_sum, signal_energy);
+
+  ch_p->noise_estimator.PostUpdate(
+      ch_p->speech_probability_estimator.get_probability(), signal_spectrum);
+
+  // Store the magnitude spectrum to make it avalilable for the process
+  // method.
+  std::copy(signal_spectrum.begin(), signal_spectrum.end(),
+            ch_p->prev_analysis_signal_spectrum.begin());
 }
 
 void NoiseSuppressor::Process(AudioBuffer* audio) {
-  // // Create RNNoise state
-  // DenoiseState *st;
-  // st = rnnoise_create(NULL);
-
-  // // Process each channel in the audio buffer
-  // for (size_t ch = 0; ch < num_channels_; ++ch) {
-  //   // Create a temporary buffer to hold the current frame
-  //   float x[FRAME_SIZE];
-  //   float y[FRAME_SIZE];
-
-  //   size_t num_frames = audio->num_frames();
-
-  //   // Process each sliding window
-  //   for (size_t window_start = 0; window_start < num_frames * FRAME_SIZE;
-  //        window_start += SLIDING_WINDOW_SIZE) {
-  //     // size_t window_end = std::min(window_start + FRAME_SIZE, num_frames * FRAME_SIZE);
-  //     size_t frame_idx = window_start / FRAME_SIZE;
-
-  //     if (frame_idx >= num_frames) {
-  //       break;
-  //     }
-
-  //     // Copy the current frame to the input buffer for RNNoise
-  //     for (size_t i = 0; i < FRAME_SIZE; ++i) {
-  //       size_t sample_idx = frame_idx * FRAME_SIZE + i;
-  //       if (sample_idx < num_frames * FRAME_SIZE) {
-  //         x[i] = audio->split_bands(ch)[0][sample_idx];
-  //       } else {
-  //         // Zero-pad if we reach the end of the audio buffer
-  //         x[i] = 0.0f;
-  //       }
-  //     }
-
-  //     // Process the frame with RNNoise
-  //     rnnoise_process_frame(st, x, y);
-
-  //     // Copy the denoised frame back to the audio buffer
-  //     for (size_t i = 0; i < FRAME_SIZE; ++i) {
-  //       size_t sample_idx = frame_idx * FRAME_SIZE + i;
-  //       if (sample_idx < num_frames * FRAME_SIZE) {
-  //         audio->split_bands(ch)[0][sample_idx] = y[i];
-  //       }
-  //     }
-  //   }
-  // }
-
-  // // Clean up RNNoise state
-  // rnnoise_destroy(st);
+  if (mode_ == NsConfig::Mode::kRnnoise) {
+    ProcessWithRnnoise(audio);
+    return;
+  }
 
   // Select the space for storing data during the processing.
   std::array<FilterBankState, kMaxNumChannelsOnStack> filter_bank_states_stack;
@@ -463,43 +536,14 @@ void NoiseSuppressor::Process(AudioBuffer* audio) {
   // Compute the suppression filters for all channels.
   for (size_t ch = 0; ch < num_channels_; ++ch) {
     // Form an extended frame and apply analysis filter bank windowing.
-    rtc::ArrayView<float, kNsFrameSize> y_band0(&audio->split_bands(ch)[0][0],
-                                                kNsFrameSize);
-
-    FormExtendedFrame(y_band0, channels_[ch]->process_analysis_memory,
-                      filter_bank_states[ch].extended_frame);
-
-    ApplyFilterBankWindow(filter_bank_states[ch].extended_frame);
-
-    energies_before_filtering[ch] =
-        ComputeEnergyOfExtendedFrame(filter_bank_states[ch].extended_frame);
+    energies_before_filtering[ch] = FormProcessingFrame(
+        ch, *audio, filter_bank_states[ch].extended_frame);
 
-    // Perform filter bank analysis and compute the magnitude spectrum.
+    // Perform filter bank analysis and compute the filters.
     fft_.Fft(filter_bank_states[ch].extended_frame, filter_bank_states[ch].real,
              filter_bank_states[ch].imag);
-
-    std::array<float, kFftSizeBy2Plus1> signal_spectrum;
-    ComputeMagnitudeSpectrum(filter_bank_states[ch].real,
-                             filter_bank_states[ch].imag, signal_spectrum);
-
-    // Compute the frequency domain gain filter for noise attenuation.
-    channels_[ch]->wiener_filter.Update(
-        num_analyzed_frames_,
-        channels_[ch]->noise_estimator.get_noise_spectrum(),
-        channels_[ch]->noise_estimator.get_prev_noise_spectrum(),
-        channels_[ch]->noise_estimator.get_parametric_noise_spectrum(),
-        signal_spectrum);
-
-    if (num_bands_ > 1) {
-      // Compute the time-domain gain for attenuating the noise in the upper
-      // bands.
-
-      upper_band_gains[ch] = ComputeUpperBandsGain(
-          suppression_params_.minimum_attenuating_gain,
-          channels_[ch]->wiener_filter.get_filter(),
-          channels_[ch]->speech_probability_estimator.get_probability(),
-          channels_[ch]->prev_analysis_signal_spectrum, signal_spectrum);
-    }
+    upper_band_gains[ch] = UpdateSuppressionFilter(
+        ch, filter_bank_states[ch].real, filter_bank_states[ch].imag);
   }
 
   // Only do the below processing if the output of the audio processing module
@@ -532,40 +576,251 @@ void NoiseSuppressor::Process(AudioBuffer* audio) {
   }
 
   for (size_t ch = 0; ch < num_channels_; ++ch) {
-    const float energy_after_filtering =
-        ComputeEnergyOfExtendedFrame(filter_bank_states[ch].extended_frame);
-
-    // Apply synthesis window.
-    ApplyFilterBankWindow(filter_bank_states[ch].extended_frame);
-
-    // Compute the adjustment of the noise attenuation filter based on the
-    // effect of the attenuation.
     gain_adjustments[ch] =
-        channels_[ch]->wiener_filter.ComputeOverallScalingFactor(
-            num_analyzed_frames_,
-            channels_[ch]->speech_probability_estimator.get_prior_probability(),
-            energies_before_filtering[ch], energy_after_filtering);
+        ComputeGainAdjustment(ch, energies_before_filtering[ch],
+                              filter_bank_states[ch].extended_frame);
   }
 
-  // Select and apply adjustment of the noise attenuation filter based on the
-  // effect of the attenuation.
+  // Select the adjustment of the noise attenuation filter and the noise
+  // attenuating gain to apply to the upper band.
   float gain_adjustment = gain_adjustments[0];
+  float upper_band_gain = upper_band_gains[0];
   for (size_t ch = 1; ch < num_channels_; ++ch) {
     gain_adjustment = std::min(gain_adjustment, gain_adjustments[ch]);
+    upper_band_gain = std::min(upper_band_gain, upper_band_gains[ch]);
   }
+
   for (size_t ch = 0; ch < num_channels_; ++ch) {
-    for (size_t i = 0; i < kFftSize; ++i) {
-      filter_bank_states[ch].extended_frame[i] =
-          gain_adjustment * filter_bank_states[ch].extended_frame[i];
+    SynthesizeOutput(ch, gain_adjustment, upper_band_gain,
+                     filter_bank_states[ch].extended_frame, audio);
+  }
+}
+
+void NoiseSuppressor::ProcessBatch(
+    rtc::ArrayView<NoiseSuppressor* const> suppressors,
+    rtc::ArrayView<AudioBuffer* const> audio,
+    BatchedNrFft& fft) {
+  constexpr size_t kNumLanes = BatchedNrFft::kNumLanes;
+  RTC_DCHECK_LE(suppressors.size(), kNumLanes);
+  RTC_DCHECK_EQ(suppressors.size(), audio.size());
+
+  // Form the extended frames of the suppressors in the classic mode in the
+  // lanes of `fft`.
+  std::array<bool, kNumLanes> process;
+  process.fill(false);
+  std::array<float, kNumLanes> energies_before_filtering;
+  rtc::ArrayView<float, kFftSize * kNumLanes> time_data = fft.time_data();
+  for (size_t l = 0; l < kNumLanes; ++l) {
+    std::array<float, kFftSize> extended_frame;
+    extended_frame.fill(0.f);
+    if (l < suppressors.size()) {
+      NoiseSuppressor& suppressor = *suppressors[l];
+      RTC_DCHECK_EQ(suppressor.num_channels_, 1);
+      if (suppressor.mode_ == NsConfig::Mode::kRnnoise) {
+        suppressor.ProcessWithRnnoise(audio[l]);
+      } else {
+        process[l] = true;
+        energies_before_filtering[l] =
+            suppressor.FormProcessingFrame(/*ch=*/0, *audio[l], extended_frame);
+      }
+    }
+    for (size_t k = 0; k < kFftSize; ++k) {
+      time_data[k * kNumLanes + l] = extended_frame[k];
     }
   }
 
+  fft.Fft();
+
+  // Compute the filters and apply them to the lower band.
+  std::array<float, kNumLanes> upper_band_gains;
+  for (size_t l = 0; l < suppressors.size(); ++l) {
+    if (!process[l]) {
+      continue;
+    }
+    std::array<float, kFftSize> real;
+    std::array<float, kFftSize> imag;
+    for (size_t k = 0; k < kFftSizeBy2Plus1; ++k) {
+      real[k] = fft.real()[k * kNumLanes + l];
+      imag[k] = fft.imag()[k * kNumLanes + l];
+    }
+    NoiseSuppressor& suppressor = *suppressors[l];
+    upper_band_gains[l] =
+        suppressor.UpdateSuppressionFilter(/*ch=*/0, real, imag);
+    process[l] = suppressor.capture_output_used_;
+
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> filter =
+        suppressor.channels_[0]->wiener_filter.get_filter();
+    for (size_t k = 0; k < kFftSizeBy2Plus1; ++k) {
+      fft.real()[k * kNumLanes + l] = real[k] * filter[k];
+      fft.imag()[k * kNumLanes + l] = imag[k] * filter[k];
+    }
+  }
+
+  // Perform filter bank synthesis.
+  fft.Ifft();
+
+  for (size_t l = 0; l < suppressors.size(); ++l) {
+    if (!process[l]) {
+      continue;
+    }
+    std::array<float, kFftSize> extended_frame;
+    for (size_t k = 0; k < kFftSize; ++k) {
+      extended_frame[k] = time_data[k * kNumLanes + l];
+    }
+    NoiseSuppressor& suppressor = *suppressors[l];
+    const float gain_adjustment = suppressor.ComputeGainAdjustment(
+        /*ch=*/0, energies_before_filtering[l], extended_frame);
+    suppressor.SynthesizeOutput(/*ch=*/0, gain_adjustment, upper_band_gains[l],
+                                extended_frame, audio[l]);
+  }
+}
+
+float NoiseSuppressor::FormProcessingFrame(
+    size_t ch,
+    const AudioBuffer& audio,
+    rtc::ArrayView<float, kFftSize> extended_frame) {
+  rtc::ArrayView<const float, kNsFrameSize> y_band0(
+      &audio.split_bands_const(ch)[0][0], kNsFrameSize);
+  FormExtendedFrame(y_band0, channels_[ch]->process_analysis_memory,
+                    extended_frame);
+  ApplyFilterBankWindow(extended_frame);
+  return ComputeEnergyOfExtendedFrame(extended_frame);
+}
+
+float NoiseSuppressor::UpdateSuppressionFilter(
+    size_t ch,
+    rtc::ArrayView<const float, kFftSize> real,
+    rtc::ArrayView<const float, kFftSize> imag) {
+  std::array<float, kFftSizeBy2Plus1> signal_spectrum;
+  ComputeMagnitudeSpectrum(real, imag, signal_spectrum);
+
+  // Compute the frequency domain gain filter for noise attenuation.
+  channels_[ch]->wiener_filter.Update(
+      num_analyzed_frames_, channels_[ch]->noise_estimator.get_noise_spectrum(),
+      channels_[ch]->noise_estimator.get_prev_noise_spectrum(),
+      channels_[ch]->noise_estimator.get_parametric_noise_spectrum(),
+      signal_spectrum);
+
+  if (num_bands_ == 1) {
+    return 1.f;
+  }
+
+  // Compute the time-domain gain for attenuating the noise in the upper
+  // bands.
+  return ComputeUpperBandsGain(
+      suppression_params_.minimum_attenuating_gain,
+      channels_[ch]->wiener_filter.get_filter(),
+      channels_[ch]->speech_probability_estimator.get_probability(),
+      channels_[ch]->prev_analysis_signal_spectrum, signal_spectrum);
+}
+
+float NoiseSuppressor::ComputeGainAdjustment(
+    size_t ch,
+    float energy_before_filtering,
+    rtc::ArrayView<float, kFftSize> extended_frame) const {
+  const float energy_after_filtering =
+      ComputeEnergyOfExtendedFrame(extended_frame);
+
+  // Apply synthesis window.
+  ApplyFilterBankWindow(extended_frame);
+
+  // Compute the adjustment of the noise attenuation filter based on the
+  // effect of the attenuation.
+  return channels_[ch]->wiener_filter.ComputeOverallScalingFactor(
+      num_analyzed_frames_,
+      channels_[ch]->speech_probability_estimator.get_prior_probability(),
+      energy_before_filtering, energy_after_filtering);
+}
+
+void NoiseSuppressor::SynthesizeOutput(
+    size_t ch,
+    float gain_adjustment,
+    float upper_band_gain,
+    rtc::ArrayView<float, kFftSize> extended_frame,
+    AudioBuffer* audio) {
+  // Apply the adjustment of the noise attenuation filter.
+  for (size_t i = 0; i < kFftSize; ++i) {
+    extended_frame[i] = gain_adjustment * extended_frame[i];
+  }
+
   // Use overlap-and-add to form the output frame of the lowest band.
+  rtc::ArrayView<float, kNsFrameSize> y_band0(&audio->split_bands(ch)[0][0],
+                                              kNsFrameSize);
+  OverlapAndAdd(extended_frame, channels_[ch]->process_synthesis_memory,
+                y_band0);
+
+  // Process the upper bands.
+  for (size_t b = 1; b < num_bands_; ++b) {
+    // Delay the upper bands to match the delay of the filterbank applied to
+    // the lowest band.
+    rtc::ArrayView<float, kNsFrameSize> y_band(&audio->split_bands(ch)[b][0],
+                                               kNsFrameSize);
+    std::array<float, kNsFrameSize> delayed_frame;
+    DelaySignal(y_band, channels_[ch]->process_delay_memory[b - 1],
+                delayed_frame);
+
+    // Apply the time-domain noise-attenuating gain.
+    for (size_t j = 0; j < kNsFrameSize; j++) {
+      y_band[j] = upper_band_gain * delayed_frame[j];
+    }
+  }
+
+  // Limit the output the allowed range.
+  for (size_t b = 0; b < num_bands_; ++b) {
+    rtc::ArrayView<float, kNsFrameSize> y_band(&audio->split_bands(ch)[b][0],
+                                               kNsFrameSize);
+    for (size_t j = 0; j < kNsFrameSize; j++) {
+      y_band[j] = std::min(std::max(y_band[j], -32768.f), 32767.f);
+    }
+  }
+}
+
+void NoiseSuppressor::ProcessWithRnnoise(AudioBuffer* audio) {
+  // Only do the processing if the output of the audio processing module is
+  // used.
+  if (!capture_output_used_) {
+    return;
+  }
+
+  std::array<float, kMaxNumChannelsOnStack> upper_band_gains_stack;
+  rtc::ArrayView<float> upper_band_gains(upper_band_gains_stack.data(),
+                                         num_channels_);
+  if (NumChannelsOnHeap(num_channels_) > 0) {
+    upper_band_gains =
+        rtc::ArrayView<float>(upper_band_gains_heap_.data(), num_channels_);
+  }
+
   for (size_t ch = 0; ch < num_channels_; ++ch) {
+    RnnoiseChannelState& channel = *rnnoise_channels_[ch];
     rtc::ArrayView<float, kNsFrameSize> y_band0(&audio->split_bands(ch)[0][0],
                                                 kNsFrameSize);
-    OverlapAndAdd(filter_bank_states[ch].extended_frame,
-                  channels_[ch]->process_synthesis_memory, y_band0);
+
+    // The input aligned with the output, for the energy comparison.
+    std::array<float, kNsFrameSize> delayed_input;
+    std::copy(y_band0.begin(), y_band0.end(), delayed_input.begin());
+    DelayByRnnoiseDelay(delayed_input, channel.input_delay_memory);
+
+    // Suppress the noise of the lowest band at the rate of RNNoise.
+    std::array<float, kRnnoiseFrameSize> frame;
+    channel.upsampler.Resample(y_band0.data(), kNsFrameSize, frame.data(),
+                               kRnnoiseFrameSize);
+    rnnoise_process_frame(channel.denoise_state.get(), frame.data(),
+                          frame.data());
+    channel.downsampler.Resample(frame.data(), kRnnoiseFrameSize,
+                                 y_band0.data(), kNsFrameSize);
+
+    if (num_bands_ > 1) {
+      // Attenuate the upper bands as much as RNNoise attenuated the lowest
+      // band.
+      const float energy_before_filtering = ComputeEnergy(delayed_input);
+      const float energy_after_filtering = ComputeEnergy(y_band0);
+      float gain = 1.f;
+      if (energy_before_filtering > 0.f) {
+        gain = sqrtf(energy_after_filtering / energy_before_filtering);
+      }
+      upper_band_gains[ch] = std::min(
+          std::max(gain, suppression_params_.minimum_attenuating_gain), 1.f);
+    }
   }
 
   if (num_bands_ > 1) {
@@ -575,20 +830,15 @@ void NoiseSuppressor::Process(AudioBuffer* audio) {
       upper_band_gain = std::min(upper_band_gain, upper_band_gains[ch]);
     }
 
-    // Process the upper bands.
     for (size_t ch = 0; ch < num_channels_; ++ch) {
       for (size_t b = 1; b < num_bands_; ++b) {
-        // Delay the upper bands to match the delay of the filterbank applied to
-        // the lowest band.
+        // Delay the upper bands to match the delay of the lowest band.
         rtc::ArrayView<float, kNsFrameSize> y_band(
             &audio->split_bands(ch)[b][0], kNsFrameSize);
-        std::array<float, kNsFrameSize> delayed_frame;
-        DelaySignal(y_band, channels_[ch]->process_delay_memory[b - 1],
-                    delayed_frame);
-
-        // Apply the time-domain noise-attenuating gain.
+        DelayByRnnoiseDelay(
+            y_band, rnnoise_channels_[ch]->upper_band_delay_memory[b - 1]);
         for (size_t j = 0; j < kNsFrameSize; j++) {
-          y_band[j] = upper_band_gain * delayed_frame[j];
+          y_band[j] = upper_band_gain * y_band[j];
         }
       }
     }
@@ -11,15 +11,19 @@
 #ifndef MODULES_AUDIO_PROCESSING_NS_NOISE_SUPPRESSOR_H_
 #define MODULES_AUDIO_PROCESSING_NS_NOISE_SUPPRESSOR_H_
 
+#include <array>
 #include <memory>
 #include <vector>
 
 #include "api/array_view.h"
+#include "common_audio/resampler/push_sinc_resampler.h"
 #include "modules/audio_processing/audio_buffer.h"
+#include "modules/audio_processing/ns/batched_ns_fft.h"
 #include "modules/audio_processing/ns/noise_estimator.h"
 #include "modules/audio_processing/ns/ns_common.h"
 #include "modules/audio_processing/ns/ns_config.h"
 #include "modules/audio_processing/ns/ns_fft.h"
+#include "modules/audio_processing/ns/rnnoise/include/rnnoise.h"
 #include "modules/audio_processing/ns/speech_probability_estimator.h"
 #include "modules/audio_processing/ns/wiener_filter.h"
 
@@ -35,12 +39,23 @@ class NoiseSuppressor {
   NoiseSuppressor& operator=(const NoiseSuppressor&) = delete;
 
   // Analyses the signal (typically applied before the AEC to avoid analyzing
-  // any comfort noise signal).
+  // any comfort noise signal). Does nothing in the RNNoise mode.
   void Analyze(const AudioBuffer& audio);
 
   // Applies noise suppression.
   void Process(AudioBuffer* audio);
 
+  // Run Analyze() and Process(), respectively, of each of the mono
+  // suppressors in `suppressors` on the corresponding buffer in `audio`, with
+  // the same results, computing the FFTs of all the suppressors at once in the
+  // lanes of `fft`. Take at most `BatchedNrFft::kNumLanes` suppressors.
+  static void AnalyzeBatch(rtc::ArrayView<NoiseSuppressor* const> suppressors,
+                           rtc::ArrayView<const AudioBuffer* const> audio,
+                           BatchedNrFft& fft);
+  static void ProcessBatch(rtc::ArrayView<NoiseSuppressor* const> suppressors,
+                           rtc::ArrayView<AudioBuffer* const> audio,
+                           BatchedNrFft& fft);
+
   // Specifies whether the capture output will be used. The purpose of this is
   // to allow the noise suppressor to deactivate some of the processing when the
   // resulting output is anyway not used, for instance when the endpoint is
@@ -50,6 +65,7 @@ class NoiseSuppressor {
   }
 
  private:
+  const NsConfig::Mode mode_;
   const size_t num_bands_;
   const size_t num_channels_;
   const SuppressionParams suppression_params_;
@@ -82,9 +98,74 @@ class NoiseSuppressor {
   std::vector<float> gain_adjustments_heap_;
   std::vector<std::unique_ptr<ChannelState>> channels_;
 
+  struct RnnoiseStateDeleter {
+    void operator()(DenoiseState* state) const { rnnoise_destroy(state); }
+  };
+
+  // State of a channel in the RNNoise mode, which runs RNNoise on the lowest
+  // band resampled to 48 kHz.
+  struct RnnoiseChannelState {
+    explicit RnnoiseChannelState(size_t num_bands);
+
+    std::unique_ptr<DenoiseState, RnnoiseStateDeleter> denoise_state;
+    PushSincResampler upsampler;
+    PushSincResampler downsampler;
+    // Aligns the input of the lowest band with the output of RNNoise, to
+    // compare their energies.
+    std::array<float, kRnnoiseDelay> input_delay_memory;
+    std::vector<std::array<float, kRnnoiseDelay>> upper_band_delay_memory;
+  };
+
+  std::vector<std::unique_ptr<RnnoiseChannelState>> rnnoise_channels_;
+
+  // Prepares the analysis of a frame. Returns false if the frame is not to be
+  // analyzed.
+  bool PrepareAnalysis(const AudioBuffer& audio);
+
+  // Forms the windowed extended frame of channel `ch` to analyze.
+  void FormAnalysisFrame(size_t ch,
+                         const AudioBuffer& audio,
+                         rtc::ArrayView<float, kFftSize> extended_frame);
+
+  // Updates the estimates of channel `ch` with the spectrum of the frame to
+  // analyze.
+  void AnalyzeSpectrum(size_t ch,
+                       rtc::ArrayView<const float, kFftSize> real,
+                       rtc::ArrayView<const float, kFftSize> imag);
+
+  // Forms the windowed extended frame of channel `ch` to process. Returns its
+  // energy.
+  float FormProcessingFrame(size_t ch,
+                            const AudioBuffer& audio,
+                            rtc::ArrayView<float, kFftSize> extended_frame);
+
+  // Updates the Wiener filter of channel `ch` with the spectrum of the frame
+  // to process. Returns the gain for the upper bands.
+  float UpdateSuppressionFilter(size_t ch,
+                                rtc::ArrayView<const float, kFftSize> real,
+                                rtc::ArrayView<const float, kFftSize> imag);
+
+  // Applies the synthesis window to the filtered `extended_frame` of channel
+  // `ch` and returns the adjustment of the noise attenuation filter.
+  float ComputeGainAdjustment(
+      size_t ch,
+      float energy_before_filtering,
+      rtc::ArrayView<float, kFftSize> extended_frame) const;
+
+  // Writes the output of channel `ch` to `audio` from the filtered
+  // `extended_frame` and the gains.
+  void SynthesizeOutput(size_t ch,
+                        float gain_adjustment,
+                        float upper_band_gain,
+                        rtc::ArrayView<float, kFftSize> extended_frame,
+                        AudioBuffer* audio);
+
   // Aggregates the Wiener filters into a single filter to use.
   void AggregateWienerFilters(
       rtc::ArrayView<float, kFftSizeBy2Plus1> filter) const;
+
+  // Applies noise suppression in the RNNoise mode.
+  void ProcessWithRnnoise(AudioBuffer* audio);
 };
 
 }  // namespace webrtc
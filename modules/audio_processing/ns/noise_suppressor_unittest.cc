@@ -16,6 +16,7 @@
 #include <utility>
 #include <vector>
 
+#include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -99,4 +100,152 @@ TEST(NoiseSuppressor, IdenticalChannelEffects) {
   }
 }
 
+// Verifies that the same noise reduction effect is applied to all channels in
+// the RNNoise mode.
+TEST(NoiseSuppressor, IdenticalChannelEffectsWithRnnoise) {
+  for (auto rate : {16000, 32000, 48000}) {
+    for (auto num_channels : {1, 4}) {
+      SCOPED_TRACE(ProduceDebugText(rate, num_channels,
+                                    NsConfig::SuppressionLevel::k12dB));
+      const size_t num_bands = rate / 16000;
+      AudioBuffer audio(rate, num_channels, rate, num_channels, rate,
+                        num_channels);
+      NsConfig cfg;
+      cfg.mode = NsConfig::Mode::kRnnoise;
+      NoiseSuppressor ns(cfg, rate, num_channels);
+      for (size_t frame_index = 0; frame_index < 200; ++frame_index) {
+        if (rate > 16000) {
+          audio.SplitIntoFrequencyBands();
+        }
+
+        PopulateInputFrameWithIdenticalChannels(num_channels, num_bands,
+                                                frame_index, &audio);
+
+        ns.Analyze(audio);
+        ns.Process(&audio);
+        if (num_channels > 1) {
+          VerifyIdenticalChannels(num_channels, num_bands, frame_index, audio);
+        }
+      }
+    }
+  }
+}
+
+// Verifies that processing suppressors in a batch gives the same output as
+// processing them one at a time.
+TEST(NoiseSuppressor, BatchMatchesSeparateProcessing) {
+  constexpr size_t kNumSuppressors = BatchedNrFft::kNumLanes - 3;
+  for (auto rate : {16000, 32000, 48000}) {
+    SCOPED_TRACE(rate);
+    const size_t num_bands = rate / 16000;
+    std::vector<std::unique_ptr<NoiseSuppressor>> separate_suppressors;
+    std::vector<std::unique_ptr<NoiseSuppressor>> batch_suppressors;
+    std::vector<std::unique_ptr<AudioBuffer>> separate_audio;
+    std::vector<std::unique_ptr<AudioBuffer>> batch_audio;
+    for (size_t i = 0; i < kNumSuppressors; ++i) {
+      NsConfig cfg;
+      cfg.target_level = static_cast<NsConfig::SuppressionLevel>(i % 4);
+      separate_suppressors.push_back(
+          std::make_unique<NoiseSuppressor>(cfg, rate, 1));
+      batch_suppressors.push_back(
+          std::make_unique<NoiseSuppressor>(cfg, rate, 1));
+      separate_audio.push_back(
+          std::make_unique<AudioBuffer>(rate, 1, rate, 1, rate, 1));
+      batch_audio.push_back(
+          std::make_unique<AudioBuffer>(rate, 1, rate, 1, rate, 1));
+    }
+    separate_suppressors[1]->SetCaptureOutputUsage(false);
+    batch_suppressors[1]->SetCaptureOutputUsage(false);
+
+    std::vector<NoiseSuppressor*> suppressors;
+    std::vector<AudioBuffer*> audio;
+    for (size_t i = 0; i < kNumSuppressors; ++i) {
+      suppressors.push_back(batch_suppressors[i].get());
+      audio.push_back(batch_audio[i].get());
+    }
+    const std::vector<const AudioBuffer*> const_audio(audio.begin(),
+                                                      audio.end());
+    BatchedNrFft fft;
+    Random random(/*seed=*/42);
+    for (size_t frame_index = 0; frame_index < 300; ++frame_index) {
+      for (size_t i = 0; i < kNumSuppressors; ++i) {
+        if (rate > 16000) {
+          separate_audio[i]->SplitIntoFrequencyBands();
+          batch_audio[i]->SplitIntoFrequencyBands();
+        }
+        for (size_t b = 0; b < num_bands; ++b) {
+          for (size_t k = 0; k < 160; ++k) {
+            // Leave the first frames of some suppressors silent, which they
+            // do not analyze.
+            const float value = frame_index < 10 * (i % 3)
+                                    ? 0.f
+                                    : random.Gaussian(/*mean=*/0.0,
+                                                      /*std=*/1000.0);
+            separate_audio[i]->split_bands(0)[b][k] = value;
+            batch_audio[i]->split_bands(0)[b][k] = value;
+          }
+        }
+        separate_suppressors[i]->Analyze(*separate_audio[i]);
+        separate_suppressors[i]->Process(separate_audio[i].get());
+      }
+
+      NoiseSuppressor::AnalyzeBatch(suppressors, const_audio, fft);
+      NoiseSuppressor::ProcessBatch(suppressors, audio, fft);
+
+      for (size_t i = 0; i < kNumSuppressors; ++i) {
+        for (size_t b = 0; b < num_bands; ++b) {
+          for (size_t k = 0; k < 160; ++k) {
+            ASSERT_NEAR(batch_audio[i]->split_bands_const(0)[b][k],
+                        separate_audio[i]->split_bands_const(0)[b][k], 1e-2f)
+                << "frame " << frame_index << ", suppressor " << i;
+          }
+        }
+      }
+    }
+  }
+}
+
+// Verifies that the RNNoise mode attenuates stationary white noise in all
+// bands.
+TEST(NoiseSuppressor, RnnoiseAttenuatesWhiteNoise) {
+  constexpr int kRate = 32000;
+  constexpr size_t kNumBands = 2;
+  AudioBuffer audio(kRate, 1, kRate, 1, kRate, 1);
+  NsConfig cfg;
+  cfg.mode = NsConfig::Mode::kRnnoise;
+  NoiseSuppressor ns(cfg, kRate, 1);
+  Random random(/*seed=*/7);
+  std::array<float, kNumBands> input_energy = {};
+  std::array<float, kNumBands> output_energy = {};
+  for (size_t frame_index = 0; frame_index < 300; ++frame_index) {
+    audio.SplitIntoFrequencyBands();
+    std::array<float, kNumBands> frame_energy = {};
+    for (size_t b = 0; b < kNumBands; ++b) {
+      for (size_t i = 0; i < 160; ++i) {
+        const float value = random.Gaussian(/*mean=*/0.0, /*std=*/1000.0);
+        audio.split_bands(0)[b][i] = value;
+        frame_energy[b] += value * value;
+      }
+    }
+
+    ns.Process(&audio);
+
+    // Skip the first second, during which the network state converges.
+    if (frame_index >= 100) {
+      for (size_t b = 0; b < kNumBands; ++b) {
+        input_energy[b] += frame_energy[b];
+        for (size_t i = 0; i < 160; ++i) {
+          const float value = audio.split_bands_const(0)[b][i];
+          output_energy[b] += value * value;
+        }
+      }
+    }
+  }
+
+  for (size_t b = 0; b < kNumBands; ++b) {
+    SCOPED_TRACE(b);
+    EXPECT_LT(output_energy[b], 0.25f * input_energy[b]);
+  }
+}
+
 }  // namespace webrtc
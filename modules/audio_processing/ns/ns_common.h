@@ -20,6 +20,12 @@ constexpr size_t kFftSizeBy2Plus1 = kFftSize / 2 + 1;
 constexpr size_t kNsFrameSize = 160;
 constexpr size_t kOverlapSize = kFftSize - kNsFrameSize;
 
+// Frame size of RNNoise, which runs at 48 kHz.
+constexpr size_t kRnnoiseFrameSize = 480;
+// Delay in samples of the lowest band in the RNNoise mode, from the resampling
+// to and from 48 kHz and from the overlapping frames of RNNoise.
+constexpr size_t kRnnoiseDelay = 181;
+
 constexpr int kShortStartupPhaseBlocks = 50;
 constexpr int kLongStartupPhaseBlocks = 200;
 constexpr int kFeatureUpdateWindowSize = 500;
@@ -17,6 +17,11 @@ namespace webrtc {
 struct NsConfig {
   enum class SuppressionLevel { k6dB, k12dB, k18dB, k21dB };
   SuppressionLevel target_level = SuppressionLevel::k12dB;
+  // kRnnoise suppresses the noise of the lowest band with the RNNoise
+  // recurrent network instead of the Wiener filter, and does not use
+  // `target_level` other than for the attenuation limit of the upper bands.
+  enum class Mode { kClassic, kRnnoise };
+  Mode mode = Mode::kClassic;
 };
 
 }  // namespace webrtc
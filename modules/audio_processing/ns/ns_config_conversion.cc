@@ -0,0 +1,46 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/ns/ns_config_conversion.h"
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+NsConfig::SuppressionLevel ToSuppressionLevel(
+    AudioProcessing::Config::NoiseSuppression::Level level) {
+  using NoiseSuppression = AudioProcessing::Config::NoiseSuppression;
+  switch (level) {
+    case NoiseSuppression::kLow:
+      return NsConfig::SuppressionLevel::k6dB;
+    case NoiseSuppression::kModerate:
+      return NsConfig::SuppressionLevel::k12dB;
+    case NoiseSuppression::kHigh:
+      return NsConfig::SuppressionLevel::k18dB;
+    case NoiseSuppression::kVeryHigh:
+      return NsConfig::SuppressionLevel::k21dB;
+  }
+  RTC_CHECK_NOTREACHED();
+}
+
+}  // namespace
+
+NsConfig ToNsConfig(const AudioProcessing::Config::NoiseSuppression& config) {
+  NsConfig ns_config;
+  ns_config.target_level = ToSuppressionLevel(config.level);
+  ns_config.mode =
+      config.mode == AudioProcessing::Config::NoiseSuppression::kRnnoise
+          ? NsConfig::Mode::kRnnoise
+          : NsConfig::Mode::kClassic;
+  return ns_config;
+}
+
+}  // namespace webrtc
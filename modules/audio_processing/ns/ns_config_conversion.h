@@ -0,0 +1,25 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_NS_CONFIG_CONVERSION_H_
+#define MODULES_AUDIO_PROCESSING_NS_NS_CONFIG_CONVERSION_H_
+
+#include "api/audio/audio_processing.h"
+#include "modules/audio_processing/ns/ns_config.h"
+
+namespace webrtc {
+
+// Returns the noise suppressor config for the noise suppression settings of
+// AudioProcessing.
+NsConfig ToNsConfig(const AudioProcessing::Config::NoiseSuppression& config);
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_NS_CONFIG_CONVERSION_H_
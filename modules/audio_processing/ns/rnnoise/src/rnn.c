@@ -156,7 +156,10 @@ void rnnoise_compute_gru(const GRULayer* gru,
 
 #define INPUT_SIZE 42
 
-void compute_rnn(RNNState* rnn, float* gains, float* vad, const float* input) {
+void compute_rnn_reference(RNNState* rnn,
+                           float* gains,
+                           float* vad,
+                           const float* input) {
   int i;
   float dense_out[MAX_NEURONS];
   float noise_input[MAX_NEURONS * 3];
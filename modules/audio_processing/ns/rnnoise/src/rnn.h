@@ -65,6 +65,15 @@ void rnnoise_compute_dense(const DenseLayer* layer,
 
 void rnnoise_compute_gru(const GRULayer* gru, float* state, const float* input);
 
+/* Defined by the WebRTC noise suppressor (ns/rnnoise_network.cc), which runs
+   the built-in model with SIMD kernels and other models with
+   compute_rnn_reference(). */
 void compute_rnn(RNNState* rnn, float* gains, float* vad, const float* input);
 
+/* Scalar implementation of compute_rnn(). */
+void compute_rnn_reference(RNNState* rnn,
+                           float* gains,
+                           float* vad,
+                           const float* input);
+
 #endif /* RNN_H_ */
@@ -0,0 +1,253 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/ns/rnnoise_network.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <array>
+
+#include "rtc_base/checks.h"
+
+extern "C" {
+#include "modules/audio_processing/ns/rnnoise/src/tansig_table.h"
+
+extern const RNNModel rnnoise_model_orig;
+}
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kNumGruGates = 3;  // Update, reset, output.
+constexpr float kWeightsScale = WEIGHTS_SCALE;
+
+// Same approximations of the activation functions as in rnn.c.
+float TansigApproximated(float x) {
+  // Tests are reversed to catch NaNs.
+  if (!(x < 8.f)) {
+    return 1.f;
+  }
+  if (!(x > -8.f)) {
+    return -1.f;
+  }
+  if (isnan(x)) {
+    return 0.f;
+  }
+  float sign = 1.f;
+  if (x < 0.f) {
+    x = -x;
+    sign = -1.f;
+  }
+  const int i = static_cast<int>(floorf(.5f + 25.f * x));
+  x -= .04f * i;
+  const float y = tansig_table[i];
+  const float dy = 1.f - y * y;
+  return sign * (y + x * dy * (1.f - y * x));
+}
+
+float SigmoidApproximated(float x) {
+  return .5f + .5f * TansigApproximated(.5f * x);
+}
+
+float Activate(int activation, float x) {
+  switch (activation) {
+    case ACTIVATION_SIGMOID:
+      return SigmoidApproximated(x);
+    case ACTIVATION_TANH:
+      return TansigApproximated(x);
+    case ACTIVATION_RELU:
+      return std::max(0.f, x);
+  }
+  RTC_DCHECK_NOTREACHED();
+  return x;
+}
+
+// Scales the `num_inputs` x `num_units` weights in `src`, stored input by
+// input with `stride` weights between consecutive inputs, and transposes them
+// into one row per unit.
+void AppendTransposedWeights(const rnn_weight* src,
+                             size_t num_inputs,
+                             size_t num_units,
+                             size_t stride,
+                             std::vector<float>& dst) {
+  for (size_t unit = 0; unit < num_units; ++unit) {
+    for (size_t input = 0; input < num_inputs; ++input) {
+      dst.push_back(kWeightsScale * src[input * stride + unit]);
+    }
+  }
+}
+
+std::vector<float> ScaleBias(const rnn_weight* bias, size_t size) {
+  std::vector<float> scaled(size);
+  for (size_t i = 0; i < size; ++i) {
+    scaled[i] = kWeightsScale * bias[i];
+  }
+  return scaled;
+}
+
+}  // namespace
+
+RnnoiseNetwork::Layer::Layer(const DenseLayer& layer)
+    : input_size(layer.nb_inputs),
+      output_size(layer.nb_neurons),
+      activation(layer.activation),
+      bias(ScaleBias(layer.bias, output_size)) {
+  weights.reserve(input_size * output_size);
+  AppendTransposedWeights(layer.input_weights, input_size, output_size,
+                          output_size, weights);
+}
+
+RnnoiseNetwork::Layer::Layer(const GRULayer& layer)
+    : input_size(layer.nb_inputs),
+      output_size(layer.nb_neurons),
+      activation(layer.activation),
+      bias(ScaleBias(layer.bias, kNumGruGates * output_size)) {
+  RTC_DCHECK_LE(output_size, MAX_NEURONS);
+  const size_t stride = kNumGruGates * output_size;
+  weights.reserve(stride * input_size);
+  recurrent_weights.reserve(stride * output_size);
+  for (size_t gate = 0; gate < kNumGruGates; ++gate) {
+    AppendTransposedWeights(layer.input_weights + gate * output_size,
+                            input_size, output_size, stride, weights);
+    AppendTransposedWeights(layer.recurrent_weights + gate * output_size,
+                            output_size, output_size, stride,
+                            recurrent_weights);
+  }
+}
+
+RnnoiseNetwork::Layer::~Layer() = default;
+
+RnnoiseNetwork::RnnoiseNetwork(const RNNModel& model,
+                               const AvailableCpuFeatures& cpu_features)
+    : vector_math_(cpu_features),
+      input_dense_(*model.input_dense),
+      vad_gru_(*model.vad_gru),
+      noise_gru_(*model.noise_gru),
+      denoise_gru_(*model.denoise_gru),
+      denoise_output_(*model.denoise_output),
+      vad_output_(*model.vad_output) {}
+
+RnnoiseNetwork::~RnnoiseNetwork() = default;
+
+const RnnoiseNetwork& RnnoiseNetwork::BuiltIn() {
+  static const RnnoiseNetwork* const network =
+      new RnnoiseNetwork(rnnoise_model_orig, GetAvailableCpuFeatures());
+  return *network;
+}
+
+void RnnoiseNetwork::Compute(rtc::ArrayView<const float> features,
+                             RNNState& state,
+                             rtc::ArrayView<float> gains,
+                             float& vad_probability) const {
+  RTC_DCHECK_EQ(features.size(), input_dense_.input_size);
+  const size_t input_dense_size = input_dense_.output_size;
+  const size_t vad_gru_size = vad_gru_.output_size;
+  const size_t noise_gru_size = noise_gru_.output_size;
+  const size_t denoise_gru_size = denoise_gru_.output_size;
+  rtc::ArrayView<float> vad_gru_state(state.vad_gru_state, vad_gru_size);
+  rtc::ArrayView<float> noise_gru_state(state.noise_gru_state,
+                                        noise_gru_size);
+  rtc::ArrayView<float> denoise_gru_state(state.denoise_gru_state,
+                                          denoise_gru_size);
+
+  std::array<float, MAX_NEURONS> dense_out;
+  ComputeDense(input_dense_, features, {dense_out.data(), input_dense_size});
+  ComputeGru(vad_gru_, {dense_out.data(), input_dense_size}, vad_gru_state);
+  ComputeDense(vad_output_, vad_gru_state, {&vad_probability, 1});
+
+  // The noise GRU takes the input dense layer, the VAD GRU and the features.
+  std::array<float, 3 * MAX_NEURONS> gru_input;
+  auto it = std::copy_n(dense_out.begin(), input_dense_size, gru_input.begin());
+  it = std::copy(vad_gru_state.begin(), vad_gru_state.end(), it);
+  it = std::copy(features.begin(), features.end(), it);
+  ComputeGru(noise_gru_, {gru_input.data(), noise_gru_.input_size},
+             noise_gru_state);
+
+  // The denoise GRU takes both GRUs before it and the features.
+  it = std::copy(vad_gru_state.begin(), vad_gru_state.end(), gru_input.begin());
+  it = std::copy(noise_gru_state.begin(), noise_gru_state.end(), it);
+  it = std::copy(features.begin(), features.end(), it);
+  ComputeGru(denoise_gru_, {gru_input.data(), denoise_gru_.input_size},
+             denoise_gru_state);
+  ComputeDense(denoise_output_, denoise_gru_state, gains);
+}
+
+void RnnoiseNetwork::ComputeDense(const Layer& layer,
+                                  rtc::ArrayView<const float> input,
+                                  rtc::ArrayView<float> output) const {
+  RTC_DCHECK_EQ(input.size(), layer.input_size);
+  RTC_DCHECK_EQ(output.size(), layer.output_size);
+  rtc::ArrayView<const float> weights(layer.weights);
+  for (size_t o = 0; o < layer.output_size; ++o) {
+    const float x =
+        layer.bias[o] +
+        vector_math_.DotProduct(
+            input, weights.subview(o * layer.input_size, layer.input_size));
+    output[o] = Activate(layer.activation, x);
+  }
+}
+
+void RnnoiseNetwork::ComputeGru(const Layer& layer,
+                                rtc::ArrayView<const float> input,
+                                rtc::ArrayView<float> state) const {
+  const size_t input_size = layer.input_size;
+  const size_t output_size = layer.output_size;
+  RTC_DCHECK_EQ(input.size(), input_size);
+  RTC_DCHECK_EQ(state.size(), output_size);
+  rtc::ArrayView<const float> weights(layer.weights);
+  rtc::ArrayView<const float> recurrent_weights(layer.recurrent_weights);
+
+  // Computes the sum of a unit of `gate` before its activation.
+  auto unit_sum = [&](size_t gate, size_t o,
+                      rtc::ArrayView<const float> recurrent_input) {
+    const size_t unit = gate * output_size + o;
+    return layer.bias[unit] +
+           vector_math_.DotProduct(
+               input, weights.subview(unit * input_size, input_size)) +
+           vector_math_.DotProduct(
+               recurrent_input,
+               recurrent_weights.subview(unit * output_size, output_size));
+  };
+
+  std::array<float, MAX_NEURONS> update;
+  std::array<float, MAX_NEURONS> reset_x_state;
+  for (size_t o = 0; o < output_size; ++o) {
+    update[o] = SigmoidApproximated(unit_sum(/*gate=*/0, o, state));
+    reset_x_state[o] =
+        SigmoidApproximated(unit_sum(/*gate=*/1, o, state)) * state[o];
+  }
+  std::array<float, MAX_NEURONS> output;
+  for (size_t o = 0; o < output_size; ++o) {
+    output[o] = Activate(
+        layer.activation,
+        unit_sum(/*gate=*/2, o, {reset_x_state.data(), state.size()}));
+  }
+  for (size_t o = 0; o < output_size; ++o) {
+    state[o] = update[o] * state[o] + (1.f - update[o]) * output[o];
+  }
+}
+
+}  // namespace webrtc
+
+// Replaces the scalar network evaluation of RNNoise for the built-in model.
+extern "C" void compute_rnn(RNNState* rnn,
+                            float* gains,
+                            float* vad,
+                            const float* input) {
+  if (rnn->model != &rnnoise_model_orig) {
+    compute_rnn_reference(rnn, gains, vad, input);
+    return;
+  }
+  const RNNModel& model = *rnn->model;
+  webrtc::RnnoiseNetwork::BuiltIn().Compute(
+      {input, static_cast<size_t>(model.input_dense->nb_inputs)}, *rnn,
+      {gains, static_cast<size_t>(model.denoise_output_size)}, *vad);
+}
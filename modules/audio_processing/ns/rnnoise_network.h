@@ -0,0 +1,87 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_RNNOISE_NETWORK_H_
+#define MODULES_AUDIO_PROCESSING_NS_RNNOISE_NETWORK_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "modules/audio_processing/agc2/rnn_vad/vector_math.h"
+
+extern "C" {
+#include "modules/audio_processing/ns/rnnoise/src/rnn.h"
+#include "modules/audio_processing/ns/rnnoise/src/rnn_data.h"
+}
+
+namespace webrtc {
+
+// Evaluates the recurrent network of an RNNoise model. The 8 bit weights are
+// scaled to floats and transposed once, so that each unit is computed with
+// the SIMD dot products of the RNN VAD.
+class RnnoiseNetwork {
+ public:
+  RnnoiseNetwork(const RNNModel& model,
+                 const AvailableCpuFeatures& cpu_features);
+  RnnoiseNetwork(const RnnoiseNetwork&) = delete;
+  RnnoiseNetwork& operator=(const RnnoiseNetwork&) = delete;
+  ~RnnoiseNetwork();
+
+  // Returns the network of the built-in model, using the CPU features of the
+  // current platform.
+  static const RnnoiseNetwork& BuiltIn();
+
+  // Computes the band gains and the voice probability for the frame with
+  // `features`, and updates the GRU states of `state`, which must be for the
+  // model of this network.
+  void Compute(rtc::ArrayView<const float> features,
+               RNNState& state,
+               rtc::ArrayView<float> gains,
+               float& vad_probability) const;
+
+ private:
+  struct Layer {
+    explicit Layer(const DenseLayer& layer);
+    explicit Layer(const GRULayer& layer);
+    ~Layer();
+
+    size_t input_size;
+    size_t output_size;
+    int activation;
+    // One row of `input_size` weights for each unit. For GRU layers, the rows
+    // of the update, reset and output gates follow each other, and so do the
+    // biases and the rows of `recurrent_weights`.
+    std::vector<float> bias;
+    std::vector<float> weights;
+    std::vector<float> recurrent_weights;
+  };
+
+  void ComputeDense(const Layer& layer,
+                    rtc::ArrayView<const float> input,
+                    rtc::ArrayView<float> output) const;
+  void ComputeGru(const Layer& layer,
+                  rtc::ArrayView<const float> input,
+                  rtc::ArrayView<float> state) const;
+
+  const rnn_vad::VectorMath vector_math_;
+  const Layer input_dense_;
+  const Layer vad_gru_;
+  const Layer noise_gru_;
+  const Layer denoise_gru_;
+  const Layer denoise_output_;
+  const Layer vad_output_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_RNNOISE_NETWORK_H_
@@ -0,0 +1,115 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/ns/rnnoise_network.h"
+
+#include <array>
+#include <vector>
+
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+extern "C" {
+extern const RNNModel rnnoise_model_orig;
+}
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumFeatures = 42;
+constexpr int kNumBands = 22;
+constexpr float kTolerance = 1e-3f;
+
+// Network states with their own storage.
+struct StateWithStorage {
+  StateWithStorage() {
+    vad_gru_state.fill(0.f);
+    noise_gru_state.fill(0.f);
+    denoise_gru_state.fill(0.f);
+    state.model = &rnnoise_model_orig;
+    state.vad_gru_state = vad_gru_state.data();
+    state.noise_gru_state = noise_gru_state.data();
+    state.denoise_gru_state = denoise_gru_state.data();
+  }
+
+  std::array<float, MAX_NEURONS> vad_gru_state;
+  std::array<float, MAX_NEURONS> noise_gru_state;
+  std::array<float, MAX_NEURONS> denoise_gru_state;
+  RNNState state;
+};
+
+class RnnoiseNetworkParametrization
+    : public ::testing::TestWithParam<AvailableCpuFeatures> {};
+
+// Checks that, from the same states, the network computes the same gains,
+// voice probabilities and states as the scalar implementation of RNNoise. The
+// states are copied from the reference before each frame, since rounding
+// differences otherwise build up in the recurrent layers.
+TEST_P(RnnoiseNetworkParametrization, MatchesReferenceImplementation) {
+  const RnnoiseNetwork network(rnnoise_model_orig, GetParam());
+  StateWithStorage reference;
+  StateWithStorage optimized;
+  Random random(/*seed=*/42);
+  for (int frame = 0; frame < 200; ++frame) {
+    SCOPED_TRACE(frame);
+    std::array<float, kNumFeatures> features;
+    for (float& feature : features) {
+      feature = 8.f * random.Rand<float>() - 4.f;
+    }
+    optimized.vad_gru_state = reference.vad_gru_state;
+    optimized.noise_gru_state = reference.noise_gru_state;
+    optimized.denoise_gru_state = reference.denoise_gru_state;
+
+    std::array<float, kNumBands> reference_gains;
+    float reference_vad;
+    compute_rnn_reference(&reference.state, reference_gains.data(),
+                          &reference_vad, features.data());
+    std::array<float, kNumBands> gains;
+    float vad;
+    network.Compute(features, optimized.state, gains, vad);
+
+    EXPECT_NEAR(vad, reference_vad, kTolerance);
+    for (int i = 0; i < kNumBands; ++i) {
+      EXPECT_NEAR(gains[i], reference_gains[i], kTolerance);
+    }
+    for (int i = 0; i < rnnoise_model_orig.denoise_gru_size; ++i) {
+      EXPECT_NEAR(optimized.denoise_gru_state[i],
+                  reference.denoise_gru_state[i], kTolerance);
+    }
+  }
+}
+
+std::vector<AvailableCpuFeatures> GetCpuFeaturesToTest() {
+  std::vector<AvailableCpuFeatures> v;
+  v.push_back(NoAvailableCpuFeatures());
+  AvailableCpuFeatures available = GetAvailableCpuFeatures();
+  if (available.sse2) {
+    v.push_back({/*sse2=*/true, /*avx2=*/false, /*neon=*/false});
+  }
+  if (available.avx2) {
+    v.push_back({/*sse2=*/false, /*avx2=*/true, /*neon=*/false});
+  }
+  if (available.neon) {
+    v.push_back({/*sse2=*/false, /*avx2=*/false, /*neon=*/true});
+  }
+  return v;
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    RnnoiseNetwork,
+    RnnoiseNetworkParametrization,
+    ::testing::ValuesIn(GetCpuFeaturesToTest()),
+    [](const ::testing::TestParamInfo<AvailableCpuFeatures>& info) {
+      return info.param.ToString();
+    });
+
+}  // namespace
+}  // namespace webrtc
@@ -65,15 +65,33 @@ bool VerifyFloatBitExactness(const webrtc::audioproc::Stream& msg,
 }
 
 // Selectively reads the next proto-buf message from dump-file or string input.
-// Returns a bool indicating whether a new message was available.
-bool ReadNextMessage(bool use_dump_file,
-                     FILE* dump_input_file,
-                     std::stringstream& input,
-                     webrtc::audioproc::Event& event_msg) {
+ReadMessageResult ReadNextMessage(bool use_dump_file,
+                                  FILE* dump_input_file,
+                                  std::stringstream& input,
+                                  webrtc::audioproc::Event& event_msg) {
   if (use_dump_file) {
-    return ReadMessageFromFile(dump_input_file, &event_msg);
+    return ReadMessage(dump_input_file, &event_msg);
   }
-  return ReadMessageFromString(&input, &event_msg);
+  return ReadMessage(&input, &event_msg);
+}
+
+bool IsValidSampleRate(int sample_rate_hz) {
+  return sample_rate_hz > 0 && sample_rate_hz % kChunksPerSecond == 0;
+}
+
+// Checks that the float frame `channels` has the layout of `buffer`.
+bool MatchesChannelBuffer(
+    const google::protobuf::RepeatedPtrField<std::string>& channels,
+    const ChannelBuffer<float>& buffer) {
+  if (static_cast<size_t>(channels.size()) != buffer.num_channels()) {
+    return false;
+  }
+  for (const std::string& channel : channels) {
+    if (channel.size() != buffer.num_frames() * sizeof(float)) {
+      return false;
+    }
+  }
+  return true;
 }
 
 }  // namespace
@@ -227,6 +245,13 @@ void AecDumpBasedSimulator::PrepareReverseProcessStreamCall(
 }
 
 void AecDumpBasedSimulator::Process() {
+  const std::string error = TryProcess();
+  if (!error.empty()) {
+    std::cerr << "Stopped processing the aec dump: " << error << std::endl;
+  }
+}
+
+std::string AecDumpBasedSimulator::TryProcess() {
   ConfigureAudioProcessor();
 
   if (settings_.artificial_nearend_filename) {
@@ -247,16 +272,33 @@ void AecDumpBasedSimulator::Process() {
   const bool use_dump_file = !settings_.aec_dump_input_string.has_value();
   std::stringstream input;
   if (use_dump_file) {
-    dump_input_file_ =
-        OpenFile(settings_.aec_dump_input_filename->c_str(), "rb");
+    dump_input_file_ = fopen(settings_.aec_dump_input_filename->c_str(), "rb");
+    if (!dump_input_file_) {
+      DetachAecDump();
+      return "cannot be opened";
+    }
   } else {
     input << settings_.aec_dump_input_string.value();
   }
 
+  std::string error;
   webrtc::audioproc::Event event_msg;
   int capture_frames_since_init = 0;
   int init_index = 0;
-  while (ReadNextMessage(use_dump_file, dump_input_file_, input, event_msg)) {
+  while (true) {
+    const ReadMessageResult read_result =
+        ReadNextMessage(use_dump_file, dump_input_file_, input, event_msg);
+    if (read_result != ReadMessageResult::kSuccess) {
+      if (read_result == ReadMessageResult::kCorruptMessage) {
+        error = "truncated or corrupt message";
+      }
+      break;
+    }
+    error = CheckEvent(event_msg);
+    if (!error.empty()) {
+      break;
+    }
+
     SelectivelyToggleDataDumping(init_index, capture_frames_since_init);
     HandleEvent(event_msg, capture_frames_since_init, init_index);
 
@@ -274,6 +316,7 @@ void AecDumpBasedSimulator::Process() {
   }
 
   DetachAecDump();
+  return error;
 }
 
 void AecDumpBasedSimulator::Analyze() {
@@ -290,7 +333,8 @@ void AecDumpBasedSimulator::Analyze() {
   int num_capture_frames = 0;
   int num_render_frames = 0;
   int init_index = 0;
-  while (ReadNextMessage(use_dump_file, dump_input_file_, input, event_msg)) {
+  while (ReadNextMessage(use_dump_file, dump_input_file_, input, event_msg) ==
+         ReadMessageResult::kSuccess) {
     if (event_msg.type() == webrtc::audioproc::Event::INIT) {
       ++init_index;
       constexpr float kNumFramesPerSecond = 100.f;
@@ -316,6 +360,76 @@ void AecDumpBasedSimulator::Analyze() {
   }
 }
 
+std::string AecDumpBasedSimulator::CheckEvent(
+    const webrtc::audioproc::Event& event_msg) const {
+  switch (event_msg.type()) {
+    case webrtc::audioproc::Event::INIT: {
+      if (!event_msg.has_init()) {
+        return "init event without init message";
+      }
+      const webrtc::audioproc::Init& msg = event_msg.init();
+      if (!msg.has_sample_rate() || !msg.has_num_input_channels() ||
+          !msg.has_num_reverse_channels() || !msg.has_reverse_sample_rate()) {
+        return "incomplete init message";
+      }
+      const int output_sample_rate = settings_.output_sample_rate_hz.value_or(
+          msg.has_output_sample_rate() ? msg.output_sample_rate()
+                                       : msg.sample_rate());
+      const int reverse_output_sample_rate =
+          settings_.reverse_output_sample_rate_hz.value_or(
+              msg.has_reverse_output_sample_rate()
+                  ? msg.reverse_output_sample_rate()
+                  : msg.reverse_sample_rate());
+      if (!IsValidSampleRate(msg.sample_rate()) ||
+          !IsValidSampleRate(msg.reverse_sample_rate()) ||
+          !IsValidSampleRate(output_sample_rate) ||
+          !IsValidSampleRate(reverse_output_sample_rate)) {
+        return "unsupported sample rate";
+      }
+      if (msg.num_input_channels() <= 0 || msg.num_reverse_channels() <= 0) {
+        return "unsupported number of channels";
+      }
+      return "";
+    }
+    case webrtc::audioproc::Event::STREAM: {
+      if (!event_msg.has_stream() || !in_buf_) {
+        return "capture frame without preceding init";
+      }
+      const webrtc::audioproc::Stream& msg = event_msg.stream();
+      const bool valid_frame =
+          msg.has_input_data()
+              ? interface_used_ != InterfaceType::kFloatInterface &&
+                    sizeof(fwd_frame_.data[0]) * fwd_frame_.data.size() ==
+                        msg.input_data().size()
+              : interface_used_ != InterfaceType::kFixedInterface &&
+                    MatchesChannelBuffer(msg.input_channel(), *in_buf_);
+      return valid_frame ? "" : "capture frame inconsistent with init";
+    }
+    case webrtc::audioproc::Event::REVERSE_STREAM: {
+      if (!event_msg.has_reverse_stream() || !reverse_in_buf_) {
+        return "render frame without preceding init";
+      }
+      const webrtc::audioproc::ReverseStream& msg = event_msg.reverse_stream();
+      const bool valid_frame =
+          msg.has_data()
+              ? interface_used_ != InterfaceType::kFloatInterface &&
+                    sizeof(rev_frame_.data[0]) * rev_frame_.data.size() ==
+                        msg.data().size()
+              : interface_used_ != InterfaceType::kFixedInterface &&
+                    MatchesChannelBuffer(msg.channel(), *reverse_in_buf_);
+      return valid_frame ? "" : "render frame inconsistent with init";
+    }
+    case webrtc::audioproc::Event::CONFIG:
+      return event_msg.has_config() ? ""
+                                    : "config event without config message";
+    case webrtc::audioproc::Event::RUNTIME_SETTING:
+      return "";
+    case webrtc::audioproc::Event::UNKNOWN_EVENT:
+      break;
+  }
+  return "unknown event";
+}
+
 void AecDumpBasedSimulator::HandleEvent(
     const webrtc::audioproc::Event& event_msg,
     int& capture_frames_since_init,
@@ -38,13 +38,23 @@ class AecDumpBasedSimulator final : public AudioProcessingSimulator {
 
   ~AecDumpBasedSimulator() override;
 
-  // Processes the messages in the aecdump file.
+  // Processes the messages in the aecdump file. Reports, instead of crashing
+  // on, the first message that cannot be processed, and stops there.
   void Process() override;
 
+  // Processes the messages in the aecdump file until the first message that is
+  // truncated, corrupt or inconsistent with the preceding ones. Returns why
+  // processing stopped there, or an empty string if all messages were
+  // processed.
+  std::string TryProcess();
+
   // Analyzes the data in the aecdump file and reports the resulting statistics.
   void Analyze() override;
 
  private:
+  // Returns why `event_msg` cannot be handled after the preceding messages, or
+  // an empty string if it can.
+  std::string CheckEvent(const webrtc::audioproc::Event& event_msg) const;
   void HandleEvent(const webrtc::audioproc::Event& event_msg,
                    int& num_forward_chunks_processed,
                    int& init_index);
@@ -0,0 +1,269 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/test/aec_dump_replay_farm.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "modules/audio_processing/test/aec_dump_based_simulator.h"
+#include "modules/audio_processing/test/api_call_statistics.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/string_to_number.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+// Recursively collects the paths of all non-hidden files in `directory`.
+void FindFiles(absl::string_view directory, std::vector<std::string>* files) {
+  absl::optional<std::vector<std::string>> entries = ReadDirectory(directory);
+  if (!entries) {
+    return;
+  }
+  for (std::string& entry : *entries) {
+    const size_t name_start = entry.find_last_of("/\\") + 1;
+    if (entry[name_start] == '.') {
+      continue;
+    }
+    if (DirExists(entry)) {
+      FindFiles(entry, files);
+    } else {
+      files->push_back(std::move(entry));
+    }
+  }
+}
+
+AecDumpReplayResult ReplayAecDump(const SimulationSettings& settings,
+                                  absl::string_view filename) {
+  SimulationSettings replay_settings = settings;
+  replay_settings.aec_dump_input_filename = std::string(filename);
+  replay_settings.compute_output_digest = true;
+  // Progress output from concurrent simulations would be interleaved.
+  replay_settings.use_quiet_output = true;
+
+  AecDumpBasedSimulator simulator(replay_settings,
+                                  /*audio_processing=*/nullptr,
+                                  /*ap_builder=*/nullptr);
+  AecDumpReplayResult result;
+  // The results of a recording that cannot be processed completely are not
+  // comparable to those of other runs.
+  result.error = simulator.TryProcess();
+  const ApiCallStatistics& stats = simulator.GetApiCallStatistics();
+  if (result.error.empty() &&
+      stats.GetNumCalls(ApiCallStatistics::CallType::kCapture) == 0) {
+    result.error = "no capture frames";
+  }
+  if (!result.error.empty()) {
+    return result;
+  }
+
+  result.output_digest = simulator.OutputDigest();
+  result.render_time_us =
+      stats.GetTotalCpuDurationNanos(ApiCallStatistics::CallType::kRender) /
+      rtc::kNumNanosecsPerMicrosec;
+  result.capture_time_us =
+      stats.GetTotalCpuDurationNanos(ApiCallStatistics::CallType::kCapture) /
+      rtc::kNumNanosecsPerMicrosec;
+  result.num_render_calls =
+      stats.GetNumCalls(ApiCallStatistics::CallType::kRender);
+  result.num_capture_calls =
+      stats.GetNumCalls(ApiCallStatistics::CallType::kCapture);
+  return result;
+}
+
+int64_t TotalTimeUs(const AecDumpReplayResult& result) {
+  return result.render_time_us + result.capture_time_us;
+}
+
+void PrintNames(absl::string_view heading,
+                const std::vector<std::string>& names) {
+  if (names.empty()) {
+    return;
+  }
+  std::cout << " " << heading << ":" << std::endl;
+  for (const auto& name : names) {
+    std::cout << "   " << name << std::endl;
+  }
+}
+
+}  // namespace
+
+void AecDumpReplayComparison::PrintReport() const {
+  const float relative_time_change =
+      baseline_time_us > 0
+          ? static_cast<float>(time_us - baseline_time_us) / baseline_time_us
+          : 0.f;
+  std::cout << std::endl
+            << "Baseline comparison:" << std::endl
+            << " Changed outputs: " << changed_output.size() << std::endl
+            << " Slower recordings: " << slower.size() << std::endl
+            << " Missing recordings: " << missing.size() << std::endl
+            << " Added recordings: " << added.size() << std::endl
+            << " Total CPU time: " << baseline_time_us * 1e-6 << " s -> "
+            << time_us * 1e-6 << " s (" << relative_time_change * 100.f
+            << " %)" << std::endl;
+  PrintNames("Changed outputs", changed_output);
+  PrintNames("Slower recordings", slower);
+  PrintNames("Missing recordings", missing);
+  PrintNames("Added recordings", added);
+}
+
+bool AecDumpReplayComparison::Passed(float max_relative_time_increase) const {
+  if (!changed_output.empty() || !missing.empty()) {
+    return false;
+  }
+  return time_us <= baseline_time_us * (1.f + max_relative_time_increase);
+}
+
+std::vector<AecDumpReplayResult> ReplayAecDumps(
+    const SimulationSettings& settings,
+    absl::string_view directory,
+    int num_threads) {
+  RTC_DCHECK_GT(num_threads, 0);
+  std::vector<std::string> filenames;
+  FindFiles(directory, &filenames);
+  std::sort(filenames.begin(), filenames.end());
+
+  std::vector<AecDumpReplayResult> results(filenames.size());
+  std::atomic<size_t> next_index(0);
+  auto replay_loop = [&] {
+    for (size_t k = next_index++; k < filenames.size(); k = next_index++) {
+      results[k] = ReplayAecDump(settings, filenames[k]);
+    }
+  };
+
+  // Each thread picks the next unprocessed recording when done with the
+  // previous one, which balances the load across recordings of very
+  // different durations.
+  std::vector<rtc::PlatformThread> workers;
+  const int num_workers =
+      std::min(num_threads, static_cast<int>(filenames.size()));
+  for (int k = 0; k < num_workers; ++k) {
+    workers.push_back(
+        rtc::PlatformThread::SpawnJoinable(replay_loop, "AecDumpReplay"));
+  }
+  for (auto& worker : workers) {
+    worker.Finalize();
+  }
+
+  // ReadDirectory() appends a path separator to `directory` unless present.
+  size_t prefix_length = directory.size();
+  if (!directory.empty() && directory.back() != '/' &&
+      directory.back() != '\\') {
+    ++prefix_length;
+  }
+  for (size_t k = 0; k < filenames.size(); ++k) {
+    results[k].name = filenames[k].substr(prefix_length);
+  }
+  return results;
+}
+
+std::string AecDumpReplayResultsToCsv(
+    rtc::ArrayView<const AecDumpReplayResult> results) {
+  rtc::StringBuilder sb;
+  for (const auto& result : results) {
+    sb << result.name << ", ";
+    sb.AppendFormat("0x%08x", result.output_digest);
+    sb << ", " << result.render_time_us << ", " << result.capture_time_us
+       << "\n";
+  }
+  return sb.Release();
+}
+
+absl::optional<std::vector<AecDumpReplayResult>> ParseAecDumpReplayCsv(
+    absl::string_view csv) {
+  std::vector<AecDumpReplayResult> results;
+  while (!csv.empty()) {
+    const size_t line_end = std::min(csv.find('\n'), csv.size());
+    absl::string_view line = csv.substr(0, line_end);
+    csv.remove_prefix(std::min(line_end + 1, csv.size()));
+    if (line.empty()) {
+      continue;
+    }
+
+    // The name may contain commas, hence the fields are split off from the
+    // end of the line.
+    absl::string_view fields[3];
+    for (int k = 2; k >= 0; --k) {
+      const size_t separator = line.rfind(", ");
+      if (separator == absl::string_view::npos) {
+        return absl::nullopt;
+      }
+      fields[k] = line.substr(separator + 2);
+      line = line.substr(0, separator);
+    }
+
+    absl::optional<uint32_t> digest =
+        rtc::StringToNumber<uint32_t>(fields[0], /*base=*/16);
+    absl::optional<int64_t> render_time_us =
+        rtc::StringToNumber<int64_t>(fields[1]);
+    absl::optional<int64_t> capture_time_us =
+        rtc::StringToNumber<int64_t>(fields[2]);
+    if (line.empty() || !digest || !render_time_us || !capture_time_us) {
+      return absl::nullopt;
+    }
+
+    AecDumpReplayResult result;
+    result.name = std::string(line);
+    result.output_digest = *digest;
+    result.render_time_us = *render_time_us;
+    result.capture_time_us = *capture_time_us;
+    results.push_back(std::move(result));
+  }
+  return results;
+}
+
+AecDumpReplayComparison CompareAecDumpReplays(
+    rtc::ArrayView<const AecDumpReplayResult> results,
+    rtc::ArrayView<const AecDumpReplayResult> baseline,
+    float max_relative_time_increase) {
+  std::map<absl::string_view, const AecDumpReplayResult*> baseline_by_name;
+  for (const auto& result : baseline) {
+    baseline_by_name[result.name] = &result;
+  }
+
+  AecDumpReplayComparison comparison;
+  for (const auto& result : results) {
+    auto it = baseline_by_name.find(result.name);
+    if (it == baseline_by_name.end()) {
+      comparison.added.push_back(result.name);
+      continue;
+    }
+    const AecDumpReplayResult& reference = *it->second;
+    baseline_by_name.erase(it);
+
+    if (result.output_digest != reference.output_digest) {
+      comparison.changed_output.push_back(result.name);
+    }
+    if (TotalTimeUs(result) >
+        TotalTimeUs(reference) * (1.f + max_relative_time_increase)) {
+      comparison.slower.push_back(result.name);
+    }
+    comparison.baseline_time_us += TotalTimeUs(reference);
+    comparison.time_us += TotalTimeUs(result);
+  }
+
+  for (const auto& remaining : baseline_by_name) {
+    comparison.missing.push_back(std::string(remaining.first));
+  }
+  return comparison;
+}
+
+}  // namespace test
+}  // namespace webrtc
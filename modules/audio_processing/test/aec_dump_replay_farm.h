@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_TEST_AEC_DUMP_REPLAY_FARM_H_
+#define MODULES_AUDIO_PROCESSING_TEST_AEC_DUMP_REPLAY_FARM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "modules/audio_processing/test/audio_processing_simulator.h"
+
+namespace webrtc {
+namespace test {
+
+// Outcome of replaying a single aec dump.
+struct AecDumpReplayResult {
+  // Path of the aec dump, relative to the replayed directory.
+  std::string name;
+  // CRC32 digest of the processed capture output.
+  uint32_t output_digest = 0;
+  // Summed up CPU times that the replaying thread spent in the render and
+  // capture API calls. Unlike wall-clock durations, these are not inflated by
+  // the replay threads competing for the cores.
+  int64_t render_time_us = 0;
+  int64_t capture_time_us = 0;
+  // Number of render and capture API calls. Not part of the CSV report.
+  size_t num_render_calls = 0;
+  size_t num_capture_calls = 0;
+  // Why the file could not be replayed, or empty if it was. Not part of the
+  // CSV report.
+  std::string error;
+};
+
+// Differences between a set of replay results and a baseline.
+struct AecDumpReplayComparison {
+  // Prints out a summary of the differences.
+  void PrintReport() const;
+
+  // Returns true if no output differs from, or is missing relative to, the
+  // baseline and the total API call CPU time has not increased by more than
+  // `max_relative_time_increase`.
+  bool Passed(float max_relative_time_increase) const;
+
+  // Aec dumps for which the output digest differs from the baseline.
+  std::vector<std::string> changed_output;
+  // Aec dumps for which the API call CPU time increased by more than the
+  // allowed relative amount.
+  std::vector<std::string> slower;
+  // Aec dumps in the baseline that were not replayed.
+  std::vector<std::string> missing;
+  // Replayed aec dumps that are not in the baseline.
+  std::vector<std::string> added;
+  // Total API call CPU time for the aec dumps present in both sets.
+  int64_t baseline_time_us = 0;
+  int64_t time_us = 0;
+};
+
+// Replays all files in `directory` and its subdirectories as aec dumps,
+// spreading the recordings over `num_threads` worker threads. Each recording
+// is processed by its own simulator and AudioProcessing instance, configured
+// according to `settings`. The results are sorted by name. The results of
+// files that are not aec dumps, and of aec dumps that are truncated,
+// inconsistent or without capture frames, only have the `error` set.
+std::vector<AecDumpReplayResult> ReplayAecDumps(
+    const SimulationSettings& settings,
+    absl::string_view directory,
+    int num_threads);
+
+// Serializes replay results into CSV format, with one line per aec dump.
+std::string AecDumpReplayResultsToCsv(
+    rtc::ArrayView<const AecDumpReplayResult> results);
+
+// Parses replay results produced by AecDumpReplayResultsToCsv(). Returns
+// absl::nullopt if the input is malformed.
+absl::optional<std::vector<AecDumpReplayResult>> ParseAecDumpReplayCsv(
+    absl::string_view csv);
+
+// Compares `results` against `baseline`. The API call CPU time of an aec dump
+// is deemed to have increased if it grew by more than
+// `max_relative_time_increase` relative to the baseline.
+AecDumpReplayComparison CompareAecDumpReplays(
+    rtc::ArrayView<const AecDumpReplayResult> results,
+    rtc::ArrayView<const AecDumpReplayResult> baseline,
+    float max_relative_time_increase);
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_TEST_AEC_DUMP_REPLAY_FARM_H_
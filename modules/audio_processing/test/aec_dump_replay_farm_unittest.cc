@@ -0,0 +1,284 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/test/aec_dump_replay_farm.h"
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "api/audio/audio_processing.h"
+#include "modules/audio_processing/aec_dump/aec_dump_factory.h"
+#include "modules/audio_processing/test/audio_processing_builder_for_testing.h"
+#include "rtc_base/task_queue_for_test.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+#ifdef WEBRTC_ANDROID_PLATFORM_BUILD
+#include "external/webrtc/webrtc/modules/audio_processing/debug.pb.h"
+#else
+#include "modules/audio_processing/debug.pb.h"
+#endif
+
+namespace webrtc {
+namespace test {
+namespace {
+
+AecDumpReplayResult CreateResult(absl::string_view name,
+                                 uint32_t output_digest,
+                                 int64_t render_time_us,
+                                 int64_t capture_time_us) {
+  AecDumpReplayResult result;
+  result.name = std::string(name);
+  result.output_digest = output_digest;
+  result.render_time_us = render_time_us;
+  result.capture_time_us = capture_time_us;
+  return result;
+}
+
+// Records an aec dump of `num_frames` render and capture frames of a sawtooth
+// signal with the period `period`.
+void WriteAecDump(absl::string_view filename, int num_frames, int period) {
+  TaskQueueForTest worker_queue("AecDumpWriter");
+  rtc::scoped_refptr<AudioProcessing> apm =
+      AudioProcessingBuilderForTesting().Create();
+  apm->AttachAecDump(AecDumpFactory::Create(filename, /*max_log_size_bytes=*/-1,
+                                            worker_queue.Get()));
+  const StreamConfig config(/*sample_rate_hz=*/16000, /*num_channels=*/1);
+  std::vector<int16_t> frame(config.num_frames());
+  int sample = 0;
+  for (int k = 0; k < num_frames; ++k) {
+    for (int16_t& value : frame) {
+      value = 100 * (sample++ % period);
+    }
+    ASSERT_EQ(AudioProcessing::kNoError,
+              apm->ProcessReverseStream(frame.data(), config, config,
+                                        frame.data()));
+    ASSERT_EQ(AudioProcessing::kNoError,
+              apm->ProcessStream(frame.data(), config, config, frame.data()));
+  }
+  apm->DetachAecDump();
+}
+
+// Writes `events` as an aec dump.
+void WriteEvents(absl::string_view filename,
+                 const std::vector<audioproc::Event>& events) {
+  FILE* file = fopen(std::string(filename).c_str(), "wb");
+  ASSERT_TRUE(file);
+  for (const audioproc::Event& event : events) {
+    const std::string message = event.SerializeAsString();
+    const int32_t message_size = message.size();
+    fwrite(&message_size, sizeof(message_size), 1, file);
+    fwrite(message.data(), 1, message.size(), file);
+  }
+  fclose(file);
+}
+
+}  // namespace
+
+#ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
+// Verifies that the aec dumps in a directory and its subdirectories are
+// replayed, and that files which are not aec dumps are reported.
+TEST(AecDumpReplayFarm, ReplaysDirectoryOfAecDumps) {
+  constexpr int kNumFrames = 50;
+  const std::string directory =
+      GenerateTempFilename(OutputPath(), "aec_dump_replay_farm");
+  const std::string subdirectory = JoinFilename(directory, "sub");
+  ASSERT_TRUE(CreateDir(directory));
+  ASSERT_TRUE(CreateDir(subdirectory));
+  const std::string dump_a = JoinFilename(directory, "a.aecdump");
+  const std::string dump_b = JoinFilename(subdirectory, "b.aecdump");
+  const std::string not_a_dump = JoinFilename(directory, "notes.txt");
+  WriteAecDump(dump_a, kNumFrames, /*period=*/50);
+  WriteAecDump(dump_b, kNumFrames, /*period=*/70);
+  FILE* file = fopen(not_a_dump.c_str(), "w");
+  ASSERT_TRUE(file);
+  fputs("Not an aec dump.\n", file);
+  fclose(file);
+
+  const SimulationSettings settings;
+  const std::vector<AecDumpReplayResult> results =
+      ReplayAecDumps(settings, directory, /*num_threads=*/2);
+  ASSERT_EQ(3u, results.size());
+  EXPECT_EQ("a.aecdump", results[0].name);
+  EXPECT_EQ("notes.txt", results[1].name);
+  EXPECT_EQ(JoinFilename("sub", "b.aecdump"), results[2].name);
+  for (const AecDumpReplayResult* result : {&results[0], &results[2]}) {
+    EXPECT_EQ(static_cast<size_t>(kNumFrames), result->num_render_calls);
+    EXPECT_EQ(static_cast<size_t>(kNumFrames), result->num_capture_calls);
+    EXPECT_NE(0u, result->output_digest);
+  }
+  EXPECT_NE(results[0].output_digest, results[2].output_digest);
+  EXPECT_TRUE(results[0].error.empty());
+  EXPECT_TRUE(results[2].error.empty());
+  EXPECT_EQ(0u, results[1].num_capture_calls);
+  EXPECT_FALSE(results[1].error.empty());
+
+  // The digests don't depend on the number of threads.
+  const std::vector<AecDumpReplayResult> serial_results =
+      ReplayAecDumps(settings, directory, /*num_threads=*/1);
+  ASSERT_EQ(results.size(), serial_results.size());
+  for (size_t k = 0; k < results.size(); ++k) {
+    EXPECT_EQ(results[k].output_digest, serial_results[k].output_digest);
+  }
+
+  EXPECT_TRUE(RemoveFile(dump_a));
+  EXPECT_TRUE(RemoveFile(dump_b));
+  EXPECT_TRUE(RemoveFile(not_a_dump));
+  EXPECT_TRUE(RemoveDir(subdirectory));
+  EXPECT_TRUE(RemoveDir(directory));
+}
+
+// Verifies that truncated and inconsistent aec dumps are reported instead of
+// aborting the replay.
+TEST(AecDumpReplayFarm, ReportsAecDumpsThatCannotBeReplayed) {
+  const std::string directory =
+      GenerateTempFilename(OutputPath(), "aec_dump_replay_farm");
+  ASSERT_TRUE(CreateDir(directory));
+  const std::string complete = JoinFilename(directory, "complete.aecdump");
+  const std::string truncated = JoinFilename(directory, "truncated.aecdump");
+  const std::string without_init =
+      JoinFilename(directory, "without_init.aecdump");
+  const std::string inconsistent =
+      JoinFilename(directory, "inconsistent.aecdump");
+  WriteAecDump(complete, /*num_frames=*/10, /*period=*/50);
+
+  // Cuts the last message short.
+  std::string contents;
+  FILE* file = fopen(complete.c_str(), "rb");
+  ASSERT_TRUE(file);
+  char buffer[1024];
+  size_t bytes_read;
+  while ((bytes_read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    contents.append(buffer, bytes_read);
+  }
+  fclose(file);
+  file = fopen(truncated.c_str(), "wb");
+  ASSERT_TRUE(file);
+  fwrite(contents.data(), 1, contents.size() - 10, file);
+  fclose(file);
+
+  // Records a capture frame without a preceding init.
+  audioproc::Event stream_event;
+  stream_event.set_type(audioproc::Event::STREAM);
+  stream_event.mutable_stream()->add_input_channel(
+      std::string(160 * sizeof(float), '\0'));
+  WriteEvents(without_init, {stream_event});
+
+  // Records a stereo capture frame after a mono init.
+  audioproc::Event init_event;
+  init_event.set_type(audioproc::Event::INIT);
+  audioproc::Init* init = init_event.mutable_init();
+  init->set_sample_rate(16000);
+  init->set_num_input_channels(1);
+  init->set_reverse_sample_rate(16000);
+  init->set_num_reverse_channels(1);
+  audioproc::Event stereo_stream_event = stream_event;
+  stereo_stream_event.mutable_stream()->add_input_channel(
+      std::string(160 * sizeof(float), '\0'));
+  WriteEvents(inconsistent,
+              {init_event, stream_event, stereo_stream_event, stream_event});
+
+  const SimulationSettings settings;
+  const std::vector<AecDumpReplayResult> results =
+      ReplayAecDumps(settings, directory, /*num_threads=*/2);
+  ASSERT_EQ(4u, results.size());
+  EXPECT_EQ("complete.aecdump", results[0].name);
+  EXPECT_TRUE(results[0].error.empty());
+  EXPECT_EQ(10u, results[0].num_capture_calls);
+  EXPECT_EQ("inconsistent.aecdump", results[1].name);
+  EXPECT_EQ("capture frame inconsistent with init", results[1].error);
+  EXPECT_EQ("truncated.aecdump", results[2].name);
+  EXPECT_EQ("truncated or corrupt message", results[2].error);
+  EXPECT_EQ("without_init.aecdump", results[3].name);
+  EXPECT_EQ("capture frame without preceding init", results[3].error);
+
+  EXPECT_TRUE(RemoveFile(complete));
+  EXPECT_TRUE(RemoveFile(truncated));
+  EXPECT_TRUE(RemoveFile(without_init));
+  EXPECT_TRUE(RemoveFile(inconsistent));
+  EXPECT_TRUE(RemoveDir(directory));
+}
+#endif  // WEBRTC_AUDIOPROC_DEBUG_DUMP
+
+// Verifies that replay results are preserved when serialized and parsed.
+TEST(AecDumpReplayFarm, CsvRoundTrip) {
+  const std::vector<AecDumpReplayResult> results = {
+      CreateResult("a.aecdump", 0xab0123cd, 100, 2000),
+      CreateResult("dir/b, with comma.aecdump", 0xffffffff, 0, 1),
+  };
+  const absl::optional<std::vector<AecDumpReplayResult>> parsed =
+      ParseAecDumpReplayCsv(AecDumpReplayResultsToCsv(results));
+  ASSERT_TRUE(parsed);
+  ASSERT_EQ(results.size(), parsed->size());
+  for (size_t k = 0; k < results.size(); ++k) {
+    EXPECT_EQ(results[k].name, (*parsed)[k].name);
+    EXPECT_EQ(results[k].output_digest, (*parsed)[k].output_digest);
+    EXPECT_EQ(results[k].render_time_us, (*parsed)[k].render_time_us);
+    EXPECT_EQ(results[k].capture_time_us, (*parsed)[k].capture_time_us);
+  }
+}
+
+// Verifies that malformed reports are rejected.
+TEST(AecDumpReplayFarm, MalformedCsvIsRejected) {
+  EXPECT_FALSE(ParseAecDumpReplayCsv("a.aecdump, 0x0123abcd, 100\n"));
+  EXPECT_FALSE(ParseAecDumpReplayCsv("a.aecdump, xyz, 100, 200\n"));
+  EXPECT_FALSE(ParseAecDumpReplayCsv(", 0x0123abcd, 100, 200\n"));
+  ASSERT_TRUE(ParseAecDumpReplayCsv(""));
+  EXPECT_TRUE(ParseAecDumpReplayCsv("")->empty());
+}
+
+// Verifies that changed, slower, missing and added recordings are detected.
+TEST(AecDumpReplayFarm, ComparisonAgainstBaseline) {
+  const std::vector<AecDumpReplayResult> baseline = {
+      CreateResult("changed", 1, 100, 100),
+      CreateResult("missing", 2, 100, 100),
+      CreateResult("slower", 3, 100, 100),
+      CreateResult("unchanged", 4, 100, 100),
+  };
+  const std::vector<AecDumpReplayResult> results = {
+      CreateResult("added", 5, 100, 100),
+      CreateResult("changed", 6, 100, 100),
+      CreateResult("slower", 3, 100, 200),
+      CreateResult("unchanged", 4, 100, 100),
+  };
+  const AecDumpReplayComparison comparison =
+      CompareAecDumpReplays(results, baseline, 0.1f);
+  EXPECT_EQ(std::vector<std::string>({"changed"}), comparison.changed_output);
+  EXPECT_EQ(std::vector<std::string>({"slower"}), comparison.slower);
+  EXPECT_EQ(std::vector<std::string>({"missing"}), comparison.missing);
+  EXPECT_EQ(std::vector<std::string>({"added"}), comparison.added);
+  EXPECT_EQ(600, comparison.baseline_time_us);
+  EXPECT_EQ(700, comparison.time_us);
+  EXPECT_FALSE(comparison.Passed(0.1f));
+}
+
+// Verifies that the comparison passes when only the timing changes within the
+// allowed limit.
+TEST(AecDumpReplayFarm, ComparisonPassesWithinTimeLimit) {
+  const std::vector<AecDumpReplayResult> baseline = {
+      CreateResult("a", 1, 100, 900),
+      CreateResult("b", 2, 100, 900),
+  };
+  const std::vector<AecDumpReplayResult> results = {
+      CreateResult("a", 1, 100, 950),
+      CreateResult("b", 2, 100, 1000),
+  };
+  const AecDumpReplayComparison comparison =
+      CompareAecDumpReplays(results, baseline, 0.1f);
+  EXPECT_TRUE(comparison.changed_output.empty());
+  EXPECT_TRUE(comparison.slower.empty());
+  EXPECT_TRUE(comparison.Passed(0.1f));
+  EXPECT_FALSE(comparison.Passed(0.05f));
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -23,8 +23,37 @@
 namespace webrtc {
 namespace test {
 
-void ApiCallStatistics::Add(int64_t duration_nanos, CallType call_type) {
-  calls_.push_back(CallData(duration_nanos, call_type));
+void ApiCallStatistics::Add(int64_t duration_nanos,
+                            int64_t cpu_duration_nanos,
+                            CallType call_type) {
+  calls_.push_back(CallData(duration_nanos, cpu_duration_nanos, call_type));
+}
+
+int64_t ApiCallStatistics::GetTotalDurationNanos(CallType call_type) const {
+  int64_t sum = 0;
+  for (auto v : calls_) {
+    if (v.call_type == call_type) {
+      sum += v.duration_nanos;
+    }
+  }
+  return sum;
+}
+
+int64_t ApiCallStatistics::GetTotalCpuDurationNanos(
+    CallType call_type) const {
+  int64_t sum = 0;
+  for (auto v : calls_) {
+    if (v.call_type == call_type) {
+      sum += v.cpu_duration_nanos;
+    }
+  }
+  return sum;
+}
+
+size_t ApiCallStatistics::GetNumCalls(CallType call_type) const {
+  return std::count_if(
+      calls_.begin(), calls_.end(),
+      [call_type](const CallData& v) { return v.call_type == call_type; });
 }
 
 void ApiCallStatistics::PrintReport() const {
@@ -88,8 +117,11 @@ void ApiCallStatistics::WriteReportToFile(absl::string_view filename) const {
 }
 
 ApiCallStatistics::CallData::CallData(int64_t duration_nanos,
+                                      int64_t cpu_duration_nanos,
                                       CallType call_type)
-    : duration_nanos(duration_nanos), call_type(call_type) {}
+    : duration_nanos(duration_nanos),
+      cpu_duration_nanos(cpu_duration_nanos),
+      call_type(call_type) {}
 
 }  // namespace test
 }  // namespace webrtc
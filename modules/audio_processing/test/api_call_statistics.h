@@ -11,6 +11,9 @@
 #ifndef MODULES_AUDIO_PROCESSING_TEST_API_CALL_STATISTICS_H_
 #define MODULES_AUDIO_PROCESSING_TEST_API_CALL_STATISTICS_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <vector>
 
 #include "absl/strings/string_view.h"
@@ -23,8 +26,23 @@ class ApiCallStatistics {
  public:
   enum class CallType { kRender, kCapture };
 
-  // Adds a new datapoint.
-  void Add(int64_t duration_nanos, CallType call_type);
+  // Adds a new datapoint. `duration_nanos` is the wall-clock duration of the
+  // call and `cpu_duration_nanos` the CPU time spent by the calling thread.
+  void Add(int64_t duration_nanos,
+           int64_t cpu_duration_nanos,
+           CallType call_type);
+
+  // Returns the summed up duration of all calls of the specified type.
+  int64_t GetTotalDurationNanos(CallType call_type) const;
+
+  // Returns the summed up CPU time that the calling thread spent in all calls
+  // of the specified type. Unlike the duration, it does not include the time
+  // that the thread waited for a core, so it is not inflated when other
+  // threads compete for the cores.
+  int64_t GetTotalCpuDurationNanos(CallType call_type) const;
+
+  // Returns the number of calls of the specified type.
+  size_t GetNumCalls(CallType call_type) const;
 
   // Prints out a report of the statistics.
   void PrintReport() const;
@@ -34,8 +52,11 @@ class ApiCallStatistics {
 
  private:
   struct CallData {
-    CallData(int64_t duration_nanos, CallType call_type);
+    CallData(int64_t duration_nanos,
+             int64_t cpu_duration_nanos,
+             CallType call_type);
     int64_t duration_nanos;
+    int64_t cpu_duration_nanos;
     CallType call_type;
   };
   std::vector<CallData> calls_;
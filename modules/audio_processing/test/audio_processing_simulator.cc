@@ -28,6 +28,8 @@
 #include "modules/audio_processing/test/echo_canceller3_config_json.h"
 #include "modules/audio_processing/test/fake_recording_device.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/crc32.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/json.h"
 #include "rtc_base/strings/string_builder.h"
@@ -86,22 +88,26 @@ void WriteEchoLikelihoodGraphFileFooter(std::ofstream* output_file) {
 }
 
 // RAII class for execution time measurement. Updates the provided
-// ApiCallStatistics based on the time between ScopedTimer creation and
-// leaving the enclosing scope.
+// ApiCallStatistics based on the wall-clock and thread CPU time between
+// ScopedTimer creation and leaving the enclosing scope.
 class ScopedTimer {
  public:
   ScopedTimer(ApiCallStatistics* api_call_statistics,
               ApiCallStatistics::CallType call_type)
       : start_time_(rtc::TimeNanos()),
+        start_cpu_time_(rtc::GetThreadCpuTimeNanos()),
         call_type_(call_type),
         api_call_statistics_(api_call_statistics) {}
 
   ~ScopedTimer() {
-    api_call_statistics_->Add(rtc::TimeNanos() - start_time_, call_type_);
+    const int64_t cpu_time = rtc::GetThreadCpuTimeNanos();
+    api_call_statistics_->Add(rtc::TimeNanos() - start_time_,
+                              cpu_time - start_cpu_time_, call_type_);
   }
 
  private:
   const int64_t start_time_;
+  const int64_t start_cpu_time_;
   const ApiCallStatistics::CallType call_type_;
   ApiCallStatistics* const api_call_statistics_;
 };
@@ -293,6 +299,14 @@ void AudioProcessingSimulator::ProcessStream(bool fixed_interface) {
     applied_input_volume_ = ap_->recommended_stream_analog_level();
   }
 
+  if (settings_.compute_output_digest) {
+    for (size_t ch = 0; ch < out_buf_->num_channels(); ++ch) {
+      output_digest_ =
+          rtc::UpdateCrc32(output_digest_, out_buf_->channels()[ch],
+                           out_buf_->num_frames() * sizeof(float));
+    }
+  }
+
   if (buffer_memory_writer_) {
     RTC_CHECK(!buffer_file_writer_);
     buffer_memory_writer_->Write(*out_buf_);
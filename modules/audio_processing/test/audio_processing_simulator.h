@@ -132,6 +132,7 @@ struct SimulationSettings {
   bool report_performance = false;
   absl::optional<std::string> performance_report_output_filename;
   bool report_bitexactness = false;
+  bool compute_output_digest = false;
   bool use_verbose_logging = false;
   bool use_quiet_output = false;
   bool discard_all_settings_in_aecdump = true;
@@ -182,6 +183,10 @@ class AudioProcessingSimulator {
   // Reports whether the processed recording was bitexact.
   bool OutputWasBitexact() { return bitexact_output_; }
 
+  // Returns a CRC32 digest of all the processed capture samples. Only
+  // computed when `compute_output_digest` is set in the settings.
+  uint32_t OutputDigest() const { return output_digest_; }
+
   size_t get_num_process_stream_calls() { return num_process_stream_calls_; }
   size_t get_num_reverse_process_stream_calls() {
     return num_reverse_process_stream_calls_;
@@ -230,6 +235,7 @@ class AudioProcessingSimulator {
 
   size_t num_process_stream_calls_ = 0;
   size_t num_reverse_process_stream_calls_ = 0;
+  uint32_t output_digest_ = 0;
   std::unique_ptr<ChannelBufferWavWriter> buffer_file_writer_;
   std::unique_ptr<ChannelBufferWavWriter> reverse_buffer_file_writer_;
   std::unique_ptr<ChannelBufferVectorWriter> buffer_memory_writer_;
@@ -12,7 +12,9 @@
 
 #include <string.h>
 
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <utility>
@@ -23,15 +25,23 @@
 #include "absl/strings/string_view.h"
 #include "api/audio/audio_processing.h"
 #include "modules/audio_processing/test/aec_dump_based_simulator.h"
+#include "modules/audio_processing/test/aec_dump_replay_farm.h"
 #include "modules/audio_processing/test/audio_processing_simulator.h"
 #include "modules/audio_processing/test/wav_based_simulator.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/cpu_info.h"
 #include "system_wrappers/include/field_trial.h"
 
 constexpr int kParameterNotSpecifiedValue = -10000;
 
 ABSL_FLAG(std::string, dump_input, "", "Aec dump input filename");
+ABSL_FLAG(std::string,
+          dump_input_dir,
+          "",
+          "Directory of aec dumps to replay in parallel, each using its own "
+          "default-built audio processing object");
 ABSL_FLAG(std::string, dump_output, "", "Aec dump output filename");
 ABSL_FLAG(std::string, i, "", "Forward stream input wav filename");
 ABSL_FLAG(std::string, o, "", "Forward stream output wav filename");
@@ -313,6 +323,27 @@ ABSL_FLAG(int,
           kParameterNotSpecifiedValue,
           "Init index to process.");
 
+ABSL_FLAG(int,
+          replay_threads,
+          kParameterNotSpecifiedValue,
+          "Number of threads to replay the aec dumps in --dump_input_dir on "
+          "(default: the number of cores)");
+ABSL_FLAG(std::string,
+          replay_report_output_file,
+          "",
+          "Generate a CSV file with the output digests and API call CPU times "
+          "of the aec dumps in --dump_input_dir");
+ABSL_FLAG(std::string,
+          replay_baseline_file,
+          "",
+          "CSV file, as generated by --replay_report_output_file, to compare "
+          "the replay of --dump_input_dir against");
+ABSL_FLAG(float,
+          max_replay_time_increase,
+          0.1f,
+          "Relative API call CPU time increase over --replay_baseline_file "
+          "that is tolerated");
+
 ABSL_FLAG(bool,
           float_wav_output,
           false,
@@ -333,6 +364,8 @@ const char kUsageDescription[] =
     "Usage: audioproc_f [options] -i <input.wav>\n"
     "                   or\n"
     "       audioproc_f [options] -dump_input <aec_dump>\n"
+    "                   or\n"
+    "       audioproc_f [options] -dump_input_dir <aec_dump_directory>\n"
     "\n\n"
     "Command-line tool to simulate a call using the audio "
     "processing module, either based on wav files or "
@@ -745,6 +778,124 @@ void PerformBasicParameterSanityChecks(
   }
 }
 
+void PerformReplayParameterSanityChecks(
+    const SimulationSettings& settings,
+    bool pre_constructed_ap_provided,
+    bool pre_constructed_ap_builder_provided) {
+  ReportConditionalErrorAndExit(
+      pre_constructed_ap_provided || pre_constructed_ap_builder_provided,
+      "Error: --dump_input_dir cannot be used with a pre-constructed audio "
+      "processing object or builder, as each aec dump is replayed using its "
+      "own audio processing object.\n");
+
+  ReportConditionalErrorAndExit(
+      settings.aec_dump_input_filename || settings.aec_dump_input_string ||
+          settings.input_filename || settings.reverse_input_filename ||
+          settings.artificial_nearend_filename,
+      "Error: --dump_input_dir cannot be specified together with other "
+      "inputs.\n");
+
+  ReportConditionalErrorAndExit(
+      settings.output_filename || settings.reverse_output_filename ||
+          settings.linear_aec_output_filename ||
+          settings.aec_dump_output_filename ||
+          settings.performance_report_output_filename ||
+          settings.call_order_input_filename ||
+          settings.call_order_output_filename ||
+          settings.ed_graph_output_filename || settings.dump_internal_data,
+      "Error: --dump_input_dir cannot be specified together with per-recording "
+      "input or output files.\n");
+
+  ReportConditionalErrorAndExit(
+      settings.analysis_only,
+      "Error: --dump_input_dir cannot be specified together with --analyze.\n");
+
+  ReportConditionalErrorAndExit(
+      absl::GetFlag(FLAGS_replay_threads) != kParameterNotSpecifiedValue &&
+          absl::GetFlag(FLAGS_replay_threads) <= 0,
+      "Error: --replay_threads must be positive.\n");
+}
+
+// Replays all aec dumps in --dump_input_dir in parallel, and optionally
+// stores the results and compares them against a baseline. Files that cannot
+// be replayed are left out of the stored results and of the comparison.
+// Returns a non-zero value if any file cannot be replayed or if the comparison
+// against the baseline fails.
+int RunReplay(const SimulationSettings& settings) {
+  const std::string directory = absl::GetFlag(FLAGS_dump_input_dir);
+  int num_threads = absl::GetFlag(FLAGS_replay_threads);
+  if (num_threads == kParameterNotSpecifiedValue) {
+    num_threads = CpuInfo::DetectNumberOfCores();
+  }
+
+  const int64_t start_time_ms = rtc::TimeMillis();
+  std::vector<AecDumpReplayResult> all_results =
+      ReplayAecDumps(settings, directory, num_threads);
+  ReportConditionalErrorAndExit(
+      all_results.empty(), "Error: No aec dumps found in --dump_input_dir.");
+  std::vector<AecDumpReplayResult> results;
+  std::vector<AecDumpReplayResult> failed_results;
+  for (auto& result : all_results) {
+    (result.error.empty() ? results : failed_results)
+        .push_back(std::move(result));
+  }
+
+  int64_t render_time_us = 0;
+  int64_t capture_time_us = 0;
+  for (const auto& result : results) {
+    render_time_us += result.render_time_us;
+    capture_time_us += result.capture_time_us;
+  }
+  if (!settings.use_quiet_output) {
+    std::cout << "Replayed " << results.size() << " aec dumps on "
+              << num_threads << " threads in "
+              << (rtc::TimeMillis() - start_time_ms) * 1e-3 << " s" << std::endl
+              << " Render API calls CPU time: " << render_time_us * 1e-6
+              << " s" << std::endl
+              << " Capture API calls CPU time: " << capture_time_us * 1e-6
+              << " s" << std::endl;
+  }
+
+  const std::string report_filename =
+      absl::GetFlag(FLAGS_replay_report_output_file);
+  if (!report_filename.empty()) {
+    std::ofstream report(report_filename);
+    report << AecDumpReplayResultsToCsv(results);
+  }
+
+  bool passed = true;
+  const std::string baseline_filename =
+      absl::GetFlag(FLAGS_replay_baseline_file);
+  if (!baseline_filename.empty()) {
+    std::ifstream baseline_file(baseline_filename);
+    ReportConditionalErrorAndExit(!baseline_file.good(),
+                                  "Error: Cannot open --replay_baseline_file.");
+    const std::string baseline_csv(
+        (std::istreambuf_iterator<char>(baseline_file)),
+        std::istreambuf_iterator<char>());
+    const absl::optional<std::vector<AecDumpReplayResult>> baseline =
+        ParseAecDumpReplayCsv(baseline_csv);
+    ReportConditionalErrorAndExit(!baseline,
+                                  "Error: Malformed --replay_baseline_file.");
+
+    const float max_time_increase =
+        absl::GetFlag(FLAGS_max_replay_time_increase);
+    const AecDumpReplayComparison comparison =
+        CompareAecDumpReplays(results, *baseline, max_time_increase);
+    comparison.PrintReport();
+    passed = comparison.Passed(max_time_increase);
+  }
+
+  if (!failed_results.empty()) {
+    std::cerr << "Error: These files could not be replayed:" << std::endl;
+    for (const auto& result : failed_results) {
+      std::cerr << " " << result.name << ": " << result.error << std::endl;
+    }
+    passed = false;
+  }
+  return passed ? 0 : 1;
+}
+
 int RunSimulation(rtc::scoped_refptr<AudioProcessing> audio_processing,
                   std::unique_ptr<AudioProcessingBuilder> ap_builder,
                   int argc,
@@ -767,19 +918,36 @@ int RunSimulation(rtc::scoped_refptr<AudioProcessing> audio_processing,
     settings.processed_capture_samples = processed_capture_samples;
     RTC_CHECK(settings.processed_capture_samples);
   }
+  if (!absl::GetFlag(FLAGS_dump_input_dir).empty()) {
+    PerformReplayParameterSanityChecks(settings, !!audio_processing,
+                                       !!ap_builder);
+    return RunReplay(settings);
+  }
   PerformBasicParameterSanityChecks(settings, !!audio_processing, !!ap_builder);
   std::unique_ptr<AudioProcessingSimulator> processor;
+  AecDumpBasedSimulator* aec_dump_processor = nullptr;
 
   if (settings.aec_dump_input_filename || settings.aec_dump_input_string) {
-    processor.reset(new AecDumpBasedSimulator(
-        settings, std::move(audio_processing), std::move(ap_builder)));
+    aec_dump_processor = new AecDumpBasedSimulator(
+        settings, std::move(audio_processing), std::move(ap_builder));
+    processor.reset(aec_dump_processor);
   } else {
     processor.reset(new WavBasedSimulator(settings, std::move(audio_processing),
                                           std::move(ap_builder)));
   }
 
+  int exit_code = 0;
   if (settings.analysis_only) {
     processor->Analyze();
+  } else if (aec_dump_processor) {
+    // The output of an aec dump that cannot be processed completely is
+    // incomplete, which is reported through the exit code.
+    const std::string error = aec_dump_processor->TryProcess();
+    if (!error.empty()) {
+      std::cerr << "Error: Processing of the aec dump stopped: " << error
+                << std::endl;
+      exit_code = 1;
+    }
   } else {
     processor->Process();
   }
@@ -800,7 +968,7 @@ int RunSimulation(rtc::scoped_refptr<AudioProcessing> audio_processing,
     }
   }
 
-  return 0;
+  return exit_code;
 }
 
 }  // namespace
@@ -183,6 +183,10 @@ void Aec3ConfigFromJsonString(absl::string_view json_string,
               &cfg.buffering.excess_render_detection_interval_blocks);
     ReadParam(section, "max_allowed_excess_render_blocks",
               &cfg.buffering.max_allowed_excess_render_blocks);
+    ReadParam(section, "pipelined_render_processing",
+              &cfg.buffering.pipelined_render_processing);
+    ReadParam(section, "realtime_render_worker",
+              &cfg.buffering.realtime_render_worker);
   }
 
   if (rtc::GetValueFromJsonObject(aec3_root, "delay", &section)) {
@@ -437,7 +441,12 @@ std::string Aec3ConfigToJsonString(const EchoCanceller3Config& config) {
   ost << "\"excess_render_detection_interval_blocks\": "
       << config.buffering.excess_render_detection_interval_blocks << ",";
   ost << "\"max_allowed_excess_render_blocks\": "
-      << config.buffering.max_allowed_excess_render_blocks;
+      << config.buffering.max_allowed_excess_render_blocks << ",";
+  ost << "\"pipelined_render_processing\": "
+      << (config.buffering.pipelined_render_processing ? "true" : "false")
+      << ",";
+  ost << "\"realtime_render_worker\": "
+      << (config.buffering.realtime_render_worker ? "true" : "false");
   ost << "},";
 
   ost << "\"delay\": {";
@@ -17,6 +17,8 @@ namespace webrtc {
 
 TEST(EchoCanceller3JsonHelpers, ToStringAndParseJson) {
   EchoCanceller3Config cfg;
+  cfg.buffering.pipelined_render_processing = true;
+  cfg.buffering.realtime_render_worker = true;
   cfg.delay.down_sampling_factor = 1u;
   cfg.delay.log_warning_on_delay_changes = true;
   cfg.filter.refined.error_floor = 2.f;
@@ -52,6 +54,10 @@ TEST(EchoCanceller3JsonHelpers, ToStringAndParseJson) {
             cfg_transformed.suppressor.normal_tuning.mask_lf.enr_suppress);
 
   // Expect changed values to carry through the transformation.
+  EXPECT_EQ(cfg.buffering.pipelined_render_processing,
+            cfg_transformed.buffering.pipelined_render_processing);
+  EXPECT_EQ(cfg.buffering.realtime_render_worker,
+            cfg_transformed.buffering.realtime_render_worker);
   EXPECT_EQ(cfg.delay.down_sampling_factor,
             cfg_transformed.delay.down_sampling_factor);
   EXPECT_EQ(cfg.delay.log_warning_on_delay_changes,
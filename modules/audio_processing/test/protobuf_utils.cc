@@ -10,70 +10,106 @@
 
 #include "modules/audio_processing/test/protobuf_utils.h"
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <vector>
 
 #include "rtc_base/system/arch.h"
 
+namespace webrtc {
 namespace {
-// Allocates new memory in the memory owned by the unique_ptr to fit the raw
-// message and returns the number of bytes read when having a string stream as
-// input.
-size_t ReadMessageBytesFromString(std::stringstream* input,
-                                  std::unique_ptr<uint8_t[]>* bytes) {
-  int32_t size = 0;
-  input->read(reinterpret_cast<char*>(&size), sizeof(int32_t));
-  int32_t size_read = input->gcount();
-  if (size_read != sizeof(int32_t))
-    return 0;
-  if (size <= 0)
-    return 0;
 
-  *bytes = std::make_unique<uint8_t[]>(size);
-  input->read(reinterpret_cast<char*>(bytes->get()),
-              size * sizeof((*bytes)[0]));
-  size_read = input->gcount();
-  return size_read == size ? size : 0;
-}
-}  // namespace
+// The bytes of a message are read in chunks of at most this size, so that a
+// corrupt message size does not allocate much more memory than the input
+// holds.
+constexpr size_t kMaxChunkBytes = 1 << 20;
 
-namespace webrtc {
-
-size_t ReadMessageBytesFromFile(FILE* file, std::unique_ptr<uint8_t[]>* bytes) {
+// Reads the size and then the bytes of the next message with `read`, which
+// reads up to the requested number of bytes and returns how many it read.
+template <typename ReadFunction>
+ReadMessageResult ReadMessageBytes(ReadFunction read,
+                                   std::vector<uint8_t>* bytes) {
 // The "wire format" for the size is little-endian. Assume we're running on
 // a little-endian machine.
 #ifndef WEBRTC_ARCH_LITTLE_ENDIAN
 #error "Need to convert messsage from little-endian."
 #endif
   int32_t size = 0;
-  if (fread(&size, sizeof(size), 1, file) != 1)
-    return 0;
-  if (size <= 0)
+  const size_t size_bytes = read(&size, sizeof(size));
+  if (size_bytes == 0) {
+    return ReadMessageResult::kEndOfInput;
+  }
+  if (size_bytes != sizeof(size) || size <= 0) {
+    return ReadMessageResult::kCorruptMessage;
+  }
+
+  bytes->clear();
+  while (bytes->size() < static_cast<size_t>(size)) {
+    const size_t num_read = bytes->size();
+    bytes->resize(
+        std::min(static_cast<size_t>(size), num_read + kMaxChunkBytes));
+    const size_t chunk_size = bytes->size() - num_read;
+    if (read(bytes->data() + num_read, chunk_size) != chunk_size) {
+      return ReadMessageResult::kCorruptMessage;
+    }
+  }
+  return ReadMessageResult::kSuccess;
+}
+
+ReadMessageResult ParseMessage(ReadMessageResult result,
+                               const std::vector<uint8_t>& bytes,
+                               MessageLite* msg) {
+  if (result != ReadMessageResult::kSuccess) {
+    return result;
+  }
+  msg->Clear();
+  return msg->ParseFromArray(bytes.data(), bytes.size())
+             ? ReadMessageResult::kSuccess
+             : ReadMessageResult::kCorruptMessage;
+}
+
+}  // namespace
+
+size_t ReadMessageBytesFromFile(FILE* file, std::unique_ptr<uint8_t[]>* bytes) {
+  std::vector<uint8_t> message_bytes;
+  if (ReadMessageBytes(
+          [file](void* data, size_t size) {
+            return fread(data, 1, size, file);
+          },
+          &message_bytes) != ReadMessageResult::kSuccess) {
     return 0;
+  }
+  *bytes = std::make_unique<uint8_t[]>(message_bytes.size());
+  memcpy(bytes->get(), message_bytes.data(), message_bytes.size());
+  return message_bytes.size();
+}
 
-  *bytes = std::make_unique<uint8_t[]>(size);
-  return fread(bytes->get(), sizeof((*bytes)[0]), size, file);
+ReadMessageResult ReadMessage(FILE* file, MessageLite* msg) {
+  std::vector<uint8_t> bytes;
+  const ReadMessageResult result = ReadMessageBytes(
+      [file](void* data, size_t size) { return fread(data, 1, size, file); },
+      &bytes);
+  return ParseMessage(result, bytes, msg);
 }
 
-// Returns true on success, false on error or end-of-file.
-bool ReadMessageFromFile(FILE* file, MessageLite* msg) {
-  std::unique_ptr<uint8_t[]> bytes;
-  size_t size = ReadMessageBytesFromFile(file, &bytes);
-  if (!size)
-    return false;
+ReadMessageResult ReadMessage(std::stringstream* input, MessageLite* msg) {
+  std::vector<uint8_t> bytes;
+  const ReadMessageResult result = ReadMessageBytes(
+      [input](void* data, size_t size) -> size_t {
+        input->read(static_cast<char*>(data), size);
+        return input->gcount();
+      },
+      &bytes);
+  return ParseMessage(result, bytes, msg);
+}
 
-  msg->Clear();
-  return msg->ParseFromArray(bytes.get(), size);
+bool ReadMessageFromFile(FILE* file, MessageLite* msg) {
+  return ReadMessage(file, msg) == ReadMessageResult::kSuccess;
 }
 
-// Returns true on success, false on error or end of string stream.
 bool ReadMessageFromString(std::stringstream* input, MessageLite* msg) {
-  std::unique_ptr<uint8_t[]> bytes;
-  size_t size = ReadMessageBytesFromString(input, &bytes);
-  if (!size)
-    return false;
-
-  msg->Clear();
-  return msg->ParseFromArray(bytes.get(), size);
+  return ReadMessage(input, msg) == ReadMessageResult::kSuccess;
 }
 
 }  // namespace webrtc
@@ -21,10 +21,28 @@
 
 namespace webrtc {
 
+// Outcome of reading a size-prefixed message.
+enum class ReadMessageResult {
+  kSuccess,
+  // The input ended before the next message.
+  kEndOfInput,
+  // The input ended within the message, or the message is malformed.
+  kCorruptMessage,
+};
+
 // Allocates new memory in the unique_ptr to fit the raw message and returns the
-// number of bytes read.
+// number of bytes read. Returns 0 at the end of the file, and if the message is
+// cut short.
 size_t ReadMessageBytesFromFile(FILE* file, std::unique_ptr<uint8_t[]>* bytes);
 
+// Reads the next message from `file` or `input`. Unlike ReadMessageFromFile()
+// and ReadMessageFromString(), tells the end of the input apart from a
+// truncated or corrupt message.
+ReadMessageResult ReadMessage(FILE* file, MessageLite* msg);
+ReadMessageResult ReadMessage(
+    std::stringstream* input,  // no-presubmit-check TODO(webrtc:8982)
+    MessageLite* msg);
+
 // Returns true on success, false on error or end-of-file.
 bool ReadMessageFromFile(FILE* file, MessageLite* msg);
 
@@ -21,6 +21,8 @@
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "modules/pacing/bitrate_prober.h"
+#include "modules/pacing/prioritized_packet_queue.h"
+#include "modules/pacing/weighted_fair_packet_queue.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -42,6 +44,21 @@ bool IsEnabled(const FieldTrialsView& field_trials, absl::string_view key) {
   return absl::StartsWith(field_trials.Lookup(key), "Enabled");
 }
 
+std::unique_ptr<PacketQueueInterface> CreatePacketQueue(
+    const FieldTrialsView& field_trials,
+    const PacingController::Configuration& configuration,
+    Timestamp creation_time) {
+  if (configuration.weighted_fair_queueing ||
+      IsEnabled(field_trials, "WebRTC-Pacer-WeightedFairQueueing")) {
+    return std::make_unique<WeightedFairPacketQueue>(
+        creation_time, configuration.prioritize_audio_retransmission,
+        configuration.packet_queue_ttl);
+  }
+  return std::make_unique<PrioritizedPacketQueue>(
+      creation_time, configuration.prioritize_audio_retransmission,
+      configuration.packet_queue_ttl);
+}
+
 }  // namespace
 
 const TimeDelta PacingController::kPausedProcessInterval =
@@ -87,9 +104,8 @@ PacingController::PacingController(Clock* clock,
       last_process_time_(clock->CurrentTime()),
       last_send_time_(last_process_time_),
       seen_first_packet_(false),
-      packet_queue_(/*creation_time=*/last_process_time_,
-                    configuration.prioritize_audio_retransmission,
-                    configuration.packet_queue_ttl),
+      packet_queue_(CreatePacketQueue(field_trials_, configuration,
+                                      /*creation_time=*/last_process_time_)),
       congested_(false),
       queue_time_limit_(configuration.queue_time_limit),
       account_for_audio_(false),
@@ -114,14 +130,14 @@ void PacingController::Pause() {
   if (!paused_)
     RTC_LOG(LS_INFO) << "PacedSender paused.";
   paused_ = true;
-  packet_queue_.SetPauseState(true, CurrentTime());
+  packet_queue_->SetPauseState(true, CurrentTime());
 }
 
 void PacingController::Resume() {
   if (paused_)
     RTC_LOG(LS_INFO) << "PacedSender resumed.";
   paused_ = false;
-  packet_queue_.SetPauseState(false, CurrentTime());
+  packet_queue_->SetPauseState(false, CurrentTime());
 }
 
 bool PacingController::IsPaused() const {
@@ -140,7 +156,11 @@ void PacingController::SetCircuitBreakerThreshold(int num_iterations) {
 }
 
 void PacingController::RemovePacketsForSsrc(uint32_t ssrc) {
-  packet_queue_.RemovePacketsForSsrc(ssrc);
+  packet_queue_->RemovePacketsForSsrc(ssrc);
+}
+
+void PacingController::SetStreamWeight(uint32_t ssrc, double weight) {
+  packet_queue_->SetStreamWeight(ssrc, weight);
 }
 
 bool PacingController::IsProbing() const {
@@ -199,22 +219,22 @@ void PacingController::EnqueuePacket(std::unique_ptr<RtpPacketToSend> packet) {
   if (keyframe_flushing_ &&
       packet->packet_type() == RtpPacketMediaType::kVideo &&
       packet->is_key_frame() && packet->is_first_packet_of_frame() &&
-      !packet_queue_.HasKeyframePackets(packet->Ssrc())) {
+      !packet_queue_->HasKeyframePackets(packet->Ssrc())) {
     // First packet of a keyframe (and no keyframe packets currently in the
     // queue). Flush any pending packets currently in the queue for that stream
     // in order to get the new keyframe out as quickly as possible.
-    packet_queue_.RemovePacketsForSsrc(packet->Ssrc());
+    packet_queue_->RemovePacketsForSsrc(packet->Ssrc());
     absl::optional<uint32_t> rtx_ssrc =
         packet_sender_->GetRtxSsrcForMedia(packet->Ssrc());
     if (rtx_ssrc) {
-      packet_queue_.RemovePacketsForSsrc(*rtx_ssrc);
+      packet_queue_->RemovePacketsForSsrc(*rtx_ssrc);
     }
   }
 
   prober_.OnIncomingPacket(DataSize::Bytes(packet->payload_size()));
 
   const Timestamp now = CurrentTime();
-  if (packet_queue_.Empty()) {
+  if (packet_queue_->Empty()) {
     // If queue is empty, we need to "fast-forward" the last process time,
     // so that we don't use passed time as budget for sending the first new
     // packet.
@@ -227,7 +247,7 @@ void PacingController::EnqueuePacket(std::unique_ptr<RtpPacketToSend> packet) {
     }
     UpdateBudgetWithElapsedTime(UpdateTimeAndGetElapsed(target_process_time));
   }
-  packet_queue_.Push(now, std::move(packet));
+  packet_queue_->Push(now, std::move(packet));
   seen_first_packet_ = true;
 
   // Queue length has increased, check if we need to change the pacing rate.
@@ -262,18 +282,18 @@ TimeDelta PacingController::ExpectedQueueTime() const {
 }
 
 size_t PacingController::QueueSizePackets() const {
-  return rtc::checked_cast<size_t>(packet_queue_.SizeInPackets());
+  return rtc::checked_cast<size_t>(packet_queue_->SizeInPackets());
 }
 
 const std::array<int, kNumMediaTypes>&
 PacingController::SizeInPacketsPerRtpPacketMediaType() const {
-  return packet_queue_.SizeInPacketsPerRtpPacketMediaType();
+  return packet_queue_->SizeInPacketsPerRtpPacketMediaType();
 }
 
 DataSize PacingController::QueueSizeData() const {
-  DataSize size = packet_queue_.SizeInPayloadBytes();
+  DataSize size = packet_queue_->SizeInPayloadBytes();
   if (include_overhead_) {
-    size += static_cast<int64_t>(packet_queue_.SizeInPackets()) *
+    size += static_cast<int64_t>(packet_queue_->SizeInPackets()) *
             transport_overhead_per_packet_;
   }
   return size;
@@ -288,7 +308,7 @@ absl::optional<Timestamp> PacingController::FirstSentPacketTime() const {
 }
 
 Timestamp PacingController::OldestPacketEnqueueTime() const {
-  return packet_queue_.OldestEnqueueTime();
+  return packet_queue_->OldestEnqueueTime();
 }
 
 TimeDelta PacingController::UpdateTimeAndGetElapsed(Timestamp now) {
@@ -347,7 +367,7 @@ Timestamp PacingController::NextSendTime() const {
     return last_send_time_ + kCongestedPacketInterval;
   }
 
-  if (adjusted_media_rate_ > DataRate::Zero() && !packet_queue_.Empty()) {
+  if (adjusted_media_rate_ > DataRate::Zero() && !packet_queue_->Empty()) {
     // If packets are allowed to be sent in a burst, the
     // debt is allowed to grow up to one packet more than what can be sent
     // during 'send_burst_period_'.
@@ -359,7 +379,7 @@ Timestamp PacingController::NextSendTime() const {
     next_send_time =
         last_process_time_ +
         ((send_burst_interval > drain_time) ? TimeDelta::Zero() : drain_time);
-  } else if (padding_rate_ > DataRate::Zero() && packet_queue_.Empty()) {
+  } else if (padding_rate_ > DataRate::Zero() && packet_queue_->Empty()) {
     // If we _don't_ have pending packets, check how long until we have
     // bandwidth for padding packets. Both media and padding debts must
     // have been drained to do this.
@@ -554,9 +574,9 @@ void PacingController::ProcessPackets() {
         << ", pacing_rate = " << pacing_rate_.bps()
         << ", adjusted_media_rate = " << adjusted_media_rate_.bps()
         << ", padding_rate = " << padding_rate_.bps()
-        << ", queue size (packets) = " << packet_queue_.SizeInPackets()
+        << ", queue size (packets) = " << packet_queue_->SizeInPackets()
         << ", queue size (payload bytes) = "
-        << packet_queue_.SizeInPayloadBytes();
+        << packet_queue_->SizeInPayloadBytes();
     last_send_time_ = now;
     last_process_time_ = now;
     return;
@@ -577,7 +597,7 @@ void PacingController::ProcessPackets() {
 
 DataSize PacingController::PaddingToAdd(DataSize recommended_probe_size,
                                         DataSize data_sent) const {
-  if (!packet_queue_.Empty()) {
+  if (!packet_queue_->Empty()) {
     // Actual payload available, no need to add padding.
     return DataSize::Zero();
   }
@@ -620,7 +640,7 @@ std::unique_ptr<RtpPacketToSend> PacingController::GetPendingPacket(
     }
   }
 
-  if (packet_queue_.Empty()) {
+  if (packet_queue_->Empty()) {
     return nullptr;
   }
 
@@ -645,7 +665,7 @@ std::unique_ptr<RtpPacketToSend> PacingController::GetPendingPacket(
     }
   }
 
-  return packet_queue_.Pop();
+  return packet_queue_->Pop();
 }
 
 void PacingController::OnPacketSent(RtpPacketMediaType packet_type,
@@ -694,10 +714,10 @@ void PacingController::MaybeUpdateMediaRateDueToLongQueue(Timestamp now) {
     // Assuming equal size packets and input/output rate, the average packet
     // has avg_time_left_ms left to get queue_size_bytes out of the queue, if
     // time constraint shall be met. Determine bitrate needed for that.
-    packet_queue_.UpdateAverageQueueTime(now);
+    packet_queue_->UpdateAverageQueueTime(now);
     TimeDelta avg_time_left =
         std::max(TimeDelta::Millis(1),
-                 queue_time_limit_ - packet_queue_.AverageQueueTime());
+                 queue_time_limit_ - packet_queue_->AverageQueueTime());
     DataRate min_rate_needed = queue_size_data / avg_time_left;
     if (min_rate_needed > pacing_rate_) {
       adjusted_media_rate_ = min_rate_needed;
@@ -710,14 +730,14 @@ void PacingController::MaybeUpdateMediaRateDueToLongQueue(Timestamp now) {
 Timestamp PacingController::NextUnpacedSendTime() const {
   if (!pace_audio_) {
     Timestamp leading_audio_send_time =
-        packet_queue_.LeadingPacketEnqueueTime(RtpPacketMediaType::kAudio);
+        packet_queue_->LeadingPacketEnqueueTime(RtpPacketMediaType::kAudio);
     if (leading_audio_send_time.IsFinite()) {
       return leading_audio_send_time;
     }
   }
   if (fast_retransmissions_) {
     Timestamp leading_retransmission_send_time =
-        packet_queue_.LeadingPacketEnqueueTimeForRetransmission();
+        packet_queue_->LeadingPacketEnqueueTimeForRetransmission();
     if (leading_retransmission_send_time.IsFinite()) {
       return leading_retransmission_send_time;
     }
@@ -28,7 +28,7 @@
 #include "api/units/time_delta.h"
 #include "modules/pacing/bitrate_prober.h"
 #include "modules/pacing/interval_budget.h"
-#include "modules/pacing/prioritized_packet_queue.h"
+#include "modules/pacing/packet_queue_interface.h"
 #include "modules/pacing/rtp_packet_pacer.h"
 #include "modules/rtp_rtcp/include/rtp_packet_sender.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
@@ -115,6 +115,10 @@ class PacingController {
     // Note: to set TTL on audio retransmission,
     // `prioritize_audio_retransmission` must be true.
     PacketQueueTTL packet_queue_ttl;
+    // Share the send rate among RTP streams of the same packet type by stream
+    // weight, see SetStreamWeight(), instead of sending one packet per stream
+    // in turn. Meant for senders of many streams, such as SFUs.
+    bool weighted_fair_queueing = false;
     // The pacer is allowed to send enqueued packets in bursts and can build up
     // a packet "debt" that correspond to approximately the send rate during the
     // burst interval.
@@ -209,6 +213,11 @@ class PacingController {
   // Remove any pending packets matching this SSRC from the packet queue.
   void RemovePacketsForSsrc(uint32_t ssrc);
 
+  // Sets the share of the send rate of the RTP stream `ssrc` relative to
+  // other streams with packets of the same type. Only used with weighted fair
+  // queueing.
+  void SetStreamWeight(uint32_t ssrc, double weight);
+
  private:
   TimeDelta UpdateTimeAndGetElapsed(Timestamp now);
   bool ShouldSendKeepalive(Timestamp now) const;
@@ -278,7 +287,7 @@ class PacingController {
   absl::optional<Timestamp> first_sent_packet_time_;
   bool seen_first_packet_;
 
-  PrioritizedPacketQueue packet_queue_;
+  const std::unique_ptr<PacketQueueInterface> packet_queue_;
 
   bool congested_;
 
@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -2377,6 +2378,36 @@ TEST_F(PacingControllerTest, FlushesPacketsOnKeyFrames) {
   pacer->ProcessPackets();
 }
 
+TEST_F(PacingControllerTest, SharesSendRateByStreamWeightInTrial) {
+  const uint32_t kSsrc = 12345;
+  const uint32_t kHighWeightSsrc = 12346;
+
+  const test::ExplicitKeyValueConfig trials(
+      "WebRTC-Pacer-WeightedFairQueueing/Enabled/");
+  auto pacer = std::make_unique<PacingController>(&clock_, &callback_, trials);
+  pacer->SetPacingRates(kTargetRate, DataRate::Zero());
+  pacer->SetStreamWeight(kHighWeightSsrc, 3.0);
+  for (uint16_t sequence_number = 0; sequence_number < 200; ++sequence_number) {
+    pacer->EnqueuePacket(BuildPacket(RtpPacketMediaType::kVideo, kSsrc,
+                                     sequence_number, /*capture_time_ms=*/1,
+                                     /*size=*/1000));
+    pacer->EnqueuePacket(BuildPacket(RtpPacketMediaType::kVideo,
+                                     kHighWeightSsrc, sequence_number,
+                                     /*capture_time_ms=*/1, /*size=*/1000));
+  }
+
+  std::map<uint32_t, int> packets_sent;
+  EXPECT_CALL(callback_, SendPacket)
+      .WillRepeatedly([&](uint32_t ssrc, uint16_t, int64_t, bool, bool) {
+        ++packets_sent[ssrc];
+      });
+  while (pacer->QueueSizePackets() > 200) {
+    AdvanceTimeUntil(pacer->NextSendTime());
+    pacer->ProcessPackets();
+  }
+  EXPECT_NEAR(packets_sent[kHighWeightSsrc], 3 * packets_sent[kSsrc], 6);
+}
+
 TEST_F(PacingControllerTest, CanControlQueueSizeUsingTtl) {
   const uint32_t kSsrc = 12345;
   const uint32_t kAudioSsrc = 2345;
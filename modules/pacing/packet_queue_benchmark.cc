@@ -0,0 +1,115 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "modules/pacing/packet_queue_interface.h"
+#include "modules/pacing/prioritized_packet_queue.h"
+#include "modules/pacing/weighted_fair_packet_queue.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kPayloadSize = 1100;
+// Packets queued per stream, about one frame of a high simulcast layer.
+constexpr int kPacketsPerStream = 8;
+// Simulcast layers get weights 1, 2 and 4 in the weighted benchmarks.
+constexpr int kNumLayers = 3;
+
+std::unique_ptr<RtpPacketToSend> CreatePacket(uint32_t ssrc, uint16_t seq) {
+  auto packet = std::make_unique<RtpPacketToSend>(/*extensions=*/nullptr);
+  packet->set_packet_type(RtpPacketMediaType::kVideo);
+  packet->SetSsrc(ssrc);
+  packet->SetSequenceNumber(seq);
+  packet->SetPayloadSize(kPayloadSize);
+  return packet;
+}
+
+// Steady state of a pacer sending `state.range(0)` streams: each packet sent
+// is replaced by a new packet on the same stream. Packets are reused, so
+// that the benchmark measures the queue rather than packet allocation. With
+// `state.range(1)` set, the queue drops video packets after one second,
+// which none of the packets reach.
+template <typename Queue>
+void BM_PacketQueueSteadyState(benchmark::State& state) {
+  const int num_streams = state.range(0);
+  PacketQueueTTL ttl;
+  if (state.range(1) != 0) {
+    ttl.video = TimeDelta::Seconds(1);
+  }
+  Timestamp now = Timestamp::Seconds(1);
+  Queue queue(now, /*prioritize_audio_retransmission=*/false, ttl);
+  for (int ssrc = 1; ssrc <= num_streams; ++ssrc) {
+    queue.SetStreamWeight(ssrc, 1 << (ssrc % kNumLayers));
+    for (int seq = 0; seq < kPacketsPerStream; ++seq) {
+      queue.Push(now, CreatePacket(ssrc, seq));
+    }
+  }
+
+  for (auto _ : state) {
+    std::unique_ptr<RtpPacketToSend> packet = queue.Pop();
+    now += TimeDelta::Micros(1);
+    queue.UpdateAverageQueueTime(now);
+    queue.Push(now, std::move(packet));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Pushes one frame on each of `state.range(0)` streams, then sends all of
+// them.
+template <typename Queue>
+void BM_PacketQueueFrameBurst(benchmark::State& state) {
+  const int num_streams = state.range(0);
+  Timestamp now = Timestamp::Seconds(1);
+  Queue queue(now);
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  for (int ssrc = 1; ssrc <= num_streams; ++ssrc) {
+    queue.SetStreamWeight(ssrc, 1 << (ssrc % kNumLayers));
+    for (int seq = 0; seq < kPacketsPerStream; ++seq) {
+      packets.push_back(CreatePacket(ssrc, seq));
+    }
+  }
+
+  for (auto _ : state) {
+    now += TimeDelta::Millis(1);
+    for (std::unique_ptr<RtpPacketToSend>& packet : packets) {
+      queue.Push(now, std::move(packet));
+    }
+    for (std::unique_ptr<RtpPacketToSend>& packet : packets) {
+      packet = queue.Pop();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * packets.size());
+}
+
+BENCHMARK_TEMPLATE(BM_PacketQueueSteadyState, PrioritizedPacketQueue)
+    ->ArgsProduct({{10, 100, 1000}, {0, 1}});
+BENCHMARK_TEMPLATE(BM_PacketQueueSteadyState, WeightedFairPacketQueue)
+    ->ArgsProduct({{10, 100, 1000}, {0, 1}});
+BENCHMARK_TEMPLATE(BM_PacketQueueFrameBurst, PrioritizedPacketQueue)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000);
+BENCHMARK_TEMPLATE(BM_PacketQueueFrameBurst, WeightedFairPacketQueue)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000);
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,47 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/packet_queue_interface.h"
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+int GetPacketPriorityLevel(
+    RtpPacketMediaType type,
+    absl::optional<RtpPacketToSend::OriginalType> original_type) {
+  constexpr int kAudioPrioLevel = 0;
+  // Lower number takes priority over higher.
+  switch (type) {
+    case RtpPacketMediaType::kAudio:
+      // Audio is always prioritized over other packet types.
+      return kAudioPrioLevel;
+    case RtpPacketMediaType::kRetransmission:
+      // Send retransmissions before new media. If original_type is set, audio
+      // retransmission is prioritized more than video retransmission.
+      if (original_type == RtpPacketToSend::OriginalType::kVideo) {
+        return kAudioPrioLevel + 2;
+      }
+      return kAudioPrioLevel + 1;
+    case RtpPacketMediaType::kVideo:
+    case RtpPacketMediaType::kForwardErrorCorrection:
+      // Video has "normal" priority, in the old speak.
+      // Send redundancy concurrently to video. If it is delayed it might have a
+      // lower chance of being useful.
+      return kAudioPrioLevel + 3;
+    case RtpPacketMediaType::kPadding:
+      // Packets that are in themselves likely useless, only sent to keep the
+      // BWE high.
+      return kAudioPrioLevel + 4;
+  }
+  RTC_CHECK_NOTREACHED();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_PACKET_QUEUE_INTERFACE_H_
+#define MODULES_PACING_PACKET_QUEUE_INTERFACE_H_
+
+#include <stdint.h>
+
+#include <array>
+#include <memory>
+
+#include "absl/types/optional.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+
+namespace webrtc {
+
+// Describes how long time a packet may stay in the queue before being dropped.
+struct PacketQueueTTL {
+  TimeDelta audio_retransmission = TimeDelta::PlusInfinity();
+  TimeDelta video_retransmission = TimeDelta::PlusInfinity();
+  TimeDelta video = TimeDelta::PlusInfinity();
+};
+
+// Number of priority levels the packet queues sort packets into by type.
+inline constexpr int kNumPacketPriorityLevels = 5;
+
+// Returns the priority level of packets of the given type, lower levels are
+// sent first: audio, retransmissions, video / fec, padding. If
+// `original_type` is set, audio retransmissions are sent before video
+// retransmissions.
+int GetPacketPriorityLevel(
+    RtpPacketMediaType type,
+    absl::optional<RtpPacketToSend::OriginalType> original_type);
+
+// The queue of packets waiting to be sent by the PacingController. The
+// implementations differ in the order packets of different RTP streams are
+// sent in.
+class PacketQueueInterface {
+ public:
+  virtual ~PacketQueueInterface() = default;
+
+  // Add a packet to the queue. The enqueue time is used for queue time stats
+  // and to report the leading packet enqueue time per packet type.
+  virtual void Push(Timestamp enqueue_time,
+                    std::unique_ptr<RtpPacketToSend> packet) = 0;
+
+  // Remove the next packet from the queue, nullptr if the queue is empty.
+  virtual std::unique_ptr<RtpPacketToSend> Pop() = 0;
+
+  // Number of packets in the queue.
+  virtual int SizeInPackets() const = 0;
+
+  // Sum of all payload bytes in the queue, where the payload is calculated
+  // as `packet->payload_size() + packet->padding_size()`.
+  virtual DataSize SizeInPayloadBytes() const = 0;
+
+  // Convenience method for `SizeInPackets() == 0`.
+  virtual bool Empty() const = 0;
+
+  // Total packets in the queue per media type (RtpPacketMediaType values are
+  // used as lookup index).
+  virtual const std::array<int, kNumMediaTypes>&
+  SizeInPacketsPerRtpPacketMediaType() const = 0;
+
+  // The enqueue time of the next packet of the given type, or
+  // Timestamp::MinusInfinity() if the queue has no packets of that type.
+  virtual Timestamp LeadingPacketEnqueueTime(RtpPacketMediaType type) const = 0;
+  // As above for retransmissions, but Timestamp::PlusInfinity() if the queue
+  // has no retransmissions.
+  virtual Timestamp LeadingPacketEnqueueTimeForRetransmission() const = 0;
+
+  // Enqueue time of the oldest packet in the queue,
+  // Timestamp::MinusInfinity() if queue is empty.
+  virtual Timestamp OldestEnqueueTime() const = 0;
+
+  // Average queue time for the packets currently in the queue.
+  // The queuing time is calculated from Push() to the last UpdateQueueTime()
+  // call - with any time spent in a paused state subtracted.
+  // Returns TimeDelta::Zero() for an empty queue.
+  virtual TimeDelta AverageQueueTime() const = 0;
+
+  // Called during packet processing or when pause stats changes. Since the
+  // AverageQueueTime() method does not look at the wall time, this method
+  // needs to be called before querying queue time.
+  virtual void UpdateAverageQueueTime(Timestamp now) = 0;
+
+  // Set the pause state, while `paused` is true queuing time is not counted.
+  virtual void SetPauseState(bool paused, Timestamp now) = 0;
+
+  // Remove any packets matching the given SSRC.
+  virtual void RemovePacketsForSsrc(uint32_t ssrc) = 0;
+
+  // Checks if the queue for the given SSRC has original (retransmissions not
+  // counted) video packets containing keyframe data.
+  virtual bool HasKeyframePackets(uint32_t ssrc) const = 0;
+
+  // Sets the share of the send rate the stream `ssrc` gets relative to the
+  // other streams, for queues that schedule streams by weight. The weight
+  // stays until it is set back to the default of 1.
+  virtual void SetStreamWeight(uint32_t ssrc, double weight) {}
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_PACKET_QUEUE_INTERFACE_H_
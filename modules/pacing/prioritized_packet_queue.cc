@@ -24,53 +24,19 @@
 #include "rtc_base/logging.h"
 
 namespace webrtc {
-namespace {
-
-constexpr int kAudioPrioLevel = 0;
-
-int GetPriorityForType(
-    RtpPacketMediaType type,
-    absl::optional<RtpPacketToSend::OriginalType> original_type) {
-  // Lower number takes priority over higher.
-  switch (type) {
-    case RtpPacketMediaType::kAudio:
-      // Audio is always prioritized over other packet types.
-      return kAudioPrioLevel;
-    case RtpPacketMediaType::kRetransmission:
-      // Send retransmissions before new media. If original_type is set, audio
-      // retransmission is prioritized more than video retransmission.
-      if (original_type == RtpPacketToSend::OriginalType::kVideo) {
-        return kAudioPrioLevel + 2;
-      }
-      return kAudioPrioLevel + 1;
-    case RtpPacketMediaType::kVideo:
-    case RtpPacketMediaType::kForwardErrorCorrection:
-      // Video has "normal" priority, in the old speak.
-      // Send redundancy concurrently to video. If it is delayed it might have a
-      // lower chance of being useful.
-      return kAudioPrioLevel + 3;
-    case RtpPacketMediaType::kPadding:
-      // Packets that are in themselves likely useless, only sent to keep the
-      // BWE high.
-      return kAudioPrioLevel + 4;
-  }
-  RTC_CHECK_NOTREACHED();
-}
-
-}  // namespace
 
 absl::InlinedVector<TimeDelta, PrioritizedPacketQueue::kNumPriorityLevels>
 PrioritizedPacketQueue::ToTtlPerPrio(PacketQueueTTL packet_queue_ttl) {
   absl::InlinedVector<TimeDelta, PrioritizedPacketQueue::kNumPriorityLevels>
       ttl_per_prio(kNumPriorityLevels, TimeDelta::PlusInfinity());
-  ttl_per_prio[GetPriorityForType(RtpPacketMediaType::kRetransmission,
-                                  RtpPacketToSend::OriginalType::kAudio)] =
+  ttl_per_prio[GetPacketPriorityLevel(RtpPacketMediaType::kRetransmission,
+                                      RtpPacketToSend::OriginalType::kAudio)] =
       packet_queue_ttl.audio_retransmission;
-  ttl_per_prio[GetPriorityForType(RtpPacketMediaType::kRetransmission,
-                                  RtpPacketToSend::OriginalType::kVideo)] =
+  ttl_per_prio[GetPacketPriorityLevel(RtpPacketMediaType::kRetransmission,
+                                      RtpPacketToSend::OriginalType::kVideo)] =
       packet_queue_ttl.video_retransmission;
-  ttl_per_prio[GetPriorityForType(RtpPacketMediaType::kVideo, absl::nullopt)] =
-      packet_queue_ttl.video;
+  ttl_per_prio[GetPacketPriorityLevel(RtpPacketMediaType::kVideo,
+                                      absl::nullopt)] = packet_queue_ttl.video;
   return ttl_per_prio;
 }
 
@@ -154,6 +120,8 @@ PrioritizedPacketQueue::PrioritizedPacketQueue(
       last_culling_time_(creation_time),
       top_active_prio_level_(-1) {}
 
+PrioritizedPacketQueue::~PrioritizedPacketQueue() = default;
+
 void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
                                   std::unique_ptr<RtpPacketToSend> packet) {
   StreamQueue* stream_queue;
@@ -168,9 +136,9 @@ void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
   RTC_DCHECK(packet->packet_type().has_value());
   RtpPacketMediaType packet_type = packet->packet_type().value();
   int prio_level =
-      GetPriorityForType(packet_type, prioritize_audio_retransmission_
-                                          ? packet->original_packet_type()
-                                          : absl::nullopt);
+      GetPacketPriorityLevel(packet_type, prioritize_audio_retransmission_
+                                              ? packet->original_packet_type()
+                                              : absl::nullopt);
   PurgeOldPacketsAtPriorityLevel(prio_level, enqueue_time);
   RTC_DCHECK_GE(prio_level, 0);
   RTC_DCHECK_LT(prio_level, kNumPriorityLevels);
@@ -253,7 +221,7 @@ PrioritizedPacketQueue::SizeInPacketsPerRtpPacketMediaType() const {
 Timestamp PrioritizedPacketQueue::LeadingPacketEnqueueTime(
     RtpPacketMediaType type) const {
   RTC_DCHECK(type != RtpPacketMediaType::kRetransmission);
-  const int priority_level = GetPriorityForType(type, absl::nullopt);
+  const int priority_level = GetPacketPriorityLevel(type, absl::nullopt);
   if (streams_by_prio_[priority_level].empty()) {
     return Timestamp::MinusInfinity();
   }
@@ -264,8 +232,8 @@ Timestamp PrioritizedPacketQueue::LeadingPacketEnqueueTime(
 Timestamp PrioritizedPacketQueue::LeadingPacketEnqueueTimeForRetransmission()
     const {
   if (!prioritize_audio_retransmission_) {
-    const int priority_level =
-        GetPriorityForType(RtpPacketMediaType::kRetransmission, absl::nullopt);
+    const int priority_level = GetPacketPriorityLevel(
+        RtpPacketMediaType::kRetransmission, absl::nullopt);
     if (streams_by_prio_[priority_level].empty()) {
       return Timestamp::PlusInfinity();
     }
@@ -273,11 +241,11 @@ Timestamp PrioritizedPacketQueue::LeadingPacketEnqueueTimeForRetransmission()
         priority_level);
   }
   const int audio_priority_level =
-      GetPriorityForType(RtpPacketMediaType::kRetransmission,
-                         RtpPacketToSend::OriginalType::kAudio);
+      GetPacketPriorityLevel(RtpPacketMediaType::kRetransmission,
+                             RtpPacketToSend::OriginalType::kAudio);
   const int video_priority_level =
-      GetPriorityForType(RtpPacketMediaType::kRetransmission,
-                         RtpPacketToSend::OriginalType::kVideo);
+      GetPacketPriorityLevel(RtpPacketMediaType::kRetransmission,
+                             RtpPacketToSend::OriginalType::kVideo);
 
   Timestamp next_audio =
       streams_by_prio_[audio_priority_level].empty()
@@ -23,18 +23,12 @@
 #include "api/units/data_size.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
+#include "modules/pacing/packet_queue_interface.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 
 namespace webrtc {
 
-// Describes how long time a packet may stay in the queue before being dropped.
-struct PacketQueueTTL {
-  TimeDelta audio_retransmission = TimeDelta::PlusInfinity();
-  TimeDelta video_retransmission = TimeDelta::PlusInfinity();
-  TimeDelta video = TimeDelta::PlusInfinity();
-};
-
-class PrioritizedPacketQueue {
+class PrioritizedPacketQueue : public PacketQueueInterface {
  public:
   explicit PrioritizedPacketQueue(
       Timestamp creation_time,
@@ -42,66 +36,68 @@ class PrioritizedPacketQueue {
       PacketQueueTTL packet_queue_ttl = PacketQueueTTL());
   PrioritizedPacketQueue(const PrioritizedPacketQueue&) = delete;
   PrioritizedPacketQueue& operator=(const PrioritizedPacketQueue&) = delete;
+  ~PrioritizedPacketQueue() override;
 
   // Add a packet to the queue. The enqueue time is used for queue time stats
   // and to report the leading packet enqueue time per packet type.
-  void Push(Timestamp enqueue_time, std::unique_ptr<RtpPacketToSend> packet);
+  void Push(Timestamp enqueue_time,
+            std::unique_ptr<RtpPacketToSend> packet) override;
 
   // Remove the next packet from the queue. Packets a prioritized first
   // according to packet type, in the following order:
   // - audio, retransmissions, video / fec, padding
   // For each packet type, we use one FIFO-queue per SSRC and emit from
   // those queues in a round-robin fashion.
-  std::unique_ptr<RtpPacketToSend> Pop();
+  std::unique_ptr<RtpPacketToSend> Pop() override;
 
   // Number of packets in the queue.
-  int SizeInPackets() const;
+  int SizeInPackets() const override;
 
   // Sum of all payload bytes in the queue, where the payload is calculated
   // as `packet->payload_size() + packet->padding_size()`.
-  DataSize SizeInPayloadBytes() const;
+  DataSize SizeInPayloadBytes() const override;
 
   // Convenience method for `SizeInPackets() == 0`.
-  bool Empty() const;
+  bool Empty() const override;
 
   // Total packets in the queue per media type (RtpPacketMediaType values are
   // used as lookup index).
   const std::array<int, kNumMediaTypes>& SizeInPacketsPerRtpPacketMediaType()
-      const;
+      const override;
 
   // The enqueue time of the next packet this queue will return via the Pop()
   // method, for the given packet type. If queue has no packets, of that type,
   // returns Timestamp::MinusInfinity().
-  Timestamp LeadingPacketEnqueueTime(RtpPacketMediaType type) const;
-  Timestamp LeadingPacketEnqueueTimeForRetransmission() const;
+  Timestamp LeadingPacketEnqueueTime(RtpPacketMediaType type) const override;
+  Timestamp LeadingPacketEnqueueTimeForRetransmission() const override;
 
   // Enqueue time of the oldest packet in the queue,
   // Timestamp::MinusInfinity() if queue is empty.
-  Timestamp OldestEnqueueTime() const;
+  Timestamp OldestEnqueueTime() const override;
 
   // Average queue time for the packets currently in the queue.
   // The queuing time is calculated from Push() to the last UpdateQueueTime()
   // call - with any time spent in a paused state subtracted.
   // Returns TimeDelta::Zero() for an empty queue.
-  TimeDelta AverageQueueTime() const;
+  TimeDelta AverageQueueTime() const override;
 
   // Called during packet processing or when pause stats changes. Since the
   // AverageQueueTime() method does not look at the wall time, this method
   // needs to be called before querying queue time.
-  void UpdateAverageQueueTime(Timestamp now);
+  void UpdateAverageQueueTime(Timestamp now) override;
 
   // Set the pause state, while `paused` is true queuing time is not counted.
-  void SetPauseState(bool paused, Timestamp now);
+  void SetPauseState(bool paused, Timestamp now) override;
 
   // Remove any packets matching the given SSRC.
-  void RemovePacketsForSsrc(uint32_t ssrc);
+  void RemovePacketsForSsrc(uint32_t ssrc) override;
 
   // Checks if the queue for the given SSRC has original (retransmissions not
   // counted) video packets containing keyframe data.
-  bool HasKeyframePackets(uint32_t ssrc) const;
+  bool HasKeyframePackets(uint32_t ssrc) const override;
 
  private:
-  static constexpr int kNumPriorityLevels = 5;
+  static constexpr int kNumPriorityLevels = kNumPacketPriorityLevels;
 
   class QueuedPacket {
    public:
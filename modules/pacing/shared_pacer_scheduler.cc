@@ -0,0 +1,222 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/shared_pacer_scheduler.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/task_utils/timer_wheel.h"
+
+namespace webrtc {
+
+// Owns one thread of the pool and the timers of the sessions it schedules.
+class SharedPacerScheduler::Worker {
+ public:
+  Worker(Clock* clock, TimeDelta tick, TaskQueueFactory* task_queue_factory)
+      : clock_(clock),
+        tick_(tick),
+        wheel_(CurrentTick()),
+        task_queue_(task_queue_factory->CreateTaskQueue(
+            "SharedPacer",
+            TaskQueueFactory::Priority::HIGH)) {}
+
+  // Cancels the timer `timer_id`, if pending, and schedules a process call
+  // of `session` at `time`. Returns the id of the new timer.
+  uint64_t Schedule(uint64_t timer_id, Session* session, Timestamp time) {
+    RTC_DCHECK(time.IsFinite());
+    // Round up, so that the session is not woken up before `time`.
+    const int64_t time_us = std::max<int64_t>(time.us(), 0);
+    const uint64_t tick = (time_us + tick_.us() - 1) / tick_.us();
+    MutexLock lock(&mutex_);
+    if (timer_id != 0) {
+      wheel_.Cancel(timer_id);
+    }
+    uint64_t new_timer_id = wheel_.Schedule(tick, {session, time});
+    if (tick < armed_tick_) {
+      Arm(tick);
+    }
+    return new_timer_id;
+  }
+
+  void Cancel(uint64_t timer_id) {
+    MutexLock lock(&mutex_);
+    wheel_.Cancel(timer_id);
+  }
+
+ private:
+  static constexpr uint64_t kNotArmed = std::numeric_limits<uint64_t>::max();
+
+  struct Wakeup {
+    Session* session;
+    Timestamp time;
+  };
+
+  struct ProcessCall {
+    rtc::scoped_refptr<PendingTaskSafetyFlag> safety_flag;
+    Session* session;
+    Timestamp time;
+  };
+
+  uint64_t CurrentTick() const {
+    return std::max<int64_t>(clock_->CurrentTime().us(), 0) / tick_.us();
+  }
+
+  // Posts a wakeup of the pool thread at `tick`. The pending wakeup, if any,
+  // is retired.
+  void Arm(uint64_t tick) RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    armed_tick_ = tick;
+    const Timestamp wakeup_time =
+        Timestamp::Zero() + tick_ * static_cast<int64_t>(tick);
+    const TimeDelta delay =
+        std::max(wakeup_time - clock_->CurrentTime(), TimeDelta::Zero());
+    task_queue_->PostDelayedHighPrecisionTask([this, tick] { Process(tick); },
+                                              delay);
+  }
+
+  void Process(uint64_t tick) {
+    MutexLock lock(&mutex_);
+    if (tick != armed_tick_) {
+      // Retired by an earlier wakeup.
+      return;
+    }
+    armed_tick_ = kNotArmed;
+    wheel_.AdvanceTo(CurrentTick(), expired_);
+    PostExpired();
+    absl::optional<uint64_t> next_tick = wheel_.NextWakeupTick();
+    if (next_tick) {
+      Arm(*next_tick);
+    }
+  }
+
+  // Posts one task per task queue, calling all its sessions in `expired_`.
+  // Runs under `mutex_`, which keeps the sessions, and thereby their task
+  // queues, alive until the tasks are posted.
+  void PostExpired() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    std::stable_sort(expired_.begin(), expired_.end(),
+                     [](const Wakeup& a, const Wakeup& b) {
+                       return std::less<TaskQueueBase*>()(
+                           a.session->task_queue_, b.session->task_queue_);
+                     });
+    auto it = expired_.begin();
+    while (it != expired_.end()) {
+      TaskQueueBase* task_queue = it->session->task_queue_;
+      std::vector<ProcessCall> calls;
+      for (; it != expired_.end() && it->session->task_queue_ == task_queue;
+           ++it) {
+        calls.push_back(
+            {.safety_flag = it->session->safety_.flag(),
+             .session = it->session,
+             .time = it->time});
+      }
+      task_queue->PostTask([calls = std::move(calls)] {
+        for (const ProcessCall& call : calls) {
+          if (call.safety_flag->alive()) {
+            call.session->process_(call.time);
+          }
+        }
+      });
+    }
+    expired_.clear();
+  }
+
+  Clock* const clock_;
+  const TimeDelta tick_;
+
+  Mutex mutex_;
+  TimerWheel<Wakeup> wheel_ RTC_GUARDED_BY(mutex_);
+  uint64_t armed_tick_ RTC_GUARDED_BY(mutex_) = kNotArmed;
+  std::vector<Wakeup> expired_ RTC_GUARDED_BY(mutex_);
+
+  // Last, so that it stops running tasks before the other members are
+  // destroyed.
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> task_queue_;
+};
+
+SharedPacerScheduler::Session::Session(
+    SharedPacerScheduler* scheduler,
+    Worker* worker,
+    TaskQueueBase* task_queue,
+    absl::AnyInvocable<void(Timestamp)> process)
+    : scheduler_(scheduler),
+      worker_(worker),
+      task_queue_(task_queue),
+      process_(std::move(process)) {}
+
+SharedPacerScheduler::Session::~Session() {
+  RTC_DCHECK(task_queue_->IsCurrent());
+  worker_->Cancel(timer_id_);
+  scheduler_->Unregister(task_queue_);
+}
+
+void SharedPacerScheduler::Session::ScheduleProcess(Timestamp time) {
+  RTC_DCHECK(task_queue_->IsCurrent());
+  timer_id_ = worker_->Schedule(timer_id_, this, time);
+}
+
+SharedPacerScheduler::SharedPacerScheduler(
+    Clock* clock,
+    TaskQueueFactory* task_queue_factory,
+    int num_threads,
+    TimeDelta tick)
+    : clock_(clock), tick_(tick), task_queues_per_worker_(num_threads, 0) {
+  RTC_CHECK_GT(num_threads, 0);
+  RTC_CHECK_GT(tick_, TimeDelta::Zero());
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.push_back(
+        std::make_unique<Worker>(clock_, tick_, task_queue_factory));
+  }
+}
+
+SharedPacerScheduler::~SharedPacerScheduler() {
+  MutexLock lock(&mutex_);
+  RTC_DCHECK(task_queues_.empty());
+}
+
+std::unique_ptr<SharedPacerScheduler::Session> SharedPacerScheduler::Register(
+    absl::AnyInvocable<void(Timestamp scheduled_time)> process) {
+  TaskQueueBase* task_queue = TaskQueueBase::Current();
+  RTC_DCHECK(task_queue);
+  int worker_index;
+  {
+    MutexLock lock(&mutex_);
+    auto [it, inserted] = task_queues_.try_emplace(task_queue);
+    if (inserted) {
+      // Balance task queues rather than sessions, so that all sessions of a
+      // task queue share the wakeups of one thread.
+      it->second.worker_index = static_cast<int>(
+          std::min_element(task_queues_per_worker_.begin(),
+                           task_queues_per_worker_.end()) -
+          task_queues_per_worker_.begin());
+      ++task_queues_per_worker_[it->second.worker_index];
+    }
+    ++it->second.num_sessions;
+    worker_index = it->second.worker_index;
+  }
+  return absl::WrapUnique(new Session(this, workers_[worker_index].get(),
+                                      task_queue, std::move(process)));
+}
+
+void SharedPacerScheduler::Unregister(TaskQueueBase* task_queue) {
+  MutexLock lock(&mutex_);
+  auto it = task_queues_.find(task_queue);
+  RTC_DCHECK(it != task_queues_.end());
+  if (--it->second.num_sessions == 0) {
+    --task_queues_per_worker_[it->second.worker_index];
+    task_queues_.erase(it);
+  }
+}
+
+}  // namespace webrtc
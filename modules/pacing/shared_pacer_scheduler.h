@@ -0,0 +1,119 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_SHARED_PACER_SCHEDULER_H_
+#define MODULES_PACING_SHARED_PACER_SCHEDULER_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Schedules the process calls of many pacers, e.g. of all calls of a media
+// server, with one timer per thread of a small fixed pool instead of one
+// delayed task per pacer.
+//
+// Each pacer keeps running on its own task queue. Wakeups are rounded up to
+// the tick of the scheduler, so pacers with wakeups in the same tick share
+// one timer wakeup of the pool thread, and pacers on the same task queue
+// share one posted task per tick. Pacers on the same task queue are
+// scheduled by the same pool thread.
+//
+// Thread safe. Must outlive all its sessions.
+class SharedPacerScheduler {
+ public:
+  static constexpr TimeDelta kDefaultTick = TimeDelta::Millis(1);
+
+  class Session;
+
+  SharedPacerScheduler(Clock* clock,
+                       TaskQueueFactory* task_queue_factory,
+                       int num_threads,
+                       TimeDelta tick = kDefaultTick);
+  SharedPacerScheduler(const SharedPacerScheduler&) = delete;
+  SharedPacerScheduler& operator=(const SharedPacerScheduler&) = delete;
+  ~SharedPacerScheduler();
+
+  // Registers a pacer running on the current task queue. `process` is called
+  // on that task queue with the time passed to Session::ScheduleProcess().
+  std::unique_ptr<Session> Register(
+      absl::AnyInvocable<void(Timestamp scheduled_time)> process);
+
+  int num_threads() const { return static_cast<int>(workers_.size()); }
+  TimeDelta tick() const { return tick_; }
+
+ private:
+  class Worker;
+
+  struct TaskQueueEntry {
+    int worker_index = 0;
+    int num_sessions = 0;
+  };
+
+  void Unregister(TaskQueueBase* task_queue);
+
+  Clock* const clock_;
+  const TimeDelta tick_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  Mutex mutex_;
+  // Task queues with sessions and the worker scheduling them.
+  std::map<TaskQueueBase*, TaskQueueEntry> task_queues_
+      RTC_GUARDED_BY(mutex_);
+  std::vector<int> task_queues_per_worker_ RTC_GUARDED_BY(mutex_);
+};
+
+// A pacer registered with the scheduler. Must be created and destroyed on
+// the task queue it was registered on.
+class SharedPacerScheduler::Session {
+ public:
+  ~Session();
+  Session(const Session&) = delete;
+  Session& operator=(const Session&) = delete;
+
+  // Requests a process call at `time`, or at the first tick after it.
+  // Replaces the previous request if it has not fired yet. Requests for
+  // times that have passed fire on the next tick.
+  void ScheduleProcess(Timestamp time);
+
+ private:
+  friend class SharedPacerScheduler;
+  friend class SharedPacerScheduler::Worker;
+
+  Session(SharedPacerScheduler* scheduler,
+          Worker* worker,
+          TaskQueueBase* task_queue,
+          absl::AnyInvocable<void(Timestamp)> process);
+
+  SharedPacerScheduler* const scheduler_;
+  Worker* const worker_;
+  TaskQueueBase* const task_queue_;
+  absl::AnyInvocable<void(Timestamp)> process_;
+  ScopedTaskSafety safety_;
+  // Id of the last timer scheduled in `worker_`, 0 if none.
+  uint64_t timer_id_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_SHARED_PACER_SCHEDULER_H_
@@ -0,0 +1,157 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/shared_pacer_scheduler.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+constexpr Timestamp kStartTime = Timestamp::Millis(1234);
+
+class SharedPacerSchedulerTest : public ::testing::Test {
+ protected:
+  SharedPacerSchedulerTest()
+      : time_controller_(kStartTime),
+        scheduler_(time_controller_.GetClock(),
+                   time_controller_.GetTaskQueueFactory(),
+                   /*num_threads=*/2) {}
+
+  Timestamp Now() { return time_controller_.GetClock()->CurrentTime(); }
+
+  // Registers a session on the current task queue, recording the times it is
+  // called at in `call_times`.
+  std::unique_ptr<SharedPacerScheduler::Session> Register(
+      std::vector<Timestamp>& call_times) {
+    return scheduler_.Register(
+        [this, &call_times](Timestamp /*scheduled_time*/) {
+          call_times.push_back(Now());
+        });
+  }
+
+  GlobalSimulatedTimeController time_controller_;
+  SharedPacerScheduler scheduler_;
+};
+
+TEST_F(SharedPacerSchedulerTest, CallsSessionAtFirstTickAfterScheduledTime) {
+  TaskQueueBase* task_queue = TaskQueueBase::Current();
+  std::vector<Timestamp> scheduled_times;
+  std::unique_ptr<SharedPacerScheduler::Session> session =
+      scheduler_.Register([&](Timestamp scheduled_time) {
+        EXPECT_TRUE(task_queue->IsCurrent());
+        EXPECT_GE(Now(), scheduled_time);
+        EXPECT_LT(Now() - scheduled_time, scheduler_.tick());
+        scheduled_times.push_back(scheduled_time);
+      });
+
+  const Timestamp scheduled_time = kStartTime + TimeDelta::Micros(2500);
+  session->ScheduleProcess(scheduled_time);
+  time_controller_.AdvanceTime(TimeDelta::Millis(2));
+  EXPECT_THAT(scheduled_times, IsEmpty());
+  time_controller_.AdvanceTime(TimeDelta::Millis(1));
+  EXPECT_THAT(scheduled_times, ElementsAre(scheduled_time));
+  time_controller_.AdvanceTime(TimeDelta::Millis(10));
+  EXPECT_THAT(scheduled_times, ElementsAre(scheduled_time));
+}
+
+TEST_F(SharedPacerSchedulerTest, CoalescesWakeupsWithinTick) {
+  std::vector<Timestamp> call_times1;
+  std::vector<Timestamp> call_times2;
+  std::unique_ptr<SharedPacerScheduler::Session> session1 =
+      Register(call_times1);
+  std::unique_ptr<SharedPacerScheduler::Session> session2 =
+      Register(call_times2);
+
+  session1->ScheduleProcess(kStartTime + TimeDelta::Micros(1200));
+  session2->ScheduleProcess(kStartTime + TimeDelta::Micros(1800));
+  time_controller_.AdvanceTime(TimeDelta::Millis(5));
+  EXPECT_THAT(call_times1, ElementsAre(kStartTime + TimeDelta::Millis(2)));
+  EXPECT_THAT(call_times2, ElementsAre(kStartTime + TimeDelta::Millis(2)));
+}
+
+TEST_F(SharedPacerSchedulerTest, ReplacesPendingRequest) {
+  std::vector<Timestamp> call_times;
+  std::unique_ptr<SharedPacerScheduler::Session> session =
+      Register(call_times);
+
+  session->ScheduleProcess(kStartTime + TimeDelta::Millis(10));
+  session->ScheduleProcess(kStartTime + TimeDelta::Millis(3));
+  time_controller_.AdvanceTime(TimeDelta::Millis(20));
+  EXPECT_THAT(call_times, ElementsAre(kStartTime + TimeDelta::Millis(3)));
+
+  session->ScheduleProcess(kStartTime + TimeDelta::Millis(30));
+  session->ScheduleProcess(kStartTime + TimeDelta::Millis(40));
+  time_controller_.AdvanceTime(TimeDelta::Millis(30));
+  EXPECT_THAT(call_times, ElementsAre(kStartTime + TimeDelta::Millis(3),
+                                      kStartTime + TimeDelta::Millis(40)));
+}
+
+TEST_F(SharedPacerSchedulerTest, CallsSessionScheduledInThePastOnNextTick) {
+  std::vector<Timestamp> call_times;
+  std::unique_ptr<SharedPacerScheduler::Session> session =
+      Register(call_times);
+  time_controller_.AdvanceTime(TimeDelta::Millis(5));
+
+  session->ScheduleProcess(kStartTime);
+  time_controller_.AdvanceTime(TimeDelta::Millis(1));
+  EXPECT_THAT(call_times, ElementsAre(kStartTime + TimeDelta::Millis(5)));
+}
+
+TEST_F(SharedPacerSchedulerTest, DoesNotCallDestroyedSession) {
+  std::vector<Timestamp> call_times;
+  std::unique_ptr<SharedPacerScheduler::Session> session =
+      Register(call_times);
+  session->ScheduleProcess(kStartTime + TimeDelta::Millis(1));
+  session = nullptr;
+  time_controller_.AdvanceTime(TimeDelta::Millis(5));
+  EXPECT_THAT(call_times, IsEmpty());
+}
+
+TEST_F(SharedPacerSchedulerTest, CallsSessionsOnTheirOwnTaskQueues) {
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> task_queue =
+      time_controller_.GetTaskQueueFactory()->CreateTaskQueue(
+          "other_queue", TaskQueueFactory::Priority::NORMAL);
+  std::vector<Timestamp> call_times;
+  std::vector<Timestamp> other_call_times;
+  std::unique_ptr<SharedPacerScheduler::Session> session =
+      Register(call_times);
+  std::unique_ptr<SharedPacerScheduler::Session> other_session;
+  task_queue->PostTask([&] {
+    other_session = scheduler_.Register([&](Timestamp /*scheduled_time*/) {
+      EXPECT_TRUE(task_queue->IsCurrent());
+      other_call_times.push_back(Now());
+    });
+    other_session->ScheduleProcess(kStartTime + TimeDelta::Millis(2));
+  });
+  session->ScheduleProcess(kStartTime + TimeDelta::Millis(2));
+
+  time_controller_.AdvanceTime(TimeDelta::Millis(5));
+  EXPECT_THAT(call_times, ElementsAre(kStartTime + TimeDelta::Millis(2)));
+  EXPECT_THAT(other_call_times, ElementsAre(kStartTime + TimeDelta::Millis(2)));
+
+  task_queue->PostTask([&] { other_session = nullptr; });
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -28,7 +28,8 @@ TaskQueuePacedSender::TaskQueuePacedSender(
     PacingController::PacketSender* packet_sender,
     const FieldTrialsView& field_trials,
     TimeDelta max_hold_back_window,
-    int max_hold_back_window_in_packets)
+    int max_hold_back_window_in_packets,
+    SharedPacerScheduler* scheduler)
     : clock_(clock),
       max_hold_back_window_(max_hold_back_window),
       max_hold_back_window_in_packets_(max_hold_back_window_in_packets),
@@ -40,6 +41,12 @@ TaskQueuePacedSender::TaskQueuePacedSender(
       include_overhead_(false),
       task_queue_(TaskQueueBase::Current()) {
   RTC_DCHECK_GE(max_hold_back_window_, PacingController::kMinSleepTime);
+  if (scheduler) {
+    scheduler_session_ = scheduler->Register(
+        [this](Timestamp scheduled_time) {
+          MaybeProcessPackets(scheduled_time);
+        });
+  }
 }
 
 TaskQueuePacedSender::~TaskQueuePacedSender() {
@@ -127,6 +134,13 @@ void TaskQueuePacedSender::RemovePacketsForSsrc(uint32_t ssrc) {
   }));
 }
 
+void TaskQueuePacedSender::SetStreamWeight(uint32_t ssrc, double weight) {
+  task_queue_->PostTask(SafeTask(safety_.flag(), [this, ssrc, weight] {
+    RTC_DCHECK_RUN_ON(task_queue_);
+    pacing_controller_.SetStreamWeight(ssrc, weight);
+  }));
+}
+
 void TaskQueuePacedSender::SetAccountForAudioPackets(bool account_for_audio) {
   RTC_DCHECK_RUN_ON(task_queue_);
   pacing_controller_.SetAccountForAudioPackets(account_for_audio);
@@ -264,12 +278,18 @@ void TaskQueuePacedSender::MaybeProcessPackets(
   // schedule a new one. Previous in flight task will be retired.
   if (next_process_time_.IsMinusInfinity() ||
       next_process_time_ > next_send_time) {
-    // Prefer low precision if allowed and not probing.
-    task_queue_->PostDelayedHighPrecisionTask(
-        SafeTask(
-            safety_.flag(),
-            [this, next_send_time]() { MaybeProcessPackets(next_send_time); }),
-        time_to_next_process.RoundUpTo(TimeDelta::Millis(1)));
+    if (scheduler_session_) {
+      // Replaces the pending call, which is thereby retired as well.
+      scheduler_session_->ScheduleProcess(next_send_time);
+    } else {
+      // Prefer low precision if allowed and not probing.
+      task_queue_->PostDelayedHighPrecisionTask(
+          SafeTask(safety_.flag(),
+                   [this, next_send_time]() {
+                     MaybeProcessPackets(next_send_time);
+                   }),
+          time_to_next_process.RoundUpTo(TimeDelta::Millis(1)));
+    }
     next_process_time_ = next_send_time;
   }
 }
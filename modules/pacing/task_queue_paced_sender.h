@@ -26,6 +26,7 @@
 #include "api/units/timestamp.h"
 #include "modules/pacing/pacing_controller.h"
 #include "modules/pacing/rtp_packet_pacer.h"
+#include "modules/pacing/shared_pacer_scheduler.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/numerics/exp_filter.h"
@@ -47,11 +48,16 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
   //
   // The taskqueue used when constructing a TaskQueuePacedSender will also be
   // used for pacing.
+  //
+  // If `scheduler` is set, the delayed process calls are scheduled by it
+  // rather than posted as delayed tasks, sharing timer wakeups with the
+  // pacers of other calls. It must outlive the pacer.
   TaskQueuePacedSender(Clock* clock,
                        PacingController::PacketSender* packet_sender,
                        const FieldTrialsView& field_trials,
                        TimeDelta max_hold_back_window,
-                       int max_hold_back_window_in_packets);
+                       int max_hold_back_window_in_packets,
+                       SharedPacerScheduler* scheduler = nullptr);
 
   ~TaskQueuePacedSender() override;
 
@@ -74,6 +80,7 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
       std::vector<std::unique_ptr<RtpPacketToSend>> packets) override;
   // Remove any pending packets matching this SSRC from the packet queue.
   void RemovePacketsForSsrc(uint32_t ssrc) override;
+  void SetStreamWeight(uint32_t ssrc, double weight) override;
 
   // Methods implementing RtpPacketPacer.
 
@@ -180,6 +187,8 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
 
   ScopedTaskSafety safety_;
   TaskQueueBase* task_queue_;
+  // Set if the delayed process calls are scheduled by a SharedPacerScheduler.
+  std::unique_ptr<SharedPacerScheduler::Session> scheduler_session_;
 };
 }  // namespace webrtc
 #endif  // MODULES_PACING_TASK_QUEUE_PACED_SENDER_H_
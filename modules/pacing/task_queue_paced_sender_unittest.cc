@@ -27,6 +27,7 @@
 #include "api/units/time_delta.h"
 #include "modules/pacing/pacing_controller.h"
 #include "modules/pacing/packet_router.h"
+#include "modules/pacing/shared_pacer_scheduler.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -164,6 +165,47 @@ TEST(TaskQueuePacedSenderTest, PacesPackets) {
   EXPECT_NEAR((end_time - start_time).ms<double>(), 1000.0, 50.0);
 }
 
+TEST(TaskQueuePacedSenderTest, PacesPacketsWithSharedScheduler) {
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(1234));
+  SharedPacerScheduler scheduler(time_controller.GetClock(),
+                                 time_controller.GetTaskQueueFactory(),
+                                 /*num_threads=*/1);
+  MockPacketRouter packet_router;
+  ScopedKeyValueConfig trials;
+  TaskQueuePacedSender pacer(time_controller.GetClock(), &packet_router, trials,
+                             PacingController::kMinSleepTime,
+                             TaskQueuePacedSender::kNoPacketHoldback,
+                             &scheduler);
+
+  static constexpr size_t kPacketsToSend = 42;
+  SequenceChecker sequence_checker;
+  pacer.SetPacingRates(
+      DataRate::BitsPerSec(kDefaultPacketSize * 8 * kPacketsToSend),
+      DataRate::Zero());
+  pacer.EnsureStarted();
+  pacer.EnqueuePackets(
+      GeneratePackets(RtpPacketMediaType::kVideo, kPacketsToSend));
+
+  size_t packets_sent = 0;
+  Timestamp end_time = Timestamp::PlusInfinity();
+  EXPECT_CALL(packet_router, SendPacket)
+      .WillRepeatedly([&](std::unique_ptr<RtpPacketToSend> packet,
+                          const PacedPacketInfo& cluster_info) {
+        ++packets_sent;
+        if (packets_sent == kPacketsToSend) {
+          end_time = time_controller.GetClock()->CurrentTime();
+        }
+        // Packets are still sent on the task queue of the pacer.
+        EXPECT_TRUE(sequence_checker.IsCurrent());
+      });
+
+  const Timestamp start_time = time_controller.GetClock()->CurrentTime();
+  time_controller.AdvanceTime(TimeDelta::Seconds(1));
+  EXPECT_EQ(packets_sent, kPacketsToSend);
+  ASSERT_TRUE(end_time.IsFinite());
+  EXPECT_NEAR((end_time - start_time).ms<double>(), 1000.0, 50.0);
+}
+
 // Same test as above, but with 0.5s of burst applied.
 TEST(TaskQueuePacedSenderTest, PacesPacketsWithBurst) {
   GlobalSimulatedTimeController time_controller(Timestamp::Millis(1234));
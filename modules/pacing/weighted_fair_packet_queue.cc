@@ -0,0 +1,407 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/weighted_fair_packet_queue.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "absl/types/optional.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+// Streams without packets are forgotten after this time.
+constexpr TimeDelta kStreamTimeout = TimeDelta::Millis(500);
+
+absl::InlinedVector<TimeDelta, kNumPacketPriorityLevels> ToTtlPerPrio(
+    PacketQueueTTL packet_queue_ttl) {
+  absl::InlinedVector<TimeDelta, kNumPacketPriorityLevels> ttl_per_prio(
+      kNumPacketPriorityLevels, TimeDelta::PlusInfinity());
+  ttl_per_prio[GetPacketPriorityLevel(RtpPacketMediaType::kRetransmission,
+                                      RtpPacketToSend::OriginalType::kAudio)] =
+      packet_queue_ttl.audio_retransmission;
+  ttl_per_prio[GetPacketPriorityLevel(RtpPacketMediaType::kRetransmission,
+                                      RtpPacketToSend::OriginalType::kVideo)] =
+      packet_queue_ttl.video_retransmission;
+  ttl_per_prio[GetPacketPriorityLevel(RtpPacketMediaType::kVideo,
+                                      absl::nullopt)] = packet_queue_ttl.video;
+  return ttl_per_prio;
+}
+
+}  // namespace
+
+DataSize WeightedFairPacketQueue::QueuedPacket::PacketSize() const {
+  return DataSize::Bytes(packet->payload_size() + packet->padding_size());
+}
+
+WeightedFairPacketQueue::WeightedFairPacketQueue(
+    Timestamp creation_time,
+    bool prioritize_audio_retransmission,
+    PacketQueueTTL packet_queue_ttl)
+    : prioritize_audio_retransmission_(prioritize_audio_retransmission),
+      time_to_live_per_prio_(ToTtlPerPrio(packet_queue_ttl)),
+      queue_time_sum_(TimeDelta::Zero()),
+      pause_time_sum_(TimeDelta::Zero()),
+      size_packets_(0),
+      size_packets_per_media_type_({}),
+      size_payload_(DataSize::Zero()),
+      last_update_time_(creation_time),
+      paused_(false),
+      last_culling_time_(creation_time),
+      min_weight_(kDefaultWeight),
+      active_streams_({}) {}
+
+WeightedFairPacketQueue::~WeightedFairPacketQueue() = default;
+
+void WeightedFairPacketQueue::Push(Timestamp enqueue_time,
+                                   std::unique_ptr<RtpPacketToSend> packet) {
+  StreamQueue& stream = GetOrCreateStream(packet->Ssrc(), enqueue_time);
+  RTC_DCHECK(packet->packet_type().has_value());
+  RtpPacketMediaType packet_type = packet->packet_type().value();
+  const int level =
+      GetPacketPriorityLevel(packet_type, prioritize_audio_retransmission_
+                                              ? packet->original_packet_type()
+                                              : absl::nullopt);
+  // As in PrioritizedPacketQueue, the enqueue time of the packet is offset by
+  // the time the queue has been paused so far, so that subtracting the pause
+  // time at dequeue leaves the time the packet was queued while not paused.
+  UpdateAverageQueueTime(enqueue_time);
+  PurgeOldPackets(level, enqueue_time);
+
+  AgeOrder& age_order = age_order_[level];
+  const uint64_t age_index = age_order.front_index + age_order.entries.size();
+  age_order.entries.push_back(
+      {.enqueue_time = enqueue_time, .stream = &stream, .removed = false});
+
+  QueuedPacket queued_packet = {.packet = std::move(packet),
+                                .enqueue_time = enqueue_time - pause_time_sum_,
+                                .age_index = age_index};
+  ++size_packets_;
+  ++size_packets_per_media_type_[static_cast<size_t>(packet_type)];
+  size_payload_ += queued_packet.PacketSize();
+  if (queued_packet.packet->is_key_frame()) {
+    ++stream.num_keyframe_packets;
+  }
+  stream.last_enqueue_time = enqueue_time;
+
+  const bool first_packet_at_level = stream.packets[level].empty();
+  stream.packets[level].push_back(std::move(queued_packet));
+  if (first_packet_at_level) {
+    LinkStream(stream, level);
+  }
+
+  if (enqueue_time - last_culling_time_ > kStreamTimeout) {
+    CullInactiveStreams(enqueue_time);
+  }
+}
+
+std::unique_ptr<RtpPacketToSend> WeightedFairPacketQueue::Pop() {
+  for (int level = 0; level < kNumPriorityLevels; ++level) {
+    if (active_streams_[level] == nullptr) {
+      continue;
+    }
+    PurgeOldPackets(level, last_update_time_);
+    StreamQueue* stream = active_streams_[level];
+    if (stream == nullptr) {
+      continue;
+    }
+
+    // Streams that can't afford their next packet get their quantum for the
+    // next round and pass the turn. Since quantums are at least as large as
+    // most packets, this rarely skips more than a few streams.
+    int64_t packet_size = stream->packets[level].front().PacketSize().bytes();
+    while (stream->deficit_bytes[level] < packet_size) {
+      stream->deficit_bytes[level] += stream->quantum_bytes;
+      stream = stream->next[level];
+      packet_size = stream->packets[level].front().PacketSize().bytes();
+    }
+    active_streams_[level] = stream;
+
+    stream->deficit_bytes[level] -= packet_size;
+    QueuedPacket packet = DequeuePacket(*stream, level);
+    if (stream->packets[level].empty()) {
+      UnlinkStream(*stream, level);
+    }
+    return std::move(packet.packet);
+  }
+  return nullptr;
+}
+
+int WeightedFairPacketQueue::SizeInPackets() const {
+  return size_packets_;
+}
+
+DataSize WeightedFairPacketQueue::SizeInPayloadBytes() const {
+  return size_payload_;
+}
+
+bool WeightedFairPacketQueue::Empty() const {
+  return size_packets_ == 0;
+}
+
+const std::array<int, kNumMediaTypes>&
+WeightedFairPacketQueue::SizeInPacketsPerRtpPacketMediaType() const {
+  return size_packets_per_media_type_;
+}
+
+Timestamp WeightedFairPacketQueue::LeadingPacketEnqueueTime(
+    RtpPacketMediaType type) const {
+  RTC_DCHECK(type != RtpPacketMediaType::kRetransmission);
+  return OldestEnqueueTimeAtLevel(GetPacketPriorityLevel(type, absl::nullopt));
+}
+
+Timestamp WeightedFairPacketQueue::LeadingPacketEnqueueTimeForRetransmission()
+    const {
+  auto leading_at = [this](int level) {
+    const Timestamp oldest = OldestEnqueueTimeAtLevel(level);
+    return oldest.IsFinite() ? oldest : Timestamp::PlusInfinity();
+  };
+  if (!prioritize_audio_retransmission_) {
+    return leading_at(GetPacketPriorityLevel(
+        RtpPacketMediaType::kRetransmission, absl::nullopt));
+  }
+  const int audio_level =
+      GetPacketPriorityLevel(RtpPacketMediaType::kRetransmission,
+                             RtpPacketToSend::OriginalType::kAudio);
+  const int video_level =
+      GetPacketPriorityLevel(RtpPacketMediaType::kRetransmission,
+                             RtpPacketToSend::OriginalType::kVideo);
+  return std::min(leading_at(audio_level), leading_at(video_level));
+}
+
+Timestamp WeightedFairPacketQueue::OldestEnqueueTime() const {
+  Timestamp oldest = Timestamp::PlusInfinity();
+  for (int level = 0; level < kNumPriorityLevels; ++level) {
+    const Timestamp oldest_at_level = OldestEnqueueTimeAtLevel(level);
+    if (oldest_at_level.IsFinite()) {
+      oldest = std::min(oldest, oldest_at_level);
+    }
+  }
+  return oldest.IsFinite() ? oldest : Timestamp::MinusInfinity();
+}
+
+TimeDelta WeightedFairPacketQueue::AverageQueueTime() const {
+  if (size_packets_ == 0) {
+    return TimeDelta::Zero();
+  }
+  return queue_time_sum_ / size_packets_;
+}
+
+void WeightedFairPacketQueue::UpdateAverageQueueTime(Timestamp now) {
+  RTC_CHECK_GE(now, last_update_time_);
+  if (now == last_update_time_) {
+    return;
+  }
+
+  TimeDelta delta = now - last_update_time_;
+  if (paused_) {
+    pause_time_sum_ += delta;
+  } else {
+    queue_time_sum_ += delta * size_packets_;
+  }
+  last_update_time_ = now;
+}
+
+void WeightedFairPacketQueue::SetPauseState(bool paused, Timestamp now) {
+  UpdateAverageQueueTime(now);
+  paused_ = paused;
+}
+
+void WeightedFairPacketQueue::RemovePacketsForSsrc(uint32_t ssrc) {
+  auto it = streams_.find(ssrc);
+  if (it == streams_.end()) {
+    return;
+  }
+  StreamQueue& stream = *it->second;
+  for (int level = 0; level < kNumPriorityLevels; ++level) {
+    if (stream.packets[level].empty()) {
+      continue;
+    }
+    while (!stream.packets[level].empty()) {
+      DequeuePacket(stream, level);
+    }
+    UnlinkStream(stream, level);
+  }
+  // The weight stays in `weights_`: packets are also removed to flush a
+  // stream for a keyframe or while its layer is disabled.
+  streams_.erase(it);
+}
+
+bool WeightedFairPacketQueue::HasKeyframePackets(uint32_t ssrc) const {
+  auto it = streams_.find(ssrc);
+  return it != streams_.end() && it->second->num_keyframe_packets > 0;
+}
+
+void WeightedFairPacketQueue::SetStreamWeight(uint32_t ssrc, double weight) {
+  RTC_DCHECK_GT(weight, 0.0);
+  if (weight == kDefaultWeight) {
+    weights_.erase(ssrc);
+  } else {
+    weights_[ssrc] = weight;
+  }
+  auto it = streams_.find(ssrc);
+  if (it != streams_.end()) {
+    it->second->weight = weight;
+  }
+  UpdateQuantums();
+}
+
+int64_t WeightedFairPacketQueue::QuantumBytes(double weight) const {
+  return std::llround(kMinQuantum.bytes() * weight / min_weight_);
+}
+
+void WeightedFairPacketQueue::UpdateQuantums() {
+  min_weight_ = kDefaultWeight;
+  for (const auto& [ssrc, weight] : weights_) {
+    min_weight_ = std::min(min_weight_, weight);
+  }
+  for (auto& [ssrc, stream] : streams_) {
+    stream->quantum_bytes = QuantumBytes(stream->weight);
+  }
+}
+
+WeightedFairPacketQueue::StreamQueue&
+WeightedFairPacketQueue::GetOrCreateStream(uint32_t ssrc, Timestamp now) {
+  auto [it, inserted] = streams_.emplace(ssrc, nullptr);
+  if (inserted) {
+    it->second = std::make_unique<StreamQueue>(now);
+    auto weight = weights_.find(ssrc);
+    if (weight != weights_.end()) {
+      it->second->weight = weight->second;
+    }
+    it->second->quantum_bytes = QuantumBytes(it->second->weight);
+  }
+  return *it->second;
+}
+
+void WeightedFairPacketQueue::LinkStream(StreamQueue& stream, int level) {
+  // A stream that gets packets starts with a full quantum, and takes its
+  // turn after the streams that already have packets.
+  stream.deficit_bytes[level] = stream.quantum_bytes;
+  StreamQueue* const current = active_streams_[level];
+  if (current == nullptr) {
+    stream.next[level] = &stream;
+    stream.prev[level] = &stream;
+    active_streams_[level] = &stream;
+    return;
+  }
+  StreamQueue* const last = current->prev[level];
+  stream.prev[level] = last;
+  stream.next[level] = current;
+  last->next[level] = &stream;
+  current->prev[level] = &stream;
+}
+
+void WeightedFairPacketQueue::UnlinkStream(StreamQueue& stream, int level) {
+  RTC_DCHECK(stream.next[level] != nullptr);
+  if (stream.next[level] == &stream) {
+    RTC_DCHECK_EQ(active_streams_[level], &stream);
+    active_streams_[level] = nullptr;
+  } else {
+    stream.prev[level]->next[level] = stream.next[level];
+    stream.next[level]->prev[level] = stream.prev[level];
+    if (active_streams_[level] == &stream) {
+      active_streams_[level] = stream.next[level];
+    }
+  }
+  stream.next[level] = nullptr;
+  stream.prev[level] = nullptr;
+  stream.deficit_bytes[level] = 0;
+}
+
+WeightedFairPacketQueue::QueuedPacket WeightedFairPacketQueue::DequeuePacket(
+    StreamQueue& stream,
+    int level) {
+  RTC_DCHECK(!stream.packets[level].empty());
+  QueuedPacket packet = stream.packets[level].pop_front();
+  if (packet.packet->is_key_frame()) {
+    RTC_DCHECK_GT(stream.num_keyframe_packets, 0);
+    --stream.num_keyframe_packets;
+  }
+
+  --size_packets_;
+  RtpPacketMediaType packet_type = packet.packet->packet_type().value();
+  --size_packets_per_media_type_[static_cast<size_t>(packet_type)];
+  RTC_DCHECK_GE(size_packets_per_media_type_[static_cast<size_t>(packet_type)],
+                0);
+  size_payload_ -= packet.PacketSize();
+
+  TimeDelta time_in_non_paused_state =
+      last_update_time_ - packet.enqueue_time - pause_time_sum_;
+  queue_time_sum_ -= time_in_non_paused_state;
+  packet.packet->set_time_in_send_queue(time_in_non_paused_state);
+  RTC_DCHECK(size_packets_ > 0 || queue_time_sum_ == TimeDelta::Zero());
+
+  AgeOrder& age_order = age_order_[level];
+  RTC_DCHECK_GE(packet.age_index, age_order.front_index);
+  age_order.entries.at(packet.age_index - age_order.front_index).removed =
+      true;
+  while (!age_order.entries.empty() && age_order.entries.front().removed) {
+    age_order.entries.pop_front();
+    ++age_order.front_index;
+  }
+  return packet;
+}
+
+void WeightedFairPacketQueue::PurgeOldPackets(int level, Timestamp now) {
+  const TimeDelta time_to_live = time_to_live_per_prio_[level];
+  if (time_to_live.IsInfinite()) {
+    return;
+  }
+  // The oldest packet of a level is always first in the queue of its stream,
+  // since each stream queues the packets of a level in the order they came.
+  AgeOrder& age_order = age_order_[level];
+  while (!age_order.entries.empty() &&
+         now - age_order.entries.front().enqueue_time > time_to_live) {
+    StreamQueue& stream = *age_order.entries.front().stream;
+    const Timestamp enqueue_time = age_order.entries.front().enqueue_time;
+    RTC_DCHECK_EQ(stream.packets[level].front().age_index,
+                  age_order.front_index);
+    QueuedPacket packet = DequeuePacket(stream, level);
+    RTC_LOG(LS_INFO) << "Dropping old packet on SSRC: " << packet.packet->Ssrc()
+                     << " seq:" << packet.packet->SequenceNumber()
+                     << " time in queue:" << (now - enqueue_time).ms()
+                     << " ms";
+    if (stream.packets[level].empty()) {
+      UnlinkStream(stream, level);
+    }
+  }
+}
+
+Timestamp WeightedFairPacketQueue::OldestEnqueueTimeAtLevel(int level) const {
+  const AgeOrder& age_order = age_order_[level];
+  return age_order.entries.empty() ? Timestamp::MinusInfinity()
+                                   : age_order.entries.front().enqueue_time;
+}
+
+void WeightedFairPacketQueue::CullInactiveStreams(Timestamp now) {
+  // The weights of culled streams stay in `weights_`, so `min_weight_` and
+  // the quantums of the other streams don't change.
+  for (auto it = streams_.begin(); it != streams_.end();) {
+    const StreamQueue& stream = *it->second;
+    bool is_empty = true;
+    for (const RingBuffer<QueuedPacket>& packets : stream.packets) {
+      is_empty = is_empty && packets.empty();
+    }
+    if (is_empty && stream.last_enqueue_time + kStreamTimeout < now) {
+      it = streams_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  last_culling_time_ = now;
+}
+
+}  // namespace webrtc
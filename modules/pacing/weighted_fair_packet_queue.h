@@ -0,0 +1,213 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_WEIGHTED_FAIR_PACKET_QUEUE_H_
+#define MODULES_PACING_WEIGHTED_FAIR_PACKET_QUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "absl/container/inlined_vector.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/pacing/packet_queue_interface.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+
+namespace webrtc {
+
+// Packet queue for senders of many RTP streams, such as an SFU forwarding
+// many simulcast layers. Packets are prioritized by packet type in the same
+// way as in PrioritizedPacketQueue. Among the streams with packets of the
+// same priority, packets are scheduled with deficit round robin: on each
+// turn a stream may send a quantum of bytes proportional to its weight, so
+// streams share the send rate by weight rather than by packet count.
+//
+// Push() and Pop() are O(1) amortized. Packets are held in per stream ring
+// buffers that only grow, so once they have grown to the working set of the
+// stream, queuing packets does not allocate. Packets that have been queued
+// for longer than the TTL of their type are dropped, oldest first.
+class WeightedFairPacketQueue : public PacketQueueInterface {
+ public:
+  static constexpr double kDefaultWeight = 1.0;
+  // Quantum of the stream with the smallest weight. Larger than most
+  // packets, so that every turn sends at least one packet.
+  static constexpr DataSize kMinQuantum = DataSize::Bytes(1500);
+
+  explicit WeightedFairPacketQueue(
+      Timestamp creation_time,
+      bool prioritize_audio_retransmission = false,
+      PacketQueueTTL packet_queue_ttl = PacketQueueTTL());
+  WeightedFairPacketQueue(const WeightedFairPacketQueue&) = delete;
+  WeightedFairPacketQueue& operator=(const WeightedFairPacketQueue&) = delete;
+  ~WeightedFairPacketQueue() override;
+
+  void Push(Timestamp enqueue_time,
+            std::unique_ptr<RtpPacketToSend> packet) override;
+  std::unique_ptr<RtpPacketToSend> Pop() override;
+  int SizeInPackets() const override;
+  DataSize SizeInPayloadBytes() const override;
+  bool Empty() const override;
+  const std::array<int, kNumMediaTypes>& SizeInPacketsPerRtpPacketMediaType()
+      const override;
+  // Returns the enqueue time of the oldest packet of the type.
+  Timestamp LeadingPacketEnqueueTime(RtpPacketMediaType type) const override;
+  Timestamp LeadingPacketEnqueueTimeForRetransmission() const override;
+  Timestamp OldestEnqueueTime() const override;
+  TimeDelta AverageQueueTime() const override;
+  void UpdateAverageQueueTime(Timestamp now) override;
+  void SetPauseState(bool paused, Timestamp now) override;
+  void RemovePacketsForSsrc(uint32_t ssrc) override;
+  bool HasKeyframePackets(uint32_t ssrc) const override;
+  // `weight` must be positive. Streams without a weight of their own have
+  // kDefaultWeight. The weight is kept while the stream has no packets or
+  // its packets are removed, and only forgotten when it is set back to
+  // kDefaultWeight.
+  void SetStreamWeight(uint32_t ssrc, double weight) override;
+
+ private:
+  static constexpr int kNumPriorityLevels = kNumPacketPriorityLevels;
+
+  // FIFO queue in a power of two sized buffer, which doubles when full and
+  // never shrinks.
+  template <typename T>
+  class RingBuffer {
+   public:
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    T& front() { return buffer_[head_]; }
+    const T& front() const { return buffer_[head_]; }
+    // The element `index` positions after the front.
+    T& at(size_t index) { return buffer_[(head_ + index) & mask()]; }
+
+    void push_back(T value) {
+      if (size_ == buffer_.size()) {
+        Grow();
+      }
+      buffer_[(head_ + size_) & mask()] = std::move(value);
+      ++size_;
+    }
+    T pop_front() {
+      T value = std::move(buffer_[head_]);
+      head_ = (head_ + 1) & mask();
+      --size_;
+      return value;
+    }
+
+   private:
+    size_t mask() const { return buffer_.size() - 1; }
+    void Grow() {
+      std::vector<T> buffer(buffer_.empty() ? 8 : 2 * buffer_.size());
+      for (size_t i = 0; i < size_; ++i) {
+        buffer[i] = std::move(at(i));
+      }
+      buffer_.swap(buffer);
+      head_ = 0;
+    }
+
+    std::vector<T> buffer_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+  };
+
+  struct QueuedPacket {
+    DataSize PacketSize() const;
+
+    std::unique_ptr<RtpPacketToSend> packet;
+    // Enqueue time minus the pause time at enqueue, see Push().
+    Timestamp enqueue_time = Timestamp::MinusInfinity();
+    // Position of the packet in the `age_order_` of its priority level.
+    uint64_t age_index = 0;
+  };
+
+  struct StreamQueue {
+    explicit StreamQueue(Timestamp creation_time)
+        : last_enqueue_time(creation_time) {}
+
+    RingBuffer<QueuedPacket> packets[kNumPriorityLevels];
+    // Bytes the stream may still send in its current turn, per level.
+    int64_t deficit_bytes[kNumPriorityLevels] = {};
+    double weight = kDefaultWeight;
+    int64_t quantum_bytes = 0;
+    // Links of the circular lists of streams with packets, per level.
+    StreamQueue* next[kNumPriorityLevels] = {};
+    StreamQueue* prev[kNumPriorityLevels] = {};
+    Timestamp last_enqueue_time;
+    int num_keyframe_packets = 0;
+  };
+
+  // A packet of a priority level in the order of enqueue time.
+  struct AgeEntry {
+    Timestamp enqueue_time = Timestamp::MinusInfinity();
+    StreamQueue* stream = nullptr;
+    bool removed = false;
+  };
+
+  // The packets of a priority level in the order they were pushed, which is
+  // the order of enqueue time. Packets that left the queue are removed
+  // lazily from the front.
+  struct AgeOrder {
+    RingBuffer<AgeEntry> entries;
+    // Age index of the front of `entries`.
+    uint64_t front_index = 0;
+  };
+
+  int64_t QuantumBytes(double weight) const;
+  // Recomputes `min_weight_` from `weights_` and the quantums of all
+  // streams.
+  void UpdateQuantums();
+  StreamQueue& GetOrCreateStream(uint32_t ssrc, Timestamp now);
+  void LinkStream(StreamQueue& stream, int level);
+  void UnlinkStream(StreamQueue& stream, int level);
+  QueuedPacket DequeuePacket(StreamQueue& stream, int level);
+  void PurgeOldPackets(int level, Timestamp now);
+  Timestamp OldestEnqueueTimeAtLevel(int level) const;
+  void CullInactiveStreams(Timestamp now);
+
+  const bool prioritize_audio_retransmission_;
+  const absl::InlinedVector<TimeDelta, kNumPriorityLevels>
+      time_to_live_per_prio_;
+
+  // Cumulative sum, over all packets, of time spent in the queue.
+  TimeDelta queue_time_sum_;
+  // Cumulative sum of time the queue has spent in a paused state.
+  TimeDelta pause_time_sum_;
+  int size_packets_;
+  std::array<int, kNumMediaTypes> size_packets_per_media_type_;
+  DataSize size_payload_;
+  // The last time queue/pause time sums were updated.
+  Timestamp last_update_time_;
+  bool paused_;
+
+  // Last time `streams_` was culled for inactive streams.
+  Timestamp last_culling_time_;
+
+  std::unordered_map<uint32_t, std::unique_ptr<StreamQueue>> streams_;
+  // Weights set with SetStreamWeight(). Kept apart from `streams_`, which
+  // forgets streams that have had no packets for a while.
+  std::unordered_map<uint32_t, double> weights_;
+  // The smallest of `weights_`, and at most kDefaultWeight.
+  double min_weight_;
+
+  // Per level, the stream whose turn it is in the circular list of streams
+  // with packets at that level, nullptr if there are none.
+  std::array<StreamQueue*, kNumPriorityLevels> active_streams_;
+  std::array<AgeOrder, kNumPriorityLevels> age_order_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_WEIGHTED_FAIR_PACKET_QUEUE_H_
@@ -0,0 +1,283 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/weighted_fair_packet_queue.h"
+
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kDefaultSsrc = 123;
+constexpr int kDefaultPayloadSize = 789;
+
+std::unique_ptr<RtpPacketToSend> CreatePacket(RtpPacketMediaType type,
+                                              uint16_t seq,
+                                              uint32_t ssrc = kDefaultSsrc,
+                                              bool is_key_frame = false) {
+  auto packet = std::make_unique<RtpPacketToSend>(/*extensions=*/nullptr);
+  packet->set_packet_type(type);
+  packet->SetSsrc(ssrc);
+  packet->SetSequenceNumber(seq);
+  packet->SetPayloadSize(kDefaultPayloadSize);
+  packet->set_is_key_frame(is_key_frame);
+  return packet;
+}
+
+}  // namespace
+
+TEST(WeightedFairPacketQueue, ReturnsPacketsInPrioritizedOrder) {
+  Timestamp now = Timestamp::Zero();
+  WeightedFairPacketQueue queue(now);
+
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kPadding, /*seq=*/1));
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/2));
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kRetransmission, /*seq=*/3));
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kAudio, /*seq=*/4));
+
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 4);
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 3);
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 2);
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 1);
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_EQ(queue.Pop(), nullptr);
+}
+
+TEST(WeightedFairPacketQueue, KeepsPacketOrderWithinStream) {
+  Timestamp now = Timestamp::Zero();
+  WeightedFairPacketQueue queue(now);
+  for (uint16_t seq = 0; seq < 100; ++seq) {
+    queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, seq));
+  }
+  for (uint16_t seq = 0; seq < 100; ++seq) {
+    EXPECT_EQ(queue.Pop()->SequenceNumber(), seq);
+  }
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(WeightedFairPacketQueue, SharesBytesEquallyWithoutWeights) {
+  Timestamp now = Timestamp::Zero();
+  WeightedFairPacketQueue queue(now);
+  for (uint16_t seq = 0; seq < 100; ++seq) {
+    queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, seq, /*ssrc=*/1));
+    queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, seq, /*ssrc=*/2));
+  }
+
+  std::map<uint32_t, int> packets_per_ssrc;
+  for (int i = 0; i < 100; ++i) {
+    ++packets_per_ssrc[queue.Pop()->Ssrc()];
+  }
+  EXPECT_NEAR(packets_per_ssrc[1], 50, 2);
+  EXPECT_NEAR(packets_per_ssrc[2], 50, 2);
+}
+
+TEST(WeightedFairPacketQueue, SharesBytesByWeight) {
+  Timestamp now = Timestamp::Zero();
+  WeightedFairPacketQueue queue(now);
+  queue.SetStreamWeight(/*ssrc=*/1, 1.0);
+  queue.SetStreamWeight(/*ssrc=*/2, 3.0);
+  for (uint16_t seq = 0; seq < 400; ++seq) {
+    queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, seq, /*ssrc=*/1));
+    queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, seq, /*ssrc=*/2));
+  }
+
+  std::map<uint32_t, int> packets_per_ssrc;
+  for (int i = 0; i < 400; ++i) {
+    ++packets_per_ssrc[queue.Pop()->Ssrc()];
+  }
+  EXPECT_NEAR(packets_per_ssrc[1], 100, 5);
+  EXPECT_NEAR(packets_per_ssrc[2], 300, 5);
+}
+
+TEST(WeightedFairPacketQueue, WeightsApplyToExistingStreams) {
+  Timestamp now = Timestamp::Zero();
+  WeightedFairPacketQueue queue(now);
+  for (uint16_t seq = 0; seq < 400; ++seq) {
+    queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, seq, /*ssrc=*/1));
+    queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, seq, /*ssrc=*/2));
+  }
+  // Weights below the default weight scale up the quantum of the others.
+  queue.SetStreamWeight(/*ssrc=*/1, 0.5);
+
+  std::map<uint32_t, int> packets_per_ssrc;
+  for (int i = 0; i < 300; ++i) {
+    ++packets_per_ssrc[queue.Pop()->Ssrc()];
+  }
+  EXPECT_NEAR(packets_per_ssrc[1], 100, 5);
+  EXPECT_NEAR(packets_per_ssrc[2], 200, 5);
+}
+
+TEST(WeightedFairPacketQueue, KeepsWeightsOfIdleAndRemovedStreams) {
+  Timestamp now = Timestamp::Zero();
+  WeightedFairPacketQueue queue(now);
+  queue.SetStreamWeight(/*ssrc=*/1, 3.0);
+  queue.SetStreamWeight(/*ssrc=*/2, 3.0);
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, 0, /*ssrc=*/1));
+  queue.Pop();
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, 0, /*ssrc=*/2));
+  queue.RemovePacketsForSsrc(/*ssrc=*/2);
+  // Both streams are idle for longer than the culling timeout, and are
+  // culled when a packet of another stream arrives.
+  now += TimeDelta::Seconds(1);
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, 0, /*ssrc=*/3));
+  queue.Pop();
+  now += TimeDelta::Seconds(1);
+
+  for (uint16_t seq = 1; seq < 400; ++seq) {
+    queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, seq, /*ssrc=*/1));
+    queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, seq, /*ssrc=*/2));
+    queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, seq, /*ssrc=*/3));
+  }
+  std::map<uint32_t, int> packets_per_ssrc;
+  for (int i = 0; i < 700; ++i) {
+    ++packets_per_ssrc[queue.Pop()->Ssrc()];
+  }
+  EXPECT_NEAR(packets_per_ssrc[1], 300, 5);
+  EXPECT_NEAR(packets_per_ssrc[2], 300, 5);
+  EXPECT_NEAR(packets_per_ssrc[3], 100, 5);
+}
+
+TEST(WeightedFairPacketQueue, ForgetsWeightsSetBackToDefault) {
+  Timestamp now = Timestamp::Zero();
+  WeightedFairPacketQueue queue(now);
+  queue.SetStreamWeight(/*ssrc=*/1, 0.5);
+  queue.SetStreamWeight(/*ssrc=*/1, WeightedFairPacketQueue::kDefaultWeight);
+  for (uint16_t seq = 0; seq < 100; ++seq) {
+    queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, seq, /*ssrc=*/1));
+    queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, seq, /*ssrc=*/2));
+  }
+
+  std::map<uint32_t, int> packets_per_ssrc;
+  for (int i = 0; i < 100; ++i) {
+    ++packets_per_ssrc[queue.Pop()->Ssrc()];
+  }
+  EXPECT_NEAR(packets_per_ssrc[1], 50, 2);
+  EXPECT_NEAR(packets_per_ssrc[2], 50, 2);
+}
+
+TEST(WeightedFairPacketQueue, ReportsSizes) {
+  Timestamp now = Timestamp::Zero();
+  WeightedFairPacketQueue queue(now);
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kAudio, /*seq=*/1));
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/2));
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/3));
+
+  EXPECT_EQ(queue.SizeInPackets(), 3);
+  EXPECT_EQ(queue.SizeInPayloadBytes(),
+            DataSize::Bytes(3 * kDefaultPayloadSize));
+  EXPECT_EQ(queue.SizeInPacketsPerRtpPacketMediaType()[static_cast<size_t>(
+                RtpPacketMediaType::kAudio)],
+            1);
+  EXPECT_EQ(queue.SizeInPacketsPerRtpPacketMediaType()[static_cast<size_t>(
+                RtpPacketMediaType::kVideo)],
+            2);
+
+  queue.Pop();
+  EXPECT_EQ(queue.SizeInPackets(), 2);
+  EXPECT_EQ(queue.SizeInPacketsPerRtpPacketMediaType()[static_cast<size_t>(
+                RtpPacketMediaType::kAudio)],
+            0);
+}
+
+TEST(WeightedFairPacketQueue, ReportsOldestAndLeadingEnqueueTimes) {
+  Timestamp start = Timestamp::Zero();
+  WeightedFairPacketQueue queue(start);
+  EXPECT_EQ(queue.OldestEnqueueTime(), Timestamp::MinusInfinity());
+  EXPECT_EQ(queue.LeadingPacketEnqueueTimeForRetransmission(),
+            Timestamp::PlusInfinity());
+
+  queue.Push(start, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/1,
+                                 /*ssrc=*/1));
+  queue.Push(start + TimeDelta::Millis(10),
+             CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/2, /*ssrc=*/2));
+  queue.Push(start + TimeDelta::Millis(20),
+             CreatePacket(RtpPacketMediaType::kAudio, /*seq=*/3));
+  queue.Push(start + TimeDelta::Millis(30),
+             CreatePacket(RtpPacketMediaType::kRetransmission, /*seq=*/4));
+
+  EXPECT_EQ(queue.OldestEnqueueTime(), start);
+  EXPECT_EQ(queue.LeadingPacketEnqueueTime(RtpPacketMediaType::kAudio),
+            start + TimeDelta::Millis(20));
+  EXPECT_EQ(queue.LeadingPacketEnqueueTimeForRetransmission(),
+            start + TimeDelta::Millis(30));
+
+  // Removing the oldest packet advances the oldest enqueue time, even though
+  // the other packets of its level are queued on another stream.
+  queue.RemovePacketsForSsrc(/*ssrc=*/1);
+  EXPECT_EQ(queue.OldestEnqueueTime(), start + TimeDelta::Millis(10));
+  EXPECT_EQ(queue.LeadingPacketEnqueueTime(RtpPacketMediaType::kVideo),
+            start + TimeDelta::Millis(10));
+}
+
+TEST(WeightedFairPacketQueue, ReportsAverageQueueTimeExcludingPause) {
+  Timestamp now = Timestamp::Zero();
+  WeightedFairPacketQueue queue(now);
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/1));
+  now += TimeDelta::Millis(10);
+  queue.SetPauseState(true, now);
+  now += TimeDelta::Millis(100);
+  queue.SetPauseState(false, now);
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/2));
+  now += TimeDelta::Millis(10);
+  queue.UpdateAverageQueueTime(now);
+
+  // 20 ms and 10 ms, not counting the pause.
+  EXPECT_EQ(queue.AverageQueueTime(), TimeDelta::Millis(15));
+  std::unique_ptr<RtpPacketToSend> packet = queue.Pop();
+  EXPECT_EQ(packet->time_in_send_queue(), TimeDelta::Millis(20));
+  EXPECT_EQ(queue.AverageQueueTime(), TimeDelta::Millis(10));
+}
+
+TEST(WeightedFairPacketQueue, DropsPacketsQueuedLongerThanTtl) {
+  Timestamp now = Timestamp::Zero();
+  WeightedFairPacketQueue queue(now, /*prioritize_audio_retransmission=*/false,
+                                {.video = TimeDelta::Millis(100)});
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/1,
+                               /*ssrc=*/1));
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kAudio, /*seq=*/2));
+  now += TimeDelta::Millis(50);
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/3,
+                               /*ssrc=*/2));
+  now += TimeDelta::Millis(60);
+  queue.UpdateAverageQueueTime(now);
+
+  // Audio has no TTL, the first video packet has expired.
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 2);
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 3);
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(WeightedFairPacketQueue, RemovesPacketsForSsrc) {
+  Timestamp now = Timestamp::Zero();
+  WeightedFairPacketQueue queue(now);
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/1,
+                               /*ssrc=*/1, /*is_key_frame=*/true));
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kRetransmission, /*seq=*/2,
+                               /*ssrc=*/1));
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/3,
+                               /*ssrc=*/2));
+  EXPECT_TRUE(queue.HasKeyframePackets(/*ssrc=*/1));
+
+  queue.RemovePacketsForSsrc(/*ssrc=*/1);
+  EXPECT_FALSE(queue.HasKeyframePackets(/*ssrc=*/1));
+  EXPECT_EQ(queue.SizeInPackets(), 1);
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 3);
+  EXPECT_TRUE(queue.Empty());
+}
+
+}  // namespace webrtc
@@ -11,7 +11,9 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <limits>
 
+#include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "rtc_base/checks.h"
 
@@ -23,16 +25,17 @@ void PacketArrivalTimeMap::AddPacket(int64_t sequence_number,
   if (!has_seen_packet()) {
     // First packet.
     Reallocate(kMinCapacity);
+    base_time_ = arrival_time;
     begin_sequence_number_ = sequence_number;
     end_sequence_number_ = sequence_number + 1;
-    arrival_times_[Index(sequence_number)] = arrival_time;
+    SetArrivalTime(Index(sequence_number), arrival_time);
     return;
   }
 
   if (sequence_number >= begin_sequence_number() &&
       sequence_number < end_sequence_number()) {
     // The packet is within the buffer - no need to expand it.
-    arrival_times_[Index(sequence_number)] = arrival_time;
+    SetArrivalTime(Index(sequence_number), arrival_time);
     return;
   }
 
@@ -47,7 +50,7 @@ void PacketArrivalTimeMap::AddPacket(int64_t sequence_number,
     }
     AdjustToSize(new_size);
 
-    arrival_times_[Index(sequence_number)] = arrival_time;
+    SetArrivalTime(Index(sequence_number), arrival_time);
     SetNotReceived(sequence_number + 1, begin_sequence_number_);
     begin_sequence_number_ = sequence_number;
     return;
@@ -61,7 +64,7 @@ void PacketArrivalTimeMap::AddPacket(int64_t sequence_number,
     // All old packets have to be removed.
     begin_sequence_number_ = sequence_number;
     end_sequence_number_ = new_end_sequence_number;
-    arrival_times_[Index(sequence_number)] = arrival_time;
+    SetArrivalTime(Index(sequence_number), arrival_time);
     return;
   }
 
@@ -77,28 +80,46 @@ void PacketArrivalTimeMap::AddPacket(int64_t sequence_number,
   // packet, add enough placeholders to fill the gap.
   SetNotReceived(end_sequence_number_, sequence_number);
   end_sequence_number_ = new_end_sequence_number;
-  arrival_times_[Index(sequence_number)] = arrival_time;
+  SetArrivalTime(Index(sequence_number), arrival_time);
+}
+
+void PacketArrivalTimeMap::SetArrivalTime(int index, Timestamp arrival_time) {
+  if (arrival_time - base_time_ > kMaxArrivalTimeOffset) {
+    // Move the base time to the new packet. The offsets of packets received
+    // more than kMaxArrivalTimeOffset before it saturate; such packets are far
+    // too old to be reported in any feedback.
+    const int64_t shift_us = (base_time_ - arrival_time).us();
+    for (int64_t sequence_number = begin_sequence_number_;
+         sequence_number < end_sequence_number_; ++sequence_number) {
+      int i = Index(sequence_number);
+      if (IsReceived(i)) {
+        arrival_times_[i] = static_cast<int32_t>(
+            std::max<int64_t>(arrival_times_[i] + shift_us,
+                              std::numeric_limits<int32_t>::min()));
+      }
+    }
+    base_time_ = arrival_time;
+  }
+  // Packets arriving long before the base time, which monotonic clocks do not
+  // produce, saturate as well.
+  arrival_times_[index] = static_cast<int32_t>(std::max<int64_t>(
+      (arrival_time - base_time_).us(), std::numeric_limits<int32_t>::min()));
+  received_[index / 64] |= uint64_t{1} << (index % 64);
 }
 
 void PacketArrivalTimeMap::SetNotReceived(
     int64_t begin_sequence_number_inclusive,
     int64_t end_sequence_number_exclusive) {
-  static constexpr Timestamp value = Timestamp::MinusInfinity();
-
-  int begin_index = Index(begin_sequence_number_inclusive);
-  int end_index = Index(end_sequence_number_exclusive);
-
-  if (begin_index <= end_index) {
-    // Entries to clear are in single block:
-    // [......{-----}....]
-    std::fill(arrival_times_.get() + begin_index,
-              arrival_times_.get() + end_index, value);
-  } else {
-    // Entries to clear span across arrival_times_ border:
-    // [--}..........{---]
-    std::fill(arrival_times_.get() + begin_index,
-              arrival_times_.get() + capacity(), value);
-    std::fill(arrival_times_.get(), arrival_times_.get() + end_index, value);
+  // Clears the bits a word at a time.
+  int64_t sequence_number = begin_sequence_number_inclusive;
+  while (sequence_number < end_sequence_number_exclusive) {
+    int index = Index(sequence_number);
+    int num_bits = static_cast<int>(std::min<int64_t>(
+        64 - index % 64, end_sequence_number_exclusive - sequence_number));
+    uint64_t mask =
+        num_bits == 64 ? ~uint64_t{0} : (uint64_t{1} << num_bits) - 1;
+    received_[index / 64] &= ~(mask << (index % 64));
+    sequence_number += num_bits;
   }
 }
 
@@ -106,7 +127,7 @@ void PacketArrivalTimeMap::RemoveOldPackets(int64_t sequence_number,
                                             Timestamp arrival_time_limit) {
   int64_t check_to = std::min(sequence_number, end_sequence_number_);
   while (begin_sequence_number_ < check_to &&
-         arrival_times_[Index(begin_sequence_number_)] <= arrival_time_limit) {
+         get(begin_sequence_number_) <= arrival_time_limit) {
     ++begin_sequence_number_;
   }
   AdjustToSize(end_sequence_number_ - begin_sequence_number_);
@@ -147,17 +168,22 @@ void PacketArrivalTimeMap::Reallocate(int new_capacity) {
   int new_capacity_minus_1 = new_capacity - 1;
   // Check capacity is a power of 2.
   RTC_DCHECK_EQ(new_capacity & new_capacity_minus_1, 0);
-  // Create uninitialized memory.
-  // All valid entries should be set by `AddPacket` before use.
-  void* raw = operator new[](new_capacity * sizeof(Timestamp));
-  Timestamp* new_buffer = static_cast<Timestamp*>(raw);
+  // Arrival times are left uninitialized, they are set by `AddPacket` when a
+  // packet is marked as received.
+  auto new_received = std::make_unique<uint64_t[]>(new_capacity / 64);
+  std::unique_ptr<int32_t[]> new_arrival_times(new int32_t[new_capacity]);
 
   for (int64_t sequence_number = begin_sequence_number_;
        sequence_number < end_sequence_number_; ++sequence_number) {
-    new_buffer[sequence_number & new_capacity_minus_1] =
-        arrival_times_[sequence_number & capacity_minus_1_];
+    int index = Index(sequence_number);
+    if (IsReceived(index)) {
+      int new_index = sequence_number & new_capacity_minus_1;
+      new_received[new_index / 64] |= uint64_t{1} << (new_index % 64);
+      new_arrival_times[new_index] = arrival_times_[index];
+    }
   }
-  arrival_times_.reset(new_buffer);
+  received_ = std::move(new_received);
+  arrival_times_ = std::move(new_arrival_times);
   capacity_minus_1_ = new_capacity_minus_1;
 }
 
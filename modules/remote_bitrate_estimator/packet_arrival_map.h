@@ -13,8 +13,11 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <memory>
 
+#include "absl/numeric/bits.h"
+#include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "rtc_base/checks.h"
 
@@ -25,10 +28,14 @@ namespace webrtc {
 // needed, and remove old packets, and will expand to allow earlier packets to
 // be added (out-of-order).
 //
-// Not yet received packets have the arrival time zero. The queue will not span
-// larger than necessary and the last packet should always be received. The
-// first packet in the queue doesn't have to be received in case of receiving
-// packets out-of-order.
+// Not yet received packets have the arrival time minus infinity. The queue will
+// not span larger than necessary and the last packet should always be
+// received. The first packet in the queue doesn't have to be received in case
+// of receiving packets out-of-order.
+//
+// Which packets have been received is kept in a bitset, and arrival times are
+// kept as 32 bit microsecond offsets from a base time, so that a packet costs
+// a bit over 4 bytes and runs of lost packets are skipped a word at a time.
 class PacketArrivalTimeMap {
  public:
   struct PacketArrivalTime {
@@ -48,7 +55,7 @@ class PacketArrivalTimeMap {
   bool has_received(int64_t sequence_number) const {
     return sequence_number >= begin_sequence_number() &&
            sequence_number < end_sequence_number() &&
-           arrival_times_[Index(sequence_number)] >= Timestamp::Zero();
+           IsReceived(Index(sequence_number));
   }
 
   // Returns the sequence number of the first entry in the map, i.e. the
@@ -64,7 +71,8 @@ class PacketArrivalTimeMap {
   Timestamp get(int64_t sequence_number) {
     RTC_DCHECK_GE(sequence_number, begin_sequence_number());
     RTC_DCHECK_LT(sequence_number, end_sequence_number());
-    return arrival_times_[Index(sequence_number)];
+    int index = Index(sequence_number);
+    return IsReceived(index) ? ArrivalTime(index) : Timestamp::MinusInfinity();
   }
 
   // Returns timestamp and sequence number of the received packet with sequence
@@ -73,13 +81,17 @@ class PacketArrivalTimeMap {
   PacketArrivalTime FindNextAtOrAfter(int64_t sequence_number) const {
     RTC_DCHECK_GE(sequence_number, begin_sequence_number());
     RTC_DCHECK_LT(sequence_number, end_sequence_number());
-    while (true) {
-      Timestamp t = arrival_times_[Index(sequence_number)];
-      if (t >= Timestamp::Zero()) {
-        return {.arrival_time = t, .sequence_number = sequence_number};
-      }
-      ++sequence_number;
+    // Skips packets that have not been received a word at a time.
+    int index = Index(sequence_number);
+    uint64_t word = received_[index / 64] >> (index % 64);
+    while (word == 0) {
+      sequence_number += 64 - index % 64;
+      index = Index(sequence_number);
+      word = received_[index / 64];
     }
+    sequence_number += absl::countr_zero(word);
+    return {.arrival_time = ArrivalTime(Index(sequence_number)),
+            .sequence_number = sequence_number};
   }
 
   // Clamps `sequence_number` between [begin_sequence_number,
@@ -102,6 +114,9 @@ class PacketArrivalTimeMap {
 
  private:
   static constexpr int kMinCapacity = 128;
+  // Arrival times further than this from `base_time_` move the base time.
+  static constexpr TimeDelta kMaxArrivalTimeOffset =
+      TimeDelta::Micros(std::numeric_limits<int32_t>::max());
 
   // Returns index in the `arrival_times_` for value for `sequence_number`.
   int Index(int64_t sequence_number) const {
@@ -111,6 +126,14 @@ class PacketArrivalTimeMap {
     return sequence_number & capacity_minus_1_;
   }
 
+  bool IsReceived(int index) const {
+    return (received_[index / 64] >> (index % 64)) & 1;
+  }
+  Timestamp ArrivalTime(int index) const {
+    return base_time_ + TimeDelta::Micros(arrival_times_[index]);
+  }
+  void SetArrivalTime(int index, Timestamp arrival_time);
+
   void SetNotReceived(int64_t begin_sequence_number_inclusive,
                       int64_t end_sequence_number_exclusive);
 
@@ -122,9 +145,14 @@ class PacketArrivalTimeMap {
   int capacity() const { return capacity_minus_1_ + 1; }
   bool has_seen_packet() const { return arrival_times_ != nullptr; }
 
-  // Circular buffer. Packet with sequence number `sequence_number`
-  // is stored in the slot `sequence_number % capacity_`
-  std::unique_ptr<Timestamp[]> arrival_times_ = nullptr;
+  // Circular buffers. Packet with sequence number `sequence_number`
+  // is stored in the slot `sequence_number % capacity_`. Its bit in
+  // `received_` is set if it has been received, in which case
+  // `arrival_times_` holds its arrival time in microseconds after
+  // `base_time_`.
+  std::unique_ptr<uint64_t[]> received_ = nullptr;
+  std::unique_ptr<int32_t[]> arrival_times_ = nullptr;
+  Timestamp base_time_ = Timestamp::Zero();
 
   // Allocated size of the `arrival_times_`
   // capacity_ is a power of 2 in range [kMinCapacity, kMaxNumberOfPackets]
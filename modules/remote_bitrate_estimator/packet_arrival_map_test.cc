@@ -9,6 +9,8 @@
  */
 #include "modules/remote_bitrate_estimator/packet_arrival_map.h"
 
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -82,6 +84,38 @@ TEST(PacketArrivalMapTest, FindNextAtOrAfterWithGaps) {
   EXPECT_EQ(packet.sequence_number, 45);
 }
 
+TEST(PacketArrivalMapTest, FindNextAtOrAfterSkipsLongGaps) {
+  PacketArrivalTimeMap map;
+
+  map.AddPacket(42, Timestamp::Millis(10));
+  map.AddPacket(1042, Timestamp::Micros(20'001));
+  map.AddPacket(1043, Timestamp::Micros(20'002));
+
+  PacketArrivalTimeMap::PacketArrivalTime packet = map.FindNextAtOrAfter(43);
+  EXPECT_EQ(packet.arrival_time, Timestamp::Micros(20'001));
+  EXPECT_EQ(packet.sequence_number, 1042);
+
+  packet = map.FindNextAtOrAfter(1043);
+  EXPECT_EQ(packet.arrival_time, Timestamp::Micros(20'002));
+  EXPECT_EQ(packet.sequence_number, 1043);
+}
+
+TEST(PacketArrivalMapTest, KeepsArrivalTimesFarAfterFirstPacket) {
+  PacketArrivalTimeMap map;
+
+  constexpr Timestamp kStart = Timestamp::Seconds(1);
+  map.AddPacket(42, kStart);
+  map.AddPacket(43, kStart + TimeDelta::Minutes(20));
+  map.AddPacket(44, kStart + TimeDelta::Minutes(40));
+  EXPECT_EQ(map.get(43), kStart + TimeDelta::Minutes(20));
+  EXPECT_EQ(map.get(44), kStart + TimeDelta::Minutes(40));
+
+  map.AddPacket(45, kStart + TimeDelta::Minutes(600));
+  EXPECT_TRUE(map.has_received(42));
+  EXPECT_TRUE(map.has_received(44));
+  EXPECT_EQ(map.get(45), kStart + TimeDelta::Minutes(600));
+}
+
 TEST(PacketArrivalMapTest, InsertsWithinBuffer) {
   PacketArrivalTimeMap map;
 
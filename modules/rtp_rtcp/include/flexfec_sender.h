@@ -31,6 +31,7 @@
 namespace webrtc {
 
 class Clock;
+class FecEncodingPool;
 class RtpPacketToSend;
 
 // Note that this class is not thread safe, and thus requires external
@@ -63,6 +64,10 @@ class FlexfecSender : public VideoFecGenerator {
   // These FEC packets are then obtained by calling GetFecPackets().
   void AddPacketAndGenerateFec(const RtpPacketToSend& packet) override;
 
+  // Generates the FEC packets of large frames on the threads of `pool`, unless
+  // null. The pool must outlive this object.
+  void SetEncodingPool(FecEncodingPool* pool);
+
   // Returns generated FlexFEC packets.
   std::vector<std::unique_ptr<RtpPacketToSend>> GetFecPackets() override;
 
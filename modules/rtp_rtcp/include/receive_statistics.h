@@ -32,6 +32,14 @@ class ReceiveStatisticsProvider {
   // Returns at most `max_blocks` report blocks.
   virtual std::vector<rtcp::ReportBlock> RtcpReportBlocks(
       size_t max_blocks) = 0;
+  // Same as above, but appends the report blocks to `report_blocks`, so that
+  // callers sending reports periodically can reuse its storage.
+  virtual void AppendRtcpReportBlocks(
+      size_t max_blocks,
+      std::vector<rtcp::ReportBlock>& report_blocks) {
+    std::vector<rtcp::ReportBlock> blocks = RtcpReportBlocks(max_blocks);
+    report_blocks.insert(report_blocks.end(), blocks.begin(), blocks.end());
+  }
 };
 
 class StreamStatistician {
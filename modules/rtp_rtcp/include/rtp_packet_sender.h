@@ -33,6 +33,12 @@ class RtpPacketSender {
   // TODO(crbug.com/1395081): Make pure virtual when downstream code has been
   // updated.
   virtual void RemovePacketsForSsrc(uint32_t ssrc) {}
+
+  // Sets the share of the send rate the stream `ssrc` gets relative to other
+  // streams with packets of the same type, for senders that schedule streams
+  // by weight. The weight stays until it is set back to the default of 1,
+  // which the owner of the stream should do when it goes away.
+  virtual void SetStreamWeight(uint32_t ssrc, double weight) {}
 };
 
 }  // namespace webrtc
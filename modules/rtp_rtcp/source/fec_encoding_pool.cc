@@ -0,0 +1,87 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_encoding_pool.h"
+
+#include <algorithm>
+#include <string>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+FecEncodingPool::FecEncodingPool(int num_threads) {
+  RTC_DCHECK_GE(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    auto worker = std::make_unique<Worker>();
+    Worker* const worker_ptr = worker.get();
+    worker->thread = rtc::PlatformThread::SpawnJoinable(
+        [worker_ptr] { RunWorker(*worker_ptr); },
+        "FecEncoder" + std::to_string(i),
+        rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kHigh));
+    workers_.push_back(std::move(worker));
+  }
+}
+
+FecEncodingPool::~FecEncodingPool() {
+  for (auto& worker : workers_) {
+    worker->stop = true;
+    worker->wakeup.Set();
+    worker->thread.Finalize();
+  }
+}
+
+void FecEncodingPool::ParallelFor(size_t count,
+                                  rtc::FunctionView<void(size_t)> task) {
+  if (!workers_.empty() && count > 1 && busy_mutex_.TryLock()) {
+    // The calling thread takes part, so at most `count - 1` workers are
+    // needed.
+    const size_t num_workers = std::min(workers_.size(), count - 1);
+    Job job(count, task, static_cast<int>(num_workers));
+    for (size_t i = 0; i < num_workers; ++i) {
+      workers_[i]->job = &job;
+      workers_[i]->wakeup.Set();
+    }
+    RunTasks(job);
+    // The workers access `job` until they have signaled it done.
+    job.done.Wait(rtc::Event::kForever);
+    busy_mutex_.Unlock();
+    return;
+  }
+
+  // Another encoder is using the workers, or there is nothing to share.
+  for (size_t i = 0; i < count; ++i) {
+    task(i);
+  }
+}
+
+void FecEncodingPool::RunWorker(Worker& worker) {
+  while (true) {
+    worker.wakeup.Wait(rtc::Event::kForever);
+    if (worker.stop) {
+      return;
+    }
+    Job& job = *worker.job;
+    RunTasks(job);
+    if (job.pending_workers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      job.done.Set();
+    }
+  }
+}
+
+void FecEncodingPool::RunTasks(Job& job) {
+  for (size_t i = job.next_index.fetch_add(1, std::memory_order_relaxed);
+       i < job.count;
+       i = job.next_index.fetch_add(1, std::memory_order_relaxed)) {
+    job.task(i);
+  }
+}
+
+}  // namespace webrtc
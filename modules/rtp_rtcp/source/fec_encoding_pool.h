@@ -0,0 +1,77 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_FEC_ENCODING_POOL_H_
+#define MODULES_RTP_RTCP_SOURCE_FEC_ENCODING_POOL_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "api/function_view.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mutex.h"
+
+namespace webrtc {
+
+// A small pool of threads that the FEC encoders use to generate the packets
+// of large frames in parallel. The pool may be shared by several encoders;
+// while one of them is using it, the others do their work on their own
+// threads.
+class FecEncodingPool {
+ public:
+  // Starts `num_threads` worker threads, which help the thread calling
+  // ParallelFor().
+  explicit FecEncodingPool(int num_threads);
+  ~FecEncodingPool();
+
+  FecEncodingPool(const FecEncodingPool&) = delete;
+  FecEncodingPool& operator=(const FecEncodingPool&) = delete;
+
+  // Calls `task` once for each index in [0, `count`), from the calling thread
+  // and the worker threads, and returns when all calls have returned. Calls
+  // are made in no particular order, so `task` must be safe to call
+  // concurrently for different indices.
+  void ParallelFor(size_t count, rtc::FunctionView<void(size_t)> task);
+
+ private:
+  struct Job {
+    Job(size_t count, rtc::FunctionView<void(size_t)> task, int num_workers)
+        : count(count), task(task), pending_workers(num_workers) {}
+
+    const size_t count;
+    const rtc::FunctionView<void(size_t)> task;
+    std::atomic<size_t> next_index{0};
+    std::atomic<int> pending_workers;
+    rtc::Event done;
+  };
+
+  struct Worker {
+    rtc::Event wakeup;
+    // Written before `wakeup` is set.
+    Job* job = nullptr;
+    bool stop = false;
+    rtc::PlatformThread thread;
+  };
+
+  static void RunWorker(Worker& worker);
+  static void RunTasks(Job& job);
+
+  // Held by the thread calling ParallelFor().
+  Mutex busy_mutex_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_FEC_ENCODING_POOL_H_
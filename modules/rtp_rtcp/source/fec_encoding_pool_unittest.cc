@@ -0,0 +1,69 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_encoding_pool.h"
+
+#include <stddef.h>
+
+#include <atomic>
+#include <vector>
+
+#include "rtc_base/platform_thread.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::Each;
+
+TEST(FecEncodingPoolTest, CallsTaskOnceForEachIndex) {
+  FecEncodingPool pool(/*num_threads=*/3);
+  for (size_t count : {0, 1, 2, 5, 48}) {
+    std::vector<std::atomic<int>> calls(count);
+    pool.ParallelFor(count, [&](size_t i) { ++calls[i]; });
+    for (const std::atomic<int>& num_calls : calls) {
+      EXPECT_EQ(num_calls.load(), 1) << "count " << count;
+    }
+  }
+}
+
+TEST(FecEncodingPoolTest, RunsTasksWithoutThreads) {
+  FecEncodingPool pool(/*num_threads=*/0);
+  std::vector<int> calls(10);
+  pool.ParallelFor(calls.size(), [&](size_t i) { ++calls[i]; });
+  EXPECT_THAT(calls, Each(1));
+}
+
+TEST(FecEncodingPoolTest, IsSharedByConcurrentCallers) {
+  constexpr int kNumCallers = 4;
+  constexpr int kNumJobs = 200;
+  constexpr size_t kCount = 24;
+  FecEncodingPool pool(/*num_threads=*/2);
+  std::vector<std::vector<int>> sums(kNumCallers,
+                                     std::vector<int>(kCount, 0));
+  std::vector<rtc::PlatformThread> callers;
+  for (int caller = 0; caller < kNumCallers; ++caller) {
+    callers.push_back(rtc::PlatformThread::SpawnJoinable(
+        [&pool, &sum = sums[caller]] {
+          for (int job = 0; job < kNumJobs; ++job) {
+            pool.ParallelFor(kCount, [&sum](size_t i) { ++sum[i]; });
+          }
+        },
+        "FecEncodingPoolTest"));
+  }
+  callers.clear();
+  for (const std::vector<int>& sum : sums) {
+    EXPECT_THAT(sum, Each(kNumJobs));
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,117 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include <string.h>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+
+#include "modules/rtp_rtcp/source/fec_xor_avx2.h"
+#endif
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace webrtc {
+namespace {
+
+// Processes eight bytes at a time in general purpose registers.
+void XorFecDataScalar(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    uint64_t s;
+    uint64_t d;
+    memcpy(&s, src + i, sizeof(s));
+    memcpy(&d, dst + i, sizeof(d));
+    d ^= s;
+    memcpy(dst + i, &d, sizeof(d));
+  }
+  for (; i < length; ++i) {
+    dst[i] ^= src[i];
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void XorFecDataSse2(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const __m128i s =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i d = _mm_loadu_si128(reinterpret_cast<__m128i*>(dst + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(d, s));
+  }
+  XorFecDataScalar(src + i, length - i, dst + i);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+void XorFecDataNeon(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), vld1q_u8(src + i)));
+  }
+  XorFecDataScalar(src + i, length - i, dst + i);
+}
+#endif
+
+}  // namespace
+
+FecXorOptimization DetectFecXorOptimization() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2) != 0) {
+    return FecXorOptimization::kAvx2;
+  } else if (GetCPUInfo(kSSE2) != 0) {
+    return FecXorOptimization::kSse2;
+  }
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+  return FecXorOptimization::kNeon;
+#else
+  return FecXorOptimization::kNone;
+#endif
+}
+
+void XorFecData(const uint8_t* src, size_t length, uint8_t* dst) {
+  static const FecXorOptimization optimization = DetectFecXorOptimization();
+  XorFecData(optimization, src, length, dst);
+}
+
+void XorFecData(FecXorOptimization optimization,
+                const uint8_t* src,
+                size_t length,
+                uint8_t* dst) {
+  RTC_DCHECK(src + length <= dst || dst + length <= src);
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case FecXorOptimization::kAvx2:
+      XorFecData_AVX2(src, length, dst);
+      return;
+    case FecXorOptimization::kSse2:
+      XorFecDataSse2(src, length, dst);
+      return;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case FecXorOptimization::kNeon:
+      XorFecDataNeon(src, length, dst);
+      return;
+#endif
+    default:
+      XorFecDataScalar(src, length, dst);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,39 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
+#define MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace webrtc {
+
+// Instruction sets the FEC XOR kernels can be built for.
+enum class FecXorOptimization { kNone, kSse2, kAvx2, kNeon };
+
+// Returns the fastest kernel supported by the current CPU.
+FecXorOptimization DetectFecXorOptimization();
+
+// XORs `length` bytes of `src` into `dst`, i.e., dst[i] ^= src[i]. The two
+// ranges must not overlap. Uses the kernel returned by
+// DetectFecXorOptimization().
+void XorFecData(const uint8_t* src, size_t length, uint8_t* dst);
+
+// As above, with an explicit kernel that must be supported by the CPU. Exposed
+// for testing.
+void XorFecData(FecXorOptimization optimization,
+                const uint8_t* src,
+                size_t length,
+                uint8_t* dst);
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
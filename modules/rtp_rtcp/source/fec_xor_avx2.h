@@ -0,0 +1,24 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_FEC_XOR_AVX2_H_
+#define MODULES_RTP_RTCP_SOURCE_FEC_XOR_AVX2_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace webrtc {
+
+// AVX2 kernel of XorFecData(). Must only be called when the CPU supports AVX2.
+void XorFecData_AVX2(const uint8_t* src, size_t length, uint8_t* dst);
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_FEC_XOR_AVX2_H_
@@ -0,0 +1,91 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+// The kernels supported by the CPU running the test.
+std::vector<FecXorOptimization> SupportedOptimizations() {
+  std::vector<FecXorOptimization> optimizations = {FecXorOptimization::kNone};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kSSE2) != 0) {
+    optimizations.push_back(FecXorOptimization::kSse2);
+  }
+  if (GetCPUInfo(kAVX2) != 0) {
+    optimizations.push_back(FecXorOptimization::kAvx2);
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  optimizations.push_back(FecXorOptimization::kNeon);
+#endif
+  return optimizations;
+}
+
+std::vector<uint8_t> RandomBytes(Random& random, size_t size) {
+  std::vector<uint8_t> bytes(size);
+  for (uint8_t& byte : bytes) {
+    byte = random.Rand<uint8_t>();
+  }
+  return bytes;
+}
+
+class FecXorTest : public ::testing::TestWithParam<FecXorOptimization> {};
+
+INSTANTIATE_TEST_SUITE_P(FecXorOptimizations,
+                         FecXorTest,
+                         ::testing::ValuesIn(SupportedOptimizations()));
+
+TEST_P(FecXorTest, XorsEveryByteOfUnalignedRanges) {
+  Random random(0x1234);
+  // Covers the vector loops, their tails and a full-sized payload.
+  constexpr size_t kLengths[] = {0, 1, 7, 8, 15, 16, 17, 31, 32, 33, 63, 1200};
+  for (size_t length : kLengths) {
+    for (size_t src_offset = 0; src_offset < 4; ++src_offset) {
+      for (size_t dst_offset = 0; dst_offset < 4; ++dst_offset) {
+        const std::vector<uint8_t> src =
+            RandomBytes(random, src_offset + length);
+        std::vector<uint8_t> dst = RandomBytes(random, dst_offset + length + 1);
+        std::vector<uint8_t> expected = dst;
+        for (size_t i = 0; i < length; ++i) {
+          expected[dst_offset + i] ^= src[src_offset + i];
+        }
+
+        XorFecData(GetParam(), src.data() + src_offset, length,
+                   dst.data() + dst_offset);
+        EXPECT_THAT(dst, ElementsAreArray(expected))
+            << "length " << length << ", src offset " << src_offset
+            << ", dst offset " << dst_offset;
+      }
+    }
+  }
+}
+
+TEST(FecXorDetectTest, DetectsSupportedOptimization) {
+  const std::vector<FecXorOptimization> supported = SupportedOptimizations();
+  EXPECT_EQ(DetectFecXorOptimization(), supported.back());
+}
+
+}  // namespace
+}  // namespace webrtc
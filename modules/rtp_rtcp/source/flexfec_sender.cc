@@ -122,6 +122,10 @@ void FlexfecSender::AddPacketAndGenerateFec(const RtpPacketToSend& packet) {
   ulpfec_generator_.AddPacketAndGenerateFec(packet);
 }
 
+void FlexfecSender::SetEncodingPool(FecEncodingPool* pool) {
+  ulpfec_generator_.SetEncodingPool(pool);
+}
+
 std::vector<std::unique_ptr<RtpPacketToSend>> FlexfecSender::GetFecPackets() {
   RTC_CHECK_RUNS_SERIALIZED(&ulpfec_generator_.race_checker_);
   std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets_to_send;
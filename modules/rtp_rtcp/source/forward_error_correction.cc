@@ -19,6 +19,8 @@
 #include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/fec_encoding_pool.h"
+#include "modules/rtp_rtcp/source/fec_xor.h"
 #include "modules/rtp_rtcp/source/flexfec_03_header_reader_writer.h"
 #include "modules/rtp_rtcp/source/forward_error_correction_internal.h"
 #include "modules/rtp_rtcp/source/ulpfec_header_reader_writer.h"
@@ -33,6 +35,10 @@ namespace {
 constexpr size_t kTransportOverhead = 28;
 
 constexpr uint16_t kOldSequenceThreshold = 0x3fff;
+
+// Frames with fewer FEC packets than this are encoded on the calling thread,
+// as waking up the threads of the encoding pool would cost more than it saves.
+constexpr size_t kMinFecPacketsForEncodingPool = 8;
 }  // namespace
 
 ForwardErrorCorrection::Packet::Packet() : data(0), ref_count_(0) {}
@@ -190,6 +196,10 @@ int ForwardErrorCorrection::EncodeFec(const PacketList& media_packets,
   return 0;
 }
 
+void ForwardErrorCorrection::SetEncodingPool(FecEncodingPool* pool) {
+  encoding_pool_ = pool;
+}
+
 int ForwardErrorCorrection::NumFecPackets(int num_media_packets,
                                           int protection_factor) {
   // Result in Q0 with an unsigned round.
@@ -206,49 +216,59 @@ void ForwardErrorCorrection::GenerateFecPayloads(
     const PacketList& media_packets,
     size_t num_fec_packets) {
   RTC_DCHECK(!media_packets.empty());
+  if (encoding_pool_ != nullptr &&
+      num_fec_packets >= kMinFecPacketsForEncodingPool) {
+    encoding_pool_->ParallelFor(num_fec_packets, [&](size_t i) {
+      GenerateFecPayload(media_packets, i);
+    });
+    return;
+  }
   for (size_t i = 0; i < num_fec_packets; ++i) {
-    Packet* const fec_packet = &generated_fec_packets_[i];
-    size_t pkt_mask_idx = i * packet_mask_size_;
-    const size_t min_packet_mask_size = fec_header_writer_->MinPacketMaskSize(
-        &packet_masks_[pkt_mask_idx], packet_mask_size_);
-    const size_t fec_header_size =
-        fec_header_writer_->FecHeaderSize(min_packet_mask_size);
-
-    size_t media_pkt_idx = 0;
-    auto media_packets_it = media_packets.cbegin();
-    uint16_t prev_seq_num =
-        ParseSequenceNumber((*media_packets_it)->data.data());
-    while (media_packets_it != media_packets.end()) {
-      Packet* const media_packet = media_packets_it->get();
-      // Should `media_packet` be protected by `fec_packet`?
-      if (packet_masks_[pkt_mask_idx] & (1 << (7 - media_pkt_idx))) {
-        size_t media_payload_length =
-            media_packet->data.size() - kRtpHeaderSize;
-
-        size_t fec_packet_length = fec_header_size + media_payload_length;
-        if (fec_packet_length > fec_packet->data.size()) {
-          size_t old_size = fec_packet->data.size();
-          fec_packet->data.SetSize(fec_packet_length);
-          memset(fec_packet->data.MutableData() + old_size, 0,
-                 fec_packet_length - old_size);
-        }
-        XorHeaders(*media_packet, fec_packet);
-        XorPayloads(*media_packet, media_payload_length, fec_header_size,
-                    fec_packet);
-      }
-      media_packets_it++;
-      if (media_packets_it != media_packets.end()) {
-        uint16_t seq_num =
-            ParseSequenceNumber((*media_packets_it)->data.data());
-        media_pkt_idx += static_cast<uint16_t>(seq_num - prev_seq_num);
-        prev_seq_num = seq_num;
+    GenerateFecPayload(media_packets, i);
+  }
+}
+
+void ForwardErrorCorrection::GenerateFecPayload(
+    const PacketList& media_packets,
+    size_t fec_index) {
+  Packet* const fec_packet = &generated_fec_packets_[fec_index];
+  size_t pkt_mask_idx = fec_index * packet_mask_size_;
+  const size_t min_packet_mask_size = fec_header_writer_->MinPacketMaskSize(
+      &packet_masks_[pkt_mask_idx], packet_mask_size_);
+  const size_t fec_header_size =
+      fec_header_writer_->FecHeaderSize(min_packet_mask_size);
+
+  size_t media_pkt_idx = 0;
+  auto media_packets_it = media_packets.cbegin();
+  uint16_t prev_seq_num = ParseSequenceNumber((*media_packets_it)->data.data());
+  while (media_packets_it != media_packets.end()) {
+    Packet* const media_packet = media_packets_it->get();
+    // Should `media_packet` be protected by `fec_packet`?
+    if (packet_masks_[pkt_mask_idx] & (1 << (7 - media_pkt_idx))) {
+      size_t media_payload_length = media_packet->data.size() - kRtpHeaderSize;
+
+      size_t fec_packet_length = fec_header_size + media_payload_length;
+      if (fec_packet_length > fec_packet->data.size()) {
+        size_t old_size = fec_packet->data.size();
+        fec_packet->data.SetSize(fec_packet_length);
+        memset(fec_packet->data.MutableData() + old_size, 0,
+               fec_packet_length - old_size);
       }
-      pkt_mask_idx += media_pkt_idx / 8;
-      media_pkt_idx %= 8;
+      XorHeaders(*media_packet, fec_packet);
+      XorPayloads(*media_packet, media_payload_length, fec_header_size,
+                  fec_packet);
+    }
+    media_packets_it++;
+    if (media_packets_it != media_packets.end()) {
+      uint16_t seq_num = ParseSequenceNumber((*media_packets_it)->data.data());
+      media_pkt_idx += static_cast<uint16_t>(seq_num - prev_seq_num);
+      prev_seq_num = seq_num;
     }
-    RTC_DCHECK_GT(fec_packet->data.size(), 0)
-        << "Packet mask is wrong or poorly designed.";
+    pkt_mask_idx += media_pkt_idx / 8;
+    media_pkt_idx %= 8;
   }
+  RTC_DCHECK_GT(fec_packet->data.size(), 0)
+      << "Packet mask is wrong or poorly designed.";
 }
 
 int ForwardErrorCorrection::InsertZerosInPacketMasks(
@@ -600,24 +620,21 @@ bool ForwardErrorCorrection::FinishPacketRecovery(
 }
 
 void ForwardErrorCorrection::XorHeaders(const Packet& src, Packet* dst) {
-  uint8_t* dst_data = dst->data.MutableData();
   const uint8_t* src_data = src.data.cdata();
-  // XOR the first 2 bytes of the header: V, P, X, CC, M, PT fields.
-  dst_data[0] ^= src_data[0];
-  dst_data[1] ^= src_data[1];
-
-  // XOR the length recovery field.
-  uint8_t src_payload_length_network_order[2];
-  ByteWriter<uint16_t>::WriteBigEndian(src_payload_length_network_order,
+  // XOR the first 8 bytes of the header in one go: the V, P, X, CC, M, PT
+  // fields, the length recovery field in place of the sequence number, and
+  // the timestamp field.
+  uint8_t src_header[8];
+  memcpy(src_header, src_data, sizeof(src_header));
+  ByteWriter<uint16_t>::WriteBigEndian(&src_header[2],
                                        src.data.size() - kRtpHeaderSize);
-  dst_data[2] ^= src_payload_length_network_order[0];
-  dst_data[3] ^= src_payload_length_network_order[1];
-
-  // XOR the 5th to 8th bytes of the header: the timestamp field.
-  dst_data[4] ^= src_data[4];
-  dst_data[5] ^= src_data[5];
-  dst_data[6] ^= src_data[6];
-  dst_data[7] ^= src_data[7];
+  uint8_t* dst_data = dst->data.MutableData();
+  uint64_t src_word;
+  uint64_t dst_word;
+  memcpy(&src_word, src_header, sizeof(src_word));
+  memcpy(&dst_word, dst_data, sizeof(dst_word));
+  dst_word ^= src_word;
+  memcpy(dst_data, &dst_word, sizeof(dst_word));
 
   // Skip the 9th to 12th bytes of the header.
 }
@@ -635,11 +652,8 @@ void ForwardErrorCorrection::XorPayloads(const Packet& src,
     dst->data.SetSize(new_size);
     memset(dst->data.MutableData() + old_size, 0, new_size - old_size);
   }
-  uint8_t* dst_data = dst->data.MutableData();
-  const uint8_t* src_data = src.data.cdata();
-  for (size_t i = 0; i < payload_length; ++i) {
-    dst_data[dst_offset + i] ^= src_data[kRtpHeaderSize + i];
-  }
+  XorFecData(src.data.cdata() + kRtpHeaderSize, payload_length,
+             dst->data.MutableData() + dst_offset);
 }
 
 bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
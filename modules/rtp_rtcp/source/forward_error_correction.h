@@ -29,6 +29,7 @@
 
 namespace webrtc {
 
+class FecEncodingPool;
 class FecHeaderReader;
 class FecHeaderWriter;
 
@@ -207,6 +208,10 @@ class ForwardErrorCorrection {
                 FecMaskType fec_mask_type,
                 std::list<Packet*>* fec_packets);
 
+  // Lets EncodeFec() generate the FEC packets of large frames on the threads
+  // of `pool`, unless null. The pool must outlive this object.
+  void SetEncodingPool(FecEncodingPool* pool);
+
   // Decodes a list of received media and FEC packets. It will parse the
   // `received_packets`, storing FEC packets internally, and move
   // media packets to `recovered_packets`. The recovered list will be
@@ -274,6 +279,11 @@ class ForwardErrorCorrection {
   void GenerateFecPayloads(const PacketList& media_packets,
                            size_t num_fec_packets);
 
+  // Writes the payload of the FEC packet at `fec_index`. Only touches that
+  // packet, so different packets may be written concurrently.
+  void GenerateFecPayload(const PacketList& media_packets,
+                          size_t fec_index);
+
   // Writes the FEC header fields that are not written by GenerateFecPayloads.
   // This includes writing the packet masks.
   void FinalizeFecHeaders(size_t num_fec_packets,
@@ -367,6 +377,8 @@ class ForwardErrorCorrection {
   uint8_t packet_masks_[kUlpfecMaxMediaPackets * kUlpfecMaxPacketMaskSize];
   uint8_t tmp_packet_masks_[kUlpfecMaxMediaPackets * kUlpfecMaxPacketMaskSize];
   size_t packet_mask_size_;
+
+  FecEncodingPool* encoding_pool_ = nullptr;
 };
 
 // Classes derived from FecHeader{Reader,Writer} encapsulate the
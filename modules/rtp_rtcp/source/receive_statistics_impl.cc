@@ -21,6 +21,7 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_config.h"
+#include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/time_utils.h"
 #include "system_wrappers/include/clock.h"
@@ -29,6 +30,8 @@ namespace webrtc {
 namespace {
 constexpr TimeDelta kStatisticsTimeout = TimeDelta::Seconds(8);
 constexpr TimeDelta kStatisticsProcessInterval = TimeDelta::Seconds(1);
+// Initial number of slots of the statistician lookup table. Power of two.
+constexpr size_t kInitialTableCapacity = 16;
 
 TimeDelta UnixEpochDelta(Clock& clock) {
   Timestamp now = clock.CurrentTime();
@@ -333,11 +336,7 @@ bool StreamStatisticianImpl::IsRetransmitOfOldPacket(
 }
 
 std::unique_ptr<ReceiveStatistics> ReceiveStatistics::Create(Clock* clock) {
-  return std::make_unique<ReceiveStatisticsLocked>(
-      clock, [](uint32_t ssrc, Clock* clock, int max_reordering_threshold) {
-        return std::make_unique<StreamStatisticianLocked>(
-            ssrc, clock, max_reordering_threshold);
-      });
+  return std::make_unique<ReceiveStatisticsSharded>(clock);
 }
 
 std::unique_ptr<ReceiveStatistics> ReceiveStatistics::CreateThreadCompatible(
@@ -411,17 +410,162 @@ std::vector<rtcp::ReportBlock> ReceiveStatisticsImpl::RtcpReportBlocks(
     size_t max_blocks) {
   std::vector<rtcp::ReportBlock> result;
   result.reserve(std::min(max_blocks, all_ssrcs_.size()));
+  AppendRtcpReportBlocks(max_blocks, result);
+  return result;
+}
 
+void ReceiveStatisticsImpl::AppendRtcpReportBlocks(
+    size_t max_blocks,
+    std::vector<rtcp::ReportBlock>& report_blocks) {
+  const size_t max_size = report_blocks.size() + max_blocks;
   size_t ssrc_idx = 0;
-  for (size_t i = 0; i < all_ssrcs_.size() && result.size() < max_blocks; ++i) {
+  for (size_t i = 0; i < all_ssrcs_.size() && report_blocks.size() < max_size;
+       ++i) {
     ssrc_idx = (last_returned_ssrc_idx_ + i + 1) % all_ssrcs_.size();
     const uint32_t media_ssrc = all_ssrcs_[ssrc_idx];
     auto statistician_it = statisticians_.find(media_ssrc);
     RTC_DCHECK(statistician_it != statisticians_.end());
-    statistician_it->second->MaybeAppendReportBlockAndReset(result);
+    statistician_it->second->MaybeAppendReportBlockAndReset(report_blocks);
   }
   last_returned_ssrc_idx_ = ssrc_idx;
+}
+
+ReceiveStatisticsSharded::Table::Table(size_t capacity)
+    : mask(capacity - 1), slots(std::make_unique<Slot[]>(capacity)) {
+  RTC_DCHECK_EQ(capacity & mask, 0);
+}
+
+ReceiveStatisticsSharded::ReceiveStatisticsSharded(Clock* clock)
+    : clock_(clock),
+      table_(nullptr),
+      max_reordering_threshold_(kDefaultMaxReorderingThreshold) {
+  tables_.push_back(std::make_unique<Table>(kInitialTableCapacity));
+  table_.store(tables_.back().get(), std::memory_order_release);
+}
+
+ReceiveStatisticsSharded::~ReceiveStatisticsSharded() = default;
+
+size_t ReceiveStatisticsSharded::SlotIndex(uint32_t ssrc, size_t mask) {
+  // SSRCs are usually random, but tests and some endpoints pick consecutive
+  // ones. Mix the bits so that those do not form long probe sequences.
+  uint32_t hash = ssrc * 0x9E3779B1u;
+  return (hash ^ (hash >> 16)) & mask;
+}
+
+StreamStatisticianLocked* ReceiveStatisticsSharded::Find(uint32_t ssrc) const {
+  const Table* table = table_.load(std::memory_order_acquire);
+  for (size_t i = SlotIndex(ssrc, table->mask);; i = (i + 1) & table->mask) {
+    const Slot& slot = table->slots[i];
+    StreamStatisticianLocked* statistician =
+        slot.statistician.load(std::memory_order_acquire);
+    if (statistician == nullptr) {
+      return nullptr;
+    }
+    if (slot.ssrc.load(std::memory_order_relaxed) == ssrc) {
+      return statistician;
+    }
+  }
+}
+
+void ReceiveStatisticsSharded::Insert(uint32_t ssrc,
+                                      StreamStatisticianLocked* statistician) {
+  Table* table = tables_.back().get();
+  for (size_t i = SlotIndex(ssrc, table->mask);; i = (i + 1) & table->mask) {
+    Slot& slot = table->slots[i];
+    if (slot.statistician.load(std::memory_order_relaxed) == nullptr) {
+      slot.ssrc.store(ssrc, std::memory_order_relaxed);
+      slot.statistician.store(statistician, std::memory_order_release);
+      return;
+    }
+  }
+}
+
+StreamStatisticianLocked* ReceiveStatisticsSharded::GetOrCreateStatistician(
+    uint32_t ssrc) {
+  StreamStatisticianLocked* statistician = Find(ssrc);
+  if (statistician != nullptr) {
+    return statistician;
+  }
+  MutexLock lock(&mutex_);
+  // May have been created by another thread since the lookup above.
+  statistician = Find(ssrc);
+  if (statistician != nullptr) {
+    return statistician;
+  }
+  statisticians_.push_back(std::make_unique<StreamStatisticianLocked>(
+      ssrc, clock_, max_reordering_threshold_));
+  statistician = statisticians_.back().get();
+
+  // Keep the table at most half full, so that probe sequences stay short and
+  // lookups of unknown SSRCs always reach a free slot.
+  const Table& current = *tables_.back();
+  if (2 * statisticians_.size() > current.mask + 1) {
+    tables_.push_back(std::make_unique<Table>(2 * (current.mask + 1)));
+    for (size_t i = 0; i <= current.mask; ++i) {
+      StreamStatisticianLocked* existing =
+          current.slots[i].statistician.load(std::memory_order_relaxed);
+      if (existing != nullptr) {
+        Insert(current.slots[i].ssrc.load(std::memory_order_relaxed),
+               existing);
+      }
+    }
+  }
+  Insert(ssrc, statistician);
+  table_.store(tables_.back().get(), std::memory_order_release);
+  return statistician;
+}
+
+void ReceiveStatisticsSharded::OnRtpPacket(const RtpPacketReceived& packet) {
+  GetOrCreateStatistician(packet.Ssrc())->UpdateCounters(packet);
+}
+
+StreamStatistician* ReceiveStatisticsSharded::GetStatistician(
+    uint32_t ssrc) const {
+  return Find(ssrc);
+}
+
+void ReceiveStatisticsSharded::SetMaxReorderingThreshold(
+    int max_reordering_threshold) {
+  MutexLock lock(&mutex_);
+  max_reordering_threshold_ = max_reordering_threshold;
+  for (const auto& statistician : statisticians_) {
+    statistician->SetMaxReorderingThreshold(max_reordering_threshold);
+  }
+}
+
+void ReceiveStatisticsSharded::SetMaxReorderingThreshold(
+    uint32_t ssrc,
+    int max_reordering_threshold) {
+  GetOrCreateStatistician(ssrc)->SetMaxReorderingThreshold(
+      max_reordering_threshold);
+}
+
+void ReceiveStatisticsSharded::EnableRetransmitDetection(uint32_t ssrc,
+                                                         bool enable) {
+  GetOrCreateStatistician(ssrc)->EnableRetransmitDetection(enable);
+}
+
+std::vector<rtcp::ReportBlock> ReceiveStatisticsSharded::RtcpReportBlocks(
+    size_t max_blocks) {
+  std::vector<rtcp::ReportBlock> result;
+  AppendRtcpReportBlocks(max_blocks, result);
   return result;
 }
 
+void ReceiveStatisticsSharded::AppendRtcpReportBlocks(
+    size_t max_blocks,
+    std::vector<rtcp::ReportBlock>& report_blocks) {
+  MutexLock lock(&mutex_);
+  const size_t max_size = report_blocks.size() + max_blocks;
+  size_t index = 0;
+  for (size_t i = 0;
+       i < statisticians_.size() && report_blocks.size() < max_size; ++i) {
+    index = (last_returned_index_ + i + 1) % statisticians_.size();
+    // Takes the lock of the stream, so each block is a consistent snapshot
+    // of its stream.
+    statisticians_[index]->MaybeAppendReportBlockAndReset(report_blocks);
+  }
+  last_returned_index_ = index;
+}
+
 }  // namespace webrtc
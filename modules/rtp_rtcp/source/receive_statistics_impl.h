@@ -12,6 +12,7 @@
 #define MODULES_RTP_RTCP_SOURCE_RECEIVE_STATISTICS_IMPL_H_
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -177,6 +178,9 @@ class ReceiveStatisticsImpl : public ReceiveStatistics {
 
   // Implements ReceiveStatisticsProvider.
   std::vector<rtcp::ReportBlock> RtcpReportBlocks(size_t max_blocks) override;
+  void AppendRtcpReportBlocks(
+      size_t max_blocks,
+      std::vector<rtcp::ReportBlock>& report_blocks) override;
 
   // Implements RtpPacketSinkInterface
   void OnRtpPacket(const RtpPacketReceived& packet) override;
@@ -205,47 +209,69 @@ class ReceiveStatisticsImpl : public ReceiveStatistics {
       statisticians_;
 };
 
-// Thread-safe implementation wrapping access to ReceiveStatisticsImpl with a
-// mutex.
-class ReceiveStatisticsLocked : public ReceiveStatistics {
+// Thread-safe implementation in which the packet path only takes the lock of
+// the stream the packet belongs to, so that packets of streams arriving on
+// different network threads neither contend with each other nor with report
+// generation on the worker thread for longer than one stream update.
+//
+// Statisticians are looked up without locking in an open addressing table.
+// When it fills up, the table is replaced by a larger copy and the old one
+// is kept until destruction, since concurrent lookups may still read it. As
+// the table grows geometrically, the retired tables take no more memory than
+// the current one. `mutex_` serializes creation of statisticians, changes of
+// the reordering threshold and report generation.
+class ReceiveStatisticsSharded : public ReceiveStatistics {
  public:
-  explicit ReceiveStatisticsLocked(
-      Clock* clock,
-      std::function<std::unique_ptr<StreamStatisticianImplInterface>(
-          uint32_t ssrc,
-          Clock* clock,
-          int max_reordering_threshold)> stream_statitician_factory)
-      : impl_(clock, std::move(stream_statitician_factory)) {}
-  ~ReceiveStatisticsLocked() override = default;
-  std::vector<rtcp::ReportBlock> RtcpReportBlocks(size_t max_blocks) override {
-    MutexLock lock(&receive_statistics_lock_);
-    return impl_.RtcpReportBlocks(max_blocks);
-  }
-  void OnRtpPacket(const RtpPacketReceived& packet) override {
-    MutexLock lock(&receive_statistics_lock_);
-    return impl_.OnRtpPacket(packet);
-  }
-  StreamStatistician* GetStatistician(uint32_t ssrc) const override {
-    MutexLock lock(&receive_statistics_lock_);
-    return impl_.GetStatistician(ssrc);
-  }
-  void SetMaxReorderingThreshold(int max_reordering_threshold) override {
-    MutexLock lock(&receive_statistics_lock_);
-    return impl_.SetMaxReorderingThreshold(max_reordering_threshold);
-  }
+  explicit ReceiveStatisticsSharded(Clock* clock);
+  ~ReceiveStatisticsSharded() override;
+
+  // Implements ReceiveStatisticsProvider.
+  std::vector<rtcp::ReportBlock> RtcpReportBlocks(size_t max_blocks) override;
+  void AppendRtcpReportBlocks(
+      size_t max_blocks,
+      std::vector<rtcp::ReportBlock>& report_blocks) override;
+
+  // Implements RtpPacketSinkInterface
+  void OnRtpPacket(const RtpPacketReceived& packet) override;
+
+  // Implements ReceiveStatistics.
+  StreamStatistician* GetStatistician(uint32_t ssrc) const override;
+  void SetMaxReorderingThreshold(int max_reordering_threshold) override;
   void SetMaxReorderingThreshold(uint32_t ssrc,
-                                 int max_reordering_threshold) override {
-    MutexLock lock(&receive_statistics_lock_);
-    return impl_.SetMaxReorderingThreshold(ssrc, max_reordering_threshold);
-  }
-  void EnableRetransmitDetection(uint32_t ssrc, bool enable) override {
-    MutexLock lock(&receive_statistics_lock_);
-    return impl_.EnableRetransmitDetection(ssrc, enable);
-  }
+                                 int max_reordering_threshold) override;
+  void EnableRetransmitDetection(uint32_t ssrc, bool enable) override;
 
  private:
-  mutable Mutex receive_statistics_lock_;
-  ReceiveStatisticsImpl impl_ RTC_GUARDED_BY(&receive_statistics_lock_);
+  struct Slot {
+    std::atomic<uint32_t> ssrc{0};
+    // Null while the slot is free. Published after `ssrc`.
+    std::atomic<StreamStatisticianLocked*> statistician{nullptr};
+  };
+  struct Table {
+    explicit Table(size_t capacity);
+    const size_t mask;
+    const std::unique_ptr<Slot[]> slots;
+  };
+
+  static size_t SlotIndex(uint32_t ssrc, size_t mask);
+  StreamStatisticianLocked* Find(uint32_t ssrc) const;
+  StreamStatisticianLocked* GetOrCreateStatistician(uint32_t ssrc);
+  void Insert(uint32_t ssrc, StreamStatisticianLocked* statistician)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  Clock* const clock_;
+  // Current lookup table, owned by `tables_`.
+  std::atomic<const Table*> table_;
+
+  Mutex mutex_;
+  // Current table last, preceded by the tables it replaced.
+  std::vector<std::unique_ptr<Table>> tables_ RTC_GUARDED_BY(mutex_);
+  // In order of creation, which is the order report blocks are rotated in.
+  std::vector<std::unique_ptr<StreamStatisticianLocked>> statisticians_
+      RTC_GUARDED_BY(mutex_);
+  // The index within `statisticians_` that was last returned.
+  size_t last_returned_index_ RTC_GUARDED_BY(mutex_) = 0;
+  int max_reordering_threshold_ RTC_GUARDED_BY(mutex_);
 };
 
 }  // namespace webrtc
@@ -12,10 +12,12 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "api/units/time_delta.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/random.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gmock.h"
@@ -241,6 +243,32 @@ TEST_P(ReceiveStatisticsTest, ActiveStatisticians) {
   EXPECT_EQ(2u, counters.transmitted.packets);
 }
 
+TEST_P(ReceiveStatisticsTest, ManyIncomingSsrcs) {
+  constexpr int kNumSsrcs = 1000;
+  Random random(0x1234);
+  std::vector<uint32_t> ssrcs;
+  for (int i = 0; i < kNumSsrcs / 2; ++i) {
+    ssrcs.push_back(1000 + i);
+    ssrcs.push_back(random.Rand<uint32_t>() | 1);
+  }
+  for (uint32_t ssrc : ssrcs) {
+    receive_statistics_->OnRtpPacket(CreateRtpPacket(ssrc, kPacketSize1));
+  }
+
+  for (uint32_t ssrc : ssrcs) {
+    StreamStatistician* statistician =
+        receive_statistics_->GetStatistician(ssrc);
+    ASSERT_NE(statistician, nullptr);
+    EXPECT_EQ(
+        statistician->GetReceiveStreamDataCounters().transmitted.packets, 1u);
+  }
+  // Outside of the consecutive range, and even, unlike the random ones.
+  EXPECT_EQ(receive_statistics_->GetStatistician(0), nullptr);
+  EXPECT_EQ(receive_statistics_->GetStatistician(2 * kNumSsrcs), nullptr);
+  EXPECT_THAT(receive_statistics_->RtcpReportBlocks(kNumSsrcs),
+              SizeIs(kNumSsrcs));
+}
+
 TEST_P(ReceiveStatisticsTest,
        DoesntCreateRtcpReportBlockUntilFirstReceivedPacketForSsrc) {
   // Creates a statistician object for the ssrc.
@@ -915,5 +943,43 @@ TEST(ReviseJitterTest, TwoPacketsWithMaximumRtpTimestampDifference) {
   EXPECT_EQ(GetJitter(*statistics), 0U);
 }
 
+TEST(ReceiveStatisticsConcurrencyTest,
+     CountsPacketsReceivedOnSeveralThreadsWhileReporting) {
+  constexpr int kNumThreads = 4;
+  constexpr int kSsrcsPerThread = 4;
+  constexpr int kPacketsPerSsrc = 1000;
+  SimulatedClock clock(0);
+  std::unique_ptr<ReceiveStatistics> statistics =
+      ReceiveStatistics::Create(&clock);
+
+  std::vector<rtc::PlatformThread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.push_back(rtc::PlatformThread::SpawnJoinable(
+        [&statistics, t] {
+          for (int i = 0; i < kPacketsPerSsrc; ++i) {
+            for (int s = 0; s < kSsrcsPerThread; ++s) {
+              RtpPacketReceived packet =
+                  CreateRtpPacket(t * kSsrcsPerThread + s, kPacketSize1);
+              packet.SetSequenceNumber(i);
+              statistics->OnRtpPacket(packet);
+            }
+          }
+        },
+        "receiver" + std::to_string(t)));
+  }
+  for (int i = 0; i < 100; ++i) {
+    statistics->RtcpReportBlocks(kNumThreads * kSsrcsPerThread);
+  }
+  threads.clear();
+
+  for (uint32_t ssrc = 0; ssrc < kNumThreads * kSsrcsPerThread; ++ssrc) {
+    StreamStatistician* statistician = statistics->GetStatistician(ssrc);
+    ASSERT_NE(statistician, nullptr);
+    RtpReceiveStats stats = statistician->GetStats();
+    EXPECT_EQ(stats.packet_counter.packets, uint32_t{kPacketsPerSsrc});
+    EXPECT_EQ(stats.packets_lost, 0);
+  }
+}
+
 }  // namespace
 }  // namespace webrtc
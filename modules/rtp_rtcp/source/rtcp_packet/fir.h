@@ -39,6 +39,8 @@ class Fir : public Psfb {
   void AddRequestTo(uint32_t ssrc, uint8_t seq_num) {
     items_.emplace_back(ssrc, seq_num);
   }
+  // Removes all requests, keeping their storage.
+  void ClearRequests() { items_.clear(); }
   const std::vector<Request>& requests() const { return items_; }
 
   size_t BlockLength() const override;
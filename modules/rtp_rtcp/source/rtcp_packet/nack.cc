@@ -126,13 +126,14 @@ bool Nack::Create(uint8_t* packet,
 
 void Nack::SetPacketIds(const uint16_t* nack_list, size_t length) {
   RTC_DCHECK(nack_list);
-  SetPacketIds(std::vector<uint16_t>(nack_list, nack_list + length));
+  packet_ids_.assign(nack_list, nack_list + length);
+  packed_.clear();
+  Pack();
 }
 
 void Nack::SetPacketIds(std::vector<uint16_t> nack_list) {
-  RTC_DCHECK(packet_ids_.empty());
-  RTC_DCHECK(packed_.empty());
   packet_ids_ = std::move(nack_list);
+  packed_.clear();
   Pack();
 }
 
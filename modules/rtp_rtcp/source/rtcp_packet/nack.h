@@ -29,6 +29,8 @@ class Nack : public Rtpfb {
   // Parse assumes header is already parsed and validated.
   bool Parse(const CommonHeader& packet);
 
+  // Replaces the packet ids set before. The pointer overload reuses the
+  // storage of the previous ids.
   void SetPacketIds(const uint16_t* nack_list, size_t length);
   void SetPacketIds(std::vector<uint16_t> nack_list);
   const std::vector<uint16_t>& packet_ids() const { return packet_ids_; }
@@ -69,6 +69,19 @@ TEST(RtcpPacketNackTest, Create) {
               ElementsAreArray(kPacket));
 }
 
+TEST(RtcpPacketNackTest, SetPacketIdsReplacesPreviousIds) {
+  Nack nack;
+  nack.SetSenderSsrc(kSenderSsrc);
+  nack.SetMediaSsrc(kRemoteSsrc);
+  nack.SetPacketIds(kWrapList, kWrapListLength);
+  nack.SetPacketIds(kList, kListLength);
+
+  EXPECT_THAT(nack.packet_ids(), ElementsAreArray(kList));
+  rtc::Buffer packet = nack.Build();
+  EXPECT_THAT(make_tuple(packet.data(), packet.size()),
+              ElementsAreArray(kPacket));
+}
+
 TEST(RtcpPacketNackTest, Parse) {
   Nack parsed;
   EXPECT_TRUE(test::ParseSinglePacket(kPacket, &parsed));
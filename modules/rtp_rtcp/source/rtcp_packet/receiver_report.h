@@ -37,6 +37,7 @@ class ReceiverReport : public RtcpPacket {
 
   bool AddReportBlock(const ReportBlock& block);
   bool SetReportBlocks(std::vector<ReportBlock> blocks);
+  void ClearReportBlocks() { report_blocks_.clear(); }
 
   const std::vector<ReportBlock>& report_blocks() const {
     return report_blocks_;
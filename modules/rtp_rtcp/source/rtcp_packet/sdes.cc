@@ -70,9 +70,9 @@ bool Sdes::Parse(const CommonHeader& packet) {
   RTC_DCHECK_EQ(packet.type(), kPacketType);
 
   uint8_t number_of_chunks = packet.count();
-  std::vector<Chunk> chunks;  // Read chunk into temporary array, so that in
-                              // case of an error original array would stay
-                              // unchanged.
+  // Read chunks into a separate array, so that in case of an error the
+  // original array would stay unchanged.
+  std::vector<Chunk>& chunks = parsed_chunks_;
   size_t block_length = kHeaderLength;
 
   if (packet.payload_size_bytes() % 4 != 0) {
@@ -141,7 +141,7 @@ bool Sdes::Parse(const CommonHeader& packet) {
     looking_at += (payload_end - looking_at) % 4;
   }
 
-  chunks_ = std::move(chunks);
+  chunks_.swap(chunks);
   block_length_ = block_length;
   return true;
 }
@@ -49,6 +49,9 @@ class Sdes : public RtcpPacket {
 
  private:
   std::vector<Chunk> chunks_;
+  // Chunks being parsed. Kept, like `chunks_`, so that parsing reuses their
+  // storage.
+  std::vector<Chunk> parsed_chunks_;
   size_t block_length_;
 };
 }  // namespace rtcp
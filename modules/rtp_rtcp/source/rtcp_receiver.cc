@@ -220,9 +220,18 @@ void RTCPReceiver::IncomingPacket(rtc::ArrayView<const uint8_t> packet) {
   }
 
   PacketInformation packet_information;
-  if (!ParseCompoundPacket(packet, &packet_information))
-    return;
-  TriggerCallbacksFromRtcpPacket(packet_information);
+  if (ParseCompoundPacket(packet, &packet_information)) {
+    TriggerCallbacksFromRtcpPacket(packet_information);
+  }
+
+  // Keep the storage for the next packet.
+  packet_information.nack_sequence_numbers.clear();
+  packet_information.report_block_datas.clear();
+  MutexLock lock(&rtcp_receiver_lock_);
+  nack_sequence_numbers_storage_ =
+      std::move(packet_information.nack_sequence_numbers);
+  report_block_datas_storage_ =
+      std::move(packet_information.report_block_datas);
 }
 
 // This method is only used by test and legacy code, so we should be able to
@@ -380,18 +389,13 @@ std::vector<ReportBlockData> RTCPReceiver::GetLatestReportBlockData() const {
 bool RTCPReceiver::ParseCompoundPacket(rtc::ArrayView<const uint8_t> packet,
                                        PacketInformation* packet_information) {
   MutexLock lock(&rtcp_receiver_lock_);
+  // Both are empty; see IncomingPacket().
+  packet_information->nack_sequence_numbers.swap(
+      nack_sequence_numbers_storage_);
+  packet_information->report_block_datas.swap(report_block_datas_storage_);
 
   CommonHeader rtcp_block;
-  // If a sender report is received but no DLRR, we need to reset the
-  // roundTripTime stat according to the standard, see
-  // https://www.w3.org/TR/webrtc-stats/#dom-rtcremoteoutboundrtpstreamstats-roundtriptime
-  struct RtcpReceivedBlock {
-    bool sender_report = false;
-    bool dlrr = false;
-  };
-  // For each remote SSRC we store if we've received a sender report or a DLRR
-  // block.
-  flat_map<uint32_t, RtcpReceivedBlock> received_blocks;
+  received_blocks_.clear();
   bool valid = true;
   for (const uint8_t* next_block = packet.begin();
        valid && next_block != packet.end();
@@ -406,7 +410,7 @@ bool RTCPReceiver::ParseCompoundPacket(rtc::ArrayView<const uint8_t> packet,
     switch (rtcp_block.type()) {
       case rtcp::SenderReport::kPacketType:
         valid = HandleSenderReport(rtcp_block, packet_information);
-        received_blocks[packet_information->remote_ssrc].sender_report = true;
+        received_blocks_[packet_information->remote_ssrc].sender_report = true;
         break;
       case rtcp::ReceiverReport::kPacketType:
         valid = HandleReceiverReport(rtcp_block, packet_information);
@@ -419,7 +423,7 @@ bool RTCPReceiver::ParseCompoundPacket(rtc::ArrayView<const uint8_t> packet,
         uint32_t ssrc = 0;
         valid = HandleXr(rtcp_block, packet_information, contains_dlrr, ssrc);
         if (contains_dlrr) {
-          received_blocks[ssrc].dlrr = true;
+          received_blocks_[ssrc].dlrr = true;
         }
         break;
       }
@@ -497,7 +501,7 @@ bool RTCPReceiver::ParseCompoundPacket(rtc::ArrayView<const uint8_t> packet,
     return false;
   }
 
-  for (const auto& rb : received_blocks) {
+  for (const auto& rb : received_blocks_) {
     if (rb.second.sender_report && !rb.second.dlrr) {
       auto rtt_stats = non_sender_rtts_.find(rb.first);
       if (rtt_stats != non_sender_rtts_.end()) {
@@ -516,12 +520,11 @@ bool RTCPReceiver::ParseCompoundPacket(rtc::ArrayView<const uint8_t> packet,
 
 bool RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
                                       PacketInformation* packet_information) {
-  rtcp::SenderReport sender_report;
-  if (!sender_report.Parse(rtcp_block)) {
+  if (!sender_report_.Parse(rtcp_block)) {
     return false;
   }
 
-  const uint32_t remote_ssrc = sender_report.sender_ssrc();
+  const uint32_t remote_ssrc = sender_report_.sender_ssrc();
 
   packet_information->remote_ssrc = remote_ssrc;
 
@@ -532,11 +535,11 @@ bool RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
     // Only signal that we have received a SR when we accept one.
     packet_information->packet_type_flags |= kRtcpSr;
 
-    remote_sender_.last_remote_timestamp = sender_report.ntp();
-    remote_sender_.last_remote_rtp_timestamp = sender_report.rtp_timestamp();
+    remote_sender_.last_remote_timestamp = sender_report_.ntp();
+    remote_sender_.last_remote_rtp_timestamp = sender_report_.rtp_timestamp();
     remote_sender_.last_arrival_timestamp = clock_->CurrentNtpTime();
-    remote_sender_.packets_sent = sender_report.sender_packet_count();
-    remote_sender_.bytes_sent = sender_report.sender_octet_count();
+    remote_sender_.packets_sent = sender_report_.sender_packet_count();
+    remote_sender_.bytes_sent = sender_report_.sender_octet_count();
     remote_sender_.reports_count++;
   } else {
     // We will only store the send report from one source, but
@@ -544,7 +547,7 @@ bool RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
     packet_information->packet_type_flags |= kRtcpRr;
   }
 
-  for (const rtcp::ReportBlock& report_block : sender_report.report_blocks()) {
+  for (const rtcp::ReportBlock& report_block : sender_report_.report_blocks()) {
     HandleReportBlock(report_block, packet_information, remote_ssrc);
   }
 
@@ -553,12 +556,11 @@ bool RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
 
 bool RTCPReceiver::HandleReceiverReport(const CommonHeader& rtcp_block,
                                         PacketInformation* packet_information) {
-  rtcp::ReceiverReport receiver_report;
-  if (!receiver_report.Parse(rtcp_block)) {
+  if (!receiver_report_.Parse(rtcp_block)) {
     return false;
   }
 
-  const uint32_t remote_ssrc = receiver_report.sender_ssrc();
+  const uint32_t remote_ssrc = receiver_report_.sender_ssrc();
 
   packet_information->remote_ssrc = remote_ssrc;
 
@@ -566,7 +568,7 @@ bool RTCPReceiver::HandleReceiverReport(const CommonHeader& rtcp_block,
 
   packet_information->packet_type_flags |= kRtcpRr;
 
-  for (const ReportBlock& report_block : receiver_report.report_blocks()) {
+  for (const ReportBlock& report_block : receiver_report_.report_blocks()) {
     HandleReportBlock(report_block, packet_information, remote_ssrc);
   }
 
@@ -717,12 +719,11 @@ std::vector<rtcp::TmmbItem> RTCPReceiver::BoundingSet(bool* tmmbr_owner) {
 
 bool RTCPReceiver::HandleSdes(const CommonHeader& rtcp_block,
                               PacketInformation* packet_information) {
-  rtcp::Sdes sdes;
-  if (!sdes.Parse(rtcp_block)) {
+  if (!sdes_.Parse(rtcp_block)) {
     return false;
   }
 
-  for (const rtcp::Sdes::Chunk& chunk : sdes.chunks()) {
+  for (const rtcp::Sdes::Chunk& chunk : sdes_.chunks()) {
     if (cname_callback_)
       cname_callback_->OnCname(chunk.ssrc, chunk.cname);
   }
@@ -733,21 +734,20 @@ bool RTCPReceiver::HandleSdes(const CommonHeader& rtcp_block,
 
 bool RTCPReceiver::HandleNack(const CommonHeader& rtcp_block,
                               PacketInformation* packet_information) {
-  rtcp::Nack nack;
-  if (!nack.Parse(rtcp_block)) {
+  if (!nack_.Parse(rtcp_block)) {
     return false;
   }
 
-  if (receiver_only_ || local_media_ssrc() != nack.media_ssrc())  // Not to us.
+  if (receiver_only_ || local_media_ssrc() != nack_.media_ssrc())  // Not to us.
     return true;
 
   packet_information->nack_sequence_numbers.insert(
       packet_information->nack_sequence_numbers.end(),
-      nack.packet_ids().begin(), nack.packet_ids().end());
-  for (uint16_t packet_id : nack.packet_ids())
+      nack_.packet_ids().begin(), nack_.packet_ids().end());
+  for (uint16_t packet_id : nack_.packet_ids())
     nack_stats_.ReportRequest(packet_id);
 
-  if (!nack.packet_ids().empty()) {
+  if (!nack_.packet_ids().empty()) {
     packet_information->packet_type_flags |= kRtcpNack;
     ++packet_type_counter_.nack_packets;
     packet_type_counter_.nack_requests = nack_stats_.requests();
@@ -979,11 +979,10 @@ bool RTCPReceiver::HandleSrReq(const CommonHeader& rtcp_block,
 void RTCPReceiver::HandlePsfbApp(const CommonHeader& rtcp_block,
                                  PacketInformation* packet_information) {
   {
-    rtcp::Remb remb;
-    if (remb.Parse(rtcp_block)) {
+    if (remb_.Parse(rtcp_block)) {
       packet_information->packet_type_flags |= kRtcpRemb;
       packet_information->receiver_estimated_max_bitrate_bps =
-          remb.bitrate_bps();
+          remb_.bitrate_bps();
       return;
     }
   }
@@ -1005,16 +1004,15 @@ void RTCPReceiver::HandlePsfbApp(const CommonHeader& rtcp_block,
 
 bool RTCPReceiver::HandleFir(const CommonHeader& rtcp_block,
                              PacketInformation* packet_information) {
-  rtcp::Fir fir;
-  if (!fir.Parse(rtcp_block)) {
+  if (!fir_.Parse(rtcp_block)) {
     return false;
   }
 
-  if (fir.requests().empty())
+  if (fir_.requests().empty())
     return true;
 
   const Timestamp now = clock_->CurrentTime();
-  for (const rtcp::Fir::Request& fir_request : fir.requests()) {
+  for (const rtcp::Fir::Request& fir_request : fir_.requests()) {
     // Is it our sender that is requested to generate a new keyframe.
     if (local_media_ssrc() != fir_request.ssrc)
       continue;
@@ -1022,7 +1020,7 @@ bool RTCPReceiver::HandleFir(const CommonHeader& rtcp_block,
     ++packet_type_counter_.fir_packets;
 
     auto [it, inserted] =
-        last_fir_.try_emplace(fir.sender_ssrc(), now, fir_request.seq_nr);
+        last_fir_.try_emplace(fir_.sender_ssrc(), now, fir_request.seq_nr);
     if (!inserted) {  // There was already an entry.
       LastFirStatus* last_fir = &it->second;
 
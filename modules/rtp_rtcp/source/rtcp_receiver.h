@@ -26,6 +26,12 @@
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtcp_nack_stats.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/dlrr.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/fir.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/remb.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sdes.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sender_report.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/tmmb_item.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
 #include "rtc_base/containers/flat_map.h"
@@ -238,6 +244,14 @@ class RTCPReceiver final {
     uint8_t sequence_number;
   };
 
+  // If a sender report is received but no DLRR, we need to reset the
+  // roundTripTime stat according to the standard, see
+  // https://www.w3.org/TR/webrtc-stats/#dom-rtcremoteoutboundrtpstreamstats-roundtriptime
+  struct RtcpReceivedBlock {
+    bool sender_report = false;
+    bool dlrr = false;
+  };
+
   class RttStats {
    public:
     RttStats() = default;
@@ -417,6 +431,26 @@ class RTCPReceiver final {
 
   RtcpNackStats nack_stats_;
 
+  // Packets parsed by the handlers, reused so that parsing regular reports
+  // and PLI/FIR feedback does not allocate once their storage has grown.
+  rtcp::SenderReport sender_report_ RTC_GUARDED_BY(rtcp_receiver_lock_);
+  rtcp::ReceiverReport receiver_report_ RTC_GUARDED_BY(rtcp_receiver_lock_);
+  rtcp::Sdes sdes_ RTC_GUARDED_BY(rtcp_receiver_lock_);
+  rtcp::Nack nack_ RTC_GUARDED_BY(rtcp_receiver_lock_);
+  rtcp::Remb remb_ RTC_GUARDED_BY(rtcp_receiver_lock_);
+  rtcp::Fir fir_ RTC_GUARDED_BY(rtcp_receiver_lock_);
+  // Storage of the vectors of PacketInformation, handed from one incoming
+  // packet to the next. A packet parsed concurrently with another one gets
+  // new storage.
+  std::vector<uint16_t> nack_sequence_numbers_storage_
+      RTC_GUARDED_BY(rtcp_receiver_lock_);
+  std::vector<ReportBlockData> report_block_datas_storage_
+      RTC_GUARDED_BY(rtcp_receiver_lock_);
+  // For each remote SSRC, whether the compound packet being parsed has a
+  // sender report or a DLRR block from it.
+  flat_map<uint32_t, RtcpReceivedBlock> received_blocks_
+      RTC_GUARDED_BY(rtcp_receiver_lock_);
+
   size_t num_skipped_packets_;
   Timestamp last_skipped_packets_warning_;
 };
@@ -369,6 +369,32 @@ TEST(RtcpReceiverTest, InjectRrPacketWithOneReportBlock) {
   EXPECT_THAT(receiver.GetLatestReportBlockData(), SizeIs(1));
 }
 
+TEST(RtcpReceiverTest, InjectRrPacketWithFewerReportBlocksThanPreviousOne) {
+  ReceiverMocks mocks;
+  RTCPReceiver receiver(DefaultConfiguration(&mocks), &mocks.rtp_rtcp_impl);
+  receiver.SetRemoteSSRC(kSenderSsrc);
+
+  rtcp::ReportBlock rb1;
+  rb1.SetMediaSsrc(kReceiverMainSsrc);
+  rtcp::ReportBlock rb2;
+  rb2.SetMediaSsrc(kReceiverExtraSsrc);
+  rtcp::ReceiverReport rr1;
+  rr1.SetSenderSsrc(kSenderSsrc);
+  rr1.AddReportBlock(rb1);
+  rr1.AddReportBlock(rb2);
+  rtcp::ReceiverReport rr2;
+  rr2.SetSenderSsrc(kSenderSsrc);
+  rr2.AddReportBlock(rb2);
+
+  EXPECT_CALL(mocks.rtp_rtcp_impl, OnReceivedRtcpReportBlocks(SizeIs(2)));
+  receiver.IncomingPacket(rr1.Build());
+
+  EXPECT_CALL(mocks.rtp_rtcp_impl,
+              OnReceivedRtcpReportBlocks(ElementsAre(Property(
+                  &ReportBlockData::source_ssrc, kReceiverExtraSsrc))));
+  receiver.IncomingPacket(rr2.Build());
+}
+
 TEST(RtcpReceiverTest, InjectSrPacketWithOneReportBlock) {
   ReceiverMocks mocks;
   RTCPReceiver receiver(DefaultConfiguration(&mocks), &mocks.rtp_rtcp_impl);
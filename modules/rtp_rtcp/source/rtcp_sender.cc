@@ -54,8 +54,16 @@ namespace {
 const uint32_t kRtcpAnyExtendedReports = kRtcpXrReceiverReferenceTime |
                                          kRtcpXrDlrrReportBlock |
                                          kRtcpXrTargetBitrate;
+// All extended reports are built into one packet and share one report flag.
+// It is stored as the highest bit of kRtcpAnyExtendedReports, which keeps
+// the packet in the position it has when flags are ordered by value.
+constexpr uint32_t kExtendedReportsFlag = kRtcpXrTargetBitrate;
 constexpr int32_t kDefaultVideoReportInterval = 1000;
 constexpr int32_t kDefaultAudioReportInterval = 5000;
+
+uint32_t ReportFlag(uint32_t type) {
+  return (type & kRtcpAnyExtendedReports) ? kExtendedReportsFlag : type;
+}
 }  // namespace
 
 // Helper to put several RTCP packets into lower layer datagram RTCP packet.
@@ -159,8 +167,6 @@ RTCPSender::RTCPSender(Configuration config)
 
       sequence_number_fir_(0),
 
-      remb_bitrate_(0),
-
       tmmbr_send_bps_(0),
       packet_oh_send_(0),
       max_packet_size_(IP_PACKET_SIZE - 28),  // IPv4 + UDP by default.
@@ -171,6 +177,7 @@ RTCPSender::RTCPSender(Configuration config)
       send_video_bitrate_allocation_(false),
       last_payload_type_(-1) {
   RTC_DCHECK(transport_ != nullptr);
+  sdes_.AddCName(ssrc_, cname_);
 
   builders_[kRtcpSr] = &RTCPSender::BuildSR;
   builders_[kRtcpRr] = &RTCPSender::BuildRR;
@@ -271,8 +278,9 @@ void RTCPSender::SetRemb(int64_t bitrate_bps, std::vector<uint32_t> ssrcs) {
     RTC_LOG(LS_WARNING) << "Can't send RTCP if it is disabled.";
     return;
   }
-  remb_bitrate_ = bitrate_bps;
-  remb_ssrcs_ = std::move(ssrcs);
+  remb_ = rtcp::Remb();
+  remb_.SetBitrateBps(bitrate_bps);
+  remb_.SetSsrcs(std::move(ssrcs));
 
   SetFlag(kRtcpRemb, /*is_volatile=*/false);
   // Send a REMB immediately if we have a new REMB. The frequency of REMBs is
@@ -332,6 +340,7 @@ uint32_t RTCPSender::SSRC() const {
 void RTCPSender::SetSsrc(uint32_t ssrc) {
   MutexLock lock(&mutex_rtcp_sender_);
   ssrc_ = ssrc;
+  UpdateSdes();
 }
 
 void RTCPSender::SetRemoteSSRC(uint32_t ssrc) {
@@ -343,9 +352,15 @@ int32_t RTCPSender::SetCNAME(absl::string_view c_name) {
   RTC_DCHECK_LT(c_name.size(), RTCP_CNAME_SIZE);
   MutexLock lock(&mutex_rtcp_sender_);
   cname_ = std::string(c_name);
+  UpdateSdes();
   return 0;
 }
 
+void RTCPSender::UpdateSdes() {
+  sdes_ = rtcp::Sdes();
+  sdes_.AddCName(ssrc_, cname_);
+}
+
 bool RTCPSender::TimeToSendRTCPReport(bool send_keyframe_before_rtp) const {
   Timestamp now = clock_->CurrentTime();
 
@@ -385,31 +400,36 @@ void RTCPSender::BuildSR(const RtcpContext& ctx, PacketSender& sender) {
       ((ctx.now_.us() + 500) / 1000 - last_frame_capture_time_->ms()) *
           rtp_rate;
 
-  rtcp::SenderReport report;
-  report.SetSenderSsrc(ssrc_);
-  report.SetNtp(clock_->ConvertTimestampToNtpTime(ctx.now_));
-  report.SetRtpTimestamp(rtp_timestamp);
-  report.SetPacketCount(ctx.feedback_state_.packets_sent);
-  report.SetOctetCount(ctx.feedback_state_.media_bytes_sent);
-  report.SetReportBlocks(CreateReportBlocks(ctx.feedback_state_));
-  sender.AppendPacket(report);
+  sender_report_.SetSenderSsrc(ssrc_);
+  sender_report_.SetNtp(clock_->ConvertTimestampToNtpTime(ctx.now_));
+  sender_report_.SetRtpTimestamp(rtp_timestamp);
+  sender_report_.SetPacketCount(ctx.feedback_state_.packets_sent);
+  sender_report_.SetOctetCount(ctx.feedback_state_.media_bytes_sent);
+  sender_report_.ClearReportBlocks();
+  for (const rtcp::ReportBlock& block :
+       CreateReportBlocks(ctx.feedback_state_)) {
+    sender_report_.AddReportBlock(block);
+  }
+  sender.AppendPacket(sender_report_);
 }
 
 void RTCPSender::BuildSDES(const RtcpContext& ctx, PacketSender& sender) {
   size_t length_cname = cname_.length();
   RTC_CHECK_LT(length_cname, RTCP_CNAME_SIZE);
 
-  rtcp::Sdes sdes;
-  sdes.AddCName(ssrc_, cname_);
-  sender.AppendPacket(sdes);
+  sender.AppendPacket(sdes_);
 }
 
 void RTCPSender::BuildRR(const RtcpContext& ctx, PacketSender& sender) {
-  rtcp::ReceiverReport report;
-  report.SetSenderSsrc(ssrc_);
-  report.SetReportBlocks(CreateReportBlocks(ctx.feedback_state_));
-  if (method_ == RtcpMode::kCompound || !report.report_blocks().empty()) {
-    sender.AppendPacket(report);
+  receiver_report_.SetSenderSsrc(ssrc_);
+  receiver_report_.ClearReportBlocks();
+  for (const rtcp::ReportBlock& block :
+       CreateReportBlocks(ctx.feedback_state_)) {
+    receiver_report_.AddReportBlock(block);
+  }
+  if (method_ == RtcpMode::kCompound ||
+      !receiver_report_.report_blocks().empty()) {
+    sender.AppendPacket(receiver_report_);
   }
 }
 
@@ -425,20 +445,17 @@ void RTCPSender::BuildPLI(const RtcpContext& ctx, PacketSender& sender) {
 void RTCPSender::BuildFIR(const RtcpContext& ctx, PacketSender& sender) {
   ++sequence_number_fir_;
 
-  rtcp::Fir fir;
-  fir.SetSenderSsrc(ssrc_);
-  fir.AddRequestTo(remote_ssrc_, sequence_number_fir_);
+  fir_.SetSenderSsrc(ssrc_);
+  fir_.ClearRequests();
+  fir_.AddRequestTo(remote_ssrc_, sequence_number_fir_);
 
   ++packet_type_counter_.fir_packets;
-  sender.AppendPacket(fir);
+  sender.AppendPacket(fir_);
 }
 
 void RTCPSender::BuildREMB(const RtcpContext& ctx, PacketSender& sender) {
-  rtcp::Remb remb;
-  remb.SetSenderSsrc(ssrc_);
-  remb.SetBitrateBps(remb_bitrate_);
-  remb.SetSsrcs(remb_ssrcs_);
-  sender.AppendPacket(remb);
+  remb_.SetSenderSsrc(ssrc_);
+  sender.AppendPacket(remb_);
 }
 
 void RTCPSender::SetTargetBitrate(unsigned int target_bitrate) {
@@ -525,10 +542,9 @@ void RTCPSender::BuildLossNotification(const RtcpContext& ctx,
 }
 
 void RTCPSender::BuildNACK(const RtcpContext& ctx, PacketSender& sender) {
-  rtcp::Nack nack;
-  nack.SetSenderSsrc(ssrc_);
-  nack.SetMediaSsrc(remote_ssrc_);
-  nack.SetPacketIds(ctx.nack_list_, ctx.nack_size_);
+  nack_.SetSenderSsrc(ssrc_);
+  nack_.SetMediaSsrc(remote_ssrc_);
+  nack_.SetPacketIds(ctx.nack_list_, ctx.nack_size_);
 
   // Report stats.
   for (int idx = 0; idx < ctx.nack_size_; ++idx) {
@@ -538,7 +554,7 @@ void RTCPSender::BuildNACK(const RtcpContext& ctx, PacketSender& sender) {
   packet_type_counter_.unique_nack_requests = nack_stats_.unique_requests();
 
   ++packet_type_counter_.nack_packets;
-  sender.AppendPacket(nack);
+  sender.AppendPacket(nack_);
 }
 
 void RTCPSender::BuildBYE(const RtcpContext& ctx, PacketSender& sender) {
@@ -647,15 +663,16 @@ absl::optional<int32_t> RTCPSender::ComputeCompoundRTCPPacket(
 
   bool create_bye = false;
 
-  auto it = report_flags_.begin();
-  while (it != report_flags_.end()) {
-    uint32_t rtcp_packet_type = it->type;
-
-    if (it->is_volatile) {
-      report_flags_.erase(it++);
-    } else {
-      ++it;
-    }
+  // Build the packets in the order of their flags. Volatile flags are
+  // consumed by this call, the others stay set for the next one.
+  uint32_t flags = report_flags_;
+  report_flags_ &= ~volatile_report_flags_;
+  volatile_report_flags_ = 0;
+  while (flags != 0) {
+    const uint32_t flag = flags & (~flags + 1);
+    flags &= ~flag;
+    uint32_t rtcp_packet_type =
+        flag == kExtendedReportsFlag ? kRtcpAnyExtendedReports : flag;
 
     // If there is a BYE, don't append now - save it and append it
     // at the end later.
@@ -758,13 +775,14 @@ void RTCPSender::PrepareReport(const FeedbackState& feedback_state) {
   }
 }
 
-std::vector<rtcp::ReportBlock> RTCPSender::CreateReportBlocks(
+const std::vector<rtcp::ReportBlock>& RTCPSender::CreateReportBlocks(
     const FeedbackState& feedback_state) {
-  std::vector<rtcp::ReportBlock> result;
+  std::vector<rtcp::ReportBlock>& result = report_blocks_;
+  result.clear();
   if (!receive_statistics_)
     return result;
 
-  result = receive_statistics_->RtcpReportBlocks(RTCP_MAX_REPORT_BLOCKS);
+  receive_statistics_->AppendRtcpReportBlocks(RTCP_MAX_REPORT_BLOCKS, result);
 
   if (!result.empty() && feedback_state.last_rr.Valid()) {
     // Get our NTP as late as possible to avoid a race.
@@ -793,32 +811,32 @@ void RTCPSender::SetTmmbn(std::vector<rtcp::TmmbItem> bounding_set) {
 }
 
 void RTCPSender::SetFlag(uint32_t type, bool is_volatile) {
-  if (type & kRtcpAnyExtendedReports) {
-    report_flags_.insert(ReportFlag(kRtcpAnyExtendedReports, is_volatile));
-  } else {
-    report_flags_.insert(ReportFlag(type, is_volatile));
-  }
+  const uint32_t flag = ReportFlag(type);
+  // An existing flag is not overwritten.
+  if (report_flags_ & flag)
+    return;
+  report_flags_ |= flag;
+  if (is_volatile)
+    volatile_report_flags_ |= flag;
 }
 
 bool RTCPSender::IsFlagPresent(uint32_t type) const {
-  return report_flags_.find(ReportFlag(type, false)) != report_flags_.end();
+  return (report_flags_ & ReportFlag(type)) != 0;
 }
 
 bool RTCPSender::ConsumeFlag(uint32_t type, bool forced) {
-  auto it = report_flags_.find(ReportFlag(type, false));
-  if (it == report_flags_.end())
+  const uint32_t flag = ReportFlag(type);
+  if (!(report_flags_ & flag))
     return false;
-  if (it->is_volatile || forced)
-    report_flags_.erase((it));
+  if ((volatile_report_flags_ & flag) || forced) {
+    report_flags_ &= ~flag;
+    volatile_report_flags_ &= ~flag;
+  }
   return true;
 }
 
 bool RTCPSender::AllVolatileFlagsConsumed() const {
-  for (const ReportFlag& flag : report_flags_) {
-    if (flag.is_volatile)
-      return false;
-  }
-  return true;
+  return volatile_report_flags_ == 0;
 }
 
 void RTCPSender::SetVideoBitrateAllocation(
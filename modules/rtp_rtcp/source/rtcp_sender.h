@@ -13,7 +13,6 @@
 
 #include <map>
 #include <memory>
-#include <set>
 #include <string>
 #include <vector>
 
@@ -30,8 +29,14 @@
 #include "modules/rtp_rtcp/source/rtcp_packet.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/compound_packet.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/dlrr.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/fir.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/loss_notification.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/remb.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sdes.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sender_report.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/tmmb_item.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
 #include "rtc_base/random.h"
@@ -199,7 +204,8 @@ class RTCPSender final {
   void PrepareReport(const FeedbackState& feedback_state)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_rtcp_sender_);
 
-  std::vector<rtcp::ReportBlock> CreateReportBlocks(
+  // Fills `report_blocks_` with the blocks of the next report.
+  const std::vector<rtcp::ReportBlock>& CreateReportBlocks(
       const FeedbackState& feedback_state)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_rtcp_sender_);
 
@@ -278,9 +284,17 @@ class RTCPSender final {
 
   rtcp::LossNotification loss_notification_ RTC_GUARDED_BY(mutex_rtcp_sender_);
 
-  // REMB
-  int64_t remb_bitrate_ RTC_GUARDED_BY(mutex_rtcp_sender_);
-  std::vector<uint32_t> remb_ssrcs_ RTC_GUARDED_BY(mutex_rtcp_sender_);
+  // Packets of regular reports and of FIR requests, reused so that building
+  // them does not allocate once their storage has grown. `sdes_` and `remb_`
+  // are updated when their content changes.
+  rtcp::SenderReport sender_report_ RTC_GUARDED_BY(mutex_rtcp_sender_);
+  rtcp::ReceiverReport receiver_report_ RTC_GUARDED_BY(mutex_rtcp_sender_);
+  rtcp::Sdes sdes_ RTC_GUARDED_BY(mutex_rtcp_sender_);
+  rtcp::Remb remb_ RTC_GUARDED_BY(mutex_rtcp_sender_);
+  rtcp::Nack nack_ RTC_GUARDED_BY(mutex_rtcp_sender_);
+  rtcp::Fir fir_ RTC_GUARDED_BY(mutex_rtcp_sender_);
+  std::vector<rtcp::ReportBlock> report_blocks_
+      RTC_GUARDED_BY(mutex_rtcp_sender_);
 
   std::vector<rtcp::TmmbItem> tmmbn_to_send_ RTC_GUARDED_BY(mutex_rtcp_sender_);
   uint32_t tmmbr_send_bps_ RTC_GUARDED_BY(mutex_rtcp_sender_);
@@ -315,16 +329,12 @@ class RTCPSender final {
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_rtcp_sender_);
   bool AllVolatileFlagsConsumed() const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_rtcp_sender_);
-  struct ReportFlag {
-    ReportFlag(uint32_t type, bool is_volatile)
-        : type(type), is_volatile(is_volatile) {}
-    bool operator<(const ReportFlag& flag) const { return type < flag.type; }
-    bool operator==(const ReportFlag& flag) const { return type == flag.type; }
-    const uint32_t type;
-    const bool is_volatile;
-  };
+  void UpdateSdes() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_rtcp_sender_);
 
-  std::set<ReportFlag> report_flags_ RTC_GUARDED_BY(mutex_rtcp_sender_);
+  // RTCPPacketType bits of the packets to include in the next compound
+  // packet, and the subset of them that is consumed by building it.
+  uint32_t report_flags_ RTC_GUARDED_BY(mutex_rtcp_sender_) = 0;
+  uint32_t volatile_report_flags_ RTC_GUARDED_BY(mutex_rtcp_sender_) = 0;
 
   typedef void (RTCPSender::*BuilderFunc)(const RtcpContext&, PacketSender&);
   // Map from RTCPPacketType to builder.
@@ -0,0 +1,317 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Replaces the global allocation functions to count the allocations made by
+// RTCPSender and RTCPReceiver, and therefore is built into its own test
+// binary.
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <iterator>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/call/transport.h"
+#include "api/units/time_delta.h"
+#include "modules/rtp_rtcp/include/receive_statistics.h"
+#include "modules/rtp_rtcp/include/report_block_data.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/tmmb_item.h"
+#include "modules/rtp_rtcp/source/rtcp_receiver.h"
+#include "modules/rtp_rtcp/source/rtcp_sender.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
+#include "rtc_base/buffer.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace {
+
+// Allocations made on this thread while `count_allocations` is set.
+thread_local bool count_allocations = false;
+thread_local int num_allocations = 0;
+
+void* Allocate(size_t size) {
+  if (count_allocations) {
+    ++num_allocations;
+  }
+  void* ptr = malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    abort();
+  }
+  return ptr;
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+  return Allocate(size);
+}
+void* operator new[](size_t size) {
+  return Allocate(size);
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return Allocate(size);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return Allocate(size);
+}
+void operator delete(void* ptr) noexcept {
+  free(ptr);
+}
+void operator delete[](void* ptr) noexcept {
+  free(ptr);
+}
+void operator delete(void* ptr, size_t) noexcept {
+  free(ptr);
+}
+void operator delete[](void* ptr, size_t) noexcept {
+  free(ptr);
+}
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kSenderSsrc = 0x11111111;
+constexpr uint32_t kRemoteSsrc = 0x22222222;
+constexpr int kNumReceivedStreams = 4;
+// Longer than the small string buffer of std::string.
+constexpr char kCname[] = "a-cname-that-does-not-fit-inline@example.com";
+
+class CountingTransport : public Transport {
+ public:
+  bool SendRtp(rtc::ArrayView<const uint8_t> /*packet*/,
+               const PacketOptions& /*options*/) override {
+    return false;
+  }
+  bool SendRtcp(rtc::ArrayView<const uint8_t> packet) override {
+    ++num_packets_;
+    num_bytes_ += packet.size();
+    return true;
+  }
+
+  int num_packets_ = 0;
+  size_t num_bytes_ = 0;
+};
+
+// Keeps the RTCP packets sent since the last Clear(), reusing the storage of
+// earlier packets.
+class CapturingTransport : public Transport {
+ public:
+  bool SendRtp(rtc::ArrayView<const uint8_t> /*packet*/,
+               const PacketOptions& /*options*/) override {
+    return false;
+  }
+  bool SendRtcp(rtc::ArrayView<const uint8_t> packet) override {
+    if (num_packets_ == packets_.size()) {
+      packets_.emplace_back();
+    }
+    packets_[num_packets_++].SetData(packet);
+    return true;
+  }
+
+  void Clear() { num_packets_ = 0; }
+  rtc::ArrayView<const rtc::Buffer> packets() const {
+    return rtc::ArrayView<const rtc::Buffer>(packets_.data(), num_packets_);
+  }
+
+ private:
+  std::vector<rtc::Buffer> packets_;
+  size_t num_packets_ = 0;
+};
+
+class CountingRtpRtcp : public RTCPReceiver::ModuleRtpRtcp {
+ public:
+  void SetTmmbn(std::vector<rtcp::TmmbItem> /*bounding_set*/) override {}
+  void OnRequestSendReport() override {}
+  void OnReceivedNack(
+      const std::vector<uint16_t>& nack_sequence_numbers) override {
+    num_nacked_packets_ += nack_sequence_numbers.size();
+  }
+  void OnReceivedRtcpReportBlocks(
+      rtc::ArrayView<const ReportBlockData> report_blocks) override {
+    num_report_blocks_ += report_blocks.size();
+  }
+
+  size_t num_nacked_packets_ = 0;
+  size_t num_report_blocks_ = 0;
+};
+
+class CountingIntraFrameObserver : public RtcpIntraFrameObserver {
+ public:
+  void OnReceivedIntraFrameRequest(uint32_t /*ssrc*/) override {
+    ++num_requests_;
+  }
+
+  int num_requests_ = 0;
+};
+
+class RtcpSenderAllocationTest : public ::testing::Test {
+ protected:
+  RtcpSenderAllocationTest()
+      : clock_(1335900000),
+        receive_statistics_(ReceiveStatistics::Create(&clock_)) {}
+
+  std::unique_ptr<RTCPSender> CreateRtcpSender(bool audio,
+                                               Transport* transport = nullptr) {
+    RTCPSender::Configuration config;
+    config.audio = audio;
+    config.clock = &clock_;
+    config.outgoing_transport = transport ? transport : &transport_;
+    config.rtcp_report_interval = TimeDelta::Millis(1000);
+    config.receive_statistics = receive_statistics_.get();
+    config.local_media_ssrc = kSenderSsrc;
+    auto rtcp_sender = std::make_unique<RTCPSender>(config);
+    rtcp_sender->SetRemoteSSRC(kRemoteSsrc);
+    rtcp_sender->SetRTCPStatus(RtcpMode::kCompound);
+    rtcp_sender->SetCNAME(kCname);
+    return rtcp_sender;
+  }
+
+  // Receives one packet on each of the received streams, so that each
+  // report has report blocks for all of them.
+  void ReceivePackets() {
+    for (int i = 0; i < kNumReceivedStreams; ++i) {
+      RtpPacketReceived packet;
+      packet.SetSsrc(kRemoteSsrc + i);
+      packet.SetSequenceNumber(sequence_number_);
+      packet.SetTimestamp(12345);
+      packet.SetPayloadSize(100);
+      receive_statistics_->OnRtpPacket(packet);
+    }
+    ++sequence_number_;
+  }
+
+  // Sends a compound report and a NACK, and returns the number of
+  // allocations made doing it.
+  int SendReports(RTCPSender& rtcp_sender) {
+    static constexpr uint16_t kNackList[] = {10, 11, 13, 40};
+    RTCPSender::FeedbackState feedback_state;
+    feedback_state.packets_sent = 100;
+    feedback_state.media_bytes_sent = 100'000;
+    ReceivePackets();
+    clock_.AdvanceTime(TimeDelta::Millis(100));
+
+    num_allocations = 0;
+    count_allocations = true;
+    EXPECT_EQ(rtcp_sender.SendRTCP(feedback_state, kRtcpReport), 0);
+    EXPECT_EQ(rtcp_sender.SendRTCP(feedback_state, kRtcpNack,
+                                   std::size(kNackList), kNackList),
+              0);
+    count_allocations = false;
+    return num_allocations;
+  }
+
+  SimulatedClock clock_;
+  CountingTransport transport_;
+  std::unique_ptr<ReceiveStatistics> receive_statistics_;
+  uint16_t sequence_number_ = 0;
+};
+
+TEST_F(RtcpSenderAllocationTest, SendsReceiverReportsWithoutAllocating) {
+  std::unique_ptr<RTCPSender> rtcp_sender = CreateRtcpSender(/*audio=*/false);
+  rtcp_sender->SetRemb(/*bitrate_bps=*/1'000'000, {kRemoteSsrc});
+
+  // The first reports grow the storage reused by the later ones.
+  SendReports(*rtcp_sender);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(SendReports(*rtcp_sender), 0);
+  }
+  EXPECT_EQ(transport_.num_packets_, 22);
+}
+
+TEST_F(RtcpSenderAllocationTest, SendsSenderReportsWithoutAllocating) {
+  std::unique_ptr<RTCPSender> rtcp_sender = CreateRtcpSender(/*audio=*/true);
+  rtcp_sender->SetLastRtpTime(/*rtp_timestamp=*/0x45678, clock_.CurrentTime(),
+                              /*payload_type=*/0);
+  rtcp_sender->SetSendingStatus(RTCPSender::FeedbackState(), true);
+
+  SendReports(*rtcp_sender);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(SendReports(*rtcp_sender), 0);
+  }
+  EXPECT_EQ(transport_.num_packets_, 22);
+}
+
+TEST_F(RtcpSenderAllocationTest, SendsPliAndFirWithoutAllocating) {
+  std::unique_ptr<RTCPSender> rtcp_sender = CreateRtcpSender(/*audio=*/false);
+  RTCPSender::FeedbackState feedback_state;
+
+  for (int i = 0; i < 11; ++i) {
+    ReceivePackets();
+    clock_.AdvanceTime(TimeDelta::Millis(100));
+
+    num_allocations = 0;
+    count_allocations = true;
+    EXPECT_EQ(rtcp_sender->SendRTCP(feedback_state, kRtcpPli), 0);
+    EXPECT_EQ(rtcp_sender->SendRTCP(feedback_state, kRtcpFir), 0);
+    count_allocations = false;
+    // The first requests grow the storage reused by the later ones.
+    if (i > 0) {
+      EXPECT_EQ(num_allocations, 0);
+    }
+  }
+  EXPECT_EQ(transport_.num_packets_, 22);
+}
+
+TEST_F(RtcpSenderAllocationTest, ParsesReportsAndFeedbackWithoutAllocating) {
+  static constexpr uint16_t kNackList[] = {10, 11, 13, 40};
+  CapturingTransport capturing_transport;
+  std::unique_ptr<RTCPSender> rtcp_sender =
+      CreateRtcpSender(/*audio=*/false, &capturing_transport);
+  rtcp_sender->SetRemb(/*bitrate_bps=*/1'000'000, {kRemoteSsrc});
+
+  // The receiver is the remote end of `rtcp_sender`.
+  CountingRtpRtcp rtp_rtcp;
+  CountingIntraFrameObserver intra_frame_observer;
+  RtpRtcpInterface::Configuration config;
+  config.clock = &clock_;
+  config.intra_frame_callback = &intra_frame_observer;
+  config.rtcp_report_interval_ms = 1000;
+  config.local_media_ssrc = kRemoteSsrc;
+  RTCPReceiver rtcp_receiver(config, &rtp_rtcp);
+  rtcp_receiver.SetRemoteSSRC(kSenderSsrc);
+
+  constexpr int kNumRounds = 11;
+  for (int i = 0; i < kNumRounds; ++i) {
+    RTCPSender::FeedbackState feedback_state;
+    ReceivePackets();
+    clock_.AdvanceTime(TimeDelta::Millis(100));
+    capturing_transport.Clear();
+    EXPECT_EQ(rtcp_sender->SendRTCP(feedback_state, kRtcpReport), 0);
+    EXPECT_EQ(rtcp_sender->SendRTCP(feedback_state, kRtcpNack,
+                                    std::size(kNackList), kNackList),
+              0);
+    EXPECT_EQ(rtcp_sender->SendRTCP(feedback_state, kRtcpPli), 0);
+    EXPECT_EQ(rtcp_sender->SendRTCP(feedback_state, kRtcpFir), 0);
+    ASSERT_EQ(capturing_transport.packets().size(), 4u);
+
+    num_allocations = 0;
+    count_allocations = true;
+    for (const rtc::Buffer& packet : capturing_transport.packets()) {
+      rtcp_receiver.IncomingPacket(packet);
+    }
+    count_allocations = false;
+    // The first packets grow the storage reused by the later ones.
+    if (i > 0) {
+      EXPECT_EQ(num_allocations, 0);
+    }
+  }
+  // Each compound packet has a report block for the receiver's SSRC.
+  EXPECT_EQ(rtp_rtcp.num_report_blocks_, 4u * kNumRounds);
+  EXPECT_EQ(rtp_rtcp.num_nacked_packets_, std::size(kNackList) * kNumRounds);
+  EXPECT_EQ(intra_frame_observer.num_requests_, 2 * kNumRounds);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -310,6 +310,18 @@ TEST_F(RtcpSenderTest, SendSdes) {
   EXPECT_EQ("alice@host", parser()->sdes()->chunks()[0].cname);
 }
 
+TEST_F(RtcpSenderTest, SendSdesWithUpdatedSsrc) {
+  const uint32_t kNewSsrc = 0x33333333;
+  auto rtcp_sender = CreateRtcpSender(GetDefaultConfig());
+  rtcp_sender->SetRTCPStatus(RtcpMode::kReducedSize);
+  EXPECT_EQ(0, rtcp_sender->SetCNAME("alice@host"));
+  rtcp_sender->SetSsrc(kNewSsrc);
+  EXPECT_EQ(0, rtcp_sender->SendRTCP(feedback_state(), kRtcpSdes));
+  EXPECT_EQ(1U, parser()->sdes()->chunks().size());
+  EXPECT_EQ(kNewSsrc, parser()->sdes()->chunks()[0].ssrc);
+  EXPECT_EQ("alice@host", parser()->sdes()->chunks()[0].cname);
+}
+
 TEST_F(RtcpSenderTest, SdesIncludedInCompoundPacket) {
   auto rtcp_sender = CreateRtcpSender(GetDefaultConfig());
   rtcp_sender->SetRTCPStatus(RtcpMode::kCompound);
@@ -371,6 +383,19 @@ TEST_F(RtcpSenderTest, SendNack) {
   EXPECT_THAT(parser()->nack()->packet_ids(), ElementsAre(0, 1, 16));
 }
 
+TEST_F(RtcpSenderTest, SendNackWithNewListEachTime) {
+  auto rtcp_sender = CreateRtcpSender(GetDefaultConfig());
+  rtcp_sender->SetRTCPStatus(RtcpMode::kReducedSize);
+  const uint16_t kList1[] = {0, 1, 16, 40};
+  const uint16_t kList2[] = {2, 3};
+  EXPECT_EQ(0, rtcp_sender->SendRTCP(feedback_state(), kRtcpNack,
+                                     ABSL_ARRAYSIZE(kList1), kList1));
+  EXPECT_EQ(0, rtcp_sender->SendRTCP(feedback_state(), kRtcpNack,
+                                     ABSL_ARRAYSIZE(kList2), kList2));
+  EXPECT_EQ(2, parser()->nack()->num_packets());
+  EXPECT_THAT(parser()->nack()->packet_ids(), ElementsAre(2, 3));
+}
+
 TEST_F(RtcpSenderTest, SendLossNotificationBufferingNotAllowed) {
   auto rtcp_sender = CreateRtcpSender(GetDefaultConfig());
   rtcp_sender->SetRTCPStatus(RtcpMode::kReducedSize);
@@ -13,6 +13,7 @@
 
 #include "absl/algorithm/container.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/fec_encoding_pool.h"
 #include "modules/rtp_rtcp/source/fec_test_helper.h"
 #include "modules/rtp_rtcp/source/flexfec_03_header_reader_writer.h"
 #include "modules/rtp_rtcp/source/forward_error_correction.h"
@@ -1126,4 +1127,33 @@ TYPED_TEST(RtpFecTest, FecRecoveryNonConsecutivePacketsWrap) {
   EXPECT_FALSE(this->IsRecoveryComplete());
 }
 
+TYPED_TEST(RtpFecTest, EncodingPoolGeneratesSameFecPacketsAsCallingThread) {
+  constexpr int kNumImportantPackets = 0;
+  constexpr bool kUseUnequalProtection = false;
+  constexpr uint8_t kProtectionFactor = 255;
+
+  this->media_packets_ =
+      this->media_packet_generator_.ConstructMediaPackets(kMaxMediaPackets);
+  EXPECT_EQ(
+      0, this->fec_.EncodeFec(this->media_packets_, kProtectionFactor,
+                              kNumImportantPackets, kUseUnequalProtection,
+                              kFecMaskRandom, &this->generated_fec_packets_));
+  ASSERT_EQ(this->generated_fec_packets_.size(), kMaxMediaPackets);
+
+  FecEncodingPool pool(/*num_threads=*/3);
+  TypeParam pooled_fec;
+  pooled_fec.SetEncodingPool(&pool);
+  std::list<ForwardErrorCorrection::Packet*> pooled_fec_packets;
+  EXPECT_EQ(0, pooled_fec.EncodeFec(this->media_packets_, kProtectionFactor,
+                                    kNumImportantPackets,
+                                    kUseUnequalProtection, kFecMaskRandom,
+                                    &pooled_fec_packets));
+  EXPECT_TRUE(absl::c_equal(
+      this->generated_fec_packets_, pooled_fec_packets,
+      [](const ForwardErrorCorrection::Packet* fec_packet,
+         const ForwardErrorCorrection::Packet* pooled_fec_packet) {
+        return fec_packet->data == pooled_fec_packet->data;
+      }));
+}
+
 }  // namespace webrtc
@@ -122,6 +122,7 @@ void RtpPacket::CopyHeaderFrom(const RtpPacket& packet) {
   payload_offset_ = packet.payload_offset_;
   extensions_ = packet.extensions_;
   extension_entries_ = packet.extension_entries_;
+  extension_entry_by_id_ = packet.extension_entry_by_id_;
   extensions_size_ = packet.extensions_size_;
   buffer_ = packet.buffer_.Slice(0, packet.headers_size());
   // Reset payload and padding.
@@ -328,6 +329,7 @@ rtc::ArrayView<uint8_t> RtpPacket::AllocateRawExtension(int id, size_t length) {
   const uint8_t extension_info_length = rtc::dchecked_cast<uint8_t>(length);
   extension_entries_.emplace_back(id, extension_info_length,
                                   extension_info_offset);
+  IndexLastExtensionInfo();
 
   extensions_size_ = new_extensions_size;
 
@@ -435,7 +437,7 @@ void RtpPacket::Clear() {
   payload_size_ = 0;
   padding_size_ = 0;
   extensions_size_ = 0;
-  extension_entries_.clear();
+  ClearExtensionInfos();
 
   memset(WriteAt(0), 0, kFixedHeaderSize);
   buffer_.SetSize(kFixedHeaderSize);
@@ -465,7 +467,7 @@ bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
   payload_offset_ = kFixedHeaderSize + number_of_crcs * 4;
 
   extensions_size_ = 0;
-  extension_entries_.clear();
+  ClearExtensionInfos();
   if (has_extension) {
     /* RTP header extension, RFC 3550.
      0                   1                   2                   3
@@ -561,7 +563,7 @@ bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
   return true;
 }
 
-const RtpPacket::ExtensionInfo* RtpPacket::FindExtensionInfo(int id) const {
+const RtpPacket::ExtensionInfo* RtpPacket::SearchExtensionInfo(int id) const {
   for (const ExtensionInfo& extension : extension_entries_) {
     if (extension.id == id) {
       return &extension;
@@ -571,15 +573,28 @@ const RtpPacket::ExtensionInfo* RtpPacket::FindExtensionInfo(int id) const {
 }
 
 RtpPacket::ExtensionInfo& RtpPacket::FindOrCreateExtensionInfo(int id) {
-  for (ExtensionInfo& extension : extension_entries_) {
-    if (extension.id == id) {
-      return extension;
-    }
+  const ExtensionInfo* extension = FindExtensionInfo(id);
+  if (extension != nullptr) {
+    return extension_entries_[extension - extension_entries_.data()];
   }
   extension_entries_.emplace_back(id);
+  IndexLastExtensionInfo();
   return extension_entries_.back();
 }
 
+void RtpPacket::IndexLastExtensionInfo() {
+  const uint8_t id = extension_entries_.back().id;
+  if (id <= RtpExtension::kOneByteHeaderExtensionMaxId) {
+    extension_entry_by_id_[id] =
+        rtc::dchecked_cast<uint16_t>(extension_entries_.size());
+  }
+}
+
+void RtpPacket::ClearExtensionInfos() {
+  extension_entries_.clear();
+  extension_entry_by_id_.fill(0);
+}
+
 rtc::ArrayView<const uint8_t> RtpPacket::FindExtension(
     ExtensionType type) const {
   uint8_t id = extensions_.GetId(type);
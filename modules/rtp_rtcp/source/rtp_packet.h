@@ -10,12 +10,14 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_H_
 
+#include <array>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
 #include "api/array_view.h"
+#include "api/rtp_parameters.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "rtc_base/copy_on_write_buffer.h"
@@ -183,12 +185,29 @@ class RtpPacket {
 
   // Returns pointer to extension info for a given id. Returns nullptr if not
   // found.
-  const ExtensionInfo* FindExtensionInfo(int id) const;
+  const ExtensionInfo* FindExtensionInfo(int id) const {
+    if (id <= RtpExtension::kOneByteHeaderExtensionMaxId) {
+      const uint16_t entry = extension_entry_by_id_[id];
+      return entry == 0 ? nullptr : &extension_entries_[entry - 1];
+    }
+    return SearchExtensionInfo(id);
+  }
+  // Same as FindExtensionInfo() for ids that are not indexed.
+  const ExtensionInfo* SearchExtensionInfo(int id) const;
 
   // Returns reference to extension info for a given id. Creates a new entry
   // with the specified id if not found.
   ExtensionInfo& FindOrCreateExtensionInfo(int id);
 
+  // Adds the last entry of `extension_entries_` to `extension_entry_by_id_`.
+  void IndexLastExtensionInfo();
+  void ClearExtensionInfos();
+
+  // Typed version of FindExtension(), which the compiler can inline down to
+  // two table lookups.
+  template <typename Extension>
+  rtc::ArrayView<const uint8_t> FindTypedExtension() const;
+
   // Allocates and returns place to store rtp header extension.
   // Returns empty arrayview on failure.
   rtc::ArrayView<uint8_t> AllocateRawExtension(int id, size_t length);
@@ -217,13 +236,20 @@ class RtpPacket {
 
   ExtensionManager extensions_;
   std::vector<ExtensionInfo> extension_entries_;
+  // Index in `extension_entries_` plus one of the extension with each one-byte
+  // header id, or zero if the packet has no such extension. Larger ids are
+  // only used with extmap-allow-mixed and are searched for.
+  std::array<uint16_t, RtpExtension::kOneByteHeaderExtensionMaxId + 1>
+      extension_entry_by_id_ = {};
   size_t extensions_size_ = 0;  // Unaligned.
   rtc::CopyOnWriteBuffer buffer_;
 };
 
 template <typename Extension>
 bool RtpPacket::HasExtension() const {
-  return HasExtension(Extension::kId);
+  // Unregistered extensions have ExtensionManager::kInvalidId, which is never
+  // in a packet.
+  return FindExtensionInfo(extensions_.GetId(Extension::kId)) != nullptr;
 }
 
 template <typename Extension>
@@ -233,7 +259,7 @@ bool RtpPacket::IsRegistered() const {
 
 template <typename Extension, typename FirstValue, typename... Values>
 bool RtpPacket::GetExtension(FirstValue&& first, Values&&... values) const {
-  auto raw = FindExtension(Extension::kId);
+  auto raw = FindTypedExtension<Extension>();
   if (raw.empty())
     return false;
   return Extension::Parse(raw, std::forward<FirstValue>(first),
@@ -243,7 +269,7 @@ bool RtpPacket::GetExtension(FirstValue&& first, Values&&... values) const {
 template <typename Extension>
 absl::optional<typename Extension::value_type> RtpPacket::GetExtension() const {
   absl::optional<typename Extension::value_type> result;
-  auto raw = FindExtension(Extension::kId);
+  auto raw = FindTypedExtension<Extension>();
   if (raw.empty() || !Extension::Parse(raw, &result.emplace()))
     result = absl::nullopt;
   return result;
@@ -251,7 +277,18 @@ absl::optional<typename Extension::value_type> RtpPacket::GetExtension() const {
 
 template <typename Extension>
 rtc::ArrayView<const uint8_t> RtpPacket::GetRawExtension() const {
-  return FindExtension(Extension::kId);
+  return FindTypedExtension<Extension>();
+}
+
+template <typename Extension>
+rtc::ArrayView<const uint8_t> RtpPacket::FindTypedExtension() const {
+  const ExtensionInfo* extension_info =
+      FindExtensionInfo(extensions_.GetId(Extension::kId));
+  if (extension_info == nullptr) {
+    return nullptr;
+  }
+  return rtc::MakeArrayView(data() + extension_info->offset,
+                            extension_info->length);
 }
 
 template <typename Extension, typename... Values>
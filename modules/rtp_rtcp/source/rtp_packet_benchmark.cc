@@ -0,0 +1,260 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "absl/types/optional.h"
+#include "api/rtp_headers.h"
+#include "api/transport/rtp/dependency_descriptor.h"
+#include "api/units/data_rate.h"
+#include "api/video/video_layers_allocation.h"
+#include "benchmark/benchmark.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_dependency_descriptor_extension.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/rtp_rtcp/source/rtp_video_layers_allocation_extension.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/system/unused.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kMaxPacketSize = 1500;
+constexpr size_t kPayloadSize = 1100;
+constexpr uint32_t kSsrc = 0x12345678;
+
+constexpr int kAbsoluteSendTimeId = 1;
+constexpr int kTransportSequenceNumberId = 2;
+constexpr int kDependencyDescriptorId = 3;
+constexpr int kVideoLayersAllocationId = 4;
+constexpr int kAbsoluteCaptureTimeId = 5;
+
+// Header extension map and values of a typical video stream using the
+// abs-send-time, transport-cc, dependency descriptor, video layers
+// allocation and absolute capture time extensions.
+class RtpPacketFixture {
+ public:
+  RtpPacketFixture() {
+    extensions_.Register<AbsoluteSendTime>(kAbsoluteSendTimeId);
+    extensions_.Register<TransportSequenceNumber>(kTransportSequenceNumberId);
+    extensions_.Register<RtpDependencyDescriptorExtension>(
+        kDependencyDescriptorId);
+    extensions_.Register<RtpVideoLayersAllocationExtension>(
+        kVideoLayersAllocationId);
+    extensions_.Register<AbsoluteCaptureTimeExtension>(kAbsoluteCaptureTimeId);
+
+    structure_.num_decode_targets = 2;
+    structure_.num_chains = 1;
+    structure_.decode_target_protected_by_chain = {0, 0};
+    structure_.templates = {
+        FrameDependencyTemplate().T(0).Dtis("SS").ChainDiffs({0}),
+        FrameDependencyTemplate().T(0).Dtis("SS").FrameDiffs({2}).ChainDiffs(
+            {2}),
+        FrameDependencyTemplate().T(1).Dtis("-D").FrameDiffs({1}).ChainDiffs(
+            {1})};
+    descriptor_.frame_number = 1;
+    descriptor_.frame_dependencies = structure_.templates[1];
+
+    VideoLayersAllocation::SpatialLayer layer;
+    layer.rtp_stream_index = 0;
+    layer.spatial_id = 0;
+    layer.target_bitrate_per_temporal_layer = {DataRate::KilobitsPerSec(600),
+                                               DataRate::KilobitsPerSec(900)};
+    layer.width = 1280;
+    layer.height = 720;
+    layer.frame_rate_fps = 30;
+    allocation_.rtp_stream_index = 0;
+    allocation_.resolution_and_frame_rate_is_valid = true;
+    allocation_.active_spatial_layers = {layer};
+  }
+
+  const RtpHeaderExtensionMap& extensions() const { return extensions_; }
+  const FrameDependencyStructure& structure() const { return structure_; }
+
+  // Writes the header, all header extensions if `with_extensions` and the
+  // payload to `packet`.
+  void Build(RtpPacketToSend& packet,
+             uint16_t sequence_number,
+             bool with_extensions) const {
+    packet.SetPayloadType(96);
+    packet.SetSequenceNumber(sequence_number);
+    packet.SetTimestamp(sequence_number * 3000u);
+    packet.SetSsrc(kSsrc);
+    if (with_extensions) {
+      RTC_CHECK(packet.SetExtension<AbsoluteSendTime>(0x123456));
+      RTC_CHECK(packet.SetExtension<TransportSequenceNumber>(sequence_number));
+      RTC_CHECK(packet.SetExtension<RtpDependencyDescriptorExtension>(
+          structure_, descriptor_));
+      RTC_CHECK(packet.SetExtension<RtpVideoLayersAllocationExtension>(
+          allocation_));
+      RTC_CHECK(packet.SetExtension<AbsoluteCaptureTimeExtension>(
+          AbsoluteCaptureTime{.absolute_capture_timestamp = 0x1122334455667788,
+                              .estimated_capture_clock_offset = 0}));
+    }
+    memset(packet.AllocatePayload(kPayloadSize), 0xab, kPayloadSize);
+  }
+
+  rtc::CopyOnWriteBuffer BuildBuffer(bool with_extensions) const {
+    RtpPacketToSend packet(&extensions_, kMaxPacketSize);
+    Build(packet, /*sequence_number=*/1, with_extensions);
+    return packet.Buffer();
+  }
+
+ private:
+  RtpHeaderExtensionMap extensions_;
+  FrameDependencyStructure structure_;
+  DependencyDescriptor descriptor_;
+  VideoLayersAllocation allocation_;
+};
+
+// Arg: 0 for packets without header extensions, 1 with all five.
+void BM_RtpPacketParse(benchmark::State& state) {
+  RtpPacketFixture fixture;
+  const rtc::CopyOnWriteBuffer buffer =
+      fixture.BuildBuffer(/*with_extensions=*/state.range(0) != 0);
+  RtpPacketReceived packet(&fixture.extensions());
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    RTC_CHECK(packet.Parse(buffer.data(), buffer.size()));
+    benchmark::DoNotOptimize(packet.payload().data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Same as BM_RtpPacketParse, but the buffer is shared instead of copied.
+void BM_RtpPacketParseCopyOnWriteBuffer(benchmark::State& state) {
+  RtpPacketFixture fixture;
+  const rtc::CopyOnWriteBuffer buffer =
+      fixture.BuildBuffer(/*with_extensions=*/state.range(0) != 0);
+  RtpPacketReceived packet(&fixture.extensions());
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    RTC_CHECK(packet.Parse(buffer));
+    benchmark::DoNotOptimize(packet.payload().data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Arg: 0 for packets without header extensions, 1 with all five.
+void BM_RtpPacketToSendBuild(benchmark::State& state) {
+  RtpPacketFixture fixture;
+  uint16_t sequence_number = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    RtpPacketToSend packet(&fixture.extensions(), kMaxPacketSize);
+    fixture.Build(packet, sequence_number++, state.range(0) != 0);
+    benchmark::DoNotOptimize(packet.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Reads all five header extensions of a parsed packet.
+void BM_RtpPacketReceivedGetExtensions(benchmark::State& state) {
+  RtpPacketFixture fixture;
+  RtpPacketReceived packet(&fixture.extensions());
+  RTC_CHECK(packet.Parse(fixture.BuildBuffer(/*with_extensions=*/true)));
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    uint32_t send_time = 0;
+    uint16_t transport_sequence_number = 0;
+    DependencyDescriptor descriptor;
+    VideoLayersAllocation allocation;
+    RTC_CHECK(packet.GetExtension<AbsoluteSendTime>(&send_time));
+    RTC_CHECK(packet.GetExtension<TransportSequenceNumber>(
+        &transport_sequence_number));
+    RTC_CHECK(packet.GetExtension<RtpDependencyDescriptorExtension>(
+        &fixture.structure(), &descriptor));
+    RTC_CHECK(
+        packet.GetExtension<RtpVideoLayersAllocationExtension>(&allocation));
+    absl::optional<AbsoluteCaptureTime> capture_time =
+        packet.GetExtension<AbsoluteCaptureTimeExtension>();
+    RTC_CHECK(capture_time);
+    benchmark::DoNotOptimize(send_time);
+    benchmark::DoNotOptimize(transport_sequence_number);
+    benchmark::DoNotOptimize(descriptor);
+    benchmark::DoNotOptimize(allocation);
+    benchmark::DoNotOptimize(capture_time);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Checks presence of each of the five header extensions of a parsed packet
+// without parsing their values, which isolates the cost of finding them.
+void BM_RtpPacketReceivedFindExtensions(benchmark::State& state) {
+  RtpPacketFixture fixture;
+  RtpPacketReceived packet(&fixture.extensions());
+  RTC_CHECK(packet.Parse(fixture.BuildBuffer(/*with_extensions=*/true)));
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    benchmark::DoNotOptimize(packet.GetRawExtension<AbsoluteSendTime>());
+    benchmark::DoNotOptimize(
+        packet.GetRawExtension<TransportSequenceNumber>());
+    benchmark::DoNotOptimize(
+        packet.GetRawExtension<RtpDependencyDescriptorExtension>());
+    benchmark::DoNotOptimize(
+        packet.GetRawExtension<RtpVideoLayersAllocationExtension>());
+    benchmark::DoNotOptimize(
+        packet.GetRawExtension<AbsoluteCaptureTimeExtension>());
+  }
+  state.SetItemsProcessed(state.iterations() * 5);
+}
+
+// Looks up the type of every one-byte header extension id, and the id of
+// every extension type.
+void BM_RtpHeaderExtensionMapLookup(benchmark::State& state) {
+  RtpPacketFixture fixture;
+  const RtpHeaderExtensionMap& extensions = fixture.extensions();
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    for (int id = 1; id <= 14; ++id) {
+      benchmark::DoNotOptimize(extensions.GetType(id));
+    }
+    for (int type = kRtpExtensionNone + 1;
+         type < kRtpExtensionNumberOfExtensions; ++type) {
+      benchmark::DoNotOptimize(
+          extensions.GetId(static_cast<RTPExtensionType>(type)));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          (14 + kRtpExtensionNumberOfExtensions - 1));
+}
+
+// Copies a parsed packet, as done when a packet is handed to several
+// receivers. Arg: 0 for a plain copy, 1 to also modify the copy, which
+// detaches its buffer.
+void BM_RtpPacketReceivedCopy(benchmark::State& state) {
+  RtpPacketFixture fixture;
+  RtpPacketReceived packet(&fixture.extensions());
+  RTC_CHECK(packet.Parse(fixture.BuildBuffer(/*with_extensions=*/true)));
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    RtpPacketReceived copy(packet);
+    if (state.range(0) != 0) {
+      copy.SetSequenceNumber(copy.SequenceNumber() + 1);
+    }
+    benchmark::DoNotOptimize(copy.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_RtpPacketParse)->Arg(0)->Arg(1);
+BENCHMARK(BM_RtpPacketParseCopyOnWriteBuffer)->Arg(0)->Arg(1);
+BENCHMARK(BM_RtpPacketToSendBuild)->Arg(0)->Arg(1);
+BENCHMARK(BM_RtpPacketReceivedGetExtensions);
+BENCHMARK(BM_RtpPacketReceivedFindExtensions);
+BENCHMARK(BM_RtpHeaderExtensionMapLookup);
+BENCHMARK(BM_RtpPacketReceivedCopy)->Arg(0)->Arg(1);
+
+}  // namespace
+}  // namespace webrtc
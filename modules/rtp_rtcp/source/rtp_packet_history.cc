@@ -10,6 +10,8 @@
 
 #include "modules/rtp_rtcp/source/rtp_packet_history.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <cstdint>
 #include <limits>
@@ -28,31 +30,32 @@ namespace {
 
 constexpr size_t kOldPayloadPaddingSizeHysteresis = 100;
 constexpr uint16_t kMaxOldPayloadPaddingSequenceNumber = 1 << 13;
+constexpr size_t kInitialBufferSize = 16 * 1024;
+constexpr size_t kInitialPacketSlots = 64;
 
-}  // namespace
-
-RtpPacketHistory::StoredPacket::StoredPacket(
-    std::unique_ptr<RtpPacketToSend> packet,
-    Timestamp send_time,
-    uint64_t insert_order)
-    : packet_(std::move(packet)),
-      pending_transmission_(false),
-      send_time_(send_time),
-      insert_order_(insert_order),
-      times_retransmitted_(0) {}
-
-RtpPacketHistory::StoredPacket::StoredPacket(StoredPacket&&) = default;
-RtpPacketHistory::StoredPacket& RtpPacketHistory::StoredPacket::operator=(
-    RtpPacketHistory::StoredPacket&&) = default;
-RtpPacketHistory::StoredPacket::~StoredPacket() = default;
-
-void RtpPacketHistory::StoredPacket::IncrementTimesRetransmitted() {
-  ++times_retransmitted_;
+bool HasSameExtensions(const RtpHeaderExtensionMap& a,
+                       const RtpHeaderExtensionMap& b) {
+  if (a.ExtmapAllowMixed() != b.ExtmapAllowMixed()) {
+    return false;
+  }
+  for (int type = kRtpExtensionNone + 1; type < kRtpExtensionNumberOfExtensions;
+       ++type) {
+    if (a.GetId(static_cast<RTPExtensionType>(type)) !=
+        b.GetId(static_cast<RTPExtensionType>(type))) {
+      return false;
+    }
+  }
+  return true;
 }
 
-RtpPacketHistory::RtpPacketHistory(Clock* clock, PaddingMode padding_mode)
+}  // namespace
+
+RtpPacketHistory::RtpPacketHistory(Clock* clock,
+                                   PaddingMode padding_mode,
+                                   size_t max_stored_bytes)
     : clock_(clock),
       padding_mode_(padding_mode),
+      max_stored_bytes_(max_stored_bytes),
       number_to_store_(0),
       mode_(StorageMode::kDisabled),
       rtt_(TimeDelta::MinusInfinity()),
@@ -92,52 +95,111 @@ void RtpPacketHistory::SetRtt(TimeDelta rtt) {
 void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
                                     Timestamp send_time) {
   RTC_DCHECK(packet);
+  PutRtpPacket(*packet, send_time);
+}
+
+void RtpPacketHistory::PutRtpPacket(const RtpPacketToSend& packet,
+                                    Timestamp send_time) {
   MutexLock lock(&lock_);
   if (mode_ == StorageMode::kDisabled) {
     return;
   }
 
-  RTC_DCHECK(packet->allow_retransmission());
+  RTC_DCHECK(packet.allow_retransmission());
   CullOldPackets();
 
-  // Store packet.
-  const uint16_t rtp_seq_no = packet->SequenceNumber();
+  const uint16_t rtp_seq_no = packet.SequenceNumber();
   int packet_index = GetPacketIndex(rtp_seq_no);
   if (packet_index >= 0 &&
-      static_cast<size_t>(packet_index) < packet_history_.size() &&
-      packet_history_[packet_index].packet_ != nullptr) {
+      static_cast<size_t>(packet_index) < num_packet_slots_ &&
+      packet_slot(packet_index).stored()) {
     RTC_LOG(LS_WARNING) << "Duplicate packet inserted: " << rtp_seq_no;
     // Remove previous packet to avoid inconsistent state.
     RemovePacket(packet_index);
-    packet_index = GetPacketIndex(rtp_seq_no);
   }
 
+  // Making room in the buffer may remove packets, so find the slot after.
+  absl::optional<size_t> entry_offset =
+      AllocateBufferEntry(sizeof(BufferEntryHeader) + packet.size());
+  if (!entry_offset) {
+    RTC_LOG(LS_WARNING) << "Packet " << rtp_seq_no << " of " << packet.size()
+                        << " bytes does not fit in the packet history.";
+    return;
+  }
+  const BufferEntryHeader header = {
+      .insert_order = packets_inserted_,
+      .size = static_cast<uint32_t>(packet.size()),
+      .sequence_number = rtp_seq_no};
+  memcpy(&buffer_[*entry_offset], &header, sizeof(header));
+  memcpy(&buffer_[*entry_offset + sizeof(header)], packet.data(),
+         packet.size());
+
+  if (num_packet_slots_ == 0) {
+    first_sequence_number_ = rtp_seq_no;
+  }
+  packet_index = GetPacketIndex(rtp_seq_no);
   // Packet to be inserted ahead of first packet, expand front.
   for (; packet_index < 0; ++packet_index) {
-    packet_history_.emplace_front();
+    if (num_packet_slots_ == packet_slots_.size()) {
+      GrowPacketSlots();
+    }
+    first_packet_slot_ = (first_packet_slot_ - 1) & (packet_slots_.size() - 1);
+    ++num_packet_slots_;
+    --first_sequence_number_;
+    packet_slot(0) = StoredPacket();
   }
   // Packet to be inserted behind last packet, expand back.
-  while (static_cast<int>(packet_history_.size()) <= packet_index) {
-    packet_history_.emplace_back();
+  while (num_packet_slots_ <= static_cast<size_t>(packet_index)) {
+    if (num_packet_slots_ == packet_slots_.size()) {
+      GrowPacketSlots();
+    }
+    ++num_packet_slots_;
+    packet_slot(num_packet_slots_ - 1) = StoredPacket();
   }
 
-  RTC_DCHECK_GE(packet_index, 0);
-  RTC_DCHECK_LT(packet_index, packet_history_.size());
-  RTC_DCHECK(packet_history_[packet_index].packet_ == nullptr);
+  StoredPacket& stored_packet = packet_slot(packet_index);
+  RTC_DCHECK(!stored_packet.stored());
 
   if (padding_mode_ == PaddingMode::kRecentLargePacket) {
     if ((!large_payload_packet_ ||
-         packet->payload_size() + kOldPayloadPaddingSizeHysteresis >
+         packet.payload_size() + kOldPayloadPaddingSizeHysteresis >
              large_payload_packet_->payload_size() ||
-         IsNewerSequenceNumber(packet->SequenceNumber(),
+         IsNewerSequenceNumber(packet.SequenceNumber(),
                                large_payload_packet_->SequenceNumber() +
                                    kMaxOldPayloadPaddingSequenceNumber))) {
-      large_payload_packet_.emplace(*packet);
+      large_payload_packet_.emplace(packet);
     }
   }
 
-  packet_history_[packet_index] =
-      StoredPacket(std::move(packet), send_time, packets_inserted_++);
+  // Drop the extension maps that no stored packet refers to anymore.
+  BufferEntryHeader oldest_entry;
+  if (ReadBufferHead(oldest_entry)) {
+    while (extension_maps_.size() > 1 &&
+           extension_maps_[1].first_insert_order <=
+               oldest_entry.insert_order) {
+      extension_maps_.pop_front();
+    }
+  }
+  if (extension_maps_.empty() ||
+      !HasSameExtensions(extension_maps_.back().extension_map,
+                         packet.extension_manager())) {
+    extension_maps_.push_back({.first_insert_order = packets_inserted_,
+                               .extension_map = packet.extension_manager()});
+  }
+
+  stored_packet.insert_order = packets_inserted_++;
+  stored_packet.send_time = send_time;
+  stored_packet.offset =
+      static_cast<uint32_t>(*entry_offset + sizeof(header));
+  stored_packet.size = header.size;
+  stored_packet.is_first_packet_of_frame = packet.is_first_packet_of_frame();
+  stored_packet.is_key_frame = packet.is_key_frame();
+  stored_packet.fec_protect_packet = packet.fec_protect_packet();
+  stored_packet.is_red = packet.is_red();
+  stored_packet.packet_type = packet.packet_type();
+  stored_packet.original_packet_type = packet.original_packet_type();
+  stored_packet.capture_time = packet.capture_time();
+  stored_packet.additional_data = packet.additional_data();
 }
 
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndMarkAsPending(
@@ -162,7 +224,7 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndMarkAsPending(
     return nullptr;
   }
 
-  if (packet->pending_transmission_) {
+  if (packet->pending_transmission) {
     // Packet already in pacer queue, ignore this request.
     return nullptr;
   }
@@ -174,9 +236,9 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndMarkAsPending(
 
   // Copy and/or encapsulate packet.
   std::unique_ptr<RtpPacketToSend> encapsulated_packet =
-      encapsulate(*packet->packet_);
+      encapsulate(RestorePacket(*packet));
   if (encapsulated_packet) {
-    packet->pending_transmission_ = true;
+    packet->pending_transmission = true;
   }
 
   return encapsulated_packet;
@@ -195,9 +257,9 @@ void RtpPacketHistory::MarkPacketAsSent(uint16_t sequence_number) {
 
   // Update send-time, mark as no longer in pacer queue, and increment
   // transmission count.
-  packet->set_send_time(clock_->CurrentTime());
-  packet->pending_transmission_ = false;
-  packet->IncrementTimesRetransmitted();
+  packet->send_time = clock_->CurrentTime();
+  packet->pending_transmission = false;
+  ++packet->times_retransmitted;
 }
 
 bool RtpPacketHistory::GetPacketState(uint16_t sequence_number) const {
@@ -208,11 +270,11 @@ bool RtpPacketHistory::GetPacketState(uint16_t sequence_number) const {
 
   int packet_index = GetPacketIndex(sequence_number);
   if (packet_index < 0 ||
-      static_cast<size_t>(packet_index) >= packet_history_.size()) {
+      static_cast<size_t>(packet_index) >= num_packet_slots_) {
     return false;
   }
-  const StoredPacket& packet = packet_history_[packet_index];
-  if (packet.packet_ == nullptr) {
+  const StoredPacket& packet = packet_slot(packet_index);
+  if (!packet.stored()) {
     return false;
   }
 
@@ -225,8 +287,8 @@ bool RtpPacketHistory::GetPacketState(uint16_t sequence_number) const {
 
 bool RtpPacketHistory::VerifyRtt(
     const RtpPacketHistory::StoredPacket& packet) const {
-  if (packet.times_retransmitted() > 0 &&
-      clock_->CurrentTime() - packet.send_time() < rtt_) {
+  if (packet.times_retransmitted > 0 &&
+      clock_->CurrentTime() - packet.send_time < rtt_) {
     // This packet has already been retransmitted once, and the time since
     // that even is lower than on RTT. Ignore request as this packet is
     // likely already in the network pipe.
@@ -256,21 +318,18 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
   }
 
   StoredPacket* best_packet = nullptr;
-  if (!packet_history_.empty()) {
-    // Pick the last packet.
-    for (auto it = packet_history_.rbegin(); it != packet_history_.rend();
-         ++it) {
-      if (it->packet_ != nullptr) {
-        best_packet = &(*it);
-        break;
-      }
+  // Pick the last packet.
+  for (size_t i = num_packet_slots_; i > 0; --i) {
+    if (packet_slot(i - 1).stored()) {
+      best_packet = &packet_slot(i - 1);
+      break;
     }
   }
   if (best_packet == nullptr) {
     return nullptr;
   }
 
-  if (best_packet->pending_transmission_) {
+  if (best_packet->pending_transmission) {
     // Because PacedSender releases it's lock when it calls
     // GeneratePadding() there is the potential for a race where a new
     // packet ends up here instead of the regular transmit path. In such a
@@ -279,13 +338,13 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
     return nullptr;
   }
 
-  auto padding_packet = encapsulate(*best_packet->packet_);
+  auto padding_packet = encapsulate(RestorePacket(*best_packet));
   if (!padding_packet) {
     return nullptr;
   }
 
-  best_packet->set_send_time(clock_->CurrentTime());
-  best_packet->IncrementTimesRetransmitted();
+  best_packet->send_time = clock_->CurrentTime();
+  ++best_packet->times_retransmitted;
   return padding_packet;
 }
 
@@ -295,7 +354,8 @@ void RtpPacketHistory::CullAcknowledgedPackets(
   for (uint16_t sequence_number : sequence_numbers) {
     int packet_index = GetPacketIndex(sequence_number);
     if (packet_index < 0 ||
-        static_cast<size_t>(packet_index) >= packet_history_.size()) {
+        static_cast<size_t>(packet_index) >= num_packet_slots_ ||
+        !packet_slot(packet_index).stored()) {
       continue;
     }
     RemovePacket(packet_index);
@@ -308,7 +368,14 @@ void RtpPacketHistory::Clear() {
 }
 
 void RtpPacketHistory::Reset() {
-  packet_history_.clear();
+  packet_slots_ = {};
+  first_packet_slot_ = 0;
+  num_packet_slots_ = 0;
+  buffer_ = {};
+  buffer_head_ = 0;
+  buffer_tail_ = 0;
+  buffer_used_ = 0;
+  extension_maps_.clear();
   large_payload_packet_ = absl::nullopt;
 }
 
@@ -318,27 +385,27 @@ void RtpPacketHistory::CullOldPackets() {
       rtt_.IsFinite()
           ? std::max(kMinPacketDurationRtt * rtt_, kMinPacketDuration)
           : kMinPacketDuration;
-  while (!packet_history_.empty()) {
-    if (packet_history_.size() >= kMaxCapacity) {
+  while (num_packet_slots_ > 0) {
+    if (num_packet_slots_ >= kMaxCapacity) {
       // We have reached the absolute max capacity, remove one packet
       // unconditionally.
       RemovePacket(0);
       continue;
     }
 
-    const StoredPacket& stored_packet = packet_history_.front();
-    if (stored_packet.pending_transmission_) {
+    const StoredPacket& stored_packet = packet_slot(0);
+    if (stored_packet.pending_transmission) {
       // Don't remove packets in the pacer queue, pending tranmission.
       return;
     }
 
-    if (stored_packet.send_time() + packet_duration > now) {
+    if (stored_packet.send_time + packet_duration > now) {
       // Don't cull packets too early to avoid failed retransmission requests.
       return;
     }
 
-    if (packet_history_.size() >= number_to_store_ ||
-        stored_packet.send_time() +
+    if (num_packet_slots_ >= number_to_store_ ||
+        stored_packet.send_time +
                 (packet_duration * kPacketCullingDelayFactor) <=
             now) {
       // Too many packets in history, or this packet has timed out. Remove it
@@ -351,28 +418,24 @@ void RtpPacketHistory::CullOldPackets() {
   }
 }
 
-std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
-    int packet_index) {
-  // Move the packet out from the StoredPacket container.
-  std::unique_ptr<RtpPacketToSend> rtp_packet =
-      std::move(packet_history_[packet_index].packet_);
+void RtpPacketHistory::RemovePacket(int packet_index) {
+  packet_slot(packet_index) = StoredPacket();
   if (packet_index == 0) {
-    while (!packet_history_.empty() &&
-           packet_history_.front().packet_ == nullptr) {
-      packet_history_.pop_front();
+    while (num_packet_slots_ > 0 && !packet_slot(0).stored()) {
+      first_packet_slot_ =
+          (first_packet_slot_ + 1) & (packet_slots_.size() - 1);
+      --num_packet_slots_;
+      ++first_sequence_number_;
     }
   }
-
-  return rtp_packet;
 }
 
 int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
-  if (packet_history_.empty()) {
+  if (num_packet_slots_ == 0) {
     return 0;
   }
 
-  RTC_DCHECK(packet_history_.front().packet_ != nullptr);
-  int first_seq = packet_history_.front().packet_->SequenceNumber();
+  int first_seq = first_sequence_number_;
   if (first_seq == sequence_number) {
     return 0;
   }
@@ -396,11 +459,186 @@ int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
 RtpPacketHistory::StoredPacket* RtpPacketHistory::GetStoredPacket(
     uint16_t sequence_number) {
   int index = GetPacketIndex(sequence_number);
-  if (index < 0 || static_cast<size_t>(index) >= packet_history_.size() ||
-      packet_history_[index].packet_ == nullptr) {
+  if (index < 0 || static_cast<size_t>(index) >= num_packet_slots_ ||
+      !packet_slot(index).stored()) {
     return nullptr;
   }
-  return &packet_history_[index];
+  return &packet_slot(index);
+}
+
+RtpPacketToSend RtpPacketHistory::RestorePacket(
+    const StoredPacket& stored_packet) const {
+  const RtpHeaderExtensionMap* extension_map = nullptr;
+  for (auto it = extension_maps_.rbegin(); it != extension_maps_.rend();
+       ++it) {
+    if (it->first_insert_order <= stored_packet.insert_order) {
+      extension_map = &it->extension_map;
+      break;
+    }
+  }
+  RTC_DCHECK(extension_map);
+
+  RtpPacketToSend packet(extension_map);
+  bool parsed =
+      packet.Parse(&buffer_[stored_packet.offset], stored_packet.size);
+  RTC_DCHECK(parsed);
+  if (stored_packet.original_packet_type) {
+    // Only the type before the last change is kept as original type.
+    packet.set_packet_type(*stored_packet.original_packet_type ==
+                                   RtpPacketToSend::OriginalType::kAudio
+                               ? RtpPacketMediaType::kAudio
+                               : RtpPacketMediaType::kVideo);
+  }
+  if (stored_packet.packet_type) {
+    packet.set_packet_type(*stored_packet.packet_type);
+  }
+  packet.set_allow_retransmission(true);
+  packet.set_capture_time(stored_packet.capture_time);
+  packet.set_first_packet_of_frame(stored_packet.is_first_packet_of_frame);
+  packet.set_is_key_frame(stored_packet.is_key_frame);
+  packet.set_fec_protect_packet(stored_packet.fec_protect_packet);
+  packet.set_is_red(stored_packet.is_red);
+  packet.set_additional_data(stored_packet.additional_data);
+  return packet;
+}
+
+void RtpPacketHistory::GrowPacketSlots() {
+  std::vector<StoredPacket> packet_slots(
+      std::max(kInitialPacketSlots, 2 * packet_slots_.size()));
+  for (size_t i = 0; i < num_packet_slots_; ++i) {
+    packet_slots[i] = std::move(packet_slot(i));
+  }
+  packet_slots_.swap(packet_slots);
+  first_packet_slot_ = 0;
+}
+
+absl::optional<size_t> RtpPacketHistory::AllocateBufferEntry(
+    size_t entry_size) {
+  if (entry_size > max_stored_bytes_) {
+    return absl::nullopt;
+  }
+  while (true) {
+    ReclaimBufferEntries(/*evict_packet=*/false);
+    absl::optional<size_t> offset = TryAllocateBufferEntry(entry_size);
+    if (offset) {
+      return offset;
+    }
+    if (buffer_.size() < max_stored_bytes_) {
+      GrowBuffer(buffer_used_ + entry_size);
+    } else if (!ReclaimBufferEntries(/*evict_packet=*/true)) {
+      // The history is at its byte limit and the oldest packet is pending
+      // transmission. As when culling by count, it is kept.
+      return absl::nullopt;
+    }
+  }
+}
+
+absl::optional<size_t> RtpPacketHistory::TryAllocateBufferEntry(
+    size_t entry_size) {
+  size_t offset;
+  if (buffer_used_ == 0 || buffer_tail_ > buffer_head_) {
+    // The free space is at the end of the buffer and before the head.
+    if (buffer_.size() - buffer_tail_ >= entry_size) {
+      offset = buffer_tail_;
+    } else if (buffer_head_ >= entry_size) {
+      // Skip the end of the buffer.
+      if (buffer_.size() - buffer_tail_ >= sizeof(BufferEntryHeader)) {
+        const BufferEntryHeader wrap_marker = {
+            .insert_order = 0, .size = kWrapMarker, .sequence_number = 0};
+        memcpy(&buffer_[buffer_tail_], &wrap_marker, sizeof(wrap_marker));
+      }
+      buffer_used_ += buffer_.size() - buffer_tail_;
+      offset = 0;
+    } else {
+      return absl::nullopt;
+    }
+  } else if (buffer_head_ - buffer_tail_ >= entry_size) {
+    offset = buffer_tail_;
+  } else {
+    return absl::nullopt;
+  }
+  buffer_tail_ = offset + entry_size;
+  buffer_used_ += entry_size;
+  return offset;
+}
+
+bool RtpPacketHistory::ReadBufferHead(BufferEntryHeader& header) {
+  while (buffer_used_ > 0) {
+    if (buffer_.size() - buffer_head_ >= sizeof(BufferEntryHeader)) {
+      memcpy(&header, &buffer_[buffer_head_], sizeof(header));
+      if (header.size != kWrapMarker) {
+        return true;
+      }
+    }
+    // The rest of the buffer is unused, continue at its start.
+    buffer_used_ -= buffer_.size() - buffer_head_;
+    buffer_head_ = 0;
+  }
+  buffer_head_ = 0;
+  buffer_tail_ = 0;
+  return false;
+}
+
+void RtpPacketHistory::PopBufferHead(const BufferEntryHeader& header) {
+  const size_t entry_size = sizeof(BufferEntryHeader) + header.size;
+  buffer_head_ += entry_size;
+  buffer_used_ -= entry_size;
+}
+
+bool RtpPacketHistory::ReclaimBufferEntries(bool evict_packet) {
+  BufferEntryHeader header;
+  while (ReadBufferHead(header)) {
+    int packet_index = GetBufferEntryPacketIndex(header);
+    if (packet_index >= 0) {
+      if (!evict_packet) {
+        return true;
+      }
+      if (packet_slot(packet_index).pending_transmission) {
+        return false;
+      }
+      RemovePacket(packet_index);
+      evict_packet = false;
+    }
+    PopBufferHead(header);
+  }
+  return true;
+}
+
+int RtpPacketHistory::GetBufferEntryPacketIndex(
+    const BufferEntryHeader& header) const {
+  int packet_index = GetPacketIndex(header.sequence_number);
+  if (packet_index < 0 ||
+      static_cast<size_t>(packet_index) >= num_packet_slots_) {
+    return -1;
+  }
+  const StoredPacket& packet = packet_slot(packet_index);
+  if (!packet.stored() || packet.insert_order != header.insert_order) {
+    return -1;
+  }
+  return packet_index;
+}
+
+void RtpPacketHistory::GrowBuffer(size_t min_size) {
+  std::vector<uint8_t> buffer(std::min(
+      max_stored_bytes_,
+      std::max({kInitialBufferSize, 2 * buffer_.size(), min_size})));
+  size_t size = 0;
+  BufferEntryHeader header;
+  while (ReadBufferHead(header)) {
+    int packet_index = GetBufferEntryPacketIndex(header);
+    if (packet_index >= 0) {
+      const size_t entry_size = sizeof(BufferEntryHeader) + header.size;
+      memcpy(&buffer[size], &buffer_[buffer_head_], entry_size);
+      packet_slot(packet_index).offset =
+          static_cast<uint32_t>(size + sizeof(BufferEntryHeader));
+      size += entry_size;
+    }
+    PopBufferHead(header);
+  }
+  buffer_.swap(buffer);
+  buffer_head_ = 0;
+  buffer_tail_ = size;
+  buffer_used_ = size;
 }
 
 }  // namespace webrtc
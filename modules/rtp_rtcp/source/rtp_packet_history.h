@@ -11,17 +11,20 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <deque>
-#include <map>
 #include <memory>
-#include <set>
-#include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
 #include "api/function_view.h"
+#include "api/ref_counted_base.h"
+#include "api/scoped_refptr.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "rtc_base/synchronization/mutex.h"
@@ -31,6 +34,11 @@ namespace webrtc {
 
 class Clock;
 
+// History of sent RTP packets of one SSRC, for retransmission and payload
+// padding. Packets are stored serialized, back to back in a ring buffer, so
+// that a stored packet costs its size on the wire plus a few tens of bytes of
+// metadata, rather than a full RtpPacketToSend. Packets are looked up by
+// sequence number in O(1), and rebuilt when they are retransmitted.
 class RtpPacketHistory {
  public:
   enum class StorageMode {
@@ -55,8 +63,16 @@ class RtpPacketHistory {
   static constexpr int kMinPacketDurationRtt = 3;
   // With kStoreAndCull, always remove packets after 3x max(1000ms, 3x rtt).
   static constexpr int kPacketCullingDelayFactor = 3;
+  // Default cap on the bytes of stored packets, high enough to hold
+  // kMaxCapacity full size packets.
+  static constexpr size_t kDefaultMaxStoredBytes = kMaxCapacity * 1500;
 
-  RtpPacketHistory(Clock* clock, PaddingMode padding_mode);
+  // Stores at most `max_stored_bytes` of serialized packets, including a
+  // small per packet header. When the limit is reached, the oldest packets
+  // are removed, even if they have not yet timed out.
+  RtpPacketHistory(Clock* clock,
+                   PaddingMode padding_mode,
+                   size_t max_stored_bytes = kDefaultMaxStoredBytes);
 
   RtpPacketHistory() = delete;
   RtpPacketHistory(const RtpPacketHistory&) = delete;
@@ -73,6 +89,8 @@ class RtpPacketHistory {
   // a packet in the history before we are reasonably sure it has been received.
   void SetRtt(TimeDelta rtt);
 
+  // Stores a copy of `packet`, which must allow retransmission.
+  void PutRtpPacket(const RtpPacketToSend& packet, Timestamp send_time);
   void PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
                     Timestamp send_time);
 
@@ -123,39 +141,51 @@ class RtpPacketHistory {
   void Clear();
 
  private:
-  class StoredPacket {
-   public:
-    StoredPacket() = default;
-    StoredPacket(std::unique_ptr<RtpPacketToSend> packet,
-                 Timestamp send_time,
-                 uint64_t insert_order);
-    StoredPacket(StoredPacket&&);
-    StoredPacket& operator=(StoredPacket&&);
-    ~StoredPacket();
-
-    uint64_t insert_order() const { return insert_order_; }
-    size_t times_retransmitted() const { return times_retransmitted_; }
-    void IncrementTimesRetransmitted();
+  // Metadata of a stored packet. The packet itself is stored in `buffer_`.
+  struct StoredPacket {
+    bool stored() const { return size != 0; }
 
+    // Unique number per stored packet, incremented by one for each added
+    // packet. Used to sort on insert order.
+    uint64_t insert_order = 0;
     // The time of last transmission, including retransmissions.
-    Timestamp send_time() const { return send_time_; }
-    void set_send_time(Timestamp value) { send_time_ = value; }
-
-    // The actual packet.
-    std::unique_ptr<RtpPacketToSend> packet_;
-
+    Timestamp send_time = Timestamp::Zero();
+    // Offset of the serialized packet in `buffer_` and its size, 0 if no
+    // packet is stored.
+    uint32_t offset = 0;
+    uint32_t size = 0;
+    // Number of times RE-transmitted, ie excluding the first transmission.
+    uint32_t times_retransmitted = 0;
     // True if the packet is currently in the pacer queue pending transmission.
-    bool pending_transmission_;
-
-   private:
-    Timestamp send_time_ = Timestamp::Zero();
+    bool pending_transmission = false;
+
+    // Metadata of the RtpPacketToSend that is not part of the serialized
+    // packet.
+    bool is_first_packet_of_frame = false;
+    bool is_key_frame = false;
+    bool fec_protect_packet = false;
+    bool is_red = false;
+    absl::optional<RtpPacketMediaType> packet_type;
+    absl::optional<RtpPacketToSend::OriginalType> original_packet_type;
+    Timestamp capture_time = Timestamp::Zero();
+    rtc::scoped_refptr<rtc::RefCountedBase> additional_data;
+  };
 
-    // Unique number per StoredPacket, incremented by one for each added
-    // packet. Used to sort on insert order.
-    uint64_t insert_order_;
+  // Header of each packet in `buffer_`.
+  struct BufferEntryHeader {
+    uint64_t insert_order;
+    // Size of the packet following the header, or kWrapMarker if the rest of
+    // the buffer is unused and the next entry is at its start.
+    uint32_t size;
+    uint16_t sequence_number;
+  };
+  static constexpr uint32_t kWrapMarker = 0xffffffff;
 
-    // Number of times RE-transmitted, ie excluding the first transmission.
-    size_t times_retransmitted_;
+  // Header extension map of the packets inserted from `first_insert_order`
+  // on, until the next map.
+  struct ExtensionMapVersion {
+    uint64_t first_insert_order;
+    RtpHeaderExtensionMap extension_map;
   };
 
   // Helper method to check if packet has too recently been sent.
@@ -163,29 +193,89 @@ class RtpPacketHistory {
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void Reset() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void CullOldPackets() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
-  // Removes the packet from the history, and context/mapping that has been
-  // stored. Returns the RTP packet instance contained within the StoredPacket.
-  std::unique_ptr<RtpPacketToSend> RemovePacket(int packet_index)
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Removes the packet from the history. Its bytes in `buffer_` are
+  // reclaimed once the packets stored before it are gone.
+  void RemovePacket(int packet_index) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   int GetPacketIndex(uint16_t sequence_number) const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   StoredPacket* GetStoredPacket(uint16_t sequence_number)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Rebuilds the RtpPacketToSend of a stored packet.
+  RtpPacketToSend RestorePacket(const StoredPacket& packet) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // The slot of the packet `index` sequence numbers after
+  // `first_sequence_number_`.
+  StoredPacket& packet_slot(size_t index) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    return packet_slots_[(first_packet_slot_ + index) &
+                         (packet_slots_.size() - 1)];
+  }
+  const StoredPacket& packet_slot(size_t index) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    return packet_slots_[(first_packet_slot_ + index) &
+                         (packet_slots_.size() - 1)];
+  }
+  void GrowPacketSlots() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Returns the offset in `buffer_` where an entry of `entry_size` bytes can
+  // be written, removing the oldest packets if needed to stay within
+  // `max_stored_bytes_`. Returns nullopt if the entry is larger than that, or
+  // if the oldest packet can't be removed as it is pending transmission.
+  absl::optional<size_t> AllocateBufferEntry(size_t entry_size)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  absl::optional<size_t> TryAllocateBufferEntry(size_t entry_size)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Frees the entries at the head of `buffer_` whose packets have been
+  // removed. If `evict_packet` is set, the first stored packet found is
+  // removed as well, unless it is pending transmission, in which case false
+  // is returned.
+  bool ReclaimBufferEntries(bool evict_packet)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Reads the header of the oldest entry in `buffer_`, skipping the unused
+  // end of the buffer. Returns false if the buffer is empty.
+  bool ReadBufferHead(BufferEntryHeader& header)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void PopBufferHead(const BufferEntryHeader& header)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Returns the index of the packet stored at the entry, or -1 if it has been
+  // removed.
+  int GetBufferEntryPacketIndex(const BufferEntryHeader& header) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Moves the stored packets to the start of a buffer of at least
+  // `min_size` bytes.
+  void GrowBuffer(size_t min_size) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
   Clock* const clock_;
   const PaddingMode padding_mode_;
+  const size_t max_stored_bytes_;
   mutable Mutex lock_;
   size_t number_to_store_ RTC_GUARDED_BY(lock_);
   StorageMode mode_ RTC_GUARDED_BY(lock_);
   TimeDelta rtt_ RTC_GUARDED_BY(lock_);
 
-  // Queue of stored packets, ordered by sequence number, with older packets in
-  // the front and new packets being added to the back. Note that there may be
+  // Stored packets, ordered by sequence number, with older packets in the
+  // front and new packets being added to the back. Note that there may be
   // wrap-arounds so the back may have a lower sequence number.
   // Packets may also be removed out-of-order, in which case there will be
-  // instances of StoredPacket with `packet_` set to nullptr. The first and last
-  // entry in the queue will however always be populated.
-  std::deque<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  // slots without a stored packet. The first and last slot will however
+  // always hold a packet. The size of `packet_slots_` is a power of two, it
+  // doubles when all slots are in use.
+  std::vector<StoredPacket> packet_slots_ RTC_GUARDED_BY(lock_);
+  size_t first_packet_slot_ RTC_GUARDED_BY(lock_) = 0;
+  size_t num_packet_slots_ RTC_GUARDED_BY(lock_) = 0;
+  uint16_t first_sequence_number_ RTC_GUARDED_BY(lock_) = 0;
+
+  // Serialized packets, each preceded by a BufferEntryHeader, in insert order.
+  // Used as a ring: entries are written at `buffer_tail_` and freed from
+  // `buffer_head_`. `buffer_used_` counts the bytes from head to tail,
+  // including any unused bytes skipped at the end of the buffer.
+  std::vector<uint8_t> buffer_ RTC_GUARDED_BY(lock_);
+  size_t buffer_head_ RTC_GUARDED_BY(lock_) = 0;
+  size_t buffer_tail_ RTC_GUARDED_BY(lock_) = 0;
+  size_t buffer_used_ RTC_GUARDED_BY(lock_) = 0;
+
+  // Extension maps of the stored packets, oldest first.
+  std::deque<ExtensionMapVersion> extension_maps_ RTC_GUARDED_BY(lock_);
 
   // Total number of packets with inserted.
   uint64_t packets_inserted_ RTC_GUARDED_BY(lock_);
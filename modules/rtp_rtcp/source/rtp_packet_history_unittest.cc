@@ -17,7 +17,9 @@
 
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gmock.h"
@@ -617,6 +619,49 @@ TEST_P(RtpPacketHistoryTest, UsesLastPacketAsPaddingWithDefaultMode) {
   EXPECT_EQ(hist_.GetPayloadPaddingPacket(), nullptr);
 }
 
+TEST_P(RtpPacketHistoryTest, RestoresExtensionsAndMetadataOfStoredPackets) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+  RtpHeaderExtensionMap extensions;
+  extensions.Register<TransmissionOffset>(/*id=*/1);
+  auto packet = std::make_unique<RtpPacketToSend>(&extensions);
+  packet->SetSequenceNumber(kStartSeqNum);
+  packet->SetExtension<TransmissionOffset>(1234);
+  packet->SetPayloadSize(100);
+  packet->set_allow_retransmission(true);
+  packet->set_packet_type(RtpPacketMediaType::kVideo);
+  packet->set_first_packet_of_frame(true);
+  packet->set_is_key_frame(true);
+  packet->set_capture_time(Timestamp::Millis(42));
+  rtc::CopyOnWriteBuffer buffer = packet->Buffer();
+  hist_.PutRtpPacket(std::move(packet),
+                     /*send_time=*/fake_clock_.CurrentTime());
+
+  // Packets sent after a renegotiation use another extension map.
+  RtpHeaderExtensionMap new_extensions;
+  new_extensions.Register<AbsoluteSendTime>(/*id=*/1);
+  packet = std::make_unique<RtpPacketToSend>(&new_extensions);
+  packet->SetSequenceNumber(To16u(kStartSeqNum + 1));
+  packet->SetExtension<AbsoluteSendTime>(5678);
+  packet->set_allow_retransmission(true);
+  hist_.PutRtpPacket(std::move(packet),
+                     /*send_time=*/fake_clock_.CurrentTime());
+
+  std::unique_ptr<RtpPacketToSend> packet_out =
+      hist_.GetPacketAndMarkAsPending(kStartSeqNum);
+  ASSERT_TRUE(packet_out);
+  EXPECT_EQ(packet_out->Buffer(), buffer);
+  EXPECT_EQ(packet_out->GetExtension<TransmissionOffset>(), 1234);
+  EXPECT_EQ(packet_out->packet_type(), RtpPacketMediaType::kVideo);
+  EXPECT_TRUE(packet_out->is_first_packet_of_frame());
+  EXPECT_TRUE(packet_out->is_key_frame());
+  EXPECT_EQ(packet_out->capture_time(), Timestamp::Millis(42));
+
+  packet_out = hist_.GetPacketAndMarkAsPending(To16u(kStartSeqNum + 1));
+  ASSERT_TRUE(packet_out);
+  EXPECT_FALSE(packet_out->HasExtension<TransmissionOffset>());
+  EXPECT_EQ(packet_out->GetExtension<AbsoluteSendTime>(), 5678u);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     WithAndWithoutPaddingPrio,
     RtpPacketHistoryTest,
@@ -712,4 +757,80 @@ TEST(RtpPacketHistoryRecentLargePacketMode,
       Pointee(Property(&RtpPacketToSend::SequenceNumber, sequence_number)));
 }
 
+TEST(RtpPacketHistoryByteLimit, RemovesOldestPacketsWhenLimitIsReached) {
+  constexpr size_t kPayloadSize = 1000;
+  constexpr size_t kMaxPacketsStored = 10;
+  SimulatedClock fake_clock(1234);
+  // The limit includes a small header per stored packet.
+  RtpPacketHistory history(&fake_clock, RtpPacketHistory::PaddingMode::kDefault,
+                           /*max_stored_bytes=*/kMaxPacketsStored *
+                               (kPayloadSize + 100));
+  history.SetStorePacketsStatus(StorageMode::kStoreAndCull, 100);
+  for (uint16_t seq = 0; seq < 3 * kMaxPacketsStored; ++seq) {
+    std::unique_ptr<RtpPacketToSend> packet = CreatePacket(seq);
+    packet->SetPayloadSize(kPayloadSize);
+    history.PutRtpPacket(std::move(packet),
+                         /*send_time=*/fake_clock.CurrentTime());
+    fake_clock.AdvanceTimeMilliseconds(1);
+  }
+
+  EXPECT_FALSE(history.GetPacketState(2 * kMaxPacketsStored - 1));
+  for (uint16_t seq = 2 * kMaxPacketsStored; seq < 3 * kMaxPacketsStored;
+       ++seq) {
+    EXPECT_THAT(history.GetPacketAndMarkAsPending(seq),
+                Pointee(Property(&RtpPacketToSend::payload_size,
+                                 kPayloadSize)));
+  }
+}
+
+TEST(RtpPacketHistoryByteLimit, DoesNotRemovePacketsPendingTransmission) {
+  constexpr size_t kPayloadSize = 1000;
+  constexpr size_t kMaxPacketsStored = 10;
+  SimulatedClock fake_clock(1234);
+  RtpPacketHistory history(&fake_clock, RtpPacketHistory::PaddingMode::kDefault,
+                           /*max_stored_bytes=*/kMaxPacketsStored *
+                               (kPayloadSize + 100));
+  history.SetStorePacketsStatus(StorageMode::kStoreAndCull, 100);
+  uint16_t seq = 0;
+  for (; seq < kMaxPacketsStored; ++seq) {
+    std::unique_ptr<RtpPacketToSend> packet = CreatePacket(seq);
+    packet->SetPayloadSize(kPayloadSize);
+    history.PutRtpPacket(std::move(packet),
+                         /*send_time=*/fake_clock.CurrentTime());
+    fake_clock.AdvanceTimeMilliseconds(1);
+  }
+  // The oldest packet is queued for retransmission.
+  ASSERT_TRUE(history.GetPacketAndMarkAsPending(0));
+
+  // The history is full, and the packet at its head can't be removed, so the
+  // new packet is not stored.
+  std::unique_ptr<RtpPacketToSend> packet = CreatePacket(seq);
+  packet->SetPayloadSize(kPayloadSize);
+  history.PutRtpPacket(std::move(packet),
+                       /*send_time=*/fake_clock.CurrentTime());
+  EXPECT_TRUE(history.GetPacketState(0));
+  EXPECT_FALSE(history.GetPacketState(seq));
+
+  // Once sent, the packet can be removed to make room.
+  history.MarkPacketAsSent(0);
+  packet = CreatePacket(++seq);
+  packet->SetPayloadSize(kPayloadSize);
+  history.PutRtpPacket(std::move(packet),
+                       /*send_time=*/fake_clock.CurrentTime());
+  EXPECT_FALSE(history.GetPacketState(0));
+  EXPECT_TRUE(history.GetPacketState(seq));
+}
+
+TEST(RtpPacketHistoryByteLimit, DoesNotStorePacketLargerThanLimit) {
+  SimulatedClock fake_clock(1234);
+  RtpPacketHistory history(&fake_clock, RtpPacketHistory::PaddingMode::kDefault,
+                           /*max_stored_bytes=*/500);
+  history.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+  std::unique_ptr<RtpPacketToSend> packet = CreatePacket(kStartSeqNum);
+  packet->SetPayloadSize(1000);
+  history.PutRtpPacket(std::move(packet),
+                       /*send_time=*/fake_clock.CurrentTime());
+  EXPECT_FALSE(history.GetPacketState(kStartSeqNum));
+}
+
 }  // namespace webrtc
@@ -524,6 +524,31 @@ TEST(RtpPacketTest, ParseWithExtension) {
   EXPECT_EQ(0u, packet.padding_size());
 }
 
+TEST(RtpPacketTest, ParseForgetsExtensionsOfPreviousPacket) {
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+
+  RtpPacketReceived packet(&extensions);
+  ASSERT_TRUE(packet.Parse(kPacketWithTO, sizeof(kPacketWithTO)));
+  EXPECT_TRUE(packet.HasExtension<TransmissionOffset>());
+
+  ASSERT_TRUE(packet.Parse(kMinimumPacket, sizeof(kMinimumPacket)));
+  EXPECT_FALSE(packet.HasExtension<TransmissionOffset>());
+  EXPECT_FALSE(packet.HasExtension(kRtpExtensionTransmissionTimeOffset));
+  EXPECT_FALSE(packet.GetExtension<TransmissionOffset>());
+}
+
+TEST(RtpPacketTest, CopyHeaderFromKeepsExtensions) {
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  RtpPacketReceived packet(&extensions);
+  ASSERT_TRUE(packet.Parse(kPacketWithTO, sizeof(kPacketWithTO)));
+
+  RtpPacketToSend copy(nullptr);
+  copy.CopyHeaderFrom(packet);
+  EXPECT_EQ(copy.GetExtension<TransmissionOffset>(), kTimeOffset);
+}
+
 TEST(RtpPacketTest, ParseHeaderOnly) {
   // clang-format off
   constexpr uint8_t kPaddingHeader[] = {
@@ -45,7 +45,9 @@ constexpr TimeDelta kDefaultExpectedRetransmissionTime = TimeDelta::Millis(125);
 ModuleRtpRtcpImpl::RtpSenderContext::RtpSenderContext(
     const RtpRtcpInterface::Configuration& config)
     : packet_history(config.clock,
-                     RtpPacketHistory::PaddingMode::kRecentLargePacket),
+                     RtpPacketHistory::PaddingMode::kRecentLargePacket,
+                     config.max_packet_history_bytes.value_or(
+                         RtpPacketHistory::kDefaultMaxStoredBytes)),
       sequencer_(config.local_media_ssrc,
                  config.rtx_send_ssrc,
                  /*require_marker_before_media_padding=*/!config.audio,
@@ -57,7 +57,9 @@ ModuleRtpRtcpImpl2::RtpSenderContext::RtpSenderContext(
     TaskQueueBase& worker_queue,
     const RtpRtcpInterface::Configuration& config)
     : packet_history(config.clock,
-                     RtpPacketHistory::PaddingMode::kRecentLargePacket),
+                     RtpPacketHistory::PaddingMode::kRecentLargePacket,
+                     config.max_packet_history_bytes.value_or(
+                         RtpPacketHistory::kDefaultMaxStoredBytes)),
       sequencer(config.local_media_ssrc,
                 config.rtx_send_ssrc,
                 /*require_marker_before_media_padding=*/!config.audio,
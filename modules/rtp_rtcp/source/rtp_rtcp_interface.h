@@ -149,6 +149,11 @@ class RtpRtcpInterface : public RtcpFeedbackSenderInterface {
 
     // Enables send packet batching from the egress RTP sender.
     bool enable_send_packet_batching = false;
+
+    // If set, caps the bytes of sent packets kept for retransmission and
+    // payload padding. Older packets are dropped from the history to stay
+    // within the cap.
+    absl::optional<size_t> max_packet_history_bytes;
   };
 
   // Stats for RTCP sender reports (SR) for a specific SSRC.
@@ -298,8 +298,7 @@ void RtpSenderEgress::CompleteSendPacket(const Packet& compound_packet,
   // Put packet in retransmission history or update pending status even if
   // actual sending fails.
   if (is_media && packet->allow_retransmission()) {
-    packet_history_->PutRtpPacket(std::make_unique<RtpPacketToSend>(*packet),
-                                  now);
+    packet_history_->PutRtpPacket(*packet, now);
   } else if (packet->retransmitted_sequence_number()) {
     packet_history_->MarkPacketAsSent(*packet->retransmitted_sequence_number());
   }
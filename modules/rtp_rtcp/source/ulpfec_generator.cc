@@ -165,6 +165,11 @@ void UlpfecGenerator::AddPacketAndGenerateFec(const RtpPacketToSend& packet) {
   }
 }
 
+void UlpfecGenerator::SetEncodingPool(FecEncodingPool* pool) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  fec_->SetEncodingPool(pool);
+}
+
 bool UlpfecGenerator::ExcessOverheadBelowMax() const {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
 
@@ -27,6 +27,7 @@
 
 namespace webrtc {
 
+class FecEncodingPool;
 class FlexfecSender;
 
 class UlpfecGenerator : public VideoFecGenerator {
@@ -49,6 +50,10 @@ class UlpfecGenerator : public VideoFecGenerator {
   // These FEC packets are then obtained by calling GetFecPacketsAsRed().
   void AddPacketAndGenerateFec(const RtpPacketToSend& packet) override;
 
+  // Generates the FEC packets of large frames on the threads of `pool`, unless
+  // null. The pool must outlive this object.
+  void SetEncodingPool(FecEncodingPool* pool);
+
   // Returns the overhead, per packet, for FEC (and possibly RED).
   size_t MaxPacketOverhead() const override;
 
@@ -36,12 +36,17 @@ void TaskQueueTimeoutFactory::TaskQueueTimeout::Start(DurationMs duration_ms,
   timeout_expiration_ = parent_.Now() + duration_ms.ToTimeDelta();
   timeout_id_ = timeout_id;
 
-  if (timeout_expiration_ >= posted_task_expiration_) {
+  const TimeDelta slack =
+      precision_ == webrtc::TaskQueueBase::DelayPrecision::kLow
+          ? parent_.low_precision_slack_
+          : TimeDelta::Zero();
+  if (timeout_expiration_ + slack >= posted_task_expiration_) {
     // There is already a running task, and it's scheduled to expire sooner than
-    // the new expiration time. Don't do anything; The `timeout_expiration_` has
-    // already been updated and if the delayed task _does_ expire and the timer
-    // hasn't been stopped, that will be noticed in the timeout handler, and the
-    // task will be re-scheduled. Most timers are stopped before they expire.
+    // the new expiration time, or late by no more than the allowed slack.
+    // Don't do anything; The `timeout_expiration_` has already been updated
+    // and if the delayed task _does_ expire and the timer hasn't been stopped,
+    // that will be noticed in the timeout handler, and the task will be
+    // re-scheduled. Most timers are stopped before they expire.
     return;
   }
 
@@ -58,8 +63,11 @@ void TaskQueueTimeoutFactory::TaskQueueTimeout::Start(DurationMs duration_ms,
   }
 
   posted_task_expiration_ = timeout_expiration_;
+  // The slack takes the place of the leeway of low precision tasks. Posting
+  // with low precision as well could make the timeout expire late by both.
   parent_.task_queue_.PostDelayedTaskWithPrecision(
-      precision_,
+      slack.IsZero() ? precision_
+                     : webrtc::TaskQueueBase::DelayPrecision::kHigh,
       webrtc::SafeTask(
           pending_task_safety_flag_,
           [timeout_id, this]() {
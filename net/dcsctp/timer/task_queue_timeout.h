@@ -15,6 +15,7 @@
 
 #include "api/task_queue/pending_task_safety_flag.h"
 #include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "net/dcsctp/public/timeout.h"
 
@@ -38,12 +39,23 @@ class TaskQueueTimeoutFactory {
   // epoch. Whenever a timeout expires, the `on_expired` callback will be
   // triggered, and then the client should provided `timeout_id` to
   // `DcSctpSocketInterface::HandleTimeout`.
-  TaskQueueTimeoutFactory(webrtc::TaskQueueBase& task_queue,
-                          std::function<TimeMs()> get_time,
-                          std::function<void(TimeoutID timeout_id)> on_expired)
+  //
+  // Timeouts with low precision may expire up to `low_precision_slack` late.
+  // When such a timeout is restarted with a shorter duration, an already
+  // posted delayed task that expires within the slack is reused instead of
+  // posting a new one, which saves task queue churn for the many timers that
+  // are restarted often and mostly stopped before they expire. With a
+  // non-zero slack their delayed tasks are posted with high precision, so
+  // that the task queue's own low precision leeway doesn't add to the slack.
+  TaskQueueTimeoutFactory(
+      webrtc::TaskQueueBase& task_queue,
+      std::function<TimeMs()> get_time,
+      std::function<void(TimeoutID timeout_id)> on_expired,
+      webrtc::TimeDelta low_precision_slack = webrtc::TimeDelta::Zero())
       : task_queue_(task_queue),
         get_time_(std::move(get_time)),
-        on_expired_(std::move(on_expired)) {}
+        on_expired_(std::move(on_expired)),
+        low_precision_slack_(low_precision_slack) {}
 
   // Creates an implementation of `Timeout`.
   std::unique_ptr<Timeout> CreateTimeout(
@@ -90,6 +102,7 @@ class TaskQueueTimeoutFactory {
   webrtc::TaskQueueBase& task_queue_;
   const std::function<TimeMs()> get_time_;
   const std::function<void(TimeoutID)> on_expired_;
+  const webrtc::TimeDelta low_precision_slack_;
 };
 }  // namespace dcsctp
 
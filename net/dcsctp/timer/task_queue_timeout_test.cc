@@ -117,6 +117,53 @@ TEST_F(TaskQueueTimeoutTest, KilledBeforeExpired) {
   AdvanceTime(DurationMs(1000));
 }
 
+TEST_F(TaskQueueTimeoutTest, LowPrecisionRestartReusesTaskWithinSlack) {
+  TaskQueueTimeoutFactory factory(
+      *task_queue_,
+      [this]() {
+        return TimeMs(time_controller_.GetClock()->CurrentTime().ms());
+      },
+      on_expired_.AsStdFunction(), webrtc::TimeDelta::Millis(20));
+  std::unique_ptr<Timeout> timeout = factory.CreateTimeout();
+  timeout->Start(DurationMs(1000), TimeoutID(1));
+
+  EXPECT_CALL(on_expired_, Call).Times(0);
+  AdvanceTime(DurationMs(500));
+
+  // Expires 10 ms before the already posted task, which is within the slack.
+  timeout->Restart(DurationMs(490), TimeoutID(2));
+
+  AdvanceTime(DurationMs(499));
+
+  EXPECT_CALL(on_expired_, Call(TimeoutID(2)));
+  AdvanceTime(DurationMs(1));
+}
+
+TEST_F(TaskQueueTimeoutTest, HighPrecisionRestartIgnoresSlack) {
+  TaskQueueTimeoutFactory factory(
+      *task_queue_,
+      [this]() {
+        return TimeMs(time_controller_.GetClock()->CurrentTime().ms());
+      },
+      on_expired_.AsStdFunction(), webrtc::TimeDelta::Millis(20));
+  std::unique_ptr<Timeout> timeout =
+      factory.CreateTimeout(webrtc::TaskQueueBase::DelayPrecision::kHigh);
+  timeout->Start(DurationMs(1000), TimeoutID(1));
+
+  EXPECT_CALL(on_expired_, Call).Times(0);
+  AdvanceTime(DurationMs(500));
+
+  timeout->Restart(DurationMs(490), TimeoutID(2));
+
+  AdvanceTime(DurationMs(489));
+
+  EXPECT_CALL(on_expired_, Call(TimeoutID(2)));
+  AdvanceTime(DurationMs(1));
+
+  EXPECT_CALL(on_expired_, Call).Times(0);
+  AdvanceTime(DurationMs(1000));
+}
+
 TEST(TaskQueueTimeoutWithMockTaskQueueTest, CanSetTimeoutPrecisionToLow) {
   NiceMock<webrtc::MockTaskQueueBase> mock_task_queue;
   EXPECT_CALL(
@@ -135,6 +182,25 @@ TEST(TaskQueueTimeoutWithMockTaskQueueTest, CanSetTimeoutPrecisionToLow) {
   timeout->Start(DurationMs(1), TimeoutID(1));
 }
 
+TEST(TaskQueueTimeoutWithMockTaskQueueTest,
+     LowPrecisionTimeoutWithSlackIsPostedWithHighPrecision) {
+  NiceMock<webrtc::MockTaskQueueBase> mock_task_queue;
+  EXPECT_CALL(
+      mock_task_queue,
+      PostDelayedTaskImpl(
+          _, _,
+          Field(
+              &webrtc::MockTaskQueueBase::PostDelayedTaskTraits::high_precision,
+              true),
+          _));
+  TaskQueueTimeoutFactory factory(
+      mock_task_queue, []() { return TimeMs(1337); },
+      [](TimeoutID timeout_id) {}, webrtc::TimeDelta::Millis(16));
+  std::unique_ptr<Timeout> timeout =
+      factory.CreateTimeout(webrtc::TaskQueueBase::DelayPrecision::kLow);
+  timeout->Start(DurationMs(1), TimeoutID(1));
+}
+
 TEST(TaskQueueTimeoutWithMockTaskQueueTest, CanSetTimeoutPrecisionToHigh) {
   NiceMock<webrtc::MockTaskQueueBase> mock_task_queue;
   EXPECT_CALL(
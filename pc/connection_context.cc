@@ -10,6 +10,7 @@
 
 #include "pc/connection_context.h"
 
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -19,7 +20,9 @@
 #include "media/sctp/sctp_transport_factory.h"
 #include "pc/media_factory.h"
 #include "rtc_base/crypto_random.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/internal/default_socket_server.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/socket_server.h"
 #include "rtc_base/time_utils.h"
 
@@ -79,8 +82,47 @@ std::unique_ptr<SctpTransportFactoryInterface> MaybeCreateSctpFactory(
 rtc::scoped_refptr<ConnectionContext> ConnectionContext::Create(
     const Environment& env,
     PeerConnectionFactoryDependencies* dependencies) {
-  return rtc::scoped_refptr<ConnectionContext>(
+  // Additional network threads need their own socket server and objects bound
+  // to it, which can't be derived from injected ones.
+  const bool can_pool_network_threads =
+      dependencies->network_thread == nullptr &&
+      dependencies->socket_factory == nullptr &&
+      dependencies->network_manager == nullptr &&
+      dependencies->packet_socket_factory == nullptr &&
+      dependencies->sctp_factory == nullptr;
+  FieldTrialConstrained<int> network_threads("threads", 1, 1, 64);
+  ParseFieldTrial({&network_threads},
+                  env.field_trials().Lookup("WebRTC-PcNetworkThreadPool"));
+
+  auto context = rtc::scoped_refptr<ConnectionContext>(
       new ConnectionContext(env, dependencies));
+  if (network_threads.Get() > 1) {
+    if (can_pool_network_threads) {
+      context->StartNetworkThreadPool(network_threads.Get());
+    } else {
+      RTC_LOG(LS_WARNING) << "Network thread pool disabled: the network "
+                             "thread or objects bound to it are injected.";
+    }
+  }
+  return context;
+}
+
+ConnectionContext::NetworkThreadLease::NetworkThreadLease(
+    ConnectionContext* context,
+    size_t index,
+    const NetworkShard& shard)
+    : context_(context), index_(index), shard_(shard) {}
+
+ConnectionContext::NetworkThreadLease::NetworkThreadLease(
+    NetworkThreadLease&& other)
+    : context_(std::exchange(other.context_, nullptr)),
+      index_(other.index_),
+      shard_(other.shard_) {}
+
+ConnectionContext::NetworkThreadLease::~NetworkThreadLease() {
+  if (context_) {
+    context_->ReleaseNetworkThread(index_);
+  }
 }
 
 ConnectionContext::ConnectionContext(
@@ -169,6 +211,12 @@ ConnectionContext::ConnectionContext(
   worker_thread_->SetDispatchWarningMs(30);
   network_thread_->SetDispatchWarningMs(10);
 
+  network_shards_.push_back({.thread = network_thread_,
+                             .network_manager = default_network_manager_.get(),
+                             .socket_factory = default_socket_factory_.get(),
+                             .sctp_factory = sctp_factory_.get()});
+  network_thread_stats_.emplace_back();
+
   if (media_engine_) {
     // TODO(tommi): Change VoiceEngine to do ctor time initialization so that
     // this isn't necessary.
@@ -182,7 +230,10 @@ ConnectionContext::~ConnectionContext() {
   worker_thread_->PostTask([media_engine = std::move(media_engine_)] {});
 
   // Make sure `worker_thread()` and `signaling_thread()` outlive
-  // `default_socket_factory_` and `default_network_manager_`.
+  // `default_socket_factory_` and `default_network_manager_`. The objects of
+  // pooled network threads are destroyed before the threads are stopped.
+  network_shards_.clear();
+  pooled_network_threads_.clear();
   default_socket_factory_ = nullptr;
   default_network_manager_ = nullptr;
 
@@ -190,4 +241,70 @@ ConnectionContext::~ConnectionContext() {
     rtc::ThreadManager::Instance()->UnwrapCurrentThread();
 }
 
+ConnectionContext::NetworkThreadLease ConnectionContext::AcquireNetworkThread(
+    bool primary_only) {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  size_t index = 0;
+  if (!primary_only) {
+    for (size_t i = 1; i < network_shards_.size(); ++i) {
+      if (network_thread_stats_[i].peer_connections <
+          network_thread_stats_[index].peer_connections) {
+        index = i;
+      }
+    }
+  }
+  ++network_thread_stats_[index].peer_connections;
+  ++network_thread_stats_[index].total_peer_connections;
+  return NetworkThreadLease(this, index, network_shards_[index]);
+}
+
+std::vector<ConnectionContext::NetworkThreadStats>
+ConnectionContext::GetNetworkThreadStats() const {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  return network_thread_stats_;
+}
+
+void ConnectionContext::StartNetworkThreadPool(int num_threads) {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  RTC_DCHECK_EQ(network_shards_.size(), 1u);
+  pooled_network_threads_.reserve(num_threads - 1);
+  for (int i = 1; i < num_threads; ++i) {
+    PooledNetworkThread& pooled = pooled_network_threads_.emplace_back();
+    pooled.socket_server = rtc::CreateDefaultSocketServer();
+    pooled.thread = std::make_unique<rtc::Thread>(pooled.socket_server.get());
+    pooled.thread->SetName("pc_network_thread_" + std::to_string(i), nullptr);
+    pooled.thread->Start();
+
+    rtc::Thread* thread = pooled.thread.get();
+    signaling_thread_->AllowInvokesToThread(thread);
+    worker_thread_->AllowInvokesToThread(thread);
+    thread->PostTask([thread] {
+      thread->DisallowBlockingCalls();
+      thread->DisallowAllInvokes();
+    });
+    thread->SetDispatchWarningMs(10);
+
+    pooled.network_manager = std::make_unique<rtc::BasicNetworkManager>(
+        network_monitor_factory_.get(), pooled.socket_server.get(),
+        &env_.field_trials());
+    pooled.socket_factory = std::make_unique<rtc::BasicPacketSocketFactory>(
+        pooled.socket_server.get());
+    pooled.sctp_factory = MaybeCreateSctpFactory(nullptr, thread);
+
+    network_shards_.push_back(
+        {.thread = thread,
+         .network_manager = pooled.network_manager.get(),
+         .socket_factory = pooled.socket_factory.get(),
+         .sctp_factory = pooled.sctp_factory.get()});
+    network_thread_stats_.emplace_back();
+  }
+}
+
+void ConnectionContext::ReleaseNetworkThread(size_t index) {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  RTC_DCHECK_LT(index, network_thread_stats_.size());
+  RTC_DCHECK_GT(network_thread_stats_[index].peer_connections, 0);
+  --network_thread_stats_[index].peer_connections;
+}
+
 }  // namespace webrtc
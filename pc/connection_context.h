@@ -11,8 +11,12 @@
 #ifndef PC_CONNECTION_CONTEXT_H_
 #define PC_CONNECTION_CONTEXT_H_
 
+#include <stddef.h>
+
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "api/environment/environment.h"
 #include "api/media_stream_interface.h"
@@ -28,6 +32,7 @@
 #include "rtc_base/network_monitor_factory.h"
 #include "rtc_base/rtc_certificate_generator.h"
 #include "rtc_base/socket_factory.h"
+#include "rtc_base/socket_server.h"
 #include "rtc_base/thread.h"
 #include "rtc_base/thread_annotations.h"
 
@@ -44,8 +49,66 @@ namespace webrtc {
 // interferes with the operation of other PeerConnections.
 //
 // This class must be created and destroyed on the signaling thread.
+//
+// With the field trial "WebRTC-PcNetworkThreadPool/threads:N/", and if neither
+// the network thread nor any object bound to it is injected, the context
+// starts N network threads, each with its own socket server, network manager,
+// packet socket factory and SCTP transport factory. Every PeerConnection is
+// then assigned to one of these threads for its whole lifetime, so that all
+// its ICE, DTLS, SRTP and SCTP work runs on that thread.
 class ConnectionContext final : public RefCountedNonVirtual<ConnectionContext> {
  public:
+  // Load of one network thread.
+  struct NetworkThreadStats {
+    // PeerConnections currently assigned to the thread.
+    int peer_connections = 0;
+    // PeerConnections ever assigned to the thread.
+    int64_t total_peer_connections = 0;
+  };
+
+  // A network thread and the objects bound to it.
+  struct NetworkShard {
+    rtc::Thread* thread = nullptr;
+    rtc::NetworkManager* network_manager = nullptr;
+    rtc::PacketSocketFactory* socket_factory = nullptr;
+    SctpTransportFactoryInterface* sctp_factory = nullptr;
+  };
+
+  // Assignment of a PeerConnection to a network thread, and the objects that
+  // must be used on that thread. The assignment ends when the lease is
+  // destroyed, which must happen on the signaling thread while the context is
+  // alive.
+  class NetworkThreadLease {
+   public:
+    NetworkThreadLease(NetworkThreadLease&& other);
+    NetworkThreadLease(const NetworkThreadLease&) = delete;
+    NetworkThreadLease& operator=(const NetworkThreadLease&) = delete;
+    NetworkThreadLease& operator=(NetworkThreadLease&&) = delete;
+    ~NetworkThreadLease();
+
+    rtc::Thread* thread() const { return shard_.thread; }
+    rtc::NetworkManager* network_manager() const {
+      return shard_.network_manager;
+    }
+    rtc::PacketSocketFactory* socket_factory() const {
+      return shard_.socket_factory;
+    }
+    SctpTransportFactoryInterface* sctp_transport_factory() const {
+      return shard_.sctp_factory;
+    }
+
+   private:
+    friend class ConnectionContext;
+    NetworkThreadLease(ConnectionContext* context,
+                       size_t index,
+                       const NetworkShard& shard);
+
+    // Null once moved from.
+    ConnectionContext* context_;
+    const size_t index_;
+    const NetworkShard shard_;
+  };
+
   // Creates a ConnectionContext. May return null if initialization fails.
   // The Dependencies class allows simple management of all new dependencies
   // being added to the ConnectionContext.
@@ -91,6 +154,13 @@ class ConnectionContext final : public RefCountedNonVirtual<ConnectionContext> {
     RTC_DCHECK_RUN_ON(worker_thread());
     return call_factory_.get();
   }
+  // Assigns a PeerConnection to the network thread with the fewest
+  // PeerConnections, or to network_thread() if `primary_only` is set, e.g.
+  // because the PeerConnection uses an injected port allocator.
+  NetworkThreadLease AcquireNetworkThread(bool primary_only);
+  // Load of each network thread, network_thread() first.
+  std::vector<NetworkThreadStats> GetNetworkThreadStats() const;
+
   rtc::UniqueRandomIdGenerator* ssrc_generator() { return &ssrc_generator_; }
   // Note: There is lots of code that wants to know whether or not we
   // use RTX, but so far, no code has been found that sets it to false.
@@ -109,6 +179,20 @@ class ConnectionContext final : public RefCountedNonVirtual<ConnectionContext> {
   ~ConnectionContext();
 
  private:
+  // Owns the objects of a network thread started for the pool, in order of
+  // construction.
+  struct PooledNetworkThread {
+    std::unique_ptr<rtc::SocketServer> socket_server;
+    std::unique_ptr<rtc::Thread> thread;
+    std::unique_ptr<rtc::NetworkManager> network_manager;
+    std::unique_ptr<rtc::PacketSocketFactory> socket_factory;
+    std::unique_ptr<SctpTransportFactoryInterface> sctp_factory;
+  };
+
+  // Starts `num_threads` - 1 network threads in addition to network_thread().
+  void StartNetworkThreadPool(int num_threads);
+  void ReleaseNetworkThread(size_t index);
+
   // The following three variables are used to communicate between the
   // constructor and the destructor, and are never exposed externally.
   bool wraps_current_thread_;
@@ -141,6 +225,14 @@ class ConnectionContext final : public RefCountedNonVirtual<ConnectionContext> {
       RTC_GUARDED_BY(signaling_thread_);
   std::unique_ptr<SctpTransportFactoryInterface> const sctp_factory_;
 
+  // Additional network threads, and all network threads including
+  // network_thread() as the first one.
+  std::vector<PooledNetworkThread> pooled_network_threads_
+      RTC_GUARDED_BY(signaling_thread_);
+  std::vector<NetworkShard> network_shards_ RTC_GUARDED_BY(signaling_thread_);
+  std::vector<NetworkThreadStats> network_thread_stats_
+      RTC_GUARDED_BY(signaling_thread_);
+
   // Controls whether to announce support for the the rfc4588 payload format
   // for retransmitted video packets.
   bool use_rtx_;
@@ -113,6 +113,7 @@ class PeerConnection : public PeerConnectionInternal,
   static RTCErrorOr<rtc::scoped_refptr<PeerConnection>> Create(
       const Environment& env,
       rtc::scoped_refptr<ConnectionContext> context,
+      ConnectionContext::NetworkThreadLease network_thread_lease,
       const PeerConnectionFactoryInterface::Options& options,
       std::unique_ptr<Call> call,
       const PeerConnectionInterface::RTCConfiguration& configuration,
@@ -263,7 +264,7 @@ class PeerConnection : public PeerConnectionInternal,
   }
 
   rtc::Thread* network_thread() const final {
-    return context_->network_thread();
+    return network_thread_lease_.thread();
   }
   rtc::Thread* worker_thread() const final { return context_->worker_thread(); }
 
@@ -453,6 +454,7 @@ class PeerConnection : public PeerConnectionInternal,
   // Available for rtc::scoped_refptr creation
   PeerConnection(const Environment& env,
                  rtc::scoped_refptr<ConnectionContext> context,
+                 ConnectionContext::NetworkThreadLease network_thread_lease,
                  const PeerConnectionFactoryInterface::Options& options,
                  bool is_unified_plan,
                  std::unique_ptr<Call> call,
@@ -609,6 +611,8 @@ class PeerConnection : public PeerConnectionInternal,
 
   const Environment env_;
   const rtc::scoped_refptr<ConnectionContext> context_;
+  // The network thread this PeerConnection runs on, one of the context's.
+  const ConnectionContext::NetworkThreadLease network_thread_lease_;
   const PeerConnectionFactoryInterface::Options options_;
   PeerConnectionObserver* observer_ RTC_GUARDED_BY(signaling_thread()) =
       nullptr;
@@ -230,17 +230,23 @@ PeerConnectionFactory::CreatePeerConnectionOrError(
 
   const Environment env = env_factory.Create();
 
+  // An injected port allocator is bound to the primary network thread.
+  ConnectionContext::NetworkThreadLease network_thread_lease =
+      context_->AcquireNetworkThread(
+          /*primary_only=*/dependencies.allocator != nullptr);
+  rtc::Thread* const pc_network_thread = network_thread_lease.thread();
+
   // Set internal defaults if optional dependencies are not set.
   if (!dependencies.cert_generator) {
     dependencies.cert_generator =
         std::make_unique<rtc::RTCCertificateGenerator>(signaling_thread(),
-                                                       network_thread());
+                                                       pc_network_thread);
   }
   if (!dependencies.allocator) {
     dependencies.allocator = std::make_unique<cricket::BasicPortAllocator>(
-        context_->default_network_manager(), context_->default_socket_factory(),
-        configuration.turn_customizer, /*relay_port_factory=*/nullptr,
-        &env.field_trials());
+        network_thread_lease.network_manager(),
+        network_thread_lease.socket_factory(), configuration.turn_customizer,
+        /*relay_port_factory=*/nullptr, &env.field_trials());
     dependencies.allocator->SetPortRange(
         configuration.port_allocator_config.min_port,
         configuration.port_allocator_config.max_port);
@@ -256,13 +262,14 @@ PeerConnectionFactory::CreatePeerConnectionOrError(
   dependencies.allocator->SetNetworkIgnoreMask(options().network_ignore_mask);
   dependencies.allocator->SetVpnList(configuration.vpn_list);
 
-  std::unique_ptr<Call> call =
-      worker_thread()->BlockingCall([this, &env, &configuration] {
-        return CreateCall_w(env, configuration);
+  std::unique_ptr<Call> call = worker_thread()->BlockingCall(
+      [this, &env, &configuration, pc_network_thread] {
+        return CreateCall_w(env, configuration, pc_network_thread);
       });
 
-  auto result = PeerConnection::Create(env, context_, options_, std::move(call),
-                                       configuration, std::move(dependencies));
+  auto result = PeerConnection::Create(
+      env, context_, std::move(network_thread_lease), options_, std::move(call),
+      configuration, std::move(dependencies));
   if (!result.ok()) {
     return result.MoveError();
   }
@@ -273,7 +280,7 @@ PeerConnectionFactory::CreatePeerConnectionOrError(
   // worker_thread()).  All such methods have thread checks though, so the code
   // should still be clear (outside of macro expansion).
   rtc::scoped_refptr<PeerConnectionInterface> result_proxy =
-      PeerConnectionProxy::Create(signaling_thread(), network_thread(),
+      PeerConnectionProxy::Create(signaling_thread(), pc_network_thread,
                                   result.MoveValue());
   return result_proxy;
 }
@@ -305,10 +312,11 @@ rtc::scoped_refptr<AudioTrackInterface> PeerConnectionFactory::CreateAudioTrack(
 
 std::unique_ptr<Call> PeerConnectionFactory::CreateCall_w(
     const Environment& env,
-    const PeerConnectionInterface::RTCConfiguration& configuration) {
+    const PeerConnectionInterface::RTCConfiguration& configuration,
+    rtc::Thread* network_thread) {
   RTC_DCHECK_RUN_ON(worker_thread());
 
-  CallConfig call_config(env, network_thread());
+  CallConfig call_config(env, network_thread);
   if (!media_engine() || !context_->call_factory()) {
     return nullptr;
   }
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "api/audio_options.h"
@@ -95,6 +96,13 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
     return context_->sctp_transport_factory();
   }
 
+  // Load of each network thread PeerConnections are assigned to.
+  std::vector<ConnectionContext::NetworkThreadStats> GetNetworkThreadStats()
+      const {
+    RTC_DCHECK_RUN_ON(signaling_thread());
+    return context_->GetNetworkThreadStats();
+  }
+
   rtc::Thread* signaling_thread() const {
     // This method can be called on a different thread when the factory is
     // created in CreatePeerConnectionFactory().
@@ -127,13 +135,12 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   virtual ~PeerConnectionFactory();
 
  private:
-  rtc::Thread* network_thread() const { return context_->network_thread(); }
-
   bool IsTrialEnabled(absl::string_view key) const;
 
   std::unique_ptr<Call> CreateCall_w(
       const Environment& env,
-      const PeerConnectionInterface::RTCConfiguration& configuration);
+      const PeerConnectionInterface::RTCConfiguration& configuration,
+      rtc::Thread* network_thread);
 
   rtc::scoped_refptr<ConnectionContext> context_;
   PeerConnectionFactoryInterface::Options options_
@@ -720,5 +720,60 @@ TEST(PeerConnectionFactoryDependenciesTest, UsesPacketSocketFactory) {
   called.Wait(kWaitTimeout);
 }
 
+TEST(PeerConnectionFactoryNetworkThreadPoolTest,
+     AssignsPeerConnectionsToLeastLoadedNetworkThread) {
+  PeerConnectionFactoryDependencies pcf_dependencies;
+  rtc::scoped_refptr<ConnectionContext> context = ConnectionContext::Create(
+      CreateEnvironment(std::make_unique<test::ScopedKeyValueConfig>(
+          "WebRTC-PcNetworkThreadPool/threads:2/")),
+      &pcf_dependencies);
+  auto pcf =
+      rtc::make_ref_counted<PeerConnectionFactory>(context, &pcf_dependencies);
+
+  PeerConnectionInterface::RTCConfiguration config;
+  NullPeerConnectionObserver observer;
+  rtc::scoped_refptr<PeerConnectionInterface> pc1 =
+      pcf->CreatePeerConnectionOrError(config,
+                                       PeerConnectionDependencies(&observer))
+          .MoveValue();
+  rtc::scoped_refptr<PeerConnectionInterface> pc2 =
+      pcf->CreatePeerConnectionOrError(config,
+                                       PeerConnectionDependencies(&observer))
+          .MoveValue();
+  ASSERT_TRUE(pc1);
+  ASSERT_TRUE(pc2);
+
+  std::vector<ConnectionContext::NetworkThreadStats> stats =
+      pcf->GetNetworkThreadStats();
+  ASSERT_EQ(stats.size(), 2u);
+  EXPECT_EQ(stats[0].peer_connections, 1);
+  EXPECT_EQ(stats[1].peer_connections, 1);
+
+  // The thread freed up by closing the first PeerConnection takes the next.
+  pc1 = nullptr;
+  rtc::scoped_refptr<PeerConnectionInterface> pc3 =
+      pcf->CreatePeerConnectionOrError(config,
+                                       PeerConnectionDependencies(&observer))
+          .MoveValue();
+  ASSERT_TRUE(pc3);
+  stats = pcf->GetNetworkThreadStats();
+  EXPECT_EQ(stats[0].peer_connections, 1);
+  EXPECT_EQ(stats[0].total_peer_connections, 2);
+  EXPECT_EQ(stats[1].peer_connections, 1);
+  EXPECT_EQ(stats[1].total_peer_connections, 1);
+}
+
+TEST(PeerConnectionFactoryNetworkThreadPoolTest,
+     UsesSingleNetworkThreadWhenNetworkThreadIsInjected) {
+  rtc::AutoThread main_thread;
+  PeerConnectionFactoryDependencies pcf_dependencies;
+  pcf_dependencies.network_thread = rtc::Thread::Current();
+  rtc::scoped_refptr<ConnectionContext> context = ConnectionContext::Create(
+      CreateEnvironment(std::make_unique<test::ScopedKeyValueConfig>(
+          "WebRTC-PcNetworkThreadPool/threads:2/")),
+      &pcf_dependencies);
+  EXPECT_EQ(context->GetNetworkThreadStats().size(), 1u);
+}
+
 }  // namespace
 }  // namespace webrtc
@@ -143,11 +143,13 @@ TaskQueueBase* GetCurrentTaskQueueOrThread() {
 }  // namespace
 
 RtpTransceiver::RtpTransceiver(cricket::MediaType media_type,
-                               ConnectionContext* context)
+                               ConnectionContext* context,
+                               rtc::Thread* network_thread)
     : thread_(GetCurrentTaskQueueOrThread()),
       unified_plan_(false),
       media_type_(media_type),
-      context_(context) {
+      context_(context),
+      network_thread_(network_thread) {
   RTC_DCHECK(media_type == cricket::MEDIA_TYPE_AUDIO ||
              media_type == cricket::MEDIA_TYPE_VIDEO);
 }
@@ -157,12 +159,14 @@ RtpTransceiver::RtpTransceiver(
     rtc::scoped_refptr<RtpReceiverProxyWithInternal<RtpReceiverInternal>>
         receiver,
     ConnectionContext* context,
+    rtc::Thread* network_thread,
     std::vector<RtpHeaderExtensionCapability> header_extensions_to_negotiate,
     std::function<void()> on_negotiation_needed)
     : thread_(GetCurrentTaskQueueOrThread()),
       unified_plan_(true),
       media_type_(sender->media_type()),
       context_(context),
+      network_thread_(network_thread),
       header_extensions_to_negotiate_(
           std::move(header_extensions_to_negotiate)),
       on_negotiation_needed_(std::move(on_negotiation_needed)) {
@@ -273,7 +277,7 @@ RTCError RtpTransceiver::CreateChannel(
           });
 
       new_channel = std::make_unique<cricket::VoiceChannel>(
-          context()->worker_thread(), context()->network_thread(),
+          context()->worker_thread(), network_thread_,
           context()->signaling_thread(), std::move(media_send_channel),
           std::move(media_receive_channel), mid, srtp_required, crypto_options,
           context()->ssrc_generator());
@@ -310,7 +314,7 @@ RTCError RtpTransceiver::CreateChannel(
           });
 
       new_channel = std::make_unique<cricket::VideoChannel>(
-          context()->worker_thread(), context()->network_thread(),
+          context()->worker_thread(), network_thread_,
           context()->signaling_thread(), std::move(media_send_channel),
           std::move(media_receive_channel), mid, srtp_required, crypto_options,
           context()->ssrc_generator());
@@ -353,7 +357,7 @@ void RtpTransceiver::SetChannel(
   // Similarly, if the channel() accessor is limited to the network thread, that
   // helps with keeping the channel implementation requirements being met and
   // avoids synchronization for accessing the pointer or network related state.
-  context()->network_thread()->BlockingCall([&]() {
+  network_thread_->BlockingCall([&]() {
     if (channel_) {
       channel_->SetFirstPacketReceivedCallback(nullptr);
       channel_->SetRtpTransport(nullptr);
@@ -389,7 +393,7 @@ void RtpTransceiver::ClearChannel() {
   }
   std::unique_ptr<cricket::ChannelInterface> channel_to_delete;
 
-  context()->network_thread()->BlockingCall([&]() {
+  network_thread_->BlockingCall([&]() {
     if (channel_) {
       channel_->SetFirstPacketReceivedCallback(nullptr);
       channel_->SetRtpTransport(nullptr);
@@ -74,7 +74,8 @@ class RtpTransceiverTest : public testing::Test {
 TEST_F(RtpTransceiverTest, CannotSetChannelOnStoppedTransceiver) {
   const std::string content_name("my_mid");
   auto transceiver = rtc::make_ref_counted<RtpTransceiver>(
-      cricket::MediaType::MEDIA_TYPE_AUDIO, context());
+      cricket::MediaType::MEDIA_TYPE_AUDIO, context(),
+      context()->network_thread());
   auto channel1 = std::make_unique<cricket::MockChannelInterface>();
   EXPECT_CALL(*channel1, media_type())
       .WillRepeatedly(Return(cricket::MediaType::MEDIA_TYPE_AUDIO));
@@ -109,7 +110,8 @@ TEST_F(RtpTransceiverTest, CannotSetChannelOnStoppedTransceiver) {
 TEST_F(RtpTransceiverTest, CanUnsetChannelOnStoppedTransceiver) {
   const std::string content_name("my_mid");
   auto transceiver = rtc::make_ref_counted<RtpTransceiver>(
-      cricket::MediaType::MEDIA_TYPE_VIDEO, context());
+      cricket::MediaType::MEDIA_TYPE_VIDEO, context(),
+      context()->network_thread());
   auto channel = std::make_unique<cricket::MockChannelInterface>();
   EXPECT_CALL(*channel, media_type())
       .WillRepeatedly(Return(cricket::MediaType::MEDIA_TYPE_VIDEO));
@@ -146,6 +148,7 @@ class RtpTransceiverUnifiedPlanTest : public RtpTransceiverTest {
                 rtc::Thread::Current(),
                 receiver_),
             context(),
+            context()->network_thread(),
             media_engine()->voice().GetRtpHeaderExtensions(),
             /* on_negotiation_needed= */ [] {})) {}
 
@@ -213,6 +216,7 @@ class RtpTransceiverTestForHeaderExtensions : public RtpTransceiverTest {
                 rtc::Thread::Current(),
                 receiver_),
             context(),
+            context()->network_thread(),
             extensions_,
             /* on_negotiation_needed= */ [] {})) {}
 
@@ -497,7 +501,7 @@ TEST_F(RtpTransceiverTestForHeaderExtensions,
           rtc::Thread::Current(), sender),
       RtpReceiverProxyWithInternal<RtpReceiverInternal>::Create(
           rtc::Thread::Current(), rtc::Thread::Current(), receiver_),
-      context(), extensions,
+      context(), context()->network_thread(), extensions,
       /* on_negotiation_needed= */ [] {});
   std::vector<webrtc::RtpHeaderExtensionCapability> header_extensions =
       transceiver->GetHeaderExtensionsToNegotiate();
@@ -518,7 +522,7 @@ TEST_F(RtpTransceiverTestForHeaderExtensions,
           rtc::Thread::Current(), simulcast_sender),
       RtpReceiverProxyWithInternal<RtpReceiverInternal>::Create(
           rtc::Thread::Current(), rtc::Thread::Current(), receiver_),
-      context(), extensions,
+      context(), context()->network_thread(), extensions,
       /* on_negotiation_needed= */ [] {});
   auto simulcast_extensions =
       simulcast_transceiver->GetHeaderExtensionsToNegotiate();
@@ -545,7 +549,7 @@ TEST_F(RtpTransceiverTestForHeaderExtensions,
           rtc::Thread::Current(), svc_sender),
       RtpReceiverProxyWithInternal<RtpReceiverInternal>::Create(
           rtc::Thread::Current(), rtc::Thread::Current(), receiver_),
-      context(), extensions,
+      context(), context()->network_thread(), extensions,
       /* on_negotiation_needed= */ [] {});
   std::vector<webrtc::RtpHeaderExtensionCapability> svc_extensions =
       svc_transceiver->GetHeaderExtensionsToNegotiate();
@@ -36,12 +36,14 @@ static const char kDefaultVideoSenderId[] = "defaultv0";
 RtpTransmissionManager::RtpTransmissionManager(
     bool is_unified_plan,
     ConnectionContext* context,
+    rtc::Thread* network_thread,
     UsagePattern* usage_pattern,
     PeerConnectionObserver* observer,
     LegacyStatsCollectorInterface* legacy_stats,
     std::function<void()> on_negotiation_needed)
     : is_unified_plan_(is_unified_plan),
       context_(context),
+      network_thread_(network_thread),
       usage_pattern_(usage_pattern),
       observer_(observer),
       legacy_stats_(legacy_stats),
@@ -300,7 +302,7 @@ RtpTransmissionManager::CreateAndAddTransceiver(
   auto transceiver = RtpTransceiverProxyWithInternal<RtpTransceiver>::Create(
       signaling_thread(),
       rtc::make_ref_counted<RtpTransceiver>(
-          sender, receiver, context_,
+          sender, receiver, context_, network_thread(),
           sender->media_type() == cricket::MEDIA_TYPE_AUDIO
               ? media_engine()->voice().GetRtpHeaderExtensions()
               : media_engine()->video().GetRtpHeaderExtensions(),
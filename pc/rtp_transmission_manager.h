@@ -72,6 +72,7 @@ class RtpTransmissionManager : public RtpSenderBase::SetStreamsObserver {
  public:
   RtpTransmissionManager(bool is_unified_plan,
                          ConnectionContext* context,
+                         rtc::Thread* network_thread,
                          UsagePattern* usage_pattern,
                          PeerConnectionObserver* observer,
                          LegacyStatsCollectorInterface* legacy_stats,
@@ -213,6 +214,7 @@ class RtpTransmissionManager : public RtpSenderBase::SetStreamsObserver {
  private:
   rtc::Thread* signaling_thread() const { return context_->signaling_thread(); }
   rtc::Thread* worker_thread() const { return context_->worker_thread(); }
+  rtc::Thread* network_thread() const { return network_thread_; }
   bool IsUnifiedPlan() const { return is_unified_plan_; }
   void NoteUsageEvent(UsageEvent event) {
     usage_pattern_->NoteUsageEvent(event);
@@ -265,6 +267,7 @@ class RtpTransmissionManager : public RtpSenderBase::SetStreamsObserver {
   bool closed_ = false;
   bool const is_unified_plan_;
   ConnectionContext* context_;
+  rtc::Thread* const network_thread_;
   UsagePattern* usage_pattern_;
   PeerConnectionObserver* observer_;
   LegacyStatsCollectorInterface* const legacy_stats_;
@@ -190,6 +190,22 @@ flat_set<uint32_t> RtpTransport::GetSsrcsForSink(RtpPacketSinkInterface* sink) {
   return rtp_demuxer_.GetSsrcsForSink(sink);
 }
 
+rtc::CopyOnWriteBuffer RtpTransport::TakeReceivedPayload(
+    const rtc::ReceivedPacket& packet) {
+  // The transport is the final consumer of the packet, so it may take over
+  // the storage of the payload.
+  rtc::CopyOnWriteBuffer payload =
+      packet.payload_storage() != nullptr
+          ? packet.payload_storage()->Take(packet.payload())
+          : rtc::CopyOnWriteBuffer(packet.payload());
+  ++receive_copy_stats_.packets_received;
+  receive_copy_stats_.bytes_received += payload.size();
+  if (payload.cdata() != packet.payload().data()) {
+    receive_copy_stats_.bytes_copied += payload.size();
+  }
+  return payload;
+}
+
 void RtpTransport::DemuxPacket(rtc::CopyOnWriteBuffer packet,
                                webrtc::Timestamp arrival_time,
                                rtc::EcnMarking ecn) {
@@ -249,16 +265,16 @@ void RtpTransport::OnSentPacket(rtc::PacketTransportInternal* packet_transport,
 
 void RtpTransport::OnRtpPacketReceived(
     const rtc::ReceivedPacket& received_packet) {
-  rtc::CopyOnWriteBuffer payload(received_packet.payload());
+  rtc::CopyOnWriteBuffer payload = TakeReceivedPayload(received_packet);
   DemuxPacket(
-      payload,
+      std::move(payload),
       received_packet.arrival_time().value_or(Timestamp::MinusInfinity()),
       received_packet.ecn());
 }
 
 void RtpTransport::OnRtcpPacketReceived(
     const rtc::ReceivedPacket& received_packet) {
-  rtc::CopyOnWriteBuffer payload(received_packet.payload());
+  rtc::CopyOnWriteBuffer payload = TakeReceivedPayload(received_packet);
   // TODO(bugs.webrtc.org/15368): Propagate timestamp and maybe received packet
   // further.
   SendRtcpPacketReceived(&payload, received_packet.arrival_time()
@@ -44,6 +44,15 @@ namespace webrtc {
 
 class RtpTransport : public RtpTransportInternal {
  public:
+  // Counts the received RTP and RTCP payload bytes that had to be copied on
+  // their way from the packet transport to the demuxer, i.e. that were not
+  // received into a buffer lent by the socket.
+  struct ReceiveCopyStats {
+    int64_t packets_received = 0;
+    int64_t bytes_received = 0;
+    int64_t bytes_copied = 0;
+  };
+
   RtpTransport(const RtpTransport&) = delete;
   RtpTransport& operator=(const RtpTransport&) = delete;
 
@@ -90,6 +99,8 @@ class RtpTransport : public RtpTransportInternal {
 
   bool UnregisterRtpDemuxerSink(RtpPacketSinkInterface* sink) override;
 
+  ReceiveCopyStats GetReceiveCopyStats() const { return receive_copy_stats_; }
+
  protected:
   // These methods will be used in the subclasses.
   void DemuxPacket(rtc::CopyOnWriteBuffer packet,
@@ -102,6 +113,10 @@ class RtpTransport : public RtpTransportInternal {
                   int flags);
   flat_set<uint32_t> GetSsrcsForSink(RtpPacketSinkInterface* sink);
 
+  // Takes the payload of `packet` over, copying it only if it isn't held by a
+  // lent buffer, and accounts for it in the receive copy stats.
+  rtc::CopyOnWriteBuffer TakeReceivedPayload(const rtc::ReceivedPacket& packet);
+
   // Overridden by SrtpTransport.
   virtual void OnNetworkRouteChanged(
       absl::optional<rtc::NetworkRoute> network_route);
@@ -141,6 +156,7 @@ class RtpTransport : public RtpTransportInternal {
   // Guard against recursive "ready to send" signals
   bool processing_ready_to_send_ = false;
   bool processing_sent_packet_ = false;
+  ReceiveCopyStats receive_copy_stats_;
   ScopedTaskSafety safety_;
 };
 
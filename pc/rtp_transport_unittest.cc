@@ -17,6 +17,7 @@
 #include "rtc_base/buffer.h"
 #include "rtc_base/containers/flat_set.h"
 #include "rtc_base/gunit.h"
+#include "rtc_base/network/received_packet.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "test/gtest.h"
 #include "test/run_loop.h"
@@ -324,6 +325,80 @@ TEST(RtpTransportTest, ReceivedPacketEcnMarkingPropagatedToDemuxedPacket) {
   transport.UnregisterRtpDemuxerSink(&observer);
 }
 
+TEST(RtpTransportTest, TakesOverReceiveStorageWithoutCopy) {
+  RtpTransport transport(kMuxDisabled);
+  rtc::FakePacketTransport fake_rtp("fake_rtp");
+  transport.SetRtpPacketTransport(&fake_rtp);
+  TransportObserver observer(&transport);
+  RtpDemuxerCriteria demuxer_criteria;
+  demuxer_criteria.payload_types().insert(0x11);
+  transport.RegisterRtpDemuxerSink(demuxer_criteria, &observer);
+
+  rtc::ReceivedPacket::PayloadStorage storage(kRtpLen);
+  storage.buffer().SetData(kRtpData, kRtpLen);
+  const uint8_t* receive_data = storage.buffer().data();
+  rtc::ReceivedPacket packet(storage.buffer(), rtc::SocketAddress());
+  packet.set_payload_storage(&storage);
+  fake_rtp.NotifyPacketReceived(packet);
+
+  ASSERT_EQ(observer.rtp_count(), 1);
+  EXPECT_EQ(observer.last_recv_rtp_packet().data(), receive_data);
+  EXPECT_EQ(storage.buffer().capacity(), 0u);
+  RtpTransport::ReceiveCopyStats stats = transport.GetReceiveCopyStats();
+  EXPECT_EQ(stats.packets_received, 1);
+  EXPECT_EQ(stats.bytes_received, kRtpLen);
+  EXPECT_EQ(stats.bytes_copied, 0);
+
+  transport.UnregisterRtpDemuxerSink(&observer);
+}
+
+TEST(RtpTransportTest, CopiesPayloadMuchSmallerThanReceiveStorage) {
+  RtpTransport transport(kMuxDisabled);
+  rtc::FakePacketTransport fake_rtp("fake_rtp");
+  transport.SetRtpPacketTransport(&fake_rtp);
+  TransportObserver observer(&transport);
+  RtpDemuxerCriteria demuxer_criteria;
+  demuxer_criteria.payload_types().insert(0x11);
+  transport.RegisterRtpDemuxerSink(demuxer_criteria, &observer);
+
+  rtc::ReceivedPacket::PayloadStorage storage(1500);
+  storage.buffer().SetData(kRtpData, kRtpLen);
+  rtc::ReceivedPacket packet(storage.buffer(), rtc::SocketAddress());
+  packet.set_payload_storage(&storage);
+  fake_rtp.NotifyPacketReceived(packet);
+
+  // The packet doesn't keep the whole storage alive, which stays in place for
+  // the next read.
+  ASSERT_EQ(observer.rtp_count(), 1);
+  EXPECT_NE(observer.last_recv_rtp_packet().data(), storage.buffer().data());
+  EXPECT_EQ(storage.buffer().capacity(), 1500u);
+  EXPECT_EQ(transport.GetReceiveCopyStats().bytes_copied, kRtpLen);
+
+  transport.UnregisterRtpDemuxerSink(&observer);
+}
+
+TEST(RtpTransportTest, CountsCopiedReceivedBytes) {
+  RtpTransport transport(kMuxDisabled);
+  rtc::FakePacketTransport fake_rtp("fake_rtp");
+  fake_rtp.SetDestination(&fake_rtp, true);
+  transport.SetRtpPacketTransport(&fake_rtp);
+  TransportObserver observer(&transport);
+  RtpDemuxerCriteria demuxer_criteria;
+  demuxer_criteria.payload_types().insert(0x11);
+  transport.RegisterRtpDemuxerSink(demuxer_criteria, &observer);
+
+  const rtc::PacketOptions options;
+  const int flags = 0;
+  rtc::Buffer rtp_data(kRtpData, kRtpLen);
+  fake_rtp.SendPacket(rtp_data.data<char>(), kRtpLen, options, flags);
+  ASSERT_EQ(observer.rtp_count(), 1);
+  RtpTransport::ReceiveCopyStats stats = transport.GetReceiveCopyStats();
+  EXPECT_EQ(stats.packets_received, 1);
+  EXPECT_EQ(stats.bytes_copied, kRtpLen);
+
+  transport.UnregisterRtpDemuxerSink(&observer);
+}
+
 // Test that SignalPacketReceived does not fire when a RTP packet with an
 // unhandled payload type is received.
 TEST(RtpTransportTest, DontSignalUnhandledRtpPayloadType) {
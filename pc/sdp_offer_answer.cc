@@ -1519,7 +1519,7 @@ rtc::Thread* SdpOfferAnswerHandler::signaling_thread() const {
 }
 
 rtc::Thread* SdpOfferAnswerHandler::network_thread() const {
-  return context_->network_thread();
+  return pc_->network_thread();
 }
 
 void SdpOfferAnswerHandler::CreateOffer(
@@ -1755,8 +1755,7 @@ RTCError SdpOfferAnswerHandler::ApplyLocalDescription(
         // information about DTLS transports.
         if (transceiver->mid()) {
           auto dtls_transport = LookupDtlsTransportByMid(
-              context_->network_thread(), transport_controller_s(),
-              *transceiver->mid());
+              network_thread(), transport_controller_s(), *transceiver->mid());
           transceiver->sender_internal()->set_transport(dtls_transport);
           transceiver->receiver_internal()->set_transport(dtls_transport);
         }
@@ -2219,8 +2218,7 @@ void SdpOfferAnswerHandler::ApplyRemoteDescriptionUpdateTransceiverState(
       // 2.2.8.1.11.[3-6]: Set the transport internal slots.
       if (transceiver->mid()) {
         auto dtls_transport = LookupDtlsTransportByMid(
-            context_->network_thread(), transport_controller_s(),
-            *transceiver->mid());
+            network_thread(), transport_controller_s(), *transceiver->mid());
         transceiver->sender_internal()->set_transport(dtls_transport);
         transceiver->receiver_internal()->set_transport(dtls_transport);
       }
@@ -2400,7 +2398,7 @@ void SdpOfferAnswerHandler::DoSetLocalDescription(
 
     // TODO(deadbeef): We already had to hop to the network thread for
     // MaybeStartGathering...
-    context_->network_thread()->BlockingCall(
+    network_thread()->BlockingCall(
         [this] { port_allocator()->DiscardCandidatePool(); });
   }
 
@@ -2602,7 +2600,7 @@ void SdpOfferAnswerHandler::SetRemoteDescriptionPostProcess(bool was_answer) {
   if (was_answer) {
     // TODO(deadbeef): We already had to hop to the network thread for
     // MaybeStartGathering...
-    context_->network_thread()->BlockingCall(
+    network_thread()->BlockingCall(
         [this] { port_allocator()->DiscardCandidatePool(); });
   }
 
@@ -4135,9 +4133,8 @@ void SdpOfferAnswerHandler::GetOptionsForOffer(
 
   session_options->rtcp_cname = rtcp_cname_;
   session_options->crypto_options = pc_->GetCryptoOptions();
-  session_options->pooled_ice_credentials =
-      context_->network_thread()->BlockingCall(
-          [this] { return port_allocator()->GetPooledIceCredentials(); });
+  session_options->pooled_ice_credentials = network_thread()->BlockingCall(
+      [this] { return port_allocator()->GetPooledIceCredentials(); });
   session_options->offer_extmap_allow_mixed =
       pc_->configuration()->offer_extmap_allow_mixed;
 
@@ -4418,9 +4415,8 @@ void SdpOfferAnswerHandler::GetOptionsForAnswer(
 
   session_options->rtcp_cname = rtcp_cname_;
   session_options->crypto_options = pc_->GetCryptoOptions();
-  session_options->pooled_ice_credentials =
-      context_->network_thread()->BlockingCall(
-          [this] { return port_allocator()->GetPooledIceCredentials(); });
+  session_options->pooled_ice_credentials = network_thread()->BlockingCall(
+      [this] { return port_allocator()->GetPooledIceCredentials(); });
 }
 
 void SdpOfferAnswerHandler::GetOptionsForPlanBAnswer(
@@ -108,6 +108,13 @@ void LibSrtpInitializer::DecrementLibsrtpUsageCountAndMaybeDeinit() {
   }
 }
 
+// Returns the packet index of the last packet protected by `stream`, shifted
+// by 16 and in network byte order.
+int64_t SendPacketIndex(const srtp_stream_ctx_t& stream) {
+  return static_cast<int64_t>(rtc::NetworkToHost64(
+      srtp_rdbx_get_packet_index(&stream.rtp_rdbx) << 16));
+}
+
 }  // namespace
 
 using ::webrtc::ParseRtpSequenceNumber;
@@ -247,17 +254,7 @@ bool SrtpSession::UnprotectRtp(void* p, int in_len, int* out_len) {
   *out_len = in_len;
   int err = srtp_unprotect(session_, p, out_len);
   if (err != srtp_err_status_ok) {
-    // Limit the error logging to avoid excessive logs when there are lots of
-    // bad packets.
-    const int kFailureLogThrottleCount = 100;
-    if (decryption_failure_count_ % kFailureLogThrottleCount == 0) {
-      RTC_LOG(LS_WARNING) << "Failed to unprotect SRTP packet, err=" << err
-                          << ", previous failure count: "
-                          << decryption_failure_count_;
-    }
-    ++decryption_failure_count_;
-    RTC_HISTOGRAM_ENUMERATION("WebRTC.PeerConnection.SrtpUnprotectError",
-                              static_cast<int>(err), kSrtpErrorCodeBoundary);
+    OnUnprotectRtpFailure(err);
     return false;
   }
   if (dump_plain_rtp_) {
@@ -287,6 +284,100 @@ bool SrtpSession::UnprotectRtcp(void* p, int in_len, int* out_len) {
   return true;
 }
 
+size_t SrtpSession::ProtectRtpBatch(rtc::ArrayView<RtpPacketBuffer> packets) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  if (!session_) {
+    RTC_LOG(LS_WARNING) << "Failed to protect " << packets.size()
+                        << " SRTP packets: no SRTP Session";
+    for (RtpPacketBuffer& packet : packets) {
+      packet.ok = false;
+    }
+    return 0;
+  }
+
+  size_t protected_count = 0;
+  const RtpPacketBuffer* last_protected = nullptr;
+  // Consecutive packets usually belong to the same stream. Streams are only
+  // added by srtp_protect(), so the pointer stays valid for the batch.
+  srtp_stream_ctx_t* stream = nullptr;
+  for (RtpPacketBuffer& packet : packets) {
+    // See ProtectRtp() for why this differs from the libsrtp recommendation.
+    if (packet.max_len < packet.len + rtp_auth_tag_len_) {
+      RTC_LOG(LS_WARNING) << "Failed to protect SRTP packet: The buffer length "
+                          << packet.max_len << " is less than the needed "
+                          << packet.len + rtp_auth_tag_len_;
+      packet.ok = false;
+      continue;
+    }
+    if (dump_plain_rtp_) {
+      DumpPacket(packet.data, packet.len, /*outbound=*/true);
+    }
+    int out_len = packet.len;
+    int err = srtp_protect(session_, packet.data, &out_len);
+    packet.ok = err == srtp_err_status_ok;
+    if (!packet.ok) {
+      // The sequence number is only parsed when needed, unlike ProtectRtp().
+      RTC_LOG(LS_WARNING) << "Failed to protect SRTP packet, seqnum="
+                          << ParseRtpSequenceNumber(rtc::MakeArrayView(
+                                 static_cast<const uint8_t*>(packet.data),
+                                 packet.len))
+                          << ", err=" << err;
+      continue;
+    }
+    packet.len = out_len;
+    last_protected = &packet;
+    if (packet.index) {
+      const uint32_t ssrc = static_cast<srtp_hdr_t*>(packet.data)->ssrc;
+      if (!stream || stream->ssrc != ssrc) {
+        stream = srtp_get_stream(session_, ssrc);
+      }
+      if (!stream) {
+        packet.ok = false;
+        continue;
+      }
+      *packet.index = SendPacketIndex(*stream);
+    }
+    ++protected_count;
+  }
+  if (last_protected) {
+    // The RTP header, including the sequence number, is not encrypted.
+    last_send_seq_num_ = ParseRtpSequenceNumber(rtc::MakeArrayView(
+        static_cast<const uint8_t*>(last_protected->data),
+        last_protected->len));
+  }
+  return protected_count;
+}
+
+size_t SrtpSession::UnprotectRtpBatch(
+    rtc::ArrayView<RtpPacketBuffer> packets) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  if (!session_) {
+    RTC_LOG(LS_WARNING) << "Failed to unprotect " << packets.size()
+                        << " SRTP packets: no SRTP Session";
+    for (RtpPacketBuffer& packet : packets) {
+      packet.ok = false;
+    }
+    return 0;
+  }
+
+  size_t unprotected_count = 0;
+  for (RtpPacketBuffer& packet : packets) {
+    int out_len = packet.len;
+    int err = srtp_unprotect(session_, packet.data, &out_len);
+    packet.ok = err == srtp_err_status_ok;
+    if (!packet.ok) {
+      OnUnprotectRtpFailure(err);
+      continue;
+    }
+    packet.len = out_len;
+    if (dump_plain_rtp_) {
+      DumpPacket(packet.data, packet.len, /*outbound=*/false);
+    }
+    ++unprotected_count;
+  }
+  return unprotected_count;
+}
+
 bool SrtpSession::GetRtpAuthParams(uint8_t** key, int* key_len, int* tag_len) {
   RTC_DCHECK(thread_checker_.IsCurrent());
   RTC_DCHECK(IsExternalAuthActive());
@@ -347,10 +438,7 @@ bool SrtpSession::GetSendStreamPacketIndex(void* p,
   if (!stream) {
     return false;
   }
-
-  // Shift packet index, put into network byte order
-  *index = static_cast<int64_t>(rtc::NetworkToHost64(
-      srtp_rdbx_get_packet_index(&stream->rtp_rdbx) << 16));
+  *index = SendPacketIndex(*stream);
   return true;
 }
 
@@ -498,6 +586,20 @@ void SrtpSession::HandleEventThunk(srtp_event_data_t* ev) {
   }
 }
 
+void SrtpSession::OnUnprotectRtpFailure(int err) {
+  // Limit the error logging to avoid excessive logs when there are lots of
+  // bad packets.
+  const int kFailureLogThrottleCount = 100;
+  if (decryption_failure_count_ % kFailureLogThrottleCount == 0) {
+    RTC_LOG(LS_WARNING) << "Failed to unprotect SRTP packet, err=" << err
+                        << ", previous failure count: "
+                        << decryption_failure_count_;
+  }
+  ++decryption_failure_count_;
+  RTC_HISTOGRAM_ENUMERATION("WebRTC.PeerConnection.SrtpUnprotectError",
+                            static_cast<int>(err), kSrtpErrorCodeBoundary);
+}
+
 // Logs the unencrypted packet in text2pcap format. This can then be
 // extracted by searching for RTP_DUMP
 //   grep RTP_DUMP chrome_debug.log > in.txt
@@ -16,6 +16,7 @@
 
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/field_trials_view.h"
 #include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
@@ -79,6 +80,30 @@ class SrtpSession {
   bool UnprotectRtp(void* data, int in_len, int* out_len);
   bool UnprotectRtcp(void* data, int in_len, int* out_len);
 
+  // An RTP packet that is protected or unprotected in-place as part of a
+  // batch.
+  struct RtpPacketBuffer {
+    void* data = nullptr;
+    // Length of the packet. Updated to the output length on success.
+    int len = 0;
+    // Size of the buffer pointed to by `data`. Only used when protecting.
+    int max_len = 0;
+    // Set to whether the packet was processed successfully.
+    bool ok = false;
+    // If set, receives the packet index when protecting, as with the
+    // `index` argument of ProtectRtp().
+    int64_t* index = nullptr;
+  };
+  // Encrypts/signs or decrypts/verifies `packets` in-place, in order. This is
+  // equivalent to calling ProtectRtp()/UnprotectRtp() on each packet, with
+  // the session checks done once for the batch, and the send stream looked up
+  // once per run of packets of the same SSRC for the packet indices. Packets
+  // that fail do not affect the others. Returns the number of packets that
+  // were processed successfully. Not used by SrtpTransport, which gets
+  // packets one at a time.
+  size_t ProtectRtpBatch(rtc::ArrayView<RtpPacketBuffer> packets);
+  size_t UnprotectRtpBatch(rtc::ArrayView<RtpPacketBuffer> packets);
+
   // Helper method to get authentication params.
   bool GetRtpAuthParams(uint8_t** key, int* key_len, int* tag_len);
 
@@ -124,6 +149,9 @@ class SrtpSession {
   // Returns send stream current packet index from srtp db.
   bool GetSendStreamPacketIndex(void* data, int in_len, int64_t* index);
 
+  // Logs (throttled) and records a failure of srtp_unprotect().
+  void OnUnprotectRtpFailure(int err);
+
   // Writes unencrypted packets in text2pcap format to the log file
   // for debugging.
   void DumpPacket(const void* buf, int len, bool outbound);
@@ -0,0 +1,136 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "pc/srtp_session.h"
+#include "rtc_base/byte_order.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/ssl_stream_adapter.h"
+#include "rtc_base/system/unused.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kPayloadSize = 1200;
+constexpr int kRtpHeaderSize = 12;
+constexpr int kPacketCapacity = kRtpHeaderSize + kPayloadSize + 16;
+constexpr uint8_t kKey[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ1234567890ABCDEFGH";
+
+// A sending and a receiving session, and `batch_size` packet buffers.
+class SrtpFixture {
+ public:
+  SrtpFixture(int crypto_suite, int batch_size)
+      : packets_(batch_size, std::vector<uint8_t>(kPacketCapacity)),
+        batch_(batch_size) {
+    int key_len;
+    int salt_len;
+    RTC_CHECK(
+        rtc::GetSrtpKeyAndSaltLengths(crypto_suite, &key_len, &salt_len));
+    RTC_CHECK_LE(static_cast<size_t>(key_len + salt_len), sizeof(kKey) - 1);
+    RTC_CHECK(sender_.SetSend(crypto_suite, kKey, key_len + salt_len, {}));
+    RTC_CHECK(receiver_.SetRecv(crypto_suite, kKey, key_len + salt_len, {}));
+
+    for (std::vector<uint8_t>& packet : packets_) {
+      memset(packet.data(), 0, kRtpHeaderSize);
+      packet[0] = 0x80;
+      packet[1] = 111;
+      rtc::SetBE32(packet.data() + 4, 3000);
+      rtc::SetBE32(packet.data() + 8, 0x12345678);
+      memset(packet.data() + kRtpHeaderSize, 0xab, kPayloadSize);
+    }
+  }
+
+  // Turns the buffers into the next `batch_size` plain RTP packets. A round
+  // trip leaves the plain packets in place, so only the sequence numbers,
+  // which the replay protection requires to be new, are rewritten. That is
+  // cheap enough to leave in the timed loop.
+  void NextPackets() {
+    for (size_t i = 0; i < packets_.size(); ++i) {
+      rtc::SetBE16(packets_[i].data() + 2, sequence_number_++);
+      batch_[i] = {.data = packets_[i].data(),
+                   .len = kRtpHeaderSize + kPayloadSize,
+                   .max_len = kPacketCapacity};
+    }
+  }
+
+  void ProtectAndUnprotectEach() {
+    for (cricket::SrtpSession::RtpPacketBuffer& packet : batch_) {
+      int out_len;
+      RTC_CHECK(sender_.ProtectRtp(packet.data, packet.len, packet.max_len,
+                                   &out_len));
+      RTC_CHECK(receiver_.UnprotectRtp(packet.data, out_len, &out_len));
+    }
+  }
+
+  void ProtectAndUnprotectBatch() {
+    RTC_CHECK_EQ(sender_.ProtectRtpBatch(batch_), batch_.size());
+    RTC_CHECK_EQ(receiver_.UnprotectRtpBatch(batch_), batch_.size());
+  }
+
+ private:
+  cricket::SrtpSession sender_;
+  cricket::SrtpSession receiver_;
+  std::vector<std::vector<uint8_t>> packets_;
+  std::vector<cricket::SrtpSession::RtpPacketBuffer> batch_;
+  uint16_t sequence_number_ = 0;
+};
+
+// Args: crypto suite, number of packets per call.
+void BM_SrtpRoundTripSingle(benchmark::State& state) {
+  SrtpFixture fixture(state.range(0), state.range(1));
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    fixture.NextPackets();
+    fixture.ProtectAndUnprotectEach();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+void BM_SrtpRoundTripBatch(benchmark::State& state) {
+  SrtpFixture fixture(state.range(0), state.range(1));
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    fixture.NextPackets();
+    fixture.ProtectAndUnprotectBatch();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+void SrtpArgs(benchmark::internal::Benchmark* b) {
+  for (int crypto_suite :
+       {rtc::kSrtpAes128CmSha1_80, rtc::kSrtpAeadAes128Gcm}) {
+    for (int batch_size : {8, 32}) {
+      b->Args({crypto_suite, batch_size});
+    }
+  }
+}
+
+BENCHMARK(BM_SrtpRoundTripSingle)->Apply(SrtpArgs);
+BENCHMARK(BM_SrtpRoundTripBatch)->Apply(SrtpArgs);
+
+}  // namespace
+}  // namespace webrtc
+
+/*
+
+Each iteration protects and then unprotects a burst of 1212 byte RTP packets
+with one session pair; items/s is packets/s. Crypto suite 1 is
+AES_CM_128_HMAC_SHA1_80, 7 is AEAD_AES_128_GCM.
+
+No results are recorded here yet. libsrtp has no multi-packet cipher API, so
+both variants do the same cipher work and only the per-call checks differ;
+whether that is measurable is what this benchmark is for.
+
+*/
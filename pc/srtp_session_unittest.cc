@@ -284,4 +284,115 @@ TEST_F(SrtpSessionTest, RemoveSsrc) {
   EXPECT_TRUE(s2_.RemoveSsrcFromSession(1));
 }
 
+TEST_F(SrtpSessionTest, ProtectAndUnprotectRtpBatch) {
+  EXPECT_TRUE(s1_.SetSend(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.SetRecv(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  constexpr int kNumPackets = 4;
+  char packets[kNumPackets][sizeof(rtp_packet_)];
+  cricket::SrtpSession::RtpPacketBuffer batch[kNumPackets];
+  for (int i = 0; i < kNumPackets; ++i) {
+    memcpy(packets[i], kPcmuFrame, rtp_len_);
+    SetBE16(reinterpret_cast<uint8_t*>(packets[i]) + 2, i + 1);
+    batch[i] = {.data = packets[i],
+                .len = rtp_len_,
+                .max_len = sizeof(packets[i])};
+  }
+
+  EXPECT_EQ(s1_.ProtectRtpBatch(batch), static_cast<size_t>(kNumPackets));
+  for (const auto& packet : batch) {
+    EXPECT_TRUE(packet.ok);
+    EXPECT_EQ(packet.len,
+              rtp_len_ + rtp_auth_tag_len(kSrtpAes128CmSha1_80));
+  }
+
+  EXPECT_EQ(s2_.UnprotectRtpBatch(batch), static_cast<size_t>(kNumPackets));
+  for (int i = 0; i < kNumPackets; ++i) {
+    EXPECT_TRUE(batch[i].ok);
+    EXPECT_EQ(batch[i].len, rtp_len_);
+    // Everything but the sequence number matches the original packet.
+    EXPECT_EQ(0, memcmp(packets[i] + 4, kPcmuFrame + 4, rtp_len_ - 4));
+  }
+}
+
+TEST_F(SrtpSessionTest, RtpBatchFailuresDoNotAffectOtherPackets) {
+  EXPECT_TRUE(s1_.SetSend(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.SetRecv(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  constexpr int kNumPackets = 3;
+  char packets[kNumPackets][sizeof(rtp_packet_)];
+  cricket::SrtpSession::RtpPacketBuffer batch[kNumPackets];
+  for (int i = 0; i < kNumPackets; ++i) {
+    memcpy(packets[i], kPcmuFrame, rtp_len_);
+    SetBE16(reinterpret_cast<uint8_t*>(packets[i]) + 2, i + 1);
+    batch[i] = {.data = packets[i],
+                .len = rtp_len_,
+                .max_len = sizeof(packets[i])};
+  }
+  // No room for the auth tag.
+  batch[0].max_len = rtp_len_;
+
+  EXPECT_EQ(s1_.ProtectRtpBatch(batch), 2u);
+  EXPECT_FALSE(batch[0].ok);
+  EXPECT_EQ(batch[0].len, rtp_len_);
+  EXPECT_TRUE(batch[1].ok);
+  EXPECT_TRUE(batch[2].ok);
+
+  // Tamper with the payload of the second packet.
+  packets[1][rtp_len_ - 1] ^= 0x01;
+  EXPECT_EQ(s2_.UnprotectRtpBatch(
+                rtc::ArrayView<cricket::SrtpSession::RtpPacketBuffer>(batch)
+                    .subview(1)),
+            1u);
+  EXPECT_FALSE(batch[1].ok);
+  EXPECT_TRUE(batch[2].ok);
+  EXPECT_EQ(batch[2].len, rtp_len_);
+  EXPECT_METRIC_THAT(
+      webrtc::metrics::Samples("WebRTC.PeerConnection.SrtpUnprotectError"),
+      ElementsAre(Pair(srtp_err_status_auth_fail, 1)));
+}
+
+TEST_F(SrtpSessionTest, ProtectRtpBatchGetsPacketIndices) {
+  EXPECT_TRUE(s1_.SetSend(kSrtpAes128CmSha1_32, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  constexpr int kNumPackets = 3;
+  // The last packet is of another stream, with its own packet index.
+  constexpr uint16_t kSequenceNumbers[kNumPackets] = {1, 2, 5};
+  char packets[kNumPackets][sizeof(rtp_packet_)];
+  int64_t indices[kNumPackets] = {};
+  cricket::SrtpSession::RtpPacketBuffer batch[kNumPackets];
+  for (int i = 0; i < kNumPackets; ++i) {
+    memcpy(packets[i], kPcmuFrame, rtp_len_);
+    SetBE16(reinterpret_cast<uint8_t*>(packets[i]) + 2, kSequenceNumbers[i]);
+    batch[i] = {.data = packets[i],
+                .len = rtp_len_,
+                .max_len = sizeof(packets[i]),
+                .index = &indices[i]};
+  }
+  SetBE32(reinterpret_cast<uint8_t*>(packets[2]) + 8, 0x12345678);
+
+  EXPECT_EQ(s1_.ProtectRtpBatch(batch), static_cast<size_t>(kNumPackets));
+  for (int i = 0; i < kNumPackets; ++i) {
+    EXPECT_TRUE(batch[i].ok);
+    // `index` will be shifted by 16.
+    EXPECT_EQ(indices[i], static_cast<int64_t>(NetworkToHost64(
+                              uint64_t{kSequenceNumbers[i]} << 16)));
+  }
+}
+
+TEST_F(SrtpSessionTest, RtpBatchFailsWithoutSession) {
+  cricket::SrtpSession::RtpPacketBuffer batch[1] = {
+      {.data = rtp_packet_,
+       .len = rtp_len_,
+       .max_len = sizeof(rtp_packet_),
+       .ok = true}};
+  EXPECT_EQ(s1_.ProtectRtpBatch(batch), 0u);
+  EXPECT_FALSE(batch[0].ok);
+  batch[0].ok = true;
+  EXPECT_EQ(s2_.UnprotectRtpBatch(batch), 0u);
+  EXPECT_FALSE(batch[0].ok);
+}
+
 }  // namespace rtc
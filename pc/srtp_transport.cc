@@ -126,7 +126,7 @@ void SrtpTransport::OnRtpPacketReceived(const rtc::ReceivedPacket& packet) {
     return;
   }
 
-  rtc::CopyOnWriteBuffer payload(packet.payload());
+  rtc::CopyOnWriteBuffer payload = TakeReceivedPayload(packet);
   char* data = payload.MutableData<char>();
   int len = rtc::checked_cast<int>(payload.size());
   if (!UnprotectRtp(data, len, &len)) {
@@ -156,7 +156,7 @@ void SrtpTransport::OnRtcpPacketReceived(const rtc::ReceivedPacket& packet) {
         << "Inactive SRTP transport received an RTCP packet. Drop it.";
     return;
   }
-  rtc::CopyOnWriteBuffer payload(packet.payload());
+  rtc::CopyOnWriteBuffer payload = TakeReceivedPayload(packet);
   char* data = payload.MutableData<char>();
   int len = rtc::checked_cast<int>(payload.size());
   if (!UnprotectRtcp(data, len, &len)) {
@@ -10,9 +10,12 @@
 
 #include "rtc_base/async_udp_socket.h"
 
+#include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "api/task_queue/task_queue_base.h"
 #include "api/units/time_delta.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/network/received_packet.h"
 #include "rtc_base/network/sent_packet.h"
@@ -20,6 +23,21 @@
 #include "system_wrappers/include/field_trial.h"
 
 namespace rtc {
+namespace {
+
+struct BatchedReceiveConfig {
+  explicit BatchedReceiveConfig(absl::string_view field_trial) {
+    webrtc::ParseFieldTrial({&enabled, &batch_size, &buffer_size},
+                            field_trial);
+  }
+
+  webrtc::FieldTrialFlag enabled{"Enabled"};
+  webrtc::FieldTrialConstrained<int> batch_size{"batch_size", 16, 1, 1024};
+  webrtc::FieldTrialConstrained<int> buffer_size{"buffer_size", 2048, 1,
+                                                 64 * 1024};
+};
+
+}  // namespace
 
 AsyncUDPSocket* AsyncUDPSocket::Create(Socket* socket,
                                        const SocketAddress& bind_address) {
@@ -44,6 +62,25 @@ AsyncUDPSocket::AsyncUDPSocket(Socket* socket) : socket_(socket) {
   // The socket should start out readable but not writable.
   socket_->SignalReadEvent.connect(this, &AsyncUDPSocket::OnReadEvent);
   socket_->SignalWriteEvent.connect(this, &AsyncUDPSocket::OnWriteEvent);
+
+  BatchedReceiveConfig config(
+      webrtc::field_trial::FindFullName("WebRTC-UdpBatchedReceive"));
+  if (config.enabled && config.batch_size.Get() > 1) {
+    batch_buffer_size_ = config.buffer_size.Get();
+    // The receive buffers refer to the pool, which is never resized.
+    batch_buffers_.reserve(config.batch_size.Get());
+    receive_buffers_.reserve(config.batch_size.Get());
+    for (int i = 0; i < config.batch_size.Get(); ++i) {
+      batch_buffers_.emplace_back(batch_buffer_size_);
+      receive_buffers_.emplace_back(batch_buffers_.back().buffer());
+    }
+  }
+}
+
+AsyncUDPSocket::~AsyncUDPSocket() {
+  // The socket may be destroyed off the send sequence and its listeners may
+  // be gone already, so queued packets are written without signalling them.
+  WriteSendBatch();
 }
 
 SocketAddress AsyncUDPSocket::GetLocalAddress() const {
@@ -57,6 +94,7 @@ SocketAddress AsyncUDPSocket::GetRemoteAddress() const {
 int AsyncUDPSocket::Send(const void* pv,
                          size_t cb,
                          const rtc::PacketOptions& options) {
+  FlushSendBatch();
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, false, &sent_packet.info);
@@ -69,6 +107,11 @@ int AsyncUDPSocket::SendTo(const void* pv,
                            size_t cb,
                            const SocketAddress& addr,
                            const rtc::PacketOptions& options) {
+  if (options.batchable) {
+    return EnqueueForBatch(pv, cb, addr, options);
+  }
+  // Keep packets in order with respect to an unfinished batch.
+  FlushSendBatch();
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, true, &sent_packet.info);
@@ -78,6 +121,7 @@ int AsyncUDPSocket::SendTo(const void* pv,
 }
 
 int AsyncUDPSocket::Close() {
+  FlushSendBatch();
   return socket_->Close();
 }
 
@@ -101,10 +145,106 @@ void AsyncUDPSocket::SetError(int error) {
   return socket_->SetError(error);
 }
 
+AsyncUDPSocket::SendBatchStats AsyncUDPSocket::GetSendBatchStats() const {
+  RTC_DCHECK_RUN_ON(&send_sequence_checker_);
+  return send_batch_stats_;
+}
+
+int AsyncUDPSocket::EnqueueForBatch(const void* pv,
+                                    size_t cb,
+                                    const SocketAddress& addr,
+                                    const rtc::PacketOptions& options) {
+  RTC_DCHECK_RUN_ON(&send_sequence_checker_);
+  if (send_batch_size_ == send_batch_.size()) {
+    send_batch_.emplace_back();
+  }
+  PendingPacket& pending = send_batch_[send_batch_size_++];
+  pending.payload.SetData(static_cast<const uint8_t*>(pv), cb);
+  pending.address = addr;
+  pending.packet_id = options.packet_id;
+  pending.info = options.info_signaled_after_sent;
+  CopySocketInformationToPacketInfo(cb, *this, true, &pending.info);
+
+  // While the socket is blocked each packet is written right away, so that
+  // the sender learns whether it got through. The same goes for senders
+  // without a task queue, as there is nowhere to post the flush to.
+  webrtc::TaskQueueBase* current = webrtc::TaskQueueBase::Current();
+  if (options.last_packet_in_batch || send_batch_size_ >= kMaxSendBatchSize ||
+      send_blocked_ || current == nullptr) {
+    // A failed write is reported to the sender of the packet that completed
+    // the batch, with the socket error left in place for GetError().
+    return FlushSendBatch() ? static_cast<int>(cb) : -1;
+  }
+  if (send_batch_size_ == 1) {
+    // Don't hold packets indefinitely if the end of the batch never arrives,
+    // e.g. because the last packet was dropped before reaching the socket.
+    current->PostTask(
+        webrtc::SafeTask(task_safety_.flag(), [this] { FlushSendBatch(); }));
+  }
+  return static_cast<int>(cb);
+}
+
+bool AsyncUDPSocket::FlushSendBatch() {
+  RTC_DCHECK_RUN_ON(&send_sequence_checker_);
+  if (send_batch_size_ == 0) {
+    return true;
+  }
+  const size_t batch_size = send_batch_size_;
+  const bool written = WriteSendBatch();
+  const int64_t send_time_ms = rtc::TimeMillis();
+  for (size_t i = 0; i < batch_size; ++i) {
+    SignalSentPacket(this, rtc::SentPacket(send_batch_[i].packet_id,
+                                           send_time_ms, send_batch_[i].info));
+  }
+  return written;
+}
+
+bool AsyncUDPSocket::WriteSendBatch() {
+  if (send_batch_size_ == 0) {
+    return true;
+  }
+  outgoing_packets_.clear();
+  for (size_t i = 0; i < send_batch_size_; ++i) {
+    outgoing_packets_.push_back(
+        {.payload = send_batch_[i].payload, .address = send_batch_[i].address});
+  }
+
+  rtc::ArrayView<const Socket::OutgoingPacket> remaining(outgoing_packets_);
+  while (!remaining.empty()) {
+    int sent = socket_->SendToBatch(remaining);
+    if (sent <= 0) {
+      // The remaining packets are dropped, as for a failing SendTo. It is
+      // acceptable to drop packets under high load.
+      break;
+    }
+    ++send_batch_stats_.batches;
+    send_batch_stats_.packets += sent;
+    size_t bucket = 0;
+    while (bucket + 1 < send_batch_stats_.batch_size_histogram.size() &&
+           (2 << bucket) <= sent) {
+      ++bucket;
+    }
+    ++send_batch_stats_.batch_size_histogram[bucket];
+    remaining = remaining.subview(sent);
+  }
+
+  // Until a write succeeds again, packets are not queued, see
+  // EnqueueForBatch(). The socket signals SignalReadyToSend once it is
+  // writable.
+  send_blocked_ = !remaining.empty();
+  send_batch_size_ = 0;
+  return !send_blocked_;
+}
+
 void AsyncUDPSocket::OnReadEvent(Socket* socket) {
   RTC_DCHECK(socket_.get() == socket);
   RTC_DCHECK_RUN_ON(&sequence_checker_);
 
+  if (!receive_buffers_.empty()) {
+    ReadBatch();
+    return;
+  }
+
   Socket::ReceiveBuffer receive_buffer(buffer_);
   int len = socket_->RecvFrom(receive_buffer);
   if (len < 0) {
@@ -121,7 +261,45 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
     // Spurios wakeup.
     return;
   }
+  DeliverPacket(receive_buffer, /*storage=*/nullptr);
+}
+
+void AsyncUDPSocket::ReadBatch() {
+  for (Socket::ReceiveBuffer& receive_buffer : receive_buffers_) {
+    // Reset metadata left over from the previous batch.
+    receive_buffer.arrival_time = absl::nullopt;
+    receive_buffer.ecn = EcnMarking::kNotEct;
+    // Replace the storage taken over by consumers of the previous batch.
+    if (receive_buffer.payload.capacity() == 0) {
+      receive_buffer.payload.EnsureCapacity(batch_buffer_size_);
+    }
+  }
+  int count = socket_->RecvFromBatch(receive_buffers_);
+  if (count < 0) {
+    // See comment in OnReadEvent.
+    SocketAddress local_addr = socket_->GetLocalAddress();
+    RTC_LOG(LS_INFO) << "AsyncUDPSocket[" << local_addr.ToSensitiveString()
+                     << "] receive failed with error " << socket_->GetError();
+    return;
+  }
+  // A receiver may destroy the socket while handling a packet.
+  rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> safety =
+      receive_safety_.flag();
+  for (int i = 0; i < count; ++i) {
+    Socket::ReceiveBuffer& receive_buffer = receive_buffers_[i];
+    if (receive_buffer.payload.empty()) {
+      // Empty datagram.
+      continue;
+    }
+    DeliverPacket(receive_buffer, &batch_buffers_[i]);
+    if (!safety->alive()) {
+      return;
+    }
+  }
+}
 
+void AsyncUDPSocket::DeliverPacket(Socket::ReceiveBuffer& receive_buffer,
+                                   ReceivedPacket::PayloadStorage* storage) {
   if (!receive_buffer.arrival_time) {
     // Timestamp from socket is not available.
     receive_buffer.arrival_time = webrtc::Timestamp::Micros(rtc::TimeMicros());
@@ -133,9 +311,10 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
     }
     *receive_buffer.arrival_time += *socket_time_offset_;
   }
-  NotifyPacketReceived(
-      ReceivedPacket(receive_buffer.payload, receive_buffer.source_address,
-                     receive_buffer.arrival_time, receive_buffer.ecn));
+  ReceivedPacket packet(receive_buffer.payload, receive_buffer.source_address,
+                        receive_buffer.arrival_time, receive_buffer.ecn);
+  packet.set_payload_storage(storage);
+  NotifyPacketReceived(packet);
 }
 
 void AsyncUDPSocket::OnWriteEvent(Socket* socket) {
@@ -13,13 +13,17 @@
 
 #include <stddef.h>
 
+#include <array>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/sequence_checker.h"
+#include "api/task_queue/pending_task_safety_flag.h"
 #include "api/units/time_delta.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/network/received_packet.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/socket_factory.h"
@@ -30,6 +34,18 @@ namespace rtc {
 
 // Provides the ability to receive packets asynchronously.  Sends are not
 // buffered since it is acceptable to drop packets under high load.
+// With the field trial "WebRTC-UdpBatchedReceive/Enabled/" each read event
+// drains up to `batch_size` datagrams with Socket::RecvFromBatch into a pool of
+// reusable receive buffers of `buffer_size` bytes, which grow to fit larger
+// datagrams. The receiver of a packet may take its buffer over (see
+// ReceivedPacket::PayloadStorage), so that the payload needn't be copied; a
+// buffer taken over is replaced before the next read.
+//
+// Packets sent with PacketOptions::batchable are queued until the packet marked
+// `last_packet_in_batch` and then written with one Socket::SendToBatch call.
+// SendTo() returns the size of a queued packet; a failure to write the batch
+// is returned by the SendTo() call that completes it, and after a failure
+// batchable packets are written one by one until the socket accepts them again.
 class AsyncUDPSocket : public AsyncPacketSocket {
  public:
   // Binds `socket` and creates AsyncUDPSocket for it. Takes ownership
@@ -41,8 +57,18 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   // asynchronous socket from the given factory.
   static AsyncUDPSocket* Create(SocketFactory* factory,
                                 const SocketAddress& bind_address);
+  // Distribution of the number of packets written per Socket::SendToBatch
+  // call for batchable packets.
+  struct SendBatchStats {
+    int64_t batches = 0;
+    int64_t packets = 0;
+    // Bucket `i` counts batches of [2^i, 2^(i+1)) packets.
+    std::array<int64_t, 7> batch_size_histogram = {};
+  };
+
   explicit AsyncUDPSocket(Socket* socket);
-  ~AsyncUDPSocket() = default;
+  // Writes packets still queued for a batch, without signalling them.
+  ~AsyncUDPSocket() override;
 
   SocketAddress GetLocalAddress() const override;
   SocketAddress GetRemoteAddress() const override;
@@ -61,17 +87,72 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   int GetError() const override;
   void SetError(int error) override;
 
+  SendBatchStats GetSendBatchStats() const;
+
  private:
+  // Maximum number of packets collected before the batch is flushed even if
+  // the last packet of the batch has not been seen yet.
+  static constexpr size_t kMaxSendBatchSize = 64;
+
+  struct PendingPacket {
+    rtc::Buffer payload;
+    SocketAddress address;
+    int64_t packet_id = -1;
+    rtc::PacketInfo info;
+  };
+
   // Called when the underlying socket is ready to be read from.
   void OnReadEvent(Socket* socket);
   // Called when the underlying socket is ready to send.
   void OnWriteEvent(Socket* socket);
+  // Reads and delivers up to `receive_buffers_.size()` datagrams.
+  void ReadBatch();
+  // Converts the socket timestamp to the rtc::TimeMicros() clock, or stamps
+  // the packet with the current time if the socket provided none, and
+  // delivers it. The receiver may take over `storage`, if set.
+  void DeliverPacket(Socket::ReceiveBuffer& receive_buffer,
+                     ReceivedPacket::PayloadStorage* storage);
+  // Queues a batchable packet, flushing the batch when it is complete.
+  int EnqueueForBatch(const void* pv,
+                      size_t cb,
+                      const SocketAddress& addr,
+                      const rtc::PacketOptions& options);
+  // Writes all queued packets, keeping their order. Returns false if some
+  // could not be written, in which case GetError() tells why.
+  bool FlushSendBatch();
+  // Writes and dequeues all queued packets without signalling them; the
+  // queue's packet infos are left in place for the caller to signal.
+  bool WriteSendBatch() RTC_RUN_ON(send_sequence_checker_);
 
   RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker sequence_checker_;
   std::unique_ptr<Socket> socket_;
   rtc::Buffer buffer_ RTC_GUARDED_BY(sequence_checker_);
+  // Pool used for batched reads. Empty unless batched receive is enabled.
+  std::vector<ReceivedPacket::PayloadStorage> batch_buffers_
+      RTC_GUARDED_BY(sequence_checker_);
+  size_t batch_buffer_size_ RTC_GUARDED_BY(sequence_checker_) = 0;
+  std::vector<Socket::ReceiveBuffer> receive_buffers_
+      RTC_GUARDED_BY(sequence_checker_);
   absl::optional<webrtc::TimeDelta> socket_time_offset_
       RTC_GUARDED_BY(sequence_checker_);
+  // Send batching state. Batchable packets must all be sent on one sequence,
+  // which need not be the one reading from the socket.
+  RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker send_sequence_checker_{
+      webrtc::SequenceChecker::kDetached};
+  // Queued batchable packets are the first `send_batch_size_` entries; the
+  // rest are kept to reuse their buffers.
+  std::vector<PendingPacket> send_batch_
+      RTC_GUARDED_BY(send_sequence_checker_);
+  size_t send_batch_size_ RTC_GUARDED_BY(send_sequence_checker_) = 0;
+  // Set when the last flush could not write all packets.
+  bool send_blocked_ RTC_GUARDED_BY(send_sequence_checker_) = false;
+  std::vector<Socket::OutgoingPacket> outgoing_packets_
+      RTC_GUARDED_BY(send_sequence_checker_);
+  SendBatchStats send_batch_stats_ RTC_GUARDED_BY(send_sequence_checker_);
+  webrtc::ScopedTaskSafetyDetached task_safety_;
+  // Cleared when the socket is destroyed, which a receiver of a batched read
+  // may do before the rest of the batch has been delivered.
+  webrtc::ScopedTaskSafetyDetached receive_safety_;
 };
 
 }  // namespace rtc
@@ -13,18 +13,64 @@
 #include <memory>
 #include <string>
 
+#include "api/array_view.h"
+#include "api/task_queue/task_queue_base.h"
+#include "rtc_base/async_socket.h"
 #include "rtc_base/gunit.h"
-#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/thread.h"
 #include "rtc_base/virtual_socket_server.h"
 
 namespace rtc {
+namespace {
+
+// Socket whose batched writes fail as if the send buffer was full while
+// `blocked` is set.
+class BlockableSocket : public AsyncSocketAdapter {
+ public:
+  explicit BlockableSocket(Socket* socket) : AsyncSocketAdapter(socket) {}
+
+  int SendToBatch(rtc::ArrayView<const OutgoingPacket> packets) override {
+    if (blocked) {
+      SetError(EWOULDBLOCK);
+      return -1;
+    }
+    return AsyncSocketAdapter::SendToBatch(packets);
+  }
+
+  bool blocked = false;
+};
+
+// Socket that counts the packets written in batches instead of sending them.
+class CountingSocket : public AsyncSocketAdapter {
+ public:
+  CountingSocket(Socket* socket, int* packets_written)
+      : AsyncSocketAdapter(socket), packets_written_(packets_written) {}
+
+  int SendToBatch(rtc::ArrayView<const OutgoingPacket> packets) override {
+    *packets_written_ += static_cast<int>(packets.size());
+    return static_cast<int>(packets.size());
+  }
+
+ private:
+  int* const packets_written_;
+};
+
+class SentPacketCounter : public sigslot::has_slots<> {
+ public:
+  void OnSentPacket(AsyncPacketSocket* socket, const SentPacket& packet) {
+    ++count;
+  }
+
+  int count = 0;
+};
+
+}  // namespace
 
 class AsyncUdpSocketTest : public ::testing::Test, public sigslot::has_slots<> {
  public:
   AsyncUdpSocketTest()
-      : pss_(new rtc::PhysicalSocketServer),
-        vss_(new rtc::VirtualSocketServer(pss_.get())),
-        socket_(vss_->CreateSocket(SOCK_DGRAM)),
+      : vss_(new rtc::VirtualSocketServer()),
+        socket_(vss_->CreateSocket(AF_INET, SOCK_DGRAM)),
         udp_socket_(new AsyncUDPSocket(socket_)),
         ready_to_send_(false) {
     udp_socket_->SignalReadyToSend.connect(this,
@@ -34,7 +80,6 @@ class AsyncUdpSocketTest : public ::testing::Test, public sigslot::has_slots<> {
   void OnReadyToSend(rtc::AsyncPacketSocket* socket) { ready_to_send_ = true; }
 
  protected:
-  std::unique_ptr<PhysicalSocketServer> pss_;
   std::unique_ptr<VirtualSocketServer> vss_;
   Socket* socket_;
   std::unique_ptr<AsyncUDPSocket> udp_socket_;
@@ -47,4 +92,85 @@ TEST_F(AsyncUdpSocketTest, OnWriteEvent) {
   EXPECT_TRUE(ready_to_send_);
 }
 
+TEST(AsyncUdpSocketSendBatchTest, ReportsFailedBatchWrite) {
+  VirtualSocketServer vss;
+  AutoSocketServerThread main_thread(&vss);
+  BlockableSocket* socket =
+      new BlockableSocket(vss.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<AsyncUDPSocket> udp_socket(
+      AsyncUDPSocket::Create(socket, SocketAddress("127.0.0.1", 0)));
+  ASSERT_TRUE(udp_socket);
+  const SocketAddress kDestination("127.0.0.1", 5000);
+  const char kPayload[] = "payload";
+  const int kSize = static_cast<int>(sizeof(kPayload));
+  PacketOptions options;
+  options.batchable = true;
+
+  // A queued packet is reported as sent, the failure to write the batch is
+  // returned to the sender of the last packet.
+  socket->blocked = true;
+  EXPECT_EQ(kSize, udp_socket->SendTo(kPayload, kSize, kDestination, options));
+  options.last_packet_in_batch = true;
+  EXPECT_EQ(-1, udp_socket->SendTo(kPayload, kSize, kDestination, options));
+  EXPECT_EQ(EWOULDBLOCK, udp_socket->GetError());
+
+  // Until the socket accepts packets again, they are not queued.
+  options.last_packet_in_batch = false;
+  EXPECT_EQ(-1, udp_socket->SendTo(kPayload, kSize, kDestination, options));
+  EXPECT_EQ(EWOULDBLOCK, udp_socket->GetError());
+  socket->blocked = false;
+  EXPECT_EQ(kSize, udp_socket->SendTo(kPayload, kSize, kDestination, options));
+  EXPECT_EQ(1, udp_socket->GetSendBatchStats().batches);
+
+  // Then batching resumes.
+  EXPECT_EQ(kSize, udp_socket->SendTo(kPayload, kSize, kDestination, options));
+  options.last_packet_in_batch = true;
+  EXPECT_EQ(kSize, udp_socket->SendTo(kPayload, kSize, kDestination, options));
+  const AsyncUDPSocket::SendBatchStats stats = udp_socket->GetSendBatchStats();
+  EXPECT_EQ(2, stats.batches);
+  EXPECT_EQ(3, stats.packets);
+  EXPECT_EQ(1, stats.batch_size_histogram[1]);
+}
+
+TEST(AsyncUdpSocketSendBatchTest, WritesRightAwayWithoutTaskQueue) {
+  VirtualSocketServer vss;
+  ASSERT_EQ(webrtc::TaskQueueBase::Current(), nullptr);
+  int packets_written = 0;
+  AsyncUDPSocket udp_socket(new CountingSocket(
+      vss.CreateSocket(AF_INET, SOCK_DGRAM), &packets_written));
+  const SocketAddress kDestination("127.0.0.1", 5000);
+  const char kPayload[] = "payload";
+  const int kSize = static_cast<int>(sizeof(kPayload));
+  PacketOptions options;
+  options.batchable = true;
+
+  // There is no task queue to post a flush to, so nothing would send a packet
+  // held for a batch that is never completed.
+  EXPECT_EQ(kSize, udp_socket.SendTo(kPayload, kSize, kDestination, options));
+  EXPECT_EQ(packets_written, 1);
+}
+
+TEST(AsyncUdpSocketSendBatchTest, WritesQueuedPacketsWhenDestroyed) {
+  VirtualSocketServer vss;
+  AutoSocketServerThread main_thread(&vss);
+  int packets_written = 0;
+  SentPacketCounter sent_packets;
+  auto udp_socket = std::make_unique<AsyncUDPSocket>(new CountingSocket(
+      vss.CreateSocket(AF_INET, SOCK_DGRAM), &packets_written));
+  udp_socket->SignalSentPacket.connect(&sent_packets,
+                                       &SentPacketCounter::OnSentPacket);
+  const SocketAddress kDestination("127.0.0.1", 5000);
+  const char kPayload[] = "payload";
+  const int kSize = static_cast<int>(sizeof(kPayload));
+  PacketOptions options;
+  options.batchable = true;
+
+  EXPECT_EQ(kSize, udp_socket->SendTo(kPayload, kSize, kDestination, options));
+  EXPECT_EQ(packets_written, 0);
+  udp_socket = nullptr;
+  EXPECT_EQ(packets_written, 1);
+  // Listeners may be gone by the time the socket is destroyed.
+  EXPECT_EQ(sent_packets.count, 0);
+}
+
 }  // namespace rtc
@@ -12,6 +12,8 @@
 
 #include <stddef.h>
 
+#include <utility>
+
 #include "absl/strings/string_view.h"
 
 namespace rtc {
@@ -33,6 +35,14 @@ CopyOnWriteBuffer::CopyOnWriteBuffer(CopyOnWriteBuffer&& buf) noexcept
 CopyOnWriteBuffer::CopyOnWriteBuffer(absl::string_view s)
     : CopyOnWriteBuffer(s.data(), s.length()) {}
 
+CopyOnWriteBuffer::CopyOnWriteBuffer(Buffer&& buffer)
+    : buffer_(buffer.capacity() > 0 ? new RefCountedBuffer(std::move(buffer))
+                                    : nullptr),
+      offset_(0),
+      size_(buffer_ ? buffer_->size() : 0) {
+  RTC_DCHECK(IsConsistent());
+}
+
 CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size)
     : buffer_(size > 0 ? new RefCountedBuffer(size) : nullptr),
       offset_(0),
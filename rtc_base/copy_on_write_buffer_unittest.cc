@@ -11,6 +11,7 @@
 #include "rtc_base/copy_on_write_buffer.h"
 
 #include <cstdint>
+#include <utility>
 
 #include "test/gtest.h"
 
@@ -79,6 +80,23 @@ TEST(CopyOnWriteBufferTest, TestMoveConstruct) {
   EXPECT_EQ(buf2.data(), buf1_data);
 }
 
+TEST(CopyOnWriteBufferTest, ConstructFromBufferTakesStorage) {
+  Buffer buffer(kTestData, 3, 10);
+  const uint8_t* data = buffer.data();
+  CopyOnWriteBuffer buf(std::move(buffer));
+  EXPECT_EQ(buf.size(), 3u);
+  EXPECT_EQ(buf.capacity(), 10u);
+  EXPECT_EQ(buf.cdata(), data);
+  // The storage is not shared, so writing doesn't copy it.
+  EXPECT_EQ(buf.MutableData(), data);
+}
+
+TEST(CopyOnWriteBufferTest, ConstructFromEmptyBuffer) {
+  CopyOnWriteBuffer buf{Buffer()};
+  EXPECT_TRUE(buf.empty());
+  EXPECT_EQ(buf.capacity(), 0u);
+}
+
 TEST(CopyOnWriteBufferTest, TestMoveAssign) {
   CopyOnWriteBuffer buf1(kTestData, 3, 10);
   size_t buf1_size = buf1.size();
@@ -0,0 +1,327 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/io_uring_poller.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace rtc {
+namespace {
+
+int IoUringSetup(uint32_t entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int ring_fd,
+                 uint32_t to_submit,
+                 uint32_t min_complete,
+                 uint32_t flags,
+                 const void* arg,
+                 size_t arg_size) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, ring_fd, to_submit,
+                                  min_complete, flags, arg, arg_size));
+}
+
+void* MapRing(int ring_fd, size_t size, off_t offset) {
+  void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, ring_fd, offset);
+  return ptr == MAP_FAILED ? nullptr : ptr;
+}
+
+template <typename T>
+T* RingField(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<uint8_t*>(ring) + offset);
+}
+
+}  // namespace
+
+std::unique_ptr<IoUringPoller> IoUringPoller::Create(uint32_t entries) {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  const int ring_fd = IoUringSetup(entries, &params);
+  if (ring_fd < 0) {
+    RTC_LOG_E(LS_INFO, EN, errno) << "io_uring_setup";
+    return nullptr;
+  }
+  // Waiting with a timeout relies on IORING_ENTER_EXT_ARG (Linux 5.11), and
+  // completions must not be dropped when the completion queue overflows.
+  constexpr uint32_t kRequiredFeatures =
+      IORING_FEAT_EXT_ARG | IORING_FEAT_NODROP;
+  if ((params.features & kRequiredFeatures) != kRequiredFeatures) {
+    RTC_LOG(LS_INFO) << "io_uring lacks required features, features="
+                     << params.features;
+    close(ring_fd);
+    return nullptr;
+  }
+  std::unique_ptr<IoUringPoller> poller(new IoUringPoller(ring_fd));
+  if (!poller->Init(params)) {
+    return nullptr;
+  }
+  return poller;
+}
+
+IoUringPoller::IoUringPoller(int ring_fd) : ring_fd_(ring_fd) {}
+
+IoUringPoller::~IoUringPoller() {
+  if (sqes_) {
+    munmap(sqes_, sqes_size_);
+  }
+  if (cq_ring_ && cq_ring_ != sq_ring_) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sq_ring_) {
+    munmap(sq_ring_, sq_ring_size_);
+  }
+  close(ring_fd_);
+}
+
+bool IoUringPoller::Init(const io_uring_params& params) {
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cq_ring_size_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+  sq_ring_ = MapRing(ring_fd_, sq_ring_size_, IORING_OFF_SQ_RING);
+  if (!sq_ring_) {
+    RTC_LOG_E(LS_ERROR, EN, errno) << "mmap io_uring submission queue";
+    return false;
+  }
+  cq_ring_ = single_mmap
+                 ? sq_ring_
+                 : MapRing(ring_fd_, cq_ring_size_, IORING_OFF_CQ_RING);
+  if (!cq_ring_) {
+    RTC_LOG_E(LS_ERROR, EN, errno) << "mmap io_uring completion queue";
+    return false;
+  }
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  sqes_ = static_cast<io_uring_sqe*>(
+      MapRing(ring_fd_, sqes_size_, IORING_OFF_SQES));
+  if (!sqes_) {
+    RTC_LOG_E(LS_ERROR, EN, errno) << "mmap io_uring submission entries";
+    return false;
+  }
+
+  sq_head_ = RingField<uint32_t>(sq_ring_, params.sq_off.head);
+  sq_tail_ = RingField<uint32_t>(sq_ring_, params.sq_off.tail);
+  sq_mask_ = *RingField<uint32_t>(sq_ring_, params.sq_off.ring_mask);
+  sq_entries_ = *RingField<uint32_t>(sq_ring_, params.sq_off.ring_entries);
+  sq_array_ = RingField<uint32_t>(sq_ring_, params.sq_off.array);
+  cq_head_ = RingField<uint32_t>(cq_ring_, params.cq_off.head);
+  cq_tail_ = RingField<uint32_t>(cq_ring_, params.cq_off.tail);
+  cq_mask_ = *RingField<uint32_t>(cq_ring_, params.cq_off.ring_mask);
+  cqes_ = RingField<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+  return true;
+}
+
+void IoUringPoller::Arm(uint64_t key, int fd, uint32_t poll_mask) {
+  PollState& state = polls_[key];
+  if (state.armed_id != 0) {
+    if (state.fd == fd && state.armed_mask == poll_mask) {
+      state.mask = poll_mask;
+      return;
+    }
+    CancelPoll(state);
+  }
+  state.fd = fd;
+  state.mask = poll_mask;
+  if (poll_mask != 0) {
+    ArmPoll(key, state);
+  }
+}
+
+void IoUringPoller::Remove(uint64_t key) {
+  auto it = polls_.find(key);
+  if (it == polls_.end()) {
+    return;
+  }
+  if (it->second.armed_id != 0) {
+    CancelPoll(it->second);
+  }
+  polls_.erase(it);
+}
+
+void IoUringPoller::Flush() {
+  const uint32_t to_submit = PendingSubmissions();
+  if (to_submit == 0) {
+    return;
+  }
+  if (IoUringEnter(ring_fd_, to_submit, 0, 0, nullptr, 0) < 0) {
+    RTC_LOG_E(LS_ERROR, EN, errno) << "io_uring_enter";
+  }
+}
+
+bool IoUringPoller::Enter(int timeout_ms) {
+  const uint32_t to_submit = PendingSubmissions();
+  // Don't block if completions are already waiting to be processed.
+  const bool has_completions =
+      __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE) != *cq_head_;
+  const uint32_t min_complete = has_completions ? 0 : 1;
+
+  __kernel_timespec timeout = {.tv_sec = timeout_ms / 1000,
+                               .tv_nsec = (timeout_ms % 1000) * 1000000};
+  io_uring_getevents_arg arg;
+  memset(&arg, 0, sizeof(arg));
+  arg.ts = reinterpret_cast<uint64_t>(&timeout);
+  const bool has_timeout = timeout_ms >= 0;
+
+  int res = IoUringEnter(
+      ring_fd_, to_submit, min_complete,
+      IORING_ENTER_GETEVENTS | (has_timeout ? IORING_ENTER_EXT_ARG : 0),
+      has_timeout ? &arg : nullptr, has_timeout ? sizeof(arg) : 0);
+  if (res < 0 && errno != ETIME && errno != EINTR) {
+    RTC_LOG_E(LS_ERROR, EN, errno) << "io_uring_enter";
+    return false;
+  }
+  return true;
+}
+
+size_t IoUringPoller::ReapCompletions(rtc::ArrayView<Event> events) {
+  reported_keys_.clear();
+  size_t count = 0;
+  uint32_t head = *cq_head_;
+  const uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  while (head != tail && count < events.size()) {
+    const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+    const uint64_t poll_id = cqe.user_data;
+    const int32_t res = cqe.res;
+    ++head;
+
+    // Completions of poll removals and of cancelled polls are not tracked.
+    auto id_it = key_by_poll_id_.find(poll_id);
+    if (id_it == key_by_poll_id_.end()) {
+      continue;
+    }
+    const uint64_t key = id_it->second;
+    key_by_poll_id_.erase(id_it);
+    auto it = polls_.find(key);
+    if (it == polls_.end() || it->second.armed_id != poll_id) {
+      continue;
+    }
+    it->second.armed_id = 0;
+    it->second.armed_mask = 0;
+    reported_keys_.push_back(key);
+    if (res == -ECANCELED) {
+      continue;
+    }
+    // A failed poll request (e.g. the descriptor was closed) is reported as
+    // an error on the descriptor.
+    events[count++] = {.key = key,
+                       .revents = res < 0 ? POLLERR : static_cast<uint32_t>(res)};
+  }
+  __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  return count;
+}
+
+void IoUringPoller::RearmReported() {
+  for (uint64_t key : reported_keys_) {
+    auto it = polls_.find(key);
+    // The key may have been removed, or re-armed already by Arm().
+    if (it != polls_.end() && it->second.armed_id == 0 &&
+        it->second.mask != 0) {
+      ArmPoll(key, it->second);
+    }
+  }
+  reported_keys_.clear();
+}
+
+void IoUringPoller::ArmDeferred() {
+  if (deferred_keys_.empty()) {
+    return;
+  }
+  std::vector<uint64_t> keys;
+  keys.swap(deferred_keys_);
+  for (uint64_t key : keys) {
+    auto it = polls_.find(key);
+    // The key may have been removed or armed by Arm() in the meantime.
+    if (it != polls_.end() && it->second.armed_id == 0 &&
+        it->second.mask != 0) {
+      ArmPoll(key, it->second);
+    }
+  }
+}
+
+io_uring_sqe* IoUringPoller::GetSqe() {
+  // Only the (serialized) submitting side writes the tail.
+  const uint32_t tail = *sq_tail_;
+  if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+    Flush();
+    if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+      return nullptr;
+    }
+  }
+  const uint32_t index = tail & sq_mask_;
+  io_uring_sqe* sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sq_array_[index] = index;
+  return sqe;
+}
+
+void IoUringPoller::ArmPoll(uint64_t key, PollState& state) {
+  io_uring_sqe* sqe = GetSqe();
+  if (!sqe) {
+    RTC_LOG(LS_WARNING) << "io_uring submission queue full, deferring poll";
+    deferred_keys_.push_back(key);
+    return;
+  }
+  const uint64_t poll_id = next_poll_id_++;
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = state.fd;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  sqe->poll32_events = __builtin_bswap32(state.mask);
+#else
+  sqe->poll32_events = state.mask;
+#endif
+  sqe->user_data = poll_id;
+  // Publish the entry only once it is fully written; Enter() may be
+  // submitting concurrently.
+  __atomic_store_n(sq_tail_, *sq_tail_ + 1, __ATOMIC_RELEASE);
+
+  state.armed_id = poll_id;
+  state.armed_mask = state.mask;
+  key_by_poll_id_.emplace(poll_id, key);
+}
+
+void IoUringPoller::CancelPoll(PollState& state) {
+  RTC_DCHECK_NE(state.armed_id, 0);
+  key_by_poll_id_.erase(state.armed_id);
+  io_uring_sqe* sqe = GetSqe();
+  if (sqe) {
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = state.armed_id;
+    // Poll ids start at 1, so the removal's own completion is never matched.
+    sqe->user_data = 0;
+    __atomic_store_n(sq_tail_, *sq_tail_ + 1, __ATOMIC_RELEASE);
+  } else {
+    // The stale poll completes eventually and is ignored.
+    RTC_LOG(LS_ERROR) << "io_uring submission queue full";
+  }
+  state.armed_id = 0;
+  state.armed_mask = 0;
+}
+
+uint32_t IoUringPoller::PendingSubmissions() const {
+  return __atomic_load_n(sq_tail_, __ATOMIC_ACQUIRE) -
+         __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+}
+
+}  // namespace rtc
@@ -0,0 +1,133 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_IO_URING_POLLER_H_
+#define RTC_BASE_IO_URING_POLLER_H_
+
+#include <linux/io_uring.h>
+
+#if !defined(IORING_FEAT_EXT_ARG)
+#error "rtc_use_io_uring requires Linux 5.11 or later UAPI headers."
+#endif
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "api/array_view.h"
+
+namespace rtc {
+
+// Level-triggered readiness notification for file descriptors, built on
+// io_uring one-shot poll requests. Used by PhysicalSocketServer as an
+// alternative to epoll: arming, re-arming and waiting for completions are
+// batched into a single io_uring_enter() call per loop iteration instead of
+// one epoll_ctl() per interest change plus one epoll_wait().
+//
+// Each registered descriptor is identified by a caller chosen `key`. After a
+// completion for a key has been handled, the poll is re-armed with the latest
+// mask passed to Arm(), which gives the same level-triggered semantics as
+// epoll.
+//
+// Not thread safe. All calls except Enter() must be serialized by the caller.
+// Enter() may run concurrently with the other calls.
+class IoUringPoller {
+ public:
+  // Returns null if io_uring is not supported by the kernel (5.11 or later is
+  // required for IORING_FEAT_EXT_ARG) or is disabled by a seccomp policy.
+  static std::unique_ptr<IoUringPoller> Create(uint32_t entries = 256);
+
+  ~IoUringPoller();
+
+  IoUringPoller(const IoUringPoller&) = delete;
+  IoUringPoller& operator=(const IoUringPoller&) = delete;
+
+  // Sets the poll events (POLLIN, POLLOUT...) of interest for `fd`. A zero
+  // `poll_mask` disarms the descriptor without forgetting it. The request is
+  // queued and submitted by the next Flush() or Enter().
+  void Arm(uint64_t key, int fd, uint32_t poll_mask);
+  // Forgets `key`, cancelling its outstanding poll request if any.
+  void Remove(uint64_t key);
+
+  // Submits all queued requests without waiting.
+  void Flush();
+  // Submits all queued requests and blocks until at least one completion is
+  // available or `timeout_ms` expires (-1 waits forever). Returns false on
+  // error other than EINTR or a timeout.
+  bool Enter(int timeout_ms);
+  struct Event {
+    uint64_t key;
+    uint32_t revents;
+  };
+  // Moves up to `events.size()` available poll completions into `events` and
+  // returns their number. Reported descriptors stay disarmed until
+  // RearmReported() unless Arm() is called for them first.
+  size_t ReapCompletions(rtc::ArrayView<Event> events);
+  // Re-arms the descriptors reported by the last ReapCompletions() with their
+  // latest mask, which emulates level triggering.
+  void RearmReported();
+  // Queues the polls that could not be queued earlier because the submission
+  // queue was full. Must be called before Enter() so that those descriptors
+  // are watched during the wait.
+  void ArmDeferred();
+
+ private:
+  struct PollState {
+    int fd = -1;
+    // Events last requested by Arm().
+    uint32_t mask = 0;
+    // User data of the outstanding poll request, zero if none.
+    uint64_t armed_id = 0;
+    uint32_t armed_mask = 0;
+  };
+
+  explicit IoUringPoller(int ring_fd);
+  bool Init(const io_uring_params& params);
+
+  io_uring_sqe* GetSqe();
+  void ArmPoll(uint64_t key, PollState& state);
+  void CancelPoll(PollState& state);
+  uint32_t PendingSubmissions() const;
+
+  const int ring_fd_;
+
+  // Mapped ring memory.
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  uint32_t* sq_array_ = nullptr;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+
+  // Poll request user data is unique so that completions of cancelled
+  // requests can be told apart from those of the current one.
+  uint64_t next_poll_id_ = 1;
+  std::unordered_map<uint64_t, PollState> polls_;
+  std::unordered_map<uint64_t, uint64_t> key_by_poll_id_;
+  std::vector<uint64_t> reported_keys_;
+  // Keys whose poll could not be queued because the submission queue was
+  // full. They are armed again before the next submission.
+  std::vector<uint64_t> deferred_keys_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_IO_URING_POLLER_H_
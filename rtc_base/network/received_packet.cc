@@ -13,6 +13,8 @@
 #include <utility>
 
 #include "absl/types/optional.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/socket_address.h"
 
 namespace rtc {
@@ -30,8 +32,30 @@ ReceivedPacket::ReceivedPacket(rtc::ArrayView<const uint8_t> payload,
 
 ReceivedPacket ReceivedPacket::CopyAndSet(
     DecryptionInfo decryption_info) const {
-  return ReceivedPacket(payload_, source_address_, arrival_time_, ecn_,
+  ReceivedPacket packet(payload_, source_address_, arrival_time_, ecn_,
                         decryption_info);
+  packet.payload_storage_ = payload_storage_;
+  return packet;
+}
+
+rtc::CopyOnWriteBuffer ReceivedPacket::PayloadStorage::Take(
+    rtc::ArrayView<const uint8_t> payload) {
+  // Taking over the storage empties the buffer, which is how a second take,
+  // through the same packet or any of its copies, is detected.
+  RTC_DCHECK(payload.empty() ||
+             (payload.data() >= buffer_.data() &&
+              payload.data() + payload.size() <=
+                  buffer_.data() + buffer_.size()))
+      << "The payload is not held by this storage or has already been taken.";
+  if (payload.empty() || 2 * payload.size() < buffer_.capacity()) {
+    return rtc::CopyOnWriteBuffer(payload.data(), payload.size());
+  }
+  const size_t offset = payload.data() - buffer_.data();
+  // The slice ends up as the only reference to the storage, so writing to it,
+  // e.g. to decrypt in place, doesn't copy either. The buffer is left empty
+  // rather than moved-from, for the socket to refill.
+  return rtc::CopyOnWriteBuffer(std::exchange(buffer_, rtc::Buffer()))
+      .Slice(offset, payload.size());
 }
 
 // static
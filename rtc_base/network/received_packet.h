@@ -15,6 +15,8 @@
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "api/units/timestamp.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/system/rtc_export.h"
@@ -44,6 +46,36 @@ class RTC_EXPORT ReceivedPacket {
 
   ReceivedPacket CopyAndSet(DecryptionInfo decryption_info) const;
 
+  // Storage for received payloads, owned by the socket that reads into it.
+  // The final consumer of a packet may take the storage over, so that the
+  // payload isn't copied.
+  class PayloadStorage {
+   public:
+    explicit PayloadStorage(size_t capacity) : buffer_(0, capacity) {}
+
+    // The buffer to read into. Its capacity is 0 once it has been taken.
+    rtc::Buffer& buffer() { return buffer_; }
+
+    // Hands `payload`, which must lie within buffer(), over to the caller.
+    // The storage is taken over if the payload fills at least half of it.
+    // A smaller payload is copied into a buffer of its own, so that it
+    // doesn't keep the whole storage alive, and the storage is left for the
+    // next read.
+    rtc::CopyOnWriteBuffer Take(rtc::ArrayView<const uint8_t> payload);
+
+   private:
+    rtc::Buffer buffer_;
+  };
+
+  // Sets the storage holding the payload. It must stay valid for the
+  // lifetime of this ReceivedPacket and of all its copies.
+  void set_payload_storage(PayloadStorage* storage) {
+    payload_storage_ = storage;
+  }
+  // Storage holding the payload, which only the final consumer of the packet
+  // may take, or nullptr if the payload has to be copied.
+  PayloadStorage* payload_storage() const { return payload_storage_; }
+
   // Address/port of the packet sender.
   const SocketAddress& source_address() const { return source_address_; }
   rtc::ArrayView<const uint8_t> payload() const { return payload_; }
@@ -80,6 +112,7 @@ class RTC_EXPORT ReceivedPacket {
   const SocketAddress& source_address_;
   EcnMarking ecn_;
   DecryptionInfo decryption_info_;
+  PayloadStorage* payload_storage_ = nullptr;
 };
 
 }  // namespace rtc
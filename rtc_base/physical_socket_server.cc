@@ -9,7 +9,10 @@
  */
 #include "rtc_base/physical_socket_server.h"
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <cstring>
 #include <utility>
 
 #if defined(_MSC_VER) && _MSC_VER < 1300
@@ -56,6 +59,11 @@
 
 #if defined(WEBRTC_LINUX)
 #include <linux/sockios.h>
+
+// UDP generic segmentation offload, available since Linux 4.18.
+#if !defined(UDP_SEGMENT)
+#define UDP_SEGMENT 103
+#endif  // !defined(UDP_SEGMENT)
 #endif
 
 #if defined(WEBRTC_WIN)
@@ -134,6 +142,35 @@ rtc::EcnMarking EcnFromDs(uint8_t ds) {
   return rtc::EcnMarking::kNotEct;
 }
 
+// TODO(bugs.webrtc.org/15368): What size is needed? IPV6_TCLASS is supposed
+// to be an int. Why is a larger size needed?
+constexpr size_t kControlBufferSize =
+    CMSG_SPACE(sizeof(struct timeval) + 5 * sizeof(int));
+
+// Extracts the receive timestamp and ECN marking from the ancillary data of a
+// received message. `timestamp` and `ecn` may be null if not requested.
+void ParseControlMessages(msghdr& msg,
+                          int64_t* timestamp,
+                          rtc::EcnMarking* ecn) {
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+       cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (ecn) {
+      if ((cmsg->cmsg_type == IPV6_TCLASS &&
+           cmsg->cmsg_level == IPPROTO_IPV6) ||
+          (cmsg->cmsg_type == IP_TOS && cmsg->cmsg_level == IPPROTO_IP)) {
+        *ecn = EcnFromDs(CMSG_DATA(cmsg)[0]);
+      }
+    }
+    if (cmsg->cmsg_level != SOL_SOCKET)
+      continue;
+    if (timestamp && cmsg->cmsg_type == SCM_TIMESTAMP) {
+      timeval* ts = reinterpret_cast<timeval*>(CMSG_DATA(cmsg));
+      *timestamp = rtc::kNumMicrosecsPerSec * static_cast<int64_t>(ts->tv_sec) +
+                   static_cast<int64_t>(ts->tv_usec);
+    }
+  }
+}
+
 #endif
 
 class ScopedSetTrue {
@@ -436,6 +473,127 @@ int PhysicalSocket::SendTo(const void* buffer,
   return sent;
 }
 
+int PhysicalSocket::SendToBatch(rtc::ArrayView<const OutgoingPacket> packets) {
+#if defined(WEBRTC_LINUX)
+  if (!udp_ || packets.size() <= 1) {
+    return Socket::SendToBatch(packets);
+  }
+  // Packets beyond `kMaxSendBatchSize` are left to the caller to resend.
+  packets = packets.subview(0, kMaxSendBatchSize);
+  if (gso_enabled_ && CanSendWithGso(packets)) {
+    int sent = DoSendWithGso(packets);
+    if (sent >= 0) {
+      return sent;
+    }
+    if (IsBlockingError(GetError())) {
+      EnableEvents(DE_WRITE);
+      return sent;
+    }
+    // Kernel or device without UDP GSO support, or GSO not usable on the
+    // route (e.g. no checksum offload). Fall back to sendmmsg for the
+    // lifetime of this socket.
+    RTC_LOG(LS_INFO) << "UDP GSO send failed with error " << GetError()
+                     << ", falling back to sendmmsg.";
+    gso_enabled_ = false;
+  }
+
+  std::array<mmsghdr, kMaxSendBatchSize> msgs;
+  std::array<iovec, kMaxSendBatchSize> iovs;
+  std::array<sockaddr_storage, kMaxSendBatchSize> addrs;
+  for (size_t i = 0; i < packets.size(); ++i) {
+    iovs[i] = {.iov_base = const_cast<uint8_t*>(packets[i].payload.data()),
+               .iov_len = packets[i].payload.size()};
+    msgs[i] = {};
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_hdr.msg_name = &addrs[i];
+    msgs[i].msg_hdr.msg_namelen =
+        packets[i].address.ToSockAddrStorage(&addrs[i]);
+  }
+  int sent = ::sendmmsg(s_, msgs.data(), packets.size(),
+#if !defined(WEBRTC_ANDROID)
+                        // Suppress SIGPIPE. See above for explanation.
+                        MSG_NOSIGNAL
+#else
+                        0
+#endif
+  );
+  UpdateLastError();
+  if (sent < 0 && GetError() == ENOSYS) {
+    return Socket::SendToBatch(packets);
+  }
+  MaybeRemapSendError();
+  if ((sent >= 0 && sent < static_cast<int>(packets.size())) ||
+      (sent < 0 && IsBlockingError(GetError()))) {
+    EnableEvents(DE_WRITE);
+  }
+  return sent;
+#else
+  return Socket::SendToBatch(packets);
+#endif
+}
+
+#if defined(WEBRTC_LINUX)
+bool PhysicalSocket::CanSendWithGso(
+    rtc::ArrayView<const OutgoingPacket> packets) const {
+  // The kernel splits a GSO send into segments of equal size, only the last
+  // one may be shorter. All segments share one destination.
+  constexpr size_t kMaxGsoSegments = 64;
+  constexpr size_t kMaxGsoPayloadSize = 0xffff - 8 - 40;
+  if (packets.size() > kMaxGsoSegments) {
+    return false;
+  }
+  const size_t segment_size = packets[0].payload.size();
+  size_t total_size = 0;
+  for (size_t i = 0; i < packets.size(); ++i) {
+    const size_t size = packets[i].payload.size();
+    if (size == 0 || packets[i].address != packets[0].address ||
+        size > segment_size ||
+        (size < segment_size && i + 1 < packets.size())) {
+      return false;
+    }
+    total_size += size;
+  }
+  return total_size <= kMaxGsoPayloadSize;
+}
+
+int PhysicalSocket::DoSendWithGso(
+    rtc::ArrayView<const OutgoingPacket> packets) {
+  std::array<iovec, kMaxSendBatchSize> iovs;
+  for (size_t i = 0; i < packets.size(); ++i) {
+    iovs[i] = {.iov_base = const_cast<uint8_t*>(packets[i].payload.data()),
+               .iov_len = packets[i].payload.size()};
+  }
+  sockaddr_storage addr;
+  char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+  msghdr msg = {};
+  msg.msg_name = &addr;
+  msg.msg_namelen = packets[0].address.ToSockAddrStorage(&addr);
+  msg.msg_iov = iovs.data();
+  msg.msg_iovlen = packets.size();
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = IPPROTO_UDP;
+  cmsg->cmsg_type = UDP_SEGMENT;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+  const uint16_t segment_size =
+      static_cast<uint16_t>(packets[0].payload.size());
+  memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+
+  int sent = ::sendmsg(s_, &msg,
+#if !defined(WEBRTC_ANDROID)
+                       MSG_NOSIGNAL
+#else
+                       0
+#endif
+  );
+  UpdateLastError();
+  MaybeRemapSendError();
+  return sent < 0 ? sent : static_cast<int>(packets.size());
+}
+#endif  // WEBRTC_LINUX
+
 int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
   int received = DoReadFromSocket(buffer, length, /*out_addr*/ nullptr,
                                   timestamp, /*ecn=*/nullptr);
@@ -505,6 +663,77 @@ int PhysicalSocket::RecvFrom(ReceiveBuffer& buffer) {
   return received;
 }
 
+int PhysicalSocket::RecvFromBatch(rtc::ArrayView<ReceiveBuffer> buffers) {
+#if defined(WEBRTC_LINUX)
+  if (!udp_ || buffers.size() <= 1) {
+    return Socket::RecvFromBatch(buffers);
+  }
+  // Messages beyond `kMaxRecvBatchSize` are left for the next read event.
+  const size_t batch_size = std::min(buffers.size(), kMaxRecvBatchSize);
+  std::array<mmsghdr, kMaxRecvBatchSize> msgs;
+  // Each datagram is read into its buffer and spills over into its own slice
+  // of the socket server's spill-over buffer, so that datagrams larger than
+  // the buffer aren't truncated. The spill-over memory is only touched by such
+  // datagrams.
+  std::array<std::array<iovec, 2>, kMaxRecvBatchSize> iovs;
+  uint8_t* const spill = ss_->RecvSpillBuffer();
+  std::array<sockaddr_storage, kMaxRecvBatchSize> addrs;
+  std::array<std::array<char, kControlBufferSize>, kMaxRecvBatchSize> controls;
+  for (size_t i = 0; i < batch_size; ++i) {
+    ReceiveBuffer& buffer = buffers[i];
+    if (buffer.payload.capacity() == 0) {
+      buffer.payload.EnsureCapacity(kDefaultRecvBatchBufferSize);
+    }
+    iovs[i][0] = {.iov_base = buffer.payload.data(),
+                  .iov_len = buffer.payload.capacity()};
+    iovs[i][1] = {.iov_base = &spill[i * kMaxUdpPayloadSize],
+                  .iov_len = kMaxUdpPayloadSize};
+    msgs[i] = {};
+    msgs[i].msg_hdr.msg_iov = iovs[i].data();
+    msgs[i].msg_hdr.msg_iovlen = iovs[i].size();
+    msgs[i].msg_hdr.msg_name = &addrs[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+    msgs[i].msg_hdr.msg_control = controls[i].data();
+    msgs[i].msg_hdr.msg_controllen = controls[i].size();
+  }
+
+  int received = ::recvmmsg(s_, msgs.data(), batch_size, 0, nullptr);
+  UpdateLastError();
+  if (received < 0 && GetError() == ENOSYS) {
+    return Socket::RecvFromBatch(buffers);
+  }
+  for (int i = 0; i < received; ++i) {
+    ReceiveBuffer& buffer = buffers[i];
+    msghdr& hdr = msgs[i].msg_hdr;
+    const size_t capacity = buffer.payload.capacity();
+    if (msgs[i].msg_len > capacity) {
+      // Rare: the datagram did not fit the buffer. Grow the buffer and move
+      // the part that spilled over into it.
+      buffer.payload.SetSize(capacity);
+      buffer.payload.AppendData(&spill[i * kMaxUdpPayloadSize],
+                                msgs[i].msg_len - capacity);
+    } else {
+      buffer.payload.SetSize(msgs[i].msg_len);
+    }
+    int64_t timestamp = -1;
+    ParseControlMessages(hdr, &timestamp, ecn_ ? &buffer.ecn : nullptr);
+    if (timestamp != -1) {
+      buffer.arrival_time = webrtc::Timestamp::Micros(timestamp);
+    }
+    SocketAddressFromSockAddrStorage(addrs[i], &buffer.source_address);
+  }
+
+  bool success = (received >= 0) || IsBlockingError(GetError());
+  EnableEvents(DE_READ);
+  if (!success) {
+    RTC_LOG_F(LS_VERBOSE) << "Error = " << GetError();
+  }
+  return received;
+#else
+  return Socket::RecvFromBatch(buffers);
+#endif
+}
+
 int PhysicalSocket::DoReadFromSocket(void* buffer,
                                      size_t length,
                                      SocketAddress* out_addr,
@@ -525,7 +754,7 @@ int PhysicalSocket::DoReadFromSocket(void* buffer,
   }
     // TODO(bugs.webrtc.org/15368): What size is needed? IPV6_TCLASS is supposed
     // to be an int. Why is a larger size needed?
-    char control[CMSG_SPACE(sizeof(struct timeval) + 5 * sizeof(int))] = {};
+    char control[kControlBufferSize] = {};
     if (timestamp || ecn) {
       *timestamp = -1;
       msg.msg_control = &control;
@@ -537,24 +766,7 @@ int PhysicalSocket::DoReadFromSocket(void* buffer,
       return received;
     }
     if (timestamp || ecn) {
-      struct cmsghdr* cmsg;
-      for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
-        if (ecn) {
-          if ((cmsg->cmsg_type == IPV6_TCLASS &&
-               cmsg->cmsg_level == IPPROTO_IPV6) ||
-              (cmsg->cmsg_type == IP_TOS && cmsg->cmsg_level == IPPROTO_IP)) {
-            *ecn = EcnFromDs(CMSG_DATA(cmsg)[0]);
-          }
-        }
-        if (cmsg->cmsg_level != SOL_SOCKET)
-          continue;
-        if (timestamp && cmsg->cmsg_type == SCM_TIMESTAMP) {
-          timeval* ts = reinterpret_cast<timeval*>(CMSG_DATA(cmsg));
-          *timestamp =
-              rtc::kNumMicrosecsPerSec * static_cast<int64_t>(ts->tv_sec) +
-              static_cast<int64_t>(ts->tv_usec);
-        }
-      }
+      ParseControlMessages(msg, timestamp, ecn);
     }
     if (out_addr) {
       SocketAddressFromSockAddrStorage(addr_storage, out_addr);
@@ -1252,19 +1464,31 @@ class Signaler : public Dispatcher {
 #endif  // WEBRTC_WIN
 
 PhysicalSocketServer::PhysicalSocketServer()
+    : PhysicalSocketServer(EventBackend::kDefault) {}
+
+PhysicalSocketServer::PhysicalSocketServer(EventBackend backend)
     :
+#if defined(WEBRTC_USE_IO_URING)
+      io_uring_(backend == EventBackend::kIoUring ? IoUringPoller::Create()
+                                                  : nullptr),
+#endif
 #if defined(WEBRTC_USE_EPOLL)
       // Since Linux 2.6.8, the size argument is ignored, but must be greater
       // than zero. Before that the size served as hint to the kernel for the
       // amount of space to initially allocate in internal data structures.
-      epoll_fd_(epoll_create(FD_SETSIZE)),
+      epoll_fd_(event_backend() == EventBackend::kIoUring
+                    ? INVALID_SOCKET
+                    : epoll_create(FD_SETSIZE)),
 #endif
 #if defined(WEBRTC_WIN)
       socket_ev_(WSACreateEvent()),
 #endif
       fWait_(false) {
+  if (backend != event_backend()) {
+    RTC_LOG(LS_WARNING) << "io_uring not available, using default backend.";
+  }
 #if defined(WEBRTC_USE_EPOLL)
-  if (epoll_fd_ == -1) {
+  if (event_backend() == EventBackend::kDefault && epoll_fd_ == -1) {
     // Not an error, will fall back to "select" below.
     RTC_LOG_E(LS_WARNING, EN, errno) << "epoll_create";
     // Note that -1 == INVALID_SOCKET, the alias used by later checks.
@@ -1322,6 +1546,16 @@ void PhysicalSocketServer::Add(Dispatcher* pdispatcher) {
   uint64_t key = next_dispatcher_key_++;
   dispatcher_by_key_.emplace(key, pdispatcher);
   key_by_dispatcher_.emplace(pdispatcher, key);
+#if defined(WEBRTC_USE_IO_URING)
+  if (io_uring_) {
+    io_uring_->Arm(key, pdispatcher->GetDescriptor(),
+                   GetEpollEvents(pdispatcher->GetRequestedEvents()));
+    if (!io_uring_dispatching_) {
+      io_uring_->Flush();
+    }
+    return;
+  }
+#endif  // WEBRTC_USE_IO_URING
 #if defined(WEBRTC_USE_EPOLL)
   if (epoll_fd_ != INVALID_SOCKET) {
     AddEpoll(pdispatcher, key);
@@ -1340,6 +1574,15 @@ void PhysicalSocketServer::Remove(Dispatcher* pdispatcher) {
   uint64_t key = key_by_dispatcher_.at(pdispatcher);
   key_by_dispatcher_.erase(pdispatcher);
   dispatcher_by_key_.erase(key);
+#if defined(WEBRTC_USE_IO_URING)
+  if (io_uring_) {
+    io_uring_->Remove(key);
+    if (!io_uring_dispatching_) {
+      io_uring_->Flush();
+    }
+    return;
+  }
+#endif  // WEBRTC_USE_IO_URING
 #if defined(WEBRTC_USE_EPOLL)
   if (epoll_fd_ != INVALID_SOCKET) {
     RemoveEpoll(pdispatcher);
@@ -1349,7 +1592,8 @@ void PhysicalSocketServer::Remove(Dispatcher* pdispatcher) {
 
 void PhysicalSocketServer::Update(Dispatcher* pdispatcher) {
 #if defined(WEBRTC_USE_EPOLL)
-  if (epoll_fd_ == INVALID_SOCKET) {
+  if (event_backend() == EventBackend::kDefault &&
+      epoll_fd_ == INVALID_SOCKET) {
     return;
   }
 
@@ -1359,10 +1603,41 @@ void PhysicalSocketServer::Update(Dispatcher* pdispatcher) {
     return;
   }
 
+#if defined(WEBRTC_USE_IO_URING)
+  if (io_uring_) {
+    io_uring_->Arm(key_by_dispatcher_.at(pdispatcher),
+                   pdispatcher->GetDescriptor(),
+                   GetEpollEvents(pdispatcher->GetRequestedEvents()));
+    if (!io_uring_dispatching_) {
+      io_uring_->Flush();
+    }
+    return;
+  }
+#endif  // WEBRTC_USE_IO_URING
+
   UpdateEpoll(pdispatcher, key_by_dispatcher_.at(pdispatcher));
 #endif
 }
 
+PhysicalSocketServer::EventBackend PhysicalSocketServer::event_backend()
+    const {
+#if defined(WEBRTC_USE_IO_URING)
+  if (io_uring_) {
+    return EventBackend::kIoUring;
+  }
+#endif
+  return EventBackend::kDefault;
+}
+
+uint8_t* PhysicalSocketServer::RecvSpillBuffer() {
+  if (!recv_spill_buffer_) {
+    recv_spill_buffer_.reset(
+        new uint8_t[PhysicalSocket::kMaxRecvBatchSize *
+                    PhysicalSocket::kMaxUdpPayloadSize]);
+  }
+  return recv_spill_buffer_.get();
+}
+
 int PhysicalSocketServer::ToCmsWait(webrtc::TimeDelta max_wait_duration) {
   return max_wait_duration == Event::kForever
              ? kForeverMs
@@ -1387,7 +1662,13 @@ bool PhysicalSocketServer::Wait(webrtc::TimeDelta max_wait_duration,
   // "select" to support sockets larger than FD_SETSIZE.
   if (!process_io) {
     return WaitPollOneDispatcher(cmsWait, signal_wakeup_);
-  } else if (epoll_fd_ != INVALID_SOCKET) {
+  }
+#if defined(WEBRTC_USE_IO_URING)
+  if (io_uring_) {
+    return WaitIoUring(cmsWait);
+  }
+#endif
+  if (epoll_fd_ != INVALID_SOCKET) {
     return WaitEpoll(cmsWait);
   }
 #endif
@@ -1757,6 +2038,60 @@ bool PhysicalSocketServer::WaitEpoll(int cmsWait) {
   return true;
 }
 
+#if defined(WEBRTC_USE_IO_URING)
+bool PhysicalSocketServer::WaitIoUring(int cmsWait) {
+  RTC_DCHECK(io_uring_);
+  int64_t msWait = -1;
+  int64_t msStop = -1;
+  if (cmsWait != kForeverMs) {
+    msWait = cmsWait;
+    msStop = TimeAfter(cmsWait);
+  }
+
+  fWait_ = true;
+  while (fWait_) {
+    {
+      CritScope cr(&crit_);
+      io_uring_->ArmDeferred();
+    }
+    // Submits polls re-armed while dispatching the previous completions and
+    // waits for new ones in the same call.
+    if (!io_uring_->Enter(static_cast<int>(msWait))) {
+      return false;
+    }
+    {
+      CritScope cr(&crit_);
+      io_uring_dispatching_ = true;
+      const size_t n = io_uring_->ReapCompletions(io_uring_events_);
+      for (size_t i = 0; i < n; ++i) {
+        const IoUringPoller::Event& event = io_uring_events_[i];
+        if (!dispatcher_by_key_.count(event.key)) {
+          // The dispatcher for this socket no longer exists.
+          continue;
+        }
+        Dispatcher* pdispatcher = dispatcher_by_key_.at(event.key);
+        pollfd pfd = {.fd = pdispatcher->GetDescriptor(),
+                      .events = 0,
+                      .revents = static_cast<short>(event.revents)};
+        ProcessPollEvents(pdispatcher, pfd);
+      }
+      io_uring_->RearmReported();
+      io_uring_dispatching_ = false;
+    }
+
+    if (cmsWait != kForeverMs) {
+      msWait = TimeDiff(msStop, TimeMillis());
+      if (msWait <= 0) {
+        // Return success on timeout.
+        return true;
+      }
+    }
+  }
+
+  return true;
+}
+#endif  // WEBRTC_USE_IO_URING
+
 bool PhysicalSocketServer::WaitPollOneDispatcher(int cmsWait,
                                                  Dispatcher* dispatcher) {
   RTC_DCHECK(dispatcher);
@@ -47,6 +47,10 @@
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/thread_annotations.h"
 
+#if defined(WEBRTC_USE_IO_URING)
+#include "rtc_base/io_uring_poller.h"
+#endif
+
 #if defined(WEBRTC_POSIX)
 typedef int SOCKET;
 #endif  // WEBRTC_POSIX
@@ -82,7 +86,13 @@ class Dispatcher {
 // A socket server that provides the real sockets of the underlying OS.
 class RTC_EXPORT PhysicalSocketServer : public SocketServer {
  public:
+  // Mechanism used to wait for socket events. kIoUring is only available on
+  // Linux builds with the rtc_use_io_uring GN arg; otherwise, or when the
+  // kernel does not support it, the default (epoll) is used.
+  enum class EventBackend { kDefault, kIoUring };
+
   PhysicalSocketServer();
+  explicit PhysicalSocketServer(EventBackend backend);
   ~PhysicalSocketServer() override;
 
   // SocketFactory:
@@ -99,6 +109,16 @@ class RTC_EXPORT PhysicalSocketServer : public SocketServer {
   void Remove(Dispatcher* dispatcher);
   void Update(Dispatcher* dispatcher);
 
+  // Returns the backend in use, which may differ from the requested one.
+  EventBackend event_backend() const;
+
+  // Returns spill-over space for the datagrams of one
+  // PhysicalSocket::RecvFromBatch() call that are larger than their buffers,
+  // `PhysicalSocket::kMaxUdpPayloadSize` bytes per datagram of a batch. It is
+  // shared by all sockets of this server, which are read on the thread that
+  // runs it, so the memory doesn't grow with the number of sockets.
+  uint8_t* RecvSpillBuffer();
+
  private:
   // The number of events to process with one call to "epoll_wait".
   static constexpr size_t kNumEpollEvents = 128;
@@ -122,6 +142,16 @@ class RTC_EXPORT PhysicalSocketServer : public SocketServer {
   // server can outlive the thread it's bound to, forcing the Wait call
   // to have to reset the sequence checker on Wait calls.
   std::array<epoll_event, kNumEpollEvents> epoll_events_;
+#if defined(WEBRTC_USE_IO_URING)
+  bool WaitIoUring(int cmsWait);
+
+  // Used instead of `epoll_fd_` when io_uring is selected and supported.
+  const std::unique_ptr<IoUringPoller> io_uring_;
+  std::array<IoUringPoller::Event, kNumEpollEvents> io_uring_events_;
+  // True while completions are dispatched, so that re-armed polls are
+  // submitted together by the next wait instead of one syscall each.
+  bool io_uring_dispatching_ RTC_GUARDED_BY(crit_) = false;
+#endif  // WEBRTC_USE_IO_URING
   const int epoll_fd_ = INVALID_SOCKET;
 
 #elif defined(WEBRTC_USE_POLL)
@@ -155,10 +185,20 @@ class RTC_EXPORT PhysicalSocketServer : public SocketServer {
   // Are we currently in a select()/epoll()/WSAWaitForMultipleEvents loop?
   // Used for a DCHECK, because we don't support reentrant waiting.
   bool waiting_ = false;
+  // Allocated on the first batched read and left uninitialized.
+  std::unique_ptr<uint8_t[]> recv_spill_buffer_;
 };
 
 class PhysicalSocket : public Socket, public sigslot::has_slots<> {
  public:
+  // Maximum number of datagrams read by one call to RecvFromBatch().
+  static constexpr size_t kMaxRecvBatchSize = 32;
+  static constexpr size_t kDefaultRecvBatchBufferSize = 2048;
+  // Largest UDP payload, i.e. the largest datagram RecvFromBatch() returns.
+  static constexpr size_t kMaxUdpPayloadSize = 64 * 1024;
+  // Maximum number of packets written by one call to SendToBatch().
+  static constexpr size_t kMaxSendBatchSize = 64;
+
   PhysicalSocket(PhysicalSocketServer* ss, SOCKET s = INVALID_SOCKET);
   ~PhysicalSocket() override;
 
@@ -183,6 +223,9 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
   int SendTo(const void* buffer,
              size_t length,
              const SocketAddress& addr) override;
+  // Uses UDP GSO on Linux when all packets share a destination and segment
+  // size, and sendmmsg otherwise.
+  int SendToBatch(rtc::ArrayView<const OutgoingPacket> packets) override;
 
   int Recv(void* buffer, size_t length, int64_t* timestamp) override;
   // TODO(webrtc:15368): Deprecate and remove.
@@ -191,6 +234,10 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
                SocketAddress* out_addr,
                int64_t* timestamp) override;
   int RecvFrom(ReceiveBuffer& buffer) override;
+  // Uses recvmmsg on Linux UDP sockets. Buffers without preallocated capacity
+  // are sized to `kDefaultRecvBatchBufferSize`; buffers are grown for
+  // datagrams that do not fit.
+  int RecvFromBatch(rtc::ArrayView<ReceiveBuffer> buffers) override;
 
   int Listen(int backlog) override;
   Socket* Accept(SocketAddress* out_addr) override;
@@ -226,6 +273,11 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
 
   void OnResolveResult(const webrtc::AsyncDnsResolverResult& resolver);
 
+#if defined(WEBRTC_LINUX)
+  bool CanSendWithGso(rtc::ArrayView<const OutgoingPacket> packets) const;
+  int DoSendWithGso(rtc::ArrayView<const OutgoingPacket> packets);
+#endif
+
   void UpdateLastError();
   void MaybeRemapSendError();
 
@@ -246,6 +298,9 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
   std::unique_ptr<webrtc::AsyncDnsResolverInterface> resolver_;
   uint8_t dscp_ = 0;  // 6bit.
   uint8_t ecn_ = 0;   // 2bits.
+  // Cleared the first time a UDP GSO send fails for a reason other than a
+  // full send buffer.
+  bool gso_enabled_ = true;
 
 #if !defined(NDEBUG)
   std::string dbg_addr_;
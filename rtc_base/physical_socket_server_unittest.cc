@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <memory>
 
+#include "rtc_base/event.h"
 #include "rtc_base/gunit.h"
 #include "rtc_base/ip_address.h"
 #include "rtc_base/logging.h"
@@ -41,6 +42,24 @@ namespace rtc {
     return;                                    \
   }
 
+// Receiving ECN over IPv4 does not work on every platform, while IPv6 does.
+// TODO(bugs.webrtc.org/15368): Remove once IPv4 works on IOS and MAC.
+namespace {
+bool HasIPv4EcnSupport() {
+#if defined(WEBRTC_MAC) || defined(WEBRTC_IOS)
+  return false;
+#else
+  return true;
+#endif
+}
+}  // namespace
+
+#define MAYBE_SKIP_IPV4_ECN                    \
+  MAYBE_SKIP_IPV4;                             \
+  if (!HasIPv4EcnSupport()) {                  \
+    GTEST_SKIP() << "No IPv4 ECN... skipping"; \
+  }
+
 class PhysicalSocketTest;
 
 class FakeSocketDispatcher : public SocketDispatcher {
@@ -471,19 +490,36 @@ TEST_F(PhysicalSocketTest, TestSocketRecvTimestampIPv6) {
   SocketTest::TestSocketRecvTimestampIPv6();
 }
 
-#if !defined(WEBRTC_MAC) && !defined(WEBRTC_IOS)
-// TODO(bugs.webrtc.org/15368): IpV4 fails on IOS and MAC. IPV6 works.
 TEST_F(PhysicalSocketTest, TestSocketSendRecvWithEcnIPv4) {
-  MAYBE_SKIP_IPV6;
+  MAYBE_SKIP_IPV4_ECN;
   SocketTest::TestSocketSendRecvWithEcnIPV4();
 }
-#endif
 
 TEST_F(PhysicalSocketTest, TestSocketSendRecvWithEcnIPv6) {
   MAYBE_SKIP_IPV6;
   SocketTest::TestSocketSendRecvWithEcnIPV6();
 }
 
+TEST_F(PhysicalSocketTest, TestUdpRecvFromBatchIPv4) {
+  MAYBE_SKIP_IPV4_ECN;
+  SocketTest::TestUdpRecvFromBatchIPv4();
+}
+
+TEST_F(PhysicalSocketTest, TestUdpRecvFromBatchIPv6) {
+  MAYBE_SKIP_IPV6;
+  SocketTest::TestUdpRecvFromBatchIPv6();
+}
+
+TEST_F(PhysicalSocketTest, TestUdpSendToBatchIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestUdpSendToBatchIPv4();
+}
+
+TEST_F(PhysicalSocketTest, TestUdpSendToBatchIPv6) {
+  MAYBE_SKIP_IPV6;
+  SocketTest::TestUdpSendToBatchIPv6();
+}
+
 // Verify that if the socket was unable to be bound to a real network interface
 // (not loopback), Bind will return an error.
 TEST_F(PhysicalSocketTest,
@@ -532,4 +568,236 @@ TEST_F(PhysicalSocketTest, UdpSocketRecvTimestampUseRtcEpochIPv6) {
   SocketTest::TestUdpSocketRecvTimestampUseRtcEpochIPv6();
 }
 
+#if defined(WEBRTC_USE_IO_URING)
+
+// Runs the generic socket tests with the io_uring event backend. Skipped where
+// io_uring can't be set up, e.g. on older kernels or under a seccomp policy
+// that blocks it, since the server then falls back to epoll.
+class IoUringPhysicalSocketTest : public SocketTest {
+ protected:
+  IoUringPhysicalSocketTest()
+      : SocketTest(&server_),
+        server_(PhysicalSocketServer::EventBackend::kIoUring),
+        thread_(&server_) {}
+
+  void SetUp() override {
+    if (server_.event_backend() !=
+        PhysicalSocketServer::EventBackend::kIoUring) {
+      GTEST_SKIP() << "io_uring is not available.";
+    }
+  }
+
+  PhysicalSocketServer server_;
+  rtc::AutoSocketServerThread thread_;
+};
+
+TEST_F(IoUringPhysicalSocketTest, TestConnectIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestConnectIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestConnectIPv6) {
+  SocketTest::TestConnectIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestConnectWithDnsLookupIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestConnectWithDnsLookupIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestConnectWithDnsLookupIPv6) {
+  SocketTest::TestConnectWithDnsLookupIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestConnectFailIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestConnectFailIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestConnectFailIPv6) {
+  SocketTest::TestConnectFailIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestConnectWithDnsLookupFailIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestConnectWithDnsLookupFailIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestConnectWithDnsLookupFailIPv6) {
+  SocketTest::TestConnectWithDnsLookupFailIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestConnectWithClosedSocketIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestConnectWithClosedSocketIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestConnectWithClosedSocketIPv6) {
+  SocketTest::TestConnectWithClosedSocketIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestConnectWhileNotClosedIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestConnectWhileNotClosedIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestConnectWhileNotClosedIPv6) {
+  SocketTest::TestConnectWhileNotClosedIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestServerCloseDuringConnectIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestServerCloseDuringConnectIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestServerCloseDuringConnectIPv6) {
+  SocketTest::TestServerCloseDuringConnectIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestClientCloseDuringConnectIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestClientCloseDuringConnectIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestClientCloseDuringConnectIPv6) {
+  SocketTest::TestClientCloseDuringConnectIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestServerCloseIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestServerCloseIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestServerCloseIPv6) {
+  SocketTest::TestServerCloseIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestCloseInClosedCallbackIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestCloseInClosedCallbackIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestCloseInClosedCallbackIPv6) {
+  SocketTest::TestCloseInClosedCallbackIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestDeleteInReadCallbackIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestDeleteInReadCallbackIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestDeleteInReadCallbackIPv6) {
+  SocketTest::TestDeleteInReadCallbackIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestSocketServerWaitIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestSocketServerWaitIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestSocketServerWaitIPv6) {
+  SocketTest::TestSocketServerWaitIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestTcpIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestTcpIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestTcpIPv6) {
+  SocketTest::TestTcpIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestSingleFlowControlCallbackIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestSingleFlowControlCallbackIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestSingleFlowControlCallbackIPv6) {
+  SocketTest::TestSingleFlowControlCallbackIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestUdpIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestUdpIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestUdpIPv6) {
+  SocketTest::TestUdpIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestUdpReadyToSendIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestUdpReadyToSendIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestUdpReadyToSendIPv6) {
+  SocketTest::TestUdpReadyToSendIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestGetSetOptionsIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestGetSetOptionsIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestGetSetOptionsIPv6) {
+  SocketTest::TestGetSetOptionsIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestSocketRecvTimestampIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestSocketRecvTimestampIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestSocketRecvTimestampIPv6) {
+  SocketTest::TestSocketRecvTimestampIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestUdpSocketRecvTimestampUseRtcEpochIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestUdpSocketRecvTimestampUseRtcEpochIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestUdpSocketRecvTimestampUseRtcEpochIPv6) {
+  SocketTest::TestUdpSocketRecvTimestampUseRtcEpochIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestSocketSendRecvWithEcnIPV4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestSocketSendRecvWithEcnIPV4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestSocketSendRecvWithEcnIPV6) {
+  SocketTest::TestSocketSendRecvWithEcnIPV6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestUdpRecvFromBatchIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestUdpRecvFromBatchIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestUdpRecvFromBatchIPv6) {
+  SocketTest::TestUdpRecvFromBatchIPv6();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestUdpSendToBatchIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestUdpSendToBatchIPv4();
+}
+
+TEST_F(IoUringPhysicalSocketTest, TestUdpSendToBatchIPv6) {
+  SocketTest::TestUdpSendToBatchIPv6();
+}
+
+TEST(IoUringPhysicalSocketServerTest, WakeUpInterruptsWait) {
+  PhysicalSocketServer server(PhysicalSocketServer::EventBackend::kIoUring);
+  if (server.event_backend() != PhysicalSocketServer::EventBackend::kIoUring) {
+    GTEST_SKIP() << "io_uring is not available.";
+  }
+  server.WakeUp();
+  EXPECT_TRUE(server.Wait(Event::kForever, /*process_io=*/true));
+}
+
+#endif  // WEBRTC_USE_IO_URING
+
 }  // namespace rtc
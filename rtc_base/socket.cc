@@ -12,6 +12,7 @@
 
 #include <cstdint>
 
+#include "api/array_view.h"
 #include "rtc_base/buffer.h"
 
 namespace rtc {
@@ -30,4 +31,24 @@ int Socket::RecvFrom(ReceiveBuffer& buffer) {
   return len;
 }
 
+int Socket::SendToBatch(rtc::ArrayView<const OutgoingPacket> packets) {
+  int sent = 0;
+  for (const OutgoingPacket& packet : packets) {
+    if (SendTo(packet.payload.data(), packet.payload.size(), packet.address) <
+        0) {
+      return sent > 0 ? sent : SOCKET_ERROR;
+    }
+    ++sent;
+  }
+  return sent;
+}
+
+int Socket::RecvFromBatch(rtc::ArrayView<ReceiveBuffer> buffers) {
+  if (buffers.empty()) {
+    return 0;
+  }
+  int len = RecvFrom(buffers[0]);
+  return len > 0 ? 1 : len;
+}
+
 }  // namespace rtc
@@ -28,6 +28,7 @@
 #include "rtc_base/win32.h"
 #endif
 
+#include "api/array_view.h"
 #include "api/units/timestamp.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/network/ecn_marking.h"
@@ -95,6 +96,10 @@ class RTC_EXPORT Socket {
     EcnMarking ecn = EcnMarking::kNotEct;
     Buffer& payload;
   };
+  struct OutgoingPacket {
+    rtc::ArrayView<const uint8_t> payload;
+    SocketAddress address;
+  };
   virtual ~Socket() {}
 
   Socket(const Socket&) = delete;
@@ -112,6 +117,12 @@ class RTC_EXPORT Socket {
   virtual int Connect(const SocketAddress& addr) = 0;
   virtual int Send(const void* pv, size_t cb) = 0;
   virtual int SendTo(const void* pv, size_t cb, const SocketAddress& addr) = 0;
+  // Sends `packets` in order, using a single call where the platform supports
+  // it (sendmmsg or UDP GSO on Linux). Returns the number of packets sent,
+  // which may be less than `packets.size()`, or a negative value if none
+  // could be sent.
+  // Default implementation calls SendTo for each packet.
+  virtual int SendToBatch(rtc::ArrayView<const OutgoingPacket> packets);
   // `timestamp` is in units of microseconds.
   virtual int Recv(void* pv, size_t cb, int64_t* timestamp) = 0;
   // TODO(webrtc:15368): Deprecate and remove.
@@ -126,6 +137,12 @@ class RTC_EXPORT Socket {
   // Default implementation calls RecvFrom(void* ...) with 64Kbyte buffer.
   // Returns number of bytes received or a negative value on error.
   virtual int RecvFrom(ReceiveBuffer& buffer);
+  // Receives up to `buffers.size()` datagrams with a single call where the
+  // platform supports it (recvmmsg on Linux). The received datagrams are
+  // stored in order in the first entries of `buffers`. Returns the number of
+  // datagrams received, or a negative value on error.
+  // Default implementation reads one datagram with RecvFrom(ReceiveBuffer&).
+  virtual int RecvFromBatch(rtc::ArrayView<ReceiveBuffer> buffers);
   virtual int Listen(int backlog) = 0;
   virtual Socket* Accept(SocketAddress* paddr) = 0;
   virtual int Close() = 0;
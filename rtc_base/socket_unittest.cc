@@ -17,9 +17,12 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
+#include "api/array_view.h"
 #include "api/units/timestamp.h"
 #include "rtc_base/arraysize.h"
 #include "rtc_base/async_packet_socket.h"
@@ -243,6 +246,24 @@ void SocketTest::TestSocketSendRecvWithEcnIPV6() {
   SocketSendRecvWithEcn(kIPv6Loopback);
 }
 
+void SocketTest::TestUdpRecvFromBatchIPv4() {
+  UdpRecvFromBatch(kIPv4Loopback);
+}
+
+void SocketTest::TestUdpRecvFromBatchIPv6() {
+  MAYBE_SKIP_IPV6;
+  UdpRecvFromBatch(kIPv6Loopback);
+}
+
+void SocketTest::TestUdpSendToBatchIPv4() {
+  UdpSendToBatch(kIPv4Loopback);
+}
+
+void SocketTest::TestUdpSendToBatchIPv6() {
+  MAYBE_SKIP_IPV6;
+  UdpSendToBatch(kIPv6Loopback);
+}
+
 // For unbound sockets, GetLocalAddress / GetRemoteAddress return AF_UNSPEC
 // values on Windows, but an empty address of the same family on Linux/MacOS X.
 bool IsUnspecOrEmptyIP(const IPAddress& address) {
@@ -1239,4 +1260,109 @@ void SocketTest::SocketSendRecvWithEcn(const IPAddress& loopback) {
   EXPECT_EQ(receive_buffer.ecn, EcnMarking::kCe);
 }
 
+void SocketTest::UdpRecvFromBatch(const IPAddress& loopback) {
+  StreamSink sink;
+  std::unique_ptr<Socket> socket(
+      socket_factory_->CreateSocket(loopback.family(), SOCK_DGRAM));
+  EXPECT_EQ(0, socket->Bind(SocketAddress(loopback, 0)));
+  SocketAddress address = socket->GetLocalAddress();
+  sink.Monitor(socket.get());
+  socket->SetOption(Socket::OPT_SEND_ECN, 1);  // Ect(1)
+  socket->SetOption(Socket::OPT_RECV_ECN, 1);
+
+  std::vector<rtc::Buffer> buffers(4);
+  std::vector<Socket::ReceiveBuffer> receive_buffers;
+  for (rtc::Buffer& buffer : buffers) {
+    receive_buffers.emplace_back(buffer);
+  }
+
+  // The last datagram doesn't fit the default batch buffer size.
+  const std::vector<std::string> kPayloads = {"foo", "barbaz", "q",
+                                              std::string(5000, 'x')};
+  for (const std::string& payload : kPayloads) {
+    EXPECT_EQ(static_cast<int>(payload.size()),
+              socket->SendTo(payload.data(), payload.size(), address));
+  }
+
+  // Batch support is platform dependent, so datagrams may arrive across
+  // several calls, but always in order and with their metadata.
+  std::vector<std::string> received;
+  while (received.size() < kPayloads.size()) {
+    EXPECT_TRUE_WAIT(sink.Check(socket.get(), SSE_READ), kTimeout);
+    int count = socket->RecvFromBatch(receive_buffers);
+    ASSERT_GT(count, 0);
+    ASSERT_LE(count, static_cast<int>(receive_buffers.size()));
+    for (int i = 0; i < count; ++i) {
+      const Socket::ReceiveBuffer& receive_buffer = receive_buffers[i];
+      EXPECT_EQ(receive_buffer.source_address, address);
+      EXPECT_EQ(receive_buffer.ecn, EcnMarking::kEct1);
+      received.emplace_back(receive_buffer.payload.begin(),
+                            receive_buffer.payload.end());
+    }
+  }
+  EXPECT_EQ(received, kPayloads);
+}
+
+void SocketTest::UdpSendToBatch(const IPAddress& loopback) {
+  StreamSink sink;
+  std::unique_ptr<Socket> sender(
+      socket_factory_->CreateSocket(loopback.family(), SOCK_DGRAM));
+  std::unique_ptr<Socket> receiver1(
+      socket_factory_->CreateSocket(loopback.family(), SOCK_DGRAM));
+  std::unique_ptr<Socket> receiver2(
+      socket_factory_->CreateSocket(loopback.family(), SOCK_DGRAM));
+  EXPECT_EQ(0, sender->Bind(SocketAddress(loopback, 0)));
+  EXPECT_EQ(0, receiver1->Bind(SocketAddress(loopback, 0)));
+  EXPECT_EQ(0, receiver2->Bind(SocketAddress(loopback, 0)));
+  sink.Monitor(receiver1.get());
+  sink.Monitor(receiver2.get());
+  const SocketAddress address1 = receiver1->GetLocalAddress();
+  const SocketAddress address2 = receiver2->GetLocalAddress();
+
+  auto receive_all = [&](Socket* socket, size_t count) {
+    std::vector<std::string> received;
+    rtc::Buffer buffer;
+    Socket::ReceiveBuffer receive_buffer(buffer);
+    while (received.size() < count) {
+      EXPECT_TRUE_WAIT(sink.Check(socket, SSE_READ), kTimeout);
+      if (socket->RecvFrom(receive_buffer) <= 0) {
+        break;
+      }
+      received.emplace_back(buffer.begin(), buffer.end());
+    }
+    return received;
+  };
+
+  // Equal sized packets to one destination, with a shorter last packet, may
+  // be sent with a single GSO write.
+  const std::vector<std::string> kSameDestination = {
+      std::string(100, 'a'), std::string(100, 'b'), std::string(100, 'c'),
+      std::string(40, 'd')};
+  std::vector<Socket::OutgoingPacket> packets;
+  for (const std::string& payload : kSameDestination) {
+    packets.push_back(
+        {.payload = rtc::MakeArrayView(
+             reinterpret_cast<const uint8_t*>(payload.data()), payload.size()),
+         .address = address1});
+  }
+  EXPECT_EQ(static_cast<int>(packets.size()), sender->SendToBatch(packets));
+  EXPECT_EQ(receive_all(receiver1.get(), kSameDestination.size()),
+            kSameDestination);
+
+  // Packets to different destinations.
+  const std::vector<std::string> kMixedDestination = {"foo", "bar", "baz"};
+  packets.clear();
+  for (size_t i = 0; i < kMixedDestination.size(); ++i) {
+    packets.push_back(
+        {.payload = rtc::MakeArrayView(
+             reinterpret_cast<const uint8_t*>(kMixedDestination[i].data()),
+             kMixedDestination[i].size()),
+         .address = i % 2 == 0 ? address1 : address2});
+  }
+  EXPECT_EQ(static_cast<int>(packets.size()), sender->SendToBatch(packets));
+  EXPECT_EQ(receive_all(receiver1.get(), 2),
+            std::vector<std::string>({"foo", "baz"}));
+  EXPECT_EQ(receive_all(receiver2.get(), 1), std::vector<std::string>({"bar"}));
+}
+
 }  // namespace rtc
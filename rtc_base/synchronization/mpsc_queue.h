@@ -0,0 +1,96 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_SYNCHRONIZATION_MPSC_QUEUE_H_
+#define RTC_BASE_SYNCHRONIZATION_MPSC_QUEUE_H_
+
+#include <atomic>
+#include <utility>
+
+#include "absl/types/optional.h"
+
+namespace webrtc {
+
+// Unbounded lock-free multi-producer single-consumer FIFO queue, after Dmitry
+// Vyukov's node based MPSC queue.
+//
+// Push() is wait-free and may be called from any thread. Pop() and IsEmpty()
+// must only be called by a single consumer at a time. Values pushed by one
+// producer are popped in the order they were pushed.
+//
+// A producer that has been preempted in the middle of Push() blocks the
+// values pushed after it until it resumes: Pop() then returns nullopt while
+// IsEmpty() returns false. Consumers that sleep when there is nothing to pop
+// must therefore check IsEmpty() rather than the result of Pop().
+template <typename T>
+class MpscQueue {
+ public:
+  MpscQueue() : head_(&stub_), tail_(&stub_) {}
+  ~MpscQueue() {
+    while (Pop()) {
+    }
+    if (tail_ != &stub_) {
+      delete tail_;
+    }
+  }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  void Push(T value) {
+    Node* node = new Node(std::move(value));
+    // Sequentially consistent, see IsEmpty().
+    Node* prev = head_.exchange(node);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  // Returns the oldest value, or nullopt if there is none that is fully
+  // pushed.
+  absl::optional<T> Pop() {
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      return absl::nullopt;
+    }
+    // `next` becomes the new stub; its value has been handed out.
+    absl::optional<T> value = std::move(next->value);
+    next->value.reset();
+    tail_ = next;
+    if (tail != &stub_) {
+      delete tail;
+    }
+    return value;
+  }
+
+  // Returns true if no Push() has started since the last value was popped.
+  // Sequentially consistent with Push(), so that a consumer that publishes
+  // that it is about to sleep and then sees an empty queue is guaranteed to be
+  // observed by the next producer.
+  bool IsEmpty() const { return head_.load() == tail_; }
+
+ private:
+  struct Node {
+    Node() = default;
+    explicit Node(T value) : value(std::move(value)) {}
+
+    std::atomic<Node*> next{nullptr};
+    absl::optional<T> value;
+  };
+
+  Node stub_;
+  // Most recently pushed node, written by producers.
+  std::atomic<Node*> head_;
+  // Node whose successor is the next to be popped, owned by the consumer.
+  Node* tail_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_SYNCHRONIZATION_MPSC_QUEUE_H_
@@ -0,0 +1,83 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/synchronization/mpsc_queue.h"
+
+#include <memory>
+#include <vector>
+
+#include "rtc_base/platform_thread.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+TEST(MpscQueueTest, PopsInPushOrder) {
+  MpscQueue<int> queue;
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_EQ(queue.Pop(), absl::nullopt);
+  queue.Push(1);
+  queue.Push(2);
+  EXPECT_FALSE(queue.IsEmpty());
+  EXPECT_EQ(queue.Pop(), 1);
+  queue.Push(3);
+  EXPECT_EQ(queue.Pop(), 2);
+  EXPECT_EQ(queue.Pop(), 3);
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_EQ(queue.Pop(), absl::nullopt);
+}
+
+TEST(MpscQueueTest, DestroysRemainingValues) {
+  auto value = std::make_shared<int>(1);
+  {
+    MpscQueue<std::shared_ptr<int>> queue;
+    queue.Push(value);
+    queue.Push(value);
+    EXPECT_EQ(value.use_count(), 3);
+    queue.Pop();
+    EXPECT_EQ(value.use_count(), 2);
+  }
+  EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST(MpscQueueTest, KeepsPerProducerOrderWithConcurrentProducers) {
+  constexpr int kProducers = 8;
+  constexpr int kValuesPerProducer = 10000;
+  MpscQueue<int> queue;
+  std::vector<rtc::PlatformThread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.push_back(rtc::PlatformThread::SpawnJoinable(
+        [&queue, p] {
+          for (int i = 0; i < kValuesPerProducer; ++i) {
+            queue.Push(p * kValuesPerProducer + i);
+          }
+        },
+        "producer"));
+  }
+
+  std::vector<int> last_popped(kProducers, -1);
+  int popped = 0;
+  while (popped < kProducers * kValuesPerProducer) {
+    absl::optional<int> value = queue.Pop();
+    if (!value) {
+      continue;
+    }
+    const int producer = *value / kValuesPerProducer;
+    const int index = *value % kValuesPerProducer;
+    EXPECT_EQ(index, last_popped[producer] + 1);
+    last_popped[producer] = index;
+    ++popped;
+  }
+  producers.clear();
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -13,10 +13,12 @@
 #include <string.h>
 
 #include <algorithm>
-#include <map>
+#include <atomic>
+#include <limits>
 #include <memory>
 #include <queue>
 #include <utility>
+#include <vector>
 
 #include "absl/functional/any_invocable.h"
 #include "absl/strings/string_view.h"
@@ -27,13 +29,35 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/divide_round.h"
 #include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mpsc_queue.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/task_utils/timer_wheel.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/time_utils.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 namespace {
 
+// Duration of a tick of the timer wheels holding delayed tasks.
+constexpr int64_t kTickUs = 1'000;
+
+// How many ticks low precision delayed tasks may run late, if enabled.
+constexpr uint64_t kLowPrecisionSlackTicks =
+    kLowPrecisionTimerSlack.us() / kTickUs;
+
+uint64_t NowTick() {
+  return rtc::TimeMicros() / kTickUs;
+}
+
+uint64_t FireAtTick(TimeDelta delay) {
+  return DivideRoundUp(rtc::TimeMicros() + delay.us(), kTickUs);
+}
+
+bool CoarseLowPrecisionTimersEnabled() {
+  return field_trial::IsEnabled("WebRTC-TaskQueue-CoarseLowPrecisionTimers");
+}
+
 rtc::ThreadPriority TaskQueuePriorityToThreadPriority(
     TaskQueueFactory::Priority priority) {
   switch (priority) {
@@ -64,17 +88,7 @@ class TaskQueueStdlib final : public TaskQueueBase {
 
  private:
   using OrderId = uint64_t;
-
-  struct DelayedEntryTimeout {
-    // TODO(bugs.webrtc.org/13756): Migrate to Timestamp.
-    int64_t next_fire_at_us{};
-    OrderId order{};
-
-    bool operator<(const DelayedEntryTimeout& o) const {
-      return std::tie(next_fire_at_us, order) <
-             std::tie(o.next_fire_at_us, o.order);
-    }
-  };
+  using OrderedTask = std::pair<OrderId, absl::AnyInvocable<void() &&>>;
 
   struct NextTask {
     bool final_task = false;
@@ -106,17 +120,22 @@ class TaskQueueStdlib final : public TaskQueueBase {
 
   // The list of all pending tasks that need to be processed in the
   // FIFO queue ordering on the worker thread.
-  std::queue<std::pair<OrderId, absl::AnyInvocable<void() &&>>> pending_queue_
-      RTC_GUARDED_BY(pending_lock_);
+  std::queue<OrderedTask> pending_queue_ RTC_GUARDED_BY(pending_lock_);
 
   // The list of all pending tasks that need to be processed at a future
-  // time based upon a delay. On the off change the delayed task should
-  // happen at exactly the same time interval as another task then the
-  // task is processed based on FIFO ordering. std::priority_queue was
-  // considered but rejected due to its inability to extract the
-  // move-only value out of the queue without the presence of a hack.
-  std::map<DelayedEntryTimeout, absl::AnyInvocable<void() &&>> delayed_queue_
-      RTC_GUARDED_BY(pending_lock_);
+  // time based upon a delay, keyed by the tick at which they are due. On the
+  // off chance the delayed task should happen at exactly the same tick as
+  // another task then the task is processed based on FIFO ordering.
+  TimerWheel<OrderedTask> delayed_queue_ RTC_GUARDED_BY(pending_lock_);
+
+  // Delayed tasks that are due, in the order they became due. They run
+  // interleaved with `pending_queue_` by order of posting.
+  std::queue<OrderedTask> due_queue_ RTC_GUARDED_BY(pending_lock_);
+  std::vector<OrderedTask> expired_tasks_ RTC_GUARDED_BY(pending_lock_);
+
+  // If true, low precision delayed tasks may run up to
+  // kLowPrecisionSlackTicks late so that they coalesce with other tasks.
+  const bool coarse_low_precision_;
 
   // Contains the active worker thread assigned to processing
   // tasks (including delayed tasks).
@@ -128,6 +147,8 @@ class TaskQueueStdlib final : public TaskQueueBase {
 TaskQueueStdlib::TaskQueueStdlib(absl::string_view queue_name,
                                  rtc::ThreadPriority priority)
     : flag_notify_(/*manual_reset=*/false, /*initially_signaled=*/false),
+      delayed_queue_(NowTick()),
+      coarse_low_precision_(CoarseLowPrecisionTimersEnabled()),
       thread_(InitializeThread(this, queue_name, priority)) {}
 
 // static
@@ -176,13 +197,17 @@ void TaskQueueStdlib::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
                                           TimeDelta delay,
                                           const PostDelayedTaskTraits& traits,
                                           const Location& location) {
-  DelayedEntryTimeout delayed_entry;
-  delayed_entry.next_fire_at_us = rtc::TimeMicros() + delay.us();
+  const uint64_t fire_at_tick = FireAtTick(delay);
+  const uint64_t slack_ticks =
+      coarse_low_precision_ && !traits.high_precision ? kLowPrecisionSlackTicks
+                                                      : 0;
 
   {
     MutexLock lock(&pending_lock_);
-    delayed_entry.order = ++thread_posting_order_;
-    delayed_queue_[delayed_entry] = std::move(task);
+    delayed_queue_.Schedule(
+        fire_at_tick,
+        std::make_pair(++thread_posting_order_, std::move(task)),
+        slack_ticks);
   }
 
   NotifyWake();
@@ -200,29 +225,36 @@ TaskQueueStdlib::NextTask TaskQueueStdlib::GetNextTask() {
     return result;
   }
 
-  if (delayed_queue_.size() > 0) {
-    auto delayed_entry = delayed_queue_.begin();
-    const auto& delay_info = delayed_entry->first;
-    auto& delay_run = delayed_entry->second;
-    if (tick_us >= delay_info.next_fire_at_us) {
-      if (pending_queue_.size() > 0) {
-        auto& entry = pending_queue_.front();
-        auto& entry_order = entry.first;
-        auto& entry_run = entry.second;
-        if (entry_order < delay_info.order) {
-          result.run_task = std::move(entry_run);
-          pending_queue_.pop();
-          return result;
-        }
-      }
+  if (!delayed_queue_.empty()) {
+    delayed_queue_.AdvanceTo(tick_us / kTickUs, expired_tasks_);
+    for (OrderedTask& expired : expired_tasks_) {
+      due_queue_.push(std::move(expired));
+    }
+    expired_tasks_.clear();
+  }
 
-      result.run_task = std::move(delay_run);
-      delayed_queue_.erase(delayed_entry);
-      return result;
+  if (due_queue_.size() > 0) {
+    auto& due_entry = due_queue_.front();
+    if (pending_queue_.size() > 0) {
+      auto& entry = pending_queue_.front();
+      if (entry.first < due_entry.first) {
+        result.run_task = std::move(entry.second);
+        pending_queue_.pop();
+        return result;
+      }
     }
 
+    result.run_task = std::move(due_entry.second);
+    due_queue_.pop();
+    return result;
+  }
+
+  absl::optional<uint64_t> wakeup_tick = delayed_queue_.NextWakeupTick();
+  if (wakeup_tick) {
+    const int64_t sleep_us =
+        static_cast<int64_t>(*wakeup_tick) * kTickUs - tick_us;
     result.sleep_time = TimeDelta::Millis(
-        DivideRoundUp(delay_info.next_fire_at_us - tick_us, 1'000));
+        DivideRoundUp(std::max<int64_t>(sleep_us, 0), 1'000));
   }
 
   if (pending_queue_.size() > 0) {
@@ -254,12 +286,19 @@ void TaskQueueStdlib::ProcessTasks() {
 
   // Ensure remaining deleted tasks are destroyed with Current() set up to this
   // task queue.
-  std::queue<std::pair<OrderId, absl::AnyInvocable<void() &&>>> pending_queue;
+  std::queue<OrderedTask> pending_queue;
+  std::queue<OrderedTask> due_queue;
+  std::vector<OrderedTask> delayed_tasks;
   {
     MutexLock lock(&pending_lock_);
     pending_queue_.swap(pending_queue);
+    due_queue_.swap(due_queue);
+    delayed_queue_.AdvanceTo(std::numeric_limits<uint64_t>::max(),
+                             delayed_tasks);
   }
   pending_queue = {};
+  due_queue = {};
+  delayed_tasks.clear();
 #if RTC_DCHECK_IS_ON
   MutexLock lock(&pending_lock_);
   RTC_DCHECK(pending_queue_.empty());
@@ -294,6 +333,194 @@ void TaskQueueStdlib::NotifyWake() {
   flag_notify_.Set();
 }
 
+// Variant of TaskQueueStdlib where tasks are posted to lock-free queues.
+// Posting threads only synchronize with the task queue thread, through
+// `flag_notify_`, when it is about to sleep or sleeping.
+class TaskQueueStdlibLockFree final : public TaskQueueBase {
+ public:
+  TaskQueueStdlibLockFree(absl::string_view queue_name,
+                          rtc::ThreadPriority priority);
+  ~TaskQueueStdlibLockFree() override = default;
+
+  void Delete() override;
+
+ protected:
+  void PostTaskImpl(absl::AnyInvocable<void() &&> task,
+                    const PostTaskTraits& traits,
+                    const Location& location) override;
+  void PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
+                           TimeDelta delay,
+                           const PostDelayedTaskTraits& traits,
+                           const Location& location) override;
+
+ private:
+  struct DelayedTask {
+    uint64_t fire_at_tick;
+    uint64_t slack_ticks;
+    absl::AnyInvocable<void() &&> task;
+  };
+
+  void ProcessTasks();
+  // Runs the delayed tasks that are due. Returns true if any was run.
+  bool RunDueDelayedTasks();
+  // Returns how long the task queue thread may sleep before the next delayed
+  // task is due.
+  TimeDelta SleepTime() const;
+
+  void NotifyWake();
+
+  rtc::Event flag_notify_;
+
+  std::atomic<bool> thread_should_quit_{false};
+
+  // Set by the task queue thread before it checks for tasks one last time and
+  // sleeps. Posting threads wake it up if they see it set.
+  std::atomic<bool> sleeping_{false};
+
+  MpscQueue<absl::AnyInvocable<void() &&>> pending_queue_;
+
+  // Delayed tasks posted from other threads, not yet in `delayed_tasks_`.
+  MpscQueue<DelayedTask> incoming_delayed_queue_;
+
+  // Only accessed on the task queue thread.
+  TimerWheel<absl::AnyInvocable<void() &&>> delayed_tasks_;
+  std::vector<absl::AnyInvocable<void() &&>> due_tasks_;
+
+  // If true, low precision delayed tasks may run up to
+  // kLowPrecisionSlackTicks late so that they coalesce with other tasks.
+  const bool coarse_low_precision_;
+
+  // Placed last so that the thread is started after, and joined before, the
+  // other members are initialized and destroyed.
+  rtc::PlatformThread thread_;
+};
+
+TaskQueueStdlibLockFree::TaskQueueStdlibLockFree(absl::string_view queue_name,
+                                                 rtc::ThreadPriority priority)
+    : flag_notify_(/*manual_reset=*/false, /*initially_signaled=*/false),
+      delayed_tasks_(NowTick()),
+      coarse_low_precision_(CoarseLowPrecisionTimersEnabled()) {
+  rtc::Event started;
+  thread_ = rtc::PlatformThread::SpawnJoinable(
+      [this, &started] {
+        CurrentTaskQueueSetter set_current(this);
+        started.Set();
+        ProcessTasks();
+      },
+      queue_name, rtc::ThreadAttributes().SetPriority(priority));
+  started.Wait(rtc::Event::kForever);
+}
+
+void TaskQueueStdlibLockFree::Delete() {
+  RTC_DCHECK(!IsCurrent());
+  thread_should_quit_.store(true);
+  flag_notify_.Set();
+  delete this;
+}
+
+void TaskQueueStdlibLockFree::PostTaskImpl(absl::AnyInvocable<void() &&> task,
+                                           const PostTaskTraits& traits,
+                                           const Location& location) {
+  pending_queue_.Push(std::move(task));
+  NotifyWake();
+}
+
+void TaskQueueStdlibLockFree::PostDelayedTaskImpl(
+    absl::AnyInvocable<void() &&> task,
+    TimeDelta delay,
+    const PostDelayedTaskTraits& traits,
+    const Location& location) {
+  const uint64_t fire_at_tick = FireAtTick(delay);
+  const uint64_t slack_ticks =
+      coarse_low_precision_ && !traits.high_precision ? kLowPrecisionSlackTicks
+                                                      : 0;
+  if (IsCurrent()) {
+    // The thread will compute its sleep time after this task returns.
+    delayed_tasks_.Schedule(fire_at_tick, std::move(task), slack_ticks);
+    return;
+  }
+  incoming_delayed_queue_.Push({.fire_at_tick = fire_at_tick,
+                                .slack_ticks = slack_ticks,
+                                .task = std::move(task)});
+  NotifyWake();
+}
+
+void TaskQueueStdlibLockFree::ProcessTasks() {
+  while (!thread_should_quit_.load()) {
+    if (RunDueDelayedTasks()) {
+      continue;
+    }
+    if (absl::optional<absl::AnyInvocable<void() &&>> task =
+            pending_queue_.Pop()) {
+      std::move(*task)();
+      continue;
+    }
+
+    sleeping_.store(true);
+    // A producer that pushed before `sleeping_` was set may not wake us up;
+    // its task is seen here. One that is still in the middle of pushing makes
+    // the queue non-empty without a task to pop yet, so retry until it is
+    // done.
+    if (!pending_queue_.IsEmpty() || !incoming_delayed_queue_.IsEmpty() ||
+        thread_should_quit_.load()) {
+      sleeping_.store(false);
+      continue;
+    }
+    flag_notify_.Wait(SleepTime());
+    sleeping_.store(false);
+  }
+
+  // Ensure remaining tasks are destroyed with Current() set up to this task
+  // queue.
+  while (pending_queue_.Pop()) {
+  }
+  while (incoming_delayed_queue_.Pop()) {
+  }
+  delayed_tasks_.AdvanceTo(std::numeric_limits<uint64_t>::max(), due_tasks_);
+  due_tasks_.clear();
+}
+
+bool TaskQueueStdlibLockFree::RunDueDelayedTasks() {
+  while (absl::optional<DelayedTask> delayed =
+             incoming_delayed_queue_.Pop()) {
+    delayed_tasks_.Schedule(delayed->fire_at_tick, std::move(delayed->task),
+                            delayed->slack_ticks);
+  }
+  if (delayed_tasks_.empty()) {
+    return false;
+  }
+  delayed_tasks_.AdvanceTo(NowTick(), due_tasks_);
+  if (due_tasks_.empty()) {
+    return false;
+  }
+  // Tasks may post more delayed tasks, but don't touch `due_tasks_`.
+  for (absl::AnyInvocable<void() &&>& task : due_tasks_) {
+    std::move(task)();
+  }
+  due_tasks_.clear();
+  return true;
+}
+
+TimeDelta TaskQueueStdlibLockFree::SleepTime() const {
+  absl::optional<uint64_t> wakeup_tick = delayed_tasks_.NextWakeupTick();
+  if (!wakeup_tick) {
+    return rtc::Event::kForever;
+  }
+  const int64_t sleep_us =
+      static_cast<int64_t>(*wakeup_tick) * kTickUs - rtc::TimeMicros();
+  return TimeDelta::Millis(
+      DivideRoundUp(std::max<int64_t>(sleep_us, 0), 1'000));
+}
+
+void TaskQueueStdlibLockFree::NotifyWake() {
+  // Pairs with the task queue thread setting `sleeping_` and then checking
+  // the queues: either it sees the new task, or this sees it going to sleep.
+  // Only the first poster after that pays for waking it up.
+  if (sleeping_.exchange(false)) {
+    flag_notify_.Set();
+  }
+}
+
 class TaskQueueStdlibFactory final : public TaskQueueFactory {
  public:
   std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
@@ -304,10 +531,25 @@ class TaskQueueStdlibFactory final : public TaskQueueFactory {
   }
 };
 
+class TaskQueueStdlibLockFreeFactory final : public TaskQueueFactory {
+ public:
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(
+        new TaskQueueStdlibLockFree(
+            name, TaskQueuePriorityToThreadPriority(priority)));
+  }
+};
+
 }  // namespace
 
 std::unique_ptr<TaskQueueFactory> CreateTaskQueueStdlibFactory() {
   return std::make_unique<TaskQueueStdlibFactory>();
 }
 
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueStdlibLockFreeFactory() {
+  return std::make_unique<TaskQueueStdlibLockFreeFactory>();
+}
+
 }  // namespace webrtc
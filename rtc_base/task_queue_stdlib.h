@@ -19,6 +19,12 @@ namespace webrtc {
 
 std::unique_ptr<TaskQueueFactory> CreateTaskQueueStdlibFactory();
 
+// Like CreateTaskQueueStdlibFactory(), but the task queues take tasks from
+// lock-free queues instead of a mutex protected one, so that posting threads
+// never contend with each other or with the task queue thread. Delayed tasks
+// are kept in a timer wheel with millisecond ticks.
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueStdlibLockFreeFactory();
+
 }  // namespace webrtc
 
 #endif  // RTC_BASE_TASK_QUEUE_STDLIB_H_
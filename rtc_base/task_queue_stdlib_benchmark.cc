@@ -0,0 +1,114 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "benchmark/benchmark.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/system/unused.h"
+#include "rtc_base/task_queue_stdlib.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kProducers = 8;
+constexpr int kTasksPerProducer = 10000;
+// A fixed number of iterations bounds the memory used for latencies, and lets
+// it all be reserved before timing starts.
+constexpr int kIterations = 20;
+
+// Posts kTasksPerProducer tasks from each of kProducers threads to a single
+// task queue per iteration. Reports posted tasks per second, and the
+// percentiles of the time from PostTask() until the task starts running.
+// Arg: 0 for the mutex based TaskQueueStdlib, 1 for the lock-free one.
+void BM_PostFromProducers(benchmark::State& state) {
+  std::unique_ptr<TaskQueueFactory> factory =
+      state.range(0) == 0 ? CreateTaskQueueStdlibFactory()
+                          : CreateTaskQueueStdlibLockFreeFactory();
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> queue =
+      factory->CreateTaskQueue("consumer", TaskQueueFactory::Priority::NORMAL);
+
+  // Only accessed on `queue`. Reserved for all iterations, so that the tasks
+  // don't reallocate it while being timed.
+  std::vector<int64_t> latencies_ns;
+  latencies_ns.reserve(kIterations * kProducers * kTasksPerProducer);
+  int remaining = 0;
+  rtc::Event done;
+
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    state.PauseTiming();
+    queue->PostTask([&] { remaining = kProducers * kTasksPerProducer; });
+    std::atomic<bool> go{false};
+    std::vector<rtc::PlatformThread> producers;
+    for (int i = 0; i < kProducers; ++i) {
+      producers.push_back(rtc::PlatformThread::SpawnJoinable(
+          [&] {
+            while (!go.load()) {
+            }
+            for (int j = 0; j < kTasksPerProducer; ++j) {
+              const int64_t posted_ns = rtc::TimeNanos();
+              queue->PostTask([&, posted_ns] {
+                latencies_ns.push_back(rtc::TimeNanos() - posted_ns);
+                if (--remaining == 0) {
+                  done.Set();
+                }
+              });
+            }
+          },
+          "producer"));
+    }
+    state.ResumeTiming();
+
+    go.store(true);
+    done.Wait(rtc::Event::kForever);
+
+    state.PauseTiming();
+    producers.clear();
+    state.ResumeTiming();
+  }
+
+  rtc::Event stats_ready;
+  queue->PostTask([&] {
+    std::sort(latencies_ns.begin(), latencies_ns.end());
+    auto percentile_us = [&](double p) {
+      const size_t index = std::min(
+          latencies_ns.size() - 1,
+          static_cast<size_t>(p * static_cast<double>(latencies_ns.size())));
+      return static_cast<double>(latencies_ns[index]) / 1000.0;
+    };
+    if (!latencies_ns.empty()) {
+      state.counters["p50_us"] = percentile_us(0.5);
+      state.counters["p99_us"] = percentile_us(0.99);
+      state.counters["p999_us"] = percentile_us(0.999);
+    }
+    stats_ready.Set();
+  });
+  stats_ready.Wait(rtc::Event::kForever);
+  state.SetItemsProcessed(state.iterations() * kProducers * kTasksPerProducer);
+}
+
+BENCHMARK(BM_PostFromProducers)
+    ->Arg(0)
+    ->Arg(1)
+    ->Iterations(kIterations)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace webrtc
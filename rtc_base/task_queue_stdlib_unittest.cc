@@ -25,5 +25,14 @@ INSTANTIATE_TEST_SUITE_P(TaskQueueStdlib,
                          TaskQueueTest,
                          ::testing::Values(CreateTaskQueueFactory));
 
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueLockFreeFactory(
+    const webrtc::FieldTrialsView*) {
+  return CreateTaskQueueStdlibLockFreeFactory();
+}
+
+INSTANTIATE_TEST_SUITE_P(TaskQueueStdlibLockFree,
+                         TaskQueueTest,
+                         ::testing::Values(CreateTaskQueueLockFreeFactory));
+
 }  // namespace
 }  // namespace webrtc
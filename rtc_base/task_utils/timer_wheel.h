@@ -0,0 +1,341 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TASK_UTILS_TIMER_WHEEL_H_
+#define RTC_BASE_TASK_UTILS_TIMER_WHEEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "absl/numeric/bits.h"
+#include "absl/types/optional.h"
+#include "api/units/time_delta.h"
+
+namespace webrtc {
+
+// How late low precision delayed tasks may run when the
+// "WebRTC-TaskQueue-CoarseLowPrecisionTimers" field trial is enabled, so that
+// their timers coalesce. Within the leeway documented for
+// TaskQueueBase::DelayPrecision::kLow.
+constexpr TimeDelta kLowPrecisionTimerSlack = TimeDelta::Millis(16);
+
+// Hierarchical timing wheel holding values of type T that expire at a given
+// tick. Time is measured in abstract, monotonically increasing ticks; callers
+// pick the tick duration and convert.
+//
+// Scheduling and cancelling are O(1). Each timer is moved to a finer level at
+// most once per level (at most 11 times over the full 64 bit tick range, and
+// twice for expiries within 2^18 ticks), so advancing costs O(1) amortized
+// per timer plus O(levels) per occupied slot visited. Timers scheduled for the
+// same tick while at the same current tick expire in the order they were
+// scheduled.
+//
+// Not thread safe.
+template <typename T>
+class TimerWheel {
+ public:
+  // Identifies a scheduled timer. Ids are not reused until 2^32 timers have
+  // been scheduled in the same internal slot. 0 is never a valid id.
+  using TimerId = uint64_t;
+
+  explicit TimerWheel(uint64_t now_tick = 0) : current_tick_(now_tick) {
+    head_.fill(kNone);
+    tail_.fill(kNone);
+    occupied_.fill(0);
+  }
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  // Schedules `value` to expire at `expiry_tick`. Expiry ticks that are not
+  // after current_tick() expire on the next call to AdvanceTo().
+  //
+  // A timer that tolerates firing up to `max_slack_ticks` late is moved to the
+  // tick in that range that is a multiple of the largest power of two. Timers
+  // with slack thereby coalesce onto few ticks, which saves wakeups, and
+  // usually onto slot boundaries of coarse levels, which saves cascading.
+  TimerId Schedule(uint64_t expiry_tick,
+                   T value,
+                   uint64_t max_slack_ticks = 0) {
+    if (max_slack_ticks > 0 && expiry_tick > 0) {
+      expiry_tick = CoarsenExpiry(expiry_tick, max_slack_ticks);
+    }
+    uint32_t index;
+    if (free_head_ != kNone) {
+      index = free_head_;
+      free_head_ = nodes_[index].next;
+    } else {
+      index = static_cast<uint32_t>(nodes_.size());
+      nodes_.emplace_back();
+    }
+    Node& node = nodes_[index];
+    node.value = std::move(value);
+    node.expiry_tick = expiry_tick;
+    ++size_;
+    Link(index);
+    return (static_cast<uint64_t>(node.generation) << 32) | (index + 1);
+  }
+
+  // Removes the timer `id`, destroying its value. Returns false if the timer
+  // has already expired or been cancelled.
+  bool Cancel(TimerId id) {
+    const uint64_t index_plus_one = id & 0xffffffff;
+    if (index_plus_one == 0 || index_plus_one > nodes_.size()) {
+      return false;
+    }
+    const uint32_t index = static_cast<uint32_t>(index_plus_one - 1);
+    Node& node = nodes_[index];
+    if (!node.value || node.generation != static_cast<uint32_t>(id >> 32)) {
+      return false;
+    }
+    Unlink(index);
+    Release(index);
+    return true;
+  }
+
+  // Advances time to `tick` and appends the values of all timers expiring at
+  // or before it to `expired`, in expiry order.
+  //
+  // If `tick` is before current_tick(), which happens when the clock feeding
+  // the wheel is replaced by a fake one, the timers are rescheduled relative
+  // to `tick`, keeping their expiry ticks. This costs O(size()).
+  void AdvanceTo(uint64_t tick, std::vector<T>& expired) {
+    if (tick < current_tick_) {
+      Rebase(tick);
+    }
+    TakeSlot(kDueSlot, expired);
+    while (true) {
+      absl::optional<uint64_t> next = NextEventTick();
+      if (!next || *next > tick) {
+        break;
+      }
+      current_tick_ = *next;
+      // Move the timers of the slots that begin now to finer levels, coarsest
+      // first. Cascaded timers that expire now end up in the due slot.
+      for (int level = kLevels - 1; level > 0; --level) {
+        const int shift = level * kBitsPerLevel;
+        if ((current_tick_ & ((uint64_t{1} << shift) - 1)) != 0) {
+          continue;
+        }
+        const int slot = SlotIndex(level, (current_tick_ >> shift) & kSlotMask);
+        uint32_t index = head_[slot];
+        ClearSlot(slot);
+        while (index != kNone) {
+          const uint32_t next_index = nodes_[index].next;
+          Link(index);
+          index = next_index;
+        }
+      }
+      TakeSlot(SlotIndex(0, current_tick_ & kSlotMask), expired);
+      TakeSlot(kDueSlot, expired);
+    }
+    current_tick_ = tick;
+  }
+
+  // Returns a tick at or before the earliest expiry, at which AdvanceTo()
+  // should be called next, or nullopt if there are no timers. Timers far in
+  // the future are reported at the tick where they move to a finer level,
+  // which is at most 63 wakeups per level in the worst case.
+  absl::optional<uint64_t> NextWakeupTick() const {
+    if (head_[kDueSlot] != kNone) {
+      return current_tick_;
+    }
+    return NextEventTick();
+  }
+
+  // Removes all timers, destroying their values.
+  void Clear() {
+    for (int slot = 0; slot <= kDueSlot; ++slot) {
+      uint32_t index = head_[slot];
+      ClearSlot(slot);
+      while (index != kNone) {
+        const uint32_t next_index = nodes_[index].next;
+        Release(index);
+        index = next_index;
+      }
+    }
+  }
+
+  uint64_t current_tick() const { return current_tick_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+ private:
+  static constexpr int kBitsPerLevel = 6;
+  static constexpr int kSlotsPerLevel = 1 << kBitsPerLevel;
+  static constexpr uint64_t kSlotMask = kSlotsPerLevel - 1;
+  // Enough levels to cover any 64 bit distance.
+  static constexpr int kLevels = (64 + kBitsPerLevel - 1) / kBitsPerLevel;
+  // Timers that are already expired go in an extra slot after all levels.
+  static constexpr int kDueSlot = kLevels * kSlotsPerLevel;
+  static constexpr uint32_t kNone = 0xffffffff;
+
+  struct Node {
+    absl::optional<T> value;
+    uint64_t expiry_tick = 0;
+    uint32_t generation = 0;
+    uint32_t prev = kNone;
+    uint32_t next = kNone;
+    int slot = 0;
+  };
+
+  static int SlotIndex(int level, uint64_t slot_in_level) {
+    return level * kSlotsPerLevel + static_cast<int>(slot_in_level);
+  }
+
+  // Places a timer in the slot matching the most significant group of bits
+  // in which its expiry differs from the current tick. That slot is always
+  // ahead of the current position of its level.
+  void Link(uint32_t index) {
+    Node& node = nodes_[index];
+    int slot = kDueSlot;
+    if (node.expiry_tick > current_tick_) {
+      const int level =
+          (63 - absl::countl_zero(node.expiry_tick ^ current_tick_)) /
+          kBitsPerLevel;
+      slot = SlotIndex(level,
+                       (node.expiry_tick >> (level * kBitsPerLevel)) &
+                           kSlotMask);
+      occupied_[level] |= uint64_t{1} << (slot % kSlotsPerLevel);
+    }
+    node.slot = slot;
+    node.next = kNone;
+    node.prev = tail_[slot];
+    if (tail_[slot] != kNone) {
+      nodes_[tail_[slot]].next = index;
+    } else {
+      head_[slot] = index;
+    }
+    tail_[slot] = index;
+  }
+
+  void Unlink(uint32_t index) {
+    Node& node = nodes_[index];
+    const int slot = node.slot;
+    if (node.prev != kNone) {
+      nodes_[node.prev].next = node.next;
+    } else {
+      head_[slot] = node.next;
+    }
+    if (node.next != kNone) {
+      nodes_[node.next].prev = node.prev;
+    } else {
+      tail_[slot] = node.prev;
+    }
+    if (head_[slot] == kNone && slot != kDueSlot) {
+      occupied_[slot / kSlotsPerLevel] &=
+          ~(uint64_t{1} << (slot % kSlotsPerLevel));
+    }
+  }
+
+  void ClearSlot(int slot) {
+    head_[slot] = kNone;
+    tail_[slot] = kNone;
+    if (slot != kDueSlot) {
+      occupied_[slot / kSlotsPerLevel] &=
+          ~(uint64_t{1} << (slot % kSlotsPerLevel));
+    }
+  }
+
+  // Returns the tick in [expiry_tick, expiry_tick + max_slack_ticks] with the
+  // most trailing zero bits.
+  static uint64_t CoarsenExpiry(uint64_t expiry_tick,
+                                uint64_t max_slack_ticks) {
+    const uint64_t earliest = expiry_tick - 1;
+    const uint64_t latest = max_slack_ticks > ~expiry_tick
+                                ? ~uint64_t{0}
+                                : expiry_tick + max_slack_ticks;
+    // Clearing the bits of `latest` below the highest bit in which it differs
+    // from `earliest` gives the most aligned tick after `earliest`.
+    const int bit = 63 - absl::countl_zero(earliest ^ latest);
+    return latest & ~((uint64_t{1} << bit) - 1);
+  }
+
+  // Relinks all timers relative to `tick`.
+  void Rebase(uint64_t tick) {
+    std::vector<uint32_t> indices;
+    indices.reserve(size_);
+    for (int slot = 0; slot <= kDueSlot; ++slot) {
+      for (uint32_t index = head_[slot]; index != kNone;
+           index = nodes_[index].next) {
+        indices.push_back(index);
+      }
+      ClearSlot(slot);
+    }
+    current_tick_ = tick;
+    for (uint32_t index : indices) {
+      Link(index);
+    }
+  }
+
+  // Moves the values of all timers in `slot` to `expired`.
+  void TakeSlot(int slot, std::vector<T>& expired) {
+    uint32_t index = head_[slot];
+    ClearSlot(slot);
+    while (index != kNone) {
+      const uint32_t next_index = nodes_[index].next;
+      expired.push_back(std::move(*nodes_[index].value));
+      Release(index);
+      index = next_index;
+    }
+  }
+
+  void Release(uint32_t index) {
+    Node& node = nodes_[index];
+    absl::optional<T> value = std::move(node.value);
+    node.value.reset();
+    ++node.generation;
+    node.next = free_head_;
+    free_head_ = index;
+    --size_;
+    // `value` is destroyed last, as its destructor may schedule timers.
+  }
+
+  // Returns the first tick after the current one at which an occupied slot
+  // begins.
+  absl::optional<uint64_t> NextEventTick() const {
+    absl::optional<uint64_t> next;
+    for (int level = 0; level < kLevels; ++level) {
+      const int shift = level * kBitsPerLevel;
+      const uint64_t position = (current_tick_ >> shift) & kSlotMask;
+      // Occupied slots are always ahead of the current position.
+      const uint64_t ahead =
+          position == kSlotMask ? 0 : occupied_[level] >> (position + 1);
+      if (ahead == 0) {
+        continue;
+      }
+      const uint64_t slot = position + 1 + absl::countr_zero(ahead);
+      const int group_end = shift + kBitsPerLevel;
+      const uint64_t upper =
+          group_end >= 64 ? 0 : (current_tick_ >> group_end) << group_end;
+      const uint64_t tick = upper | (slot << shift);
+      next = next ? std::min(*next, tick) : tick;
+    }
+    return next;
+  }
+
+  uint64_t current_tick_;
+  size_t size_ = 0;
+  std::vector<Node> nodes_;
+  uint32_t free_head_ = kNone;
+  std::array<uint32_t, kDueSlot + 1> head_;
+  std::array<uint32_t, kDueSlot + 1> tail_;
+  // Bit i of occupied_[level] is set if slot i of the level is not empty.
+  std::array<uint64_t, kLevels> occupied_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TASK_UTILS_TIMER_WHEEL_H_
@@ -0,0 +1,216 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_utils/timer_wheel.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Optional;
+using ::testing::UnorderedElementsAreArray;
+
+TEST(TimerWheelTest, ExpiresTimersInOrder) {
+  TimerWheel<int> wheel(/*now_tick=*/1000);
+  wheel.Schedule(1010, 2);
+  wheel.Schedule(1005, 1);
+  wheel.Schedule(5000, 4);
+  wheel.Schedule(1010, 3);
+  EXPECT_EQ(wheel.size(), 4u);
+
+  std::vector<int> expired;
+  wheel.AdvanceTo(1004, expired);
+  EXPECT_THAT(expired, IsEmpty());
+  wheel.AdvanceTo(1010, expired);
+  EXPECT_THAT(expired, ElementsAre(1, 2, 3));
+  expired.clear();
+  wheel.AdvanceTo(4999, expired);
+  EXPECT_THAT(expired, IsEmpty());
+  wheel.AdvanceTo(100000, expired);
+  EXPECT_THAT(expired, ElementsAre(4));
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_EQ(wheel.current_tick(), 100000u);
+}
+
+TEST(TimerWheelTest, TimersInThePastExpireOnNextAdvance) {
+  TimerWheel<int> wheel(/*now_tick=*/50);
+  wheel.Schedule(10, 1);
+  wheel.Schedule(50, 2);
+  EXPECT_THAT(wheel.NextWakeupTick(), Optional(50u));
+
+  std::vector<int> expired;
+  wheel.AdvanceTo(50, expired);
+  EXPECT_THAT(expired, ElementsAre(1, 2));
+}
+
+TEST(TimerWheelTest, CancelRemovesTimer) {
+  TimerWheel<std::unique_ptr<int>> wheel;
+  auto id1 = wheel.Schedule(100, std::make_unique<int>(1));
+  auto id2 = wheel.Schedule(100, std::make_unique<int>(2));
+  auto id3 = wheel.Schedule(1 << 20, std::make_unique<int>(3));
+  EXPECT_TRUE(wheel.Cancel(id1));
+  EXPECT_FALSE(wheel.Cancel(id1));
+  EXPECT_TRUE(wheel.Cancel(id3));
+  EXPECT_EQ(wheel.size(), 1u);
+
+  std::vector<std::unique_ptr<int>> expired;
+  wheel.AdvanceTo(1 << 21, expired);
+  ASSERT_EQ(expired.size(), 1u);
+  EXPECT_EQ(*expired[0], 2);
+  EXPECT_FALSE(wheel.Cancel(id2));
+}
+
+TEST(TimerWheelTest, CancelOfReusedNodeDoesNotRemoveNewTimer) {
+  TimerWheel<int> wheel;
+  auto id1 = wheel.Schedule(10, 1);
+  EXPECT_TRUE(wheel.Cancel(id1));
+  auto id2 = wheel.Schedule(10, 2);
+  EXPECT_NE(id1, id2);
+  EXPECT_FALSE(wheel.Cancel(id1));
+  EXPECT_EQ(wheel.size(), 1u);
+}
+
+TEST(TimerWheelTest, NextWakeupTickIsNotAfterEarliestExpiry) {
+  TimerWheel<int> wheel(/*now_tick=*/123);
+  EXPECT_EQ(wheel.NextWakeupTick(), absl::nullopt);
+  wheel.Schedule(130, 1);
+  EXPECT_THAT(wheel.NextWakeupTick(), Optional(130u));
+
+  wheel.Schedule(1'000'000, 2);
+  std::vector<int> expired;
+  wheel.AdvanceTo(200, expired);
+  EXPECT_THAT(expired, ElementsAre(1));
+  absl::optional<uint64_t> wakeup = wheel.NextWakeupTick();
+  ASSERT_TRUE(wakeup);
+  EXPECT_GT(*wakeup, 200u);
+  EXPECT_LE(*wakeup, 1'000'000u);
+}
+
+TEST(TimerWheelTest, CoalescesTimersWithSlack) {
+  TimerWheel<int> wheel(/*now_tick=*/64);
+  wheel.Schedule(100, 1, /*max_slack_ticks=*/20);
+  wheel.Schedule(105, 2, /*max_slack_ticks=*/20);
+  wheel.Schedule(105, 3);
+  EXPECT_THAT(wheel.NextWakeupTick(), Optional(105u));
+
+  std::vector<int> expired;
+  wheel.AdvanceTo(111, expired);
+  EXPECT_THAT(expired, ElementsAre(3));
+  expired.clear();
+  // 112 is the most aligned tick in both [100, 120] and [105, 125].
+  EXPECT_THAT(wheel.NextWakeupTick(), Optional(112u));
+  wheel.AdvanceTo(112, expired);
+  EXPECT_THAT(expired, ElementsAre(1, 2));
+}
+
+TEST(TimerWheelTest, KeepsExpiryWhenTimeGoesBackwards) {
+  TimerWheel<int> wheel(/*now_tick=*/1000);
+  wheel.Schedule(1500, 1);
+  wheel.Schedule(20, 2);
+
+  std::vector<int> expired;
+  wheel.AdvanceTo(10, expired);
+  EXPECT_THAT(expired, IsEmpty());
+  EXPECT_EQ(wheel.current_tick(), 10u);
+  wheel.AdvanceTo(1499, expired);
+  EXPECT_THAT(expired, ElementsAre(2));
+  expired.clear();
+  wheel.AdvanceTo(1500, expired);
+  EXPECT_THAT(expired, ElementsAre(1));
+}
+
+TEST(TimerWheelTest, ClearDestroysAllTimers) {
+  auto value = std::make_shared<int>(1);
+  TimerWheel<std::shared_ptr<int>> wheel;
+  auto id = wheel.Schedule(10, value);
+  wheel.Schedule(1 << 30, value);
+  wheel.Schedule(0, value);
+  EXPECT_EQ(value.use_count(), 4);
+  wheel.Clear();
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_EQ(value.use_count(), 1);
+  EXPECT_FALSE(wheel.Cancel(id));
+  EXPECT_EQ(wheel.NextWakeupTick(), absl::nullopt);
+}
+
+TEST(TimerWheelTest, MatchesReferenceWithRandomOperations) {
+  Random random(0x1234);
+  uint64_t now = 1'000'000'000;
+  TimerWheel<int> wheel(now);
+  std::multimap<uint64_t, int> reference;
+  std::map<int, std::pair<uint64_t, TimerWheel<int>::TimerId>> timers;
+  int next_value = 0;
+  for (int i = 0; i < 20000; ++i) {
+    switch (random.Rand(0, 3)) {
+      case 0:
+      case 1: {
+        const uint64_t expiry =
+            now + random.Rand(0u, 1u << random.Rand(0, 24)) - random.Rand(0, 2);
+        timers[next_value] = {expiry, wheel.Schedule(expiry, next_value)};
+        reference.emplace(expiry, next_value);
+        ++next_value;
+        break;
+      }
+      case 2: {
+        if (timers.empty()) {
+          break;
+        }
+        auto it = timers.lower_bound(random.Rand(0, next_value));
+        if (it == timers.end()) {
+          it = timers.begin();
+        }
+        EXPECT_TRUE(wheel.Cancel(it->second.second));
+        auto range = reference.equal_range(it->second.first);
+        for (auto ref = range.first; ref != range.second; ++ref) {
+          if (ref->second == it->first) {
+            reference.erase(ref);
+            break;
+          }
+        }
+        timers.erase(it);
+        break;
+      }
+      case 3: {
+        if (!reference.empty()) {
+          absl::optional<uint64_t> wakeup = wheel.NextWakeupTick();
+          ASSERT_TRUE(wakeup);
+          EXPECT_LE(*wakeup, std::max(now, reference.begin()->first));
+        }
+        now += random.Rand(0u, 1u << random.Rand(0, 26));
+        std::vector<int> expired;
+        wheel.AdvanceTo(now, expired);
+        std::vector<int> expected;
+        while (!reference.empty() && reference.begin()->first <= now) {
+          expected.push_back(reference.begin()->second);
+          timers.erase(reference.begin()->second);
+          reference.erase(reference.begin());
+        }
+        EXPECT_THAT(expired, UnorderedElementsAreArray(expected));
+        break;
+      }
+    }
+    ASSERT_EQ(wheel.size(), reference.size());
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
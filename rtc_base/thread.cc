@@ -31,19 +31,25 @@
 
 #include <stdio.h>
 
+#include <algorithm>
 #include <utility>
 
 #include "absl/algorithm/container.h"
 #include "absl/cleanup/cleanup.h"
+#include "absl/types/optional.h"
 #include "api/sequence_checker.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
 #include "rtc_base/internal/default_socket_server.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/null_socket_server.h"
+#if !defined(__native_client__)
+#include "rtc_base/physical_socket_server.h"
+#endif
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
+#include "system_wrappers/include/field_trial.h"
 
 #if defined(WEBRTC_MAC)
 #include "rtc_base/system/cocoa_threading.h"
@@ -77,6 +83,14 @@ namespace rtc {
 using ::webrtc::MutexLock;
 using ::webrtc::TimeDelta;
 
+namespace {
+
+uint64_t DelayedMessageTick(int64_t time_ms) {
+  return static_cast<uint64_t>(std::max<int64_t>(time_ms, 0));
+}
+
+}  // namespace
+
 ThreadManager* ThreadManager::Instance() {
   static ThreadManager* const thread_manager = new ThreadManager();
   return thread_manager;
@@ -316,7 +330,9 @@ Thread::Thread(std::unique_ptr<SocketServer> ss)
     : Thread(std::move(ss), /*do_init=*/true) {}
 
 Thread::Thread(SocketServer* ss, bool do_init)
-    : delayed_next_num_(0),
+    : delayed_messages_(DelayedMessageTick(TimeMillis())),
+      coarse_low_precision_(webrtc::field_trial::IsEnabled(
+          "WebRTC-TaskQueue-CoarseLowPrecisionTimers")),
       fInitialized_(false),
       fDestroyed_(false),
       stop_(0),
@@ -364,7 +380,7 @@ void Thread::DoDestroy() {
   // Clear.
   CurrentTaskQueueSetter set_current(this);
   messages_ = {};
-  delayed_messages_ = {};
+  delayed_messages_.Clear();
 }
 
 SocketServer* Thread::socketserver() {
@@ -404,14 +420,18 @@ absl::AnyInvocable<void() &&> Thread::Get(int cmsWait) {
       MutexLock lock(&mutex_);
       // Check for delayed messages that have been triggered and calculate the
       // next trigger time.
-      while (!delayed_messages_.empty()) {
-        if (msCurrent < delayed_messages_.top().run_time_ms) {
-          cmsDelayNext =
-              TimeDiff(delayed_messages_.top().run_time_ms, msCurrent);
-          break;
+      if (!delayed_messages_.empty()) {
+        delayed_messages_.AdvanceTo(DelayedMessageTick(msCurrent),
+                                    expired_messages_);
+        for (absl::AnyInvocable<void() &&>& message : expired_messages_) {
+          messages_.push(std::move(message));
+        }
+        expired_messages_.clear();
+        absl::optional<uint64_t> next_tick = delayed_messages_.NextWakeupTick();
+        if (next_tick) {
+          cmsDelayNext = static_cast<int64_t>(*next_tick -
+                                              delayed_messages_.current_tick());
         }
-        messages_.push(std::move(delayed_messages_.top().functor));
-        delayed_messages_.pop();
       }
       // Pull a message off the message queue, if available.
       if (!messages_.empty()) {
@@ -482,22 +502,18 @@ void Thread::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
   }
 
   // Keep thread safe
-  // Add to the priority queue. Gets sorted soonest first.
+  // Add to the timer wheel.
   // Signal for the multiplexer to return.
 
   int64_t delay_ms = delay.RoundUpTo(webrtc::TimeDelta::Millis(1)).ms<int>();
   int64_t run_time_ms = TimeAfter(delay_ms);
+  uint64_t slack_ms = coarse_low_precision_ && !traits.high_precision
+                          ? webrtc::kLowPrecisionTimerSlack.ms()
+                          : 0;
   {
     MutexLock lock(&mutex_);
-    delayed_messages_.push({.delay_ms = delay_ms,
-                            .run_time_ms = run_time_ms,
-                            .message_number = delayed_next_num_,
-                            .functor = std::move(task)});
-    // If this message queue processes 1 message every millisecond for 50 days,
-    // we will wrap this number.  Even then, only messages with identical times
-    // will be misordered, and then only briefly.  This is probably ok.
-    ++delayed_next_num_;
-    RTC_DCHECK_NE(0, delayed_next_num_);
+    delayed_messages_.Schedule(DelayedMessageTick(run_time_ms),
+                               std::move(task), slack_ms);
   }
   WakeUpSocketServer();
 }
@@ -508,11 +524,10 @@ int Thread::GetDelay() {
   if (!messages_.empty())
     return 0;
 
-  if (!delayed_messages_.empty()) {
-    int delay = TimeUntil(delayed_messages_.top().run_time_ms);
-    if (delay < 0)
-      delay = 0;
-    return delay;
+  absl::optional<uint64_t> next_tick = delayed_messages_.NextWakeupTick();
+  if (next_tick) {
+    int64_t delay = static_cast<int64_t>(*next_tick) - TimeMillis();
+    return static_cast<int>(std::max<int64_t>(delay, 0));
   }
 
   return kForever;
@@ -542,6 +557,16 @@ std::unique_ptr<Thread> Thread::CreateWithSocketServer() {
   return std::unique_ptr<Thread>(new Thread(CreateDefaultSocketServer()));
 }
 
+std::unique_ptr<Thread> Thread::CreateWithIoUringSocketServer() {
+#if defined(__native_client__)
+  return CreateWithSocketServer();
+#else
+  return std::unique_ptr<Thread>(
+      new Thread(std::make_unique<PhysicalSocketServer>(
+          PhysicalSocketServer::EventBackend::kIoUring)));
+#endif
+}
+
 std::unique_ptr<Thread> Thread::Create() {
   return std::unique_ptr<Thread>(
       new Thread(std::unique_ptr<SocketServer>(new NullSocketServer())));
@@ -39,6 +39,7 @@
 #include "rtc_base/socket_server.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/system/rtc_export.h"
+#include "rtc_base/task_utils/timer_wheel.h"
 #include "rtc_base/thread_annotations.h"
 
 #if defined(WEBRTC_WIN)
@@ -193,6 +194,10 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
   Thread& operator=(const Thread&) = delete;
 
   static std::unique_ptr<Thread> CreateWithSocketServer();
+  // Like CreateWithSocketServer(), but on Linux builds with rtc_use_io_uring
+  // the socket server waits for socket events with io_uring instead of epoll
+  // when the kernel supports it.
+  static std::unique_ptr<Thread> CreateWithIoUringSocketServer();
   static std::unique_ptr<Thread> Create();
   static Thread* Current();
 
@@ -394,26 +399,6 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
     rtc::Thread* const previous_;
   };
 
-  // DelayedMessage goes into a priority queue, sorted by trigger time. Messages
-  // with the same trigger time are processed in num_ (FIFO) order.
-  struct DelayedMessage {
-    bool operator<(const DelayedMessage& dmsg) const {
-      return (dmsg.run_time_ms < run_time_ms) ||
-             ((dmsg.run_time_ms == run_time_ms) &&
-              (dmsg.message_number < message_number));
-    }
-
-    int64_t delay_ms;  // for debugging
-    int64_t run_time_ms;
-    // Monotonicaly incrementing number used for ordering of messages
-    // targeted to execute at the same time.
-    uint32_t message_number;
-    // std::priority_queue doesn't allow to extract elements, but functor
-    // is move-only and thus need to be changed when pulled out of the
-    // priority queue. That is ok because `functor` doesn't affect operator<
-    mutable absl::AnyInvocable<void() &&> functor;
-  };
-
   // TaskQueueBase implementation.
   void PostTaskImpl(absl::AnyInvocable<void() &&> task,
                     const PostTaskTraits& traits,
@@ -486,8 +471,17 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
   void ClearCurrentTaskQueue();
 
   std::queue<absl::AnyInvocable<void() &&>> messages_ RTC_GUARDED_BY(mutex_);
-  std::priority_queue<DelayedMessage> delayed_messages_ RTC_GUARDED_BY(mutex_);
-  uint32_t delayed_next_num_ RTC_GUARDED_BY(mutex_);
+  // Delayed messages, keyed by their run time in TimeMillis(). Messages with
+  // the same run time are processed in FIFO order.
+  webrtc::TimerWheel<absl::AnyInvocable<void() &&>> delayed_messages_
+      RTC_GUARDED_BY(mutex_);
+  // Scratch space for delayed messages moved to `messages_`.
+  std::vector<absl::AnyInvocable<void() &&>> expired_messages_
+      RTC_GUARDED_BY(mutex_);
+  // If true, low precision delayed messages may run up to 16 ms late so that
+  // they coalesce with other messages. Set by the
+  // "WebRTC-TaskQueue-CoarseLowPrecisionTimers" field trial.
+  const bool coarse_low_precision_;
 #if RTC_DCHECK_IS_ON
   uint32_t blocking_call_count_ RTC_GUARDED_BY(this) = 0;
   uint32_t could_be_blocking_call_count_ RTC_GUARDED_BY(this) = 0;
@@ -29,6 +29,7 @@
 #include "rtc_base/socket_address.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
+#include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/testsupport/rtc_expect_death.h"
 
@@ -510,6 +511,41 @@ TEST(ThreadTest, DelayedPostsWithIdenticalTimesAreProcessedInFifoOrder) {
   DelayedPostsWithIdenticalTimesAreProcessedInFifoOrder(clock, q_nullss);
 }
 
+TEST(ThreadTest, CoarseLowPrecisionDelayedPostsRunOnAlignedTimes) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-TaskQueue-CoarseLowPrecisionTimers/Enabled/");
+  ScopedBaseFakeClock clock;
+  // Align the clock so that the time low precision posts are moved to is
+  // known.
+  clock.AdvanceTime(TimeDelta::Millis(64 - TimeMillis() % 64));
+  NullSocketServer nullss;
+  Thread q(&nullss, true);
+  q.Start();
+
+  bool low_precision_ran = false;
+  bool high_precision_ran = false;
+  Event low_precision_done;
+  q.PostDelayedTaskWithPrecision(
+      webrtc::TaskQueueBase::DelayPrecision::kLow,
+      [&] {
+        low_precision_ran = true;
+        low_precision_done.Set();
+      },
+      TimeDelta::Millis(1));
+  q.PostDelayedTaskWithPrecision(webrtc::TaskQueueBase::DelayPrecision::kHigh,
+                                 [&] { high_precision_ran = true; },
+                                 TimeDelta::Millis(1));
+
+  clock.AdvanceTime(TimeDelta::Millis(15));
+  q.BlockingCall([&] {
+    EXPECT_TRUE(high_precision_ran);
+    EXPECT_FALSE(low_precision_ran);
+  });
+
+  clock.AdvanceTime(TimeDelta::Millis(1));
+  EXPECT_TRUE(low_precision_done.Wait(TimeDelta::Seconds(1)));
+}
+
 // Ensure that ProcessAllMessageQueues does its essential function; process
 // all messages (both delayed and non delayed) up until the current time, on
 // all registered message queues.
@@ -14,6 +14,8 @@
 #include "api/test/audioproc_float.h"
 
 int main(int argc, char* argv[]) {
+  // No builder is passed, so that each simulation uses a default builder of
+  // its own, as needed to replay several aec dumps with --dump_input_dir.
   return webrtc::test::AudioprocFloat(
-      std::make_unique<webrtc::AudioProcessingBuilder>(), argc, argv);
+      std::unique_ptr<webrtc::AudioProcessingBuilder>(), argc, argv);
 }
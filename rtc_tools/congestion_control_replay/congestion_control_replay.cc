@@ -0,0 +1,249 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/congestion_control_replay/congestion_control_replay.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/transport/network_types.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_tools/rtc_event_log_visualizer/log_simulation.h"
+
+namespace webrtc {
+namespace {
+
+// Values weighted by the time they were in effect.
+class TimeWeightedSamples {
+ public:
+  void Add(double value, TimeDelta weight) {
+    if (weight <= TimeDelta::Zero()) {
+      return;
+    }
+    const double weight_us = static_cast<double>(weight.us());
+    samples_.push_back({value, weight_us});
+    total_weight_us_ += weight_us;
+    weighted_sum_ += value * weight_us;
+    sorted_ = false;
+  }
+
+  double Mean() const {
+    return samples_.empty() ? 0.0 : weighted_sum_ / total_weight_us_;
+  }
+
+  // Returns the smallest value that was in effect at least `fraction` of the
+  // time, counting from the smallest value.
+  double Percentile(double fraction) {
+    if (samples_.empty()) {
+      return 0.0;
+    }
+    if (!sorted_) {
+      std::sort(samples_.begin(), samples_.end(),
+                [](const Sample& a, const Sample& b) {
+                  return a.value < b.value;
+                });
+      sorted_ = true;
+    }
+    const double threshold = fraction * total_weight_us_;
+    double accumulated_us = 0.0;
+    for (const Sample& sample : samples_) {
+      accumulated_us += sample.weight_us;
+      if (accumulated_us >= threshold) {
+        return sample.value;
+      }
+    }
+    return samples_.back().value;
+  }
+
+ private:
+  struct Sample {
+    double value;
+    double weight_us;
+  };
+
+  std::vector<Sample> samples_;
+  double total_weight_us_ = 0.0;
+  double weighted_sum_ = 0.0;
+  bool sorted_ = true;
+};
+
+// Keeps the output one row per log.
+std::string SanitizeField(absl::string_view text) {
+  std::string field(text);
+  std::replace_if(
+      field.begin(), field.end(),
+      [](char c) { return c == '\t' || c == '\n' || c == '\r'; }, ' ');
+  return field;
+}
+
+}  // namespace
+
+CongestionControlReplayResult ReplayEventLog(
+    const ParsedRtcEventLog& parsed_log,
+    std::unique_ptr<NetworkControllerFactoryInterface> factory) {
+  CongestionControlReplayResult result;
+  TimeWeightedSamples target_rate_bps;
+  TimeWeightedSamples stable_target_rate_bps;
+  TimeWeightedSamples loss_ratio;
+  TimeWeightedSamples rtt_ms;
+
+  absl::optional<TargetTransferRate> current;
+  Timestamp current_since = Timestamp::MinusInfinity();
+  auto accumulate_until = [&](Timestamp until) {
+    if (!current || !until.IsFinite()) {
+      return;
+    }
+    const TimeDelta weight = until - current_since;
+    target_rate_bps.Add(current->target_rate.bps<double>(), weight);
+    stable_target_rate_bps.Add(current->stable_target_rate.bps<double>(),
+                               weight);
+    loss_ratio.Add(current->network_estimate.loss_rate_ratio, weight);
+    if (current->network_estimate.round_trip_time.IsFinite()) {
+      rtt_ms.Add(current->network_estimate.round_trip_time.ms<double>(),
+                 weight);
+    }
+  };
+
+  LogBasedNetworkControllerSimulation simulation(
+      std::move(factory),
+      [&](const NetworkControlUpdate& update, Timestamp at_time) {
+        if (!update.target_rate) {
+          return;
+        }
+        accumulate_until(at_time);
+        const DataRate target_rate = update.target_rate->target_rate;
+        if (result.target_rate_updates == 0) {
+          result.min_target_rate = target_rate;
+          result.max_target_rate = target_rate;
+        } else {
+          result.min_target_rate =
+              std::min(result.min_target_rate, target_rate);
+          result.max_target_rate =
+              std::max(result.max_target_rate, target_rate);
+        }
+        ++result.target_rate_updates;
+        current = update.target_rate;
+        current_since = at_time;
+      });
+  simulation.ProcessEventsInLog(parsed_log);
+  accumulate_until(parsed_log.last_timestamp());
+
+  if (parsed_log.first_timestamp().IsFinite() &&
+      parsed_log.last_timestamp().IsFinite()) {
+    result.duration =
+        parsed_log.last_timestamp() - parsed_log.first_timestamp();
+  }
+  if (current) {
+    result.final_target_rate = current->target_rate;
+  }
+  result.mean_target_rate = DataRate::BitsPerSec(target_rate_bps.Mean());
+  result.p5_target_rate =
+      DataRate::BitsPerSec(target_rate_bps.Percentile(0.05));
+  result.p50_target_rate =
+      DataRate::BitsPerSec(target_rate_bps.Percentile(0.5));
+  result.p95_target_rate =
+      DataRate::BitsPerSec(target_rate_bps.Percentile(0.95));
+  result.mean_stable_target_rate =
+      DataRate::BitsPerSec(stable_target_rate_bps.Mean());
+  result.mean_loss_ratio = loss_ratio.Mean();
+  result.mean_rtt = TimeDelta::Micros(rtt_ms.Mean() * 1000);
+  result.p95_rtt = TimeDelta::Micros(rtt_ms.Percentile(0.95) * 1000);
+  return result;
+}
+
+CongestionControlReplayResult ReplayEventLogFile(
+    absl::string_view file_name,
+    ParsedRtcEventLog::UnconfiguredHeaderExtensions header_extensions,
+    const NetworkControllerFactoryBuilder& factory_builder) {
+  ParsedRtcEventLog parsed_log(header_extensions,
+                               /*allow_incomplete_logs=*/true);
+  ParsedRtcEventLog::ParseStatus status = parsed_log.ParseFile(file_name);
+  CongestionControlReplayResult result;
+  if (!status.ok()) {
+    result.error = status.message();
+  } else {
+    result = ReplayEventLog(parsed_log, factory_builder());
+  }
+  result.log_name = std::string(file_name);
+  return result;
+}
+
+std::vector<CongestionControlReplayResult> ReplayEventLogFiles(
+    const std::vector<std::string>& file_names,
+    ParsedRtcEventLog::UnconfiguredHeaderExtensions header_extensions,
+    const NetworkControllerFactoryBuilder& factory_builder,
+    int num_workers) {
+  RTC_DCHECK_GT(num_workers, 0);
+  std::vector<CongestionControlReplayResult> results(file_names.size());
+  // Workers pick the next log when done with the previous one, which keeps
+  // them busy even though log sizes vary a lot.
+  std::atomic<size_t> next_index{0};
+  auto worker = [&] {
+    for (size_t index = next_index.fetch_add(1); index < file_names.size();
+         index = next_index.fetch_add(1)) {
+      results[index] = ReplayEventLogFile(file_names[index], header_extensions,
+                                          factory_builder);
+      if (!results[index].ok()) {
+        RTC_LOG(LS_WARNING) << "Failed to replay " << file_names[index] << ": "
+                            << results[index].error;
+      }
+    }
+  };
+
+  const size_t num_threads =
+      std::min(static_cast<size_t>(num_workers), file_names.size());
+  std::vector<rtc::PlatformThread> threads;
+  threads.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads.push_back(rtc::PlatformThread::SpawnJoinable(worker, "cc_replay"));
+  }
+  // Joins the workers.
+  threads.clear();
+  return results;
+}
+
+void WriteReplayResultsHeader(FILE* output) {
+  fprintf(output,
+          "log\tstatus\tduration_s\ttarget_rate_updates\t"
+          "mean_target_kbps\tmin_target_kbps\tmax_target_kbps\t"
+          "p5_target_kbps\tp50_target_kbps\tp95_target_kbps\t"
+          "final_target_kbps\tmean_stable_target_kbps\tmean_loss_ratio\t"
+          "mean_rtt_ms\tp95_rtt_ms\terror\n");
+}
+
+void WriteReplayResult(const CongestionControlReplayResult& result,
+                       FILE* output) {
+  fprintf(output,
+          "%s\t%s\t%.3f\t%d\t%.1f\t%.1f\t%.1f\t%.1f\t%.1f\t%.1f\t%.1f\t%.1f\t"
+          "%.4f\t%.1f\t%.1f\t%s\n",
+          SanitizeField(result.log_name).c_str(), result.ok() ? "ok" : "error",
+          result.duration.seconds<double>(), result.target_rate_updates,
+          result.mean_target_rate.kbps<double>(),
+          result.min_target_rate.kbps<double>(),
+          result.max_target_rate.kbps<double>(),
+          result.p5_target_rate.kbps<double>(),
+          result.p50_target_rate.kbps<double>(),
+          result.p95_target_rate.kbps<double>(),
+          result.final_target_rate.kbps<double>(),
+          result.mean_stable_target_rate.kbps<double>(), result.mean_loss_ratio,
+          result.mean_rtt.ms<double>(), result.p95_rtt.ms<double>(),
+          SanitizeField(result.error).c_str());
+}
+
+}  // namespace webrtc
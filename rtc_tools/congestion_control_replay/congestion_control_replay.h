@@ -0,0 +1,92 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_TOOLS_CONGESTION_CONTROL_REPLAY_CONGESTION_CONTROL_REPLAY_H_
+#define RTC_TOOLS_CONGESTION_CONTROL_REPLAY_CONGESTION_CONTROL_REPLAY_H_
+
+#include <stdio.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/transport/network_control.h"
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "logging/rtc_event_log/rtc_event_log_parser.h"
+
+namespace webrtc {
+
+// Summary of the target rates produced by a network controller while
+// replaying the packets and feedback of one RTC event log. Rates, loss and
+// round trip time are weighted by how long each target rate was in effect,
+// from its update until the next one or the end of the log.
+struct CongestionControlReplayResult {
+  std::string log_name;
+  // Empty if the log was parsed and replayed.
+  std::string error;
+
+  TimeDelta duration = TimeDelta::Zero();
+  int target_rate_updates = 0;
+
+  DataRate mean_target_rate = DataRate::Zero();
+  DataRate min_target_rate = DataRate::Zero();
+  DataRate max_target_rate = DataRate::Zero();
+  DataRate p5_target_rate = DataRate::Zero();
+  DataRate p50_target_rate = DataRate::Zero();
+  DataRate p95_target_rate = DataRate::Zero();
+  DataRate final_target_rate = DataRate::Zero();
+  DataRate mean_stable_target_rate = DataRate::Zero();
+
+  // Loss ratio and round trip time as estimated by the controller.
+  double mean_loss_ratio = 0.0;
+  TimeDelta mean_rtt = TimeDelta::Zero();
+  TimeDelta p95_rtt = TimeDelta::Zero();
+
+  bool ok() const { return error.empty(); }
+};
+
+// Creates a new controller factory for each replayed log. Called
+// concurrently from the replay workers.
+using NetworkControllerFactoryBuilder =
+    std::function<std::unique_ptr<NetworkControllerFactoryInterface>()>;
+
+// Replays `parsed_log` through a controller created by `factory`.
+CongestionControlReplayResult ReplayEventLog(
+    const ParsedRtcEventLog& parsed_log,
+    std::unique_ptr<NetworkControllerFactoryInterface> factory);
+
+// Parses and replays the event log in `file_name`. Parse errors are
+// reported in the `error` field of the result.
+CongestionControlReplayResult ReplayEventLogFile(
+    absl::string_view file_name,
+    ParsedRtcEventLog::UnconfiguredHeaderExtensions header_extensions,
+    const NetworkControllerFactoryBuilder& factory_builder);
+
+// Replays all `file_names` on `num_workers` threads. Each log is parsed and
+// replayed on a single worker, so at most `num_workers` logs are in memory at
+// a time. Returns the results in the order of `file_names`.
+std::vector<CongestionControlReplayResult> ReplayEventLogFiles(
+    const std::vector<std::string>& file_names,
+    ParsedRtcEventLog::UnconfiguredHeaderExtensions header_extensions,
+    const NetworkControllerFactoryBuilder& factory_builder,
+    int num_workers);
+
+// Writes results as tab separated values, one row per log with the column
+// names in the header row.
+void WriteReplayResultsHeader(FILE* output);
+void WriteReplayResult(const CongestionControlReplayResult& result,
+                       FILE* output);
+
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_CONGESTION_CONTROL_REPLAY_CONGESTION_CONTROL_REPLAY_H_
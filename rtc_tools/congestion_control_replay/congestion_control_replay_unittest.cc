@@ -0,0 +1,85 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/congestion_control_replay/congestion_control_replay.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/transport/goog_cc_factory.h"
+#include "logging/rtc_event_log/rtc_event_log_parser.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+using UnconfiguredHeaderExtensions =
+    ParsedRtcEventLog::UnconfiguredHeaderExtensions;
+
+constexpr UnconfiguredHeaderExtensions kHeaderExtensions =
+    UnconfiguredHeaderExtensions::kAttemptWebrtcDefaultConfig;
+
+std::unique_ptr<NetworkControllerFactoryInterface> CreateGoogCcFactory() {
+  return std::make_unique<GoogCcNetworkControllerFactory>();
+}
+
+std::string LogFileName() {
+  return test::ResourcePath("rtc_event_log/rtc_event_log_500kbps", "binarypb");
+}
+
+TEST(CongestionControlReplayTest, SummarizesTargetRates) {
+  CongestionControlReplayResult result =
+      ReplayEventLogFile(LogFileName(), kHeaderExtensions, CreateGoogCcFactory);
+  ASSERT_TRUE(result.ok()) << result.error;
+  EXPECT_EQ(result.log_name, LogFileName());
+  EXPECT_GT(result.duration, TimeDelta::Zero());
+  EXPECT_GT(result.target_rate_updates, 0);
+  EXPECT_GT(result.mean_target_rate, DataRate::Zero());
+  EXPECT_LE(result.min_target_rate, result.p5_target_rate);
+  EXPECT_LE(result.p5_target_rate, result.p50_target_rate);
+  EXPECT_LE(result.p50_target_rate, result.p95_target_rate);
+  EXPECT_LE(result.p95_target_rate, result.max_target_rate);
+  EXPECT_GE(result.mean_target_rate, result.min_target_rate);
+  EXPECT_LE(result.mean_target_rate, result.max_target_rate);
+}
+
+TEST(CongestionControlReplayTest, ParallelReplayMatchesSequential) {
+  const std::vector<std::string> file_names(4, LogFileName());
+  CongestionControlReplayResult expected =
+      ReplayEventLogFile(LogFileName(), kHeaderExtensions, CreateGoogCcFactory);
+  std::vector<CongestionControlReplayResult> results = ReplayEventLogFiles(
+      file_names, kHeaderExtensions, CreateGoogCcFactory, /*num_workers=*/3);
+  ASSERT_EQ(results.size(), file_names.size());
+  for (const CongestionControlReplayResult& result : results) {
+    ASSERT_TRUE(result.ok()) << result.error;
+    EXPECT_EQ(result.target_rate_updates, expected.target_rate_updates);
+    EXPECT_EQ(result.mean_target_rate, expected.mean_target_rate);
+    EXPECT_EQ(result.p95_target_rate, expected.p95_target_rate);
+    EXPECT_EQ(result.final_target_rate, expected.final_target_rate);
+    EXPECT_EQ(result.mean_rtt, expected.mean_rtt);
+  }
+}
+
+TEST(CongestionControlReplayTest, ReportsUnreadableLogs) {
+  const std::vector<std::string> file_names = {
+      LogFileName(), test::OutputPath() + "does_not_exist.rtceventlog"};
+  std::vector<CongestionControlReplayResult> results = ReplayEventLogFiles(
+      file_names, kHeaderExtensions, CreateGoogCcFactory, /*num_workers=*/2);
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_TRUE(results[0].ok());
+  EXPECT_FALSE(results[1].ok());
+  EXPECT_EQ(results[1].log_name, file_names[1]);
+  EXPECT_EQ(results[1].target_rate_updates, 0);
+}
+
+}  // namespace
+}  // namespace webrtc
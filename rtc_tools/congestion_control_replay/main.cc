@@ -0,0 +1,125 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/flags/usage.h"
+#include "absl/strings/string_view.h"
+#include "api/transport/goog_cc_factory.h"
+#include "logging/rtc_event_log/rtc_event_log_parser.h"
+#include "rtc_base/logging.h"
+#include "rtc_tools/congestion_control_replay/congestion_control_replay.h"
+#include "system_wrappers/include/field_trial.h"
+
+ABSL_FLAG(int,
+          workers,
+          0,
+          "Number of logs to replay in parallel. 0 uses one worker per "
+          "hardware thread.");
+ABSL_FLAG(std::string,
+          output,
+          "",
+          "File to write the tab separated per-log summaries to. Written to "
+          "stdout if empty.");
+ABSL_FLAG(bool,
+          parse_unconfigured_header_extensions,
+          true,
+          "Attempt to parse unconfigured header extensions using the default "
+          "WebRTC mapping. This can give very misleading results if the "
+          "application negotiates a different mapping.");
+ABSL_FLAG(std::string,
+          force_fieldtrials,
+          "",
+          "Field trials control experimental feature code which can be forced. "
+          "E.g. running with --force_fieldtrials=WebRTC-FooFeature/Enabled/"
+          " will assign the group Enabled to field trial WebRTC-FooFeature. "
+          "The trials apply to the replayed network controller.");
+
+// Replays the sent packets and received feedback of many RTC event logs
+// through GoogCC and writes one summary row of the resulting target rates per
+// log. Used to compare congestion controller changes over a corpus of logs.
+int main(int argc, char* argv[]) {
+  absl::SetProgramUsageMessage(
+      "Replays RTC event logs through the GoogCC network controller and\n"
+      "writes per-log summaries of the target rate, loss and round trip\n"
+      "time as tab separated values, one row per log.\n"
+      "\n"
+      "Example usage:\n"
+      "./congestion_control_replay --workers=16 --output=summary.tsv "
+      "logs/*.rtceventlog\n");
+  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+  if (args.size() < 2) {
+    absl::string_view usage = absl::ProgramUsageMessage();
+    fwrite(usage.data(), usage.size(), 1, stderr);
+    return 1;
+  }
+
+  // Print RTC_LOG warnings and errors even in release builds.
+  if (rtc::LogMessage::GetLogToDebug() > rtc::LS_WARNING) {
+    rtc::LogMessage::LogToDebug(rtc::LS_WARNING);
+  }
+  rtc::LogMessage::SetLogToStderr(true);
+
+  // InitFieldTrialsFromString stores the char*, so the char array must
+  // outlive the application.
+  const std::string field_trials = absl::GetFlag(FLAGS_force_fieldtrials);
+  webrtc::field_trial::InitFieldTrialsFromString(field_trials.c_str());
+
+  webrtc::ParsedRtcEventLog::UnconfiguredHeaderExtensions header_extensions =
+      webrtc::ParsedRtcEventLog::UnconfiguredHeaderExtensions::kDontParse;
+  if (absl::GetFlag(FLAGS_parse_unconfigured_header_extensions)) {
+    header_extensions = webrtc::ParsedRtcEventLog::
+        UnconfiguredHeaderExtensions::kAttemptWebrtcDefaultConfig;
+  }
+
+  int workers = absl::GetFlag(FLAGS_workers);
+  if (workers <= 0) {
+    workers =
+        static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  }
+
+  FILE* output = stdout;
+  const std::string output_file = absl::GetFlag(FLAGS_output);
+  if (!output_file.empty()) {
+    output = fopen(output_file.c_str(), "w");
+    if (output == nullptr) {
+      RTC_LOG(LS_ERROR) << "Failed to open " << output_file;
+      return 1;
+    }
+  }
+
+  const std::vector<std::string> file_names(args.begin() + 1, args.end());
+  const std::vector<webrtc::CongestionControlReplayResult> results =
+      webrtc::ReplayEventLogFiles(
+          file_names, header_extensions,
+          [] {
+            return std::make_unique<webrtc::GoogCcNetworkControllerFactory>();
+          },
+          workers);
+
+  bool success = true;
+  webrtc::WriteReplayResultsHeader(output);
+  for (const webrtc::CongestionControlReplayResult& result : results) {
+    webrtc::WriteReplayResult(result, output);
+    success = success && result.ok();
+  }
+  if (output != stdout) {
+    fclose(output);
+  }
+  return success ? 0 : 1;
+}
@@ -16,7 +16,8 @@
 namespace webrtc {
 
 // List of features in x86.
-typedef enum { kSSE2, kSSE3, kAVX2, kFMA3 } CPUFeature;
+// kAVX512 denotes AVX-512 Foundation (AVX-512F).
+typedef enum { kSSE2, kSSE3, kAVX2, kFMA3, kAVX512 } CPUFeature;
 
 // List of features in ARM.
 enum {
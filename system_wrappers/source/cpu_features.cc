@@ -100,6 +100,18 @@ int GetCPUInfo(CPUFeature feature) {
            (cpu_info7[1] & 0x00000020) != 0 /* AVX2 */ &&
            (cpu_info7[1] & 0x00000100) != 0 /* BMI2 */;
   }
+  if (feature == kAVX512) {
+    if (!GetCPUInfo(kAVX2)) {
+      return 0;
+    }
+    int cpu_info7[4];
+    __cpuid(cpu_info7, 7);
+
+    // AVX-512 instructions can be used when AVX2 can, AVX-512F is supported
+    // by the CPU and the kernel saves the opmask and ZMM registers.
+    return (cpu_info7[1] & 0x00010000) != 0 /* AVX-512F */ &&
+           (xgetbv(0) & 0x000000e6) == 0xe6 /* ZMM state enabled by kernel */;
+  }
 #endif  // WEBRTC_ENABLE_AVX2
   if (feature == kFMA3) {
     return 0 != (cpu_info[2] & 0x00001000);
@@ -57,6 +57,7 @@
 #include "media/base/sdp_video_format_utils.h"
 #include "modules/pacing/pacing_controller.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/include/rtp_packet_sender.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_header_extension_size.h"
 #include "modules/rtp_rtcp/source/rtp_sender.h"
@@ -524,6 +525,15 @@ VideoSendStreamImpl::~VideoSendStreamImpl() {
   RTC_LOG(LS_INFO) << "~VideoSendStreamImpl: " << config_.ToString();
   RTC_DCHECK(!started());
   RTC_DCHECK(!IsRunning());
+  // Weights outlive the packets of a stream in the pacer, so reset them.
+  if (RtpPacketSender* packet_sender = transport_->packet_sender()) {
+    for (uint32_t ssrc : config_.rtp.ssrcs) {
+      packet_sender->SetStreamWeight(ssrc, 1.0);
+    }
+    for (uint32_t ssrc : config_.rtp.rtx.ssrcs) {
+      packet_sender->SetStreamWeight(ssrc, 1.0);
+    }
+  }
   transport_->DestroyRtpVideoSender(rtp_video_sender_);
 }
 
@@ -836,6 +846,20 @@ void VideoSendStreamImpl::OnEncoderConfigurationChanged(
       stats_proxy_.OnInactiveSsrc(config_.rtp.ssrcs[i]);
     }
 
+    // Let pacers that schedule streams by weight share the send rate among
+    // the layers by bitrate priority. Layers without a priority of their own
+    // get the priority of the encoder.
+    if (RtpPacketSender* packet_sender = transport_->packet_sender()) {
+      for (size_t i = 0; i < streams.size(); ++i) {
+        const double weight =
+            streams[i].bitrate_priority.value_or(encoder_bitrate_priority_);
+        packet_sender->SetStreamWeight(config_.rtp.ssrcs[i], weight);
+        if (i < config_.rtp.rtx.ssrcs.size()) {
+          packet_sender->SetStreamWeight(config_.rtp.rtx.ssrcs[i], weight);
+        }
+      }
+    }
+
     const size_t num_temporal_layers =
         streams.back().num_temporal_layers.value_or(1);
 